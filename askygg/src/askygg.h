@@ -35,6 +35,7 @@
 #include "askygg/renderer/Framebuffer.h"
 #include "askygg/renderer/Renderer.h"
 #include "askygg/renderer/UniformBuffer.h"
+#include "askygg/renderer/PixelBuffer.h"
 //--------------------- RENDERING ---------------------//
 
 //--------------------- UI ---------------------//
@@ -1,5 +1,6 @@
 #include "askygg/core/Application.h"
 
+#include <chrono>
 #include <utility>
 #include "askygg/core/Utility.h"
 #include "askygg/core/Time.h"
@@ -16,6 +17,11 @@
 
 namespace askygg
 {
+	// ImGui handles input on the frame after it arrived and settles hover and active states over the next ones.
+	static constexpr uint32_t FramesPerEvent = 3;
+	// Upper bound on an idle wait; nothing depends on it, it only keeps the loop from sleeping indefinitely.
+	static constexpr double IdleWaitSeconds = 0.5;
+
 	Application*				  Application::s_Instance = nullptr;
 	PlatformApplicationInterface* Application::s_ApplicationDelegate = nullptr;
 
@@ -59,6 +65,20 @@ namespace askygg
 	{
 		while (m_IsRunning)
 		{
+			if (m_RenderOnDemand)
+			{
+				if (m_PendingFrames == 0)
+					GetWindow().WaitEvents(IdleWaitSeconds);
+				if (m_PendingFrames == 0)
+				{
+					m_IdleWaitCount++;
+					continue;
+				}
+				m_PendingFrames--;
+			}
+			m_FrameCount++;
+			const auto frameStart = std::chrono::steady_clock::now();
+
 			Time::Tick();
 			float deltaTime = Time::DeltaTime();
 
@@ -70,6 +90,7 @@ namespace askygg
 			for (Layer* layer : *m_LayerStack)
 				layer->OnImGuiRender();
 			m_ImGuiLayer->End();
+			m_FrameTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
 
 			s_ApplicationDelegate->Tick(deltaTime);
 		}
@@ -81,8 +102,19 @@ namespace askygg
 		s_ApplicationDelegate->Exit();
 	}
 
+	void Application::RequestFrames(uint32_t frameCount)
+	{
+		uint32_t pending = s_Instance->m_PendingFrames;
+		while (pending < frameCount && !s_Instance->m_PendingFrames.compare_exchange_weak(pending, frameCount))
+			;
+		GetWindow().Wake();
+	}
+
 	void Application::OnEvent(Event& event)
 	{
+		if (m_RenderOnDemand && m_PendingFrames < FramesPerEvent)
+			m_PendingFrames = FramesPerEvent;
+
 		EventDispatcher dispatcher(event);
 		s_ApplicationDelegate->OnEvent(event);
 
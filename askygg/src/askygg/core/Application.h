@@ -8,6 +8,8 @@
 #include "askygg/imgui/ImGuiLayer.h"
 #include "askygg/core/Assert.h"
 
+#include <atomic>
+
 namespace askygg
 {
 	struct ApplicationCommandLineArgs
@@ -48,6 +50,18 @@ namespace askygg
 		static void Close();
 		void		OnEvent(Event& event);
 
+		// Instead of spinning, sleeps in the window's event wait and only runs a frame once input arrived or a frame
+		// was requested.  Layers keep drawing whatever they last produced.
+		void		SetRenderOnDemand(bool enabled) { m_RenderOnDemand = enabled; }
+		bool		IsRenderOnDemand() const { return m_RenderOnDemand; }
+		// Makes sure the next frameCount frames run, e.g. for work finishing in the background.  Safe from any thread.
+		static void RequestFrames(uint32_t frameCount = 1);
+		// Frames run, and event waits that timed out without anything to do.
+		uint64_t	GetFrameCount() const { return m_FrameCount; }
+		uint64_t	GetIdleWaitCount() const { return m_IdleWaitCount; }
+		// CPU milliseconds the last frame spent in the layers and ImGui, the buffer swap excluded.
+		double		GetFrameTime() const { return m_FrameTime; }
+
 		static Application&					 GetApplication() { return *s_Instance; }
 		static PlatformApplicationInterface* GetPlatformAppInterface() { return s_ApplicationDelegate; }
 		static Window&						 GetWindow() { return s_ApplicationDelegate->GetWindow(); }
@@ -65,6 +79,11 @@ namespace askygg
 	private:
 		ApplicationSpecification m_Specification;
 		bool					 m_IsRunning = true;
+		bool					 m_RenderOnDemand = false;
+		std::atomic<uint32_t>	 m_PendingFrames = 0;
+		uint64_t				 m_FrameCount = 0;
+		uint64_t				 m_IdleWaitCount = 0;
+		double					 m_FrameTime = 0.0;
 		ImGuiLayer*				 m_ImGuiLayer;
 		LayerStack*				 m_LayerStack;
 
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace askygg
+{
+	// Multi-producer, multi-consumer FIFO.  Pop() blocks until an item arrives or the queue is closed and drained, so
+	// Close() is how producers signal the end of a stream.  With a capacity, Push() blocks while the queue is full.
+	template <typename T>
+	class BlockingQueue
+	{
+	public:
+		explicit BlockingQueue(size_t capacity = 0)
+			: m_Capacity(capacity) {}
+
+		// False if the queue was closed before the item could be added; the item is dropped.
+		bool Push(T item)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				if (m_Capacity > 0)
+					m_SpaceCondition.wait(lock, [this] { return m_Items.size() < m_Capacity || m_Closed; });
+				if (m_Closed && m_Capacity > 0)
+					return false;
+				m_Items.push_back(std::move(item));
+			}
+			m_Condition.notify_one();
+			return true;
+		}
+
+		// False once the queue is closed and empty.
+		bool Pop(T& item)
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Condition.wait(lock, [this] { return !m_Items.empty() || m_Closed; });
+			if (m_Items.empty())
+				return false;
+
+			item = std::move(m_Items.front());
+			m_Items.pop_front();
+			if (m_Capacity > 0)
+			{
+				lock.unlock();
+				m_SpaceCondition.notify_one();
+			}
+			return true;
+		}
+
+		void Close()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Closed = true;
+			}
+			m_Condition.notify_all();
+			m_SpaceCondition.notify_all();
+		}
+
+		size_t GetSize() const
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			return m_Items.size();
+		}
+
+	private:
+		mutable std::mutex		m_Mutex;
+		std::condition_variable m_Condition;
+		std::condition_variable m_SpaceCondition;
+		std::deque<T>			m_Items;
+		size_t					m_Capacity = 0;
+		bool					m_Closed = false;
+	};
+} // namespace askygg
@@ -4,6 +4,9 @@ int main(int argc, char** argv)
 {
 	askygg::Log::Init();
 	auto* app = askygg::CreateApplication({ argc, argv });
+	// Null when the client finished its work without an application, window or context.
+	if (!app)
+		return 0;
 	app->Run();
 	delete app;
 }
\ No newline at end of file
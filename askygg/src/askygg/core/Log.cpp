@@ -20,4 +20,11 @@ namespace askygg
 		s_Logger->set_level(spdlog::level::trace);
 		s_Logger->flush_on(spdlog::level::trace);
 	}
+
+	void Log::RedirectConsoleToStderr()
+	{
+		auto consoleSink = std::make_shared<spdlog::sinks::stderr_color_sink_mt>();
+		consoleSink->set_pattern("%^[%T] %n: %v%$");
+		s_Logger->sinks()[0] = consoleSink;
+	}
 } // namespace askygg
@@ -9,6 +9,8 @@ namespace askygg
 	{
 	public:
 		static void					Init();
+		// Moves console output to stderr, for modes that write data to stdout.
+		static void					RedirectConsoleToStderr();
 		static Ref<spdlog::logger>& GetLogger() { return s_Logger; }
 		template <typename... Args>
 		static void PrintAssertMessage(std::string_view Prefix, Args&&... args);
@@ -28,6 +28,10 @@ namespace askygg
 
 		virtual ~Window() = default;
 		virtual void OnUpdate() = 0;
+		// Blocks until an event arrives, Wake() is called or timeoutSeconds passed, dispatching what arrived.
+		virtual void WaitEvents(double timeoutSeconds) = 0;
+		// Ends a WaitEvents() early.  Safe from any thread.
+		virtual void Wake() = 0;
 
 		virtual void SetEventCallback(const EventCallbackFn& callback) = 0;
 		virtual void ToggleIsMaximized(bool maximize) const = 0;
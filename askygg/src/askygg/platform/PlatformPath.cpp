@@ -14,8 +14,18 @@
 
 #include <cstring>
 
+static std::string s_ExecutablePathOverride;
+
+void OverrideExecutablePath(const std::string& path)
+{
+    s_ExecutablePathOverride = path;
+}
+
 std::string GetExecutablePath()
 {
+    if (!s_ExecutablePathOverride.empty())
+        return s_ExecutablePathOverride;
+
     char path[1024];
     std::memset(path, 0, sizeof(path));
 
@@ -1,4 +1,7 @@
 #pragma once
 #include <string>
 
-std::string GetExecutablePath();
\ No newline at end of file
+std::string GetExecutablePath();
+// Assets are resolved next to the executable.  Hosts that embed the engine (the Python module) point this at the
+// directory holding assets/ instead.
+void OverrideExecutablePath(const std::string& path);
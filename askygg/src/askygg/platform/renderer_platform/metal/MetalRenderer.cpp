@@ -67,6 +67,7 @@ namespace askygg
 	void MetalRenderer::Clear(bool colorBit, bool depthBit) {}
 
 	void MetalRenderer::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount) {}
+	void MetalRenderer::InsertMemoryBarrier(MemoryBarrierFlag flags) {}
 
 	std::string ReadFileIntoString(const std::string& fileName)
 	{
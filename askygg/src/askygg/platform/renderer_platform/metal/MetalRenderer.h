@@ -25,6 +25,7 @@ namespace askygg
 		void SetClearColor(const glm::vec4& color) override;
 		void Clear(bool colorBit, bool depthBit) override;
 		void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount) override;
+		void InsertMemoryBarrier(MemoryBarrierFlag flags) override;
 
 	public:
 		void DrawView(MTK::View* view);
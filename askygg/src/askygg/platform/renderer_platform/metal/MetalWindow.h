@@ -15,6 +15,8 @@ namespace askygg
         ~MetalWindow() override;
 
         void OnUpdate() override;
+        void WaitEvents(double timeoutSeconds) override { }
+        void Wake() override { }
         void SetEventCallback(const EventCallbackFn &callback) override { }
         void ToggleIsMaximized(bool maximize) const override { }
         void SetVSync(bool enabled) override { }
@@ -6,12 +6,28 @@
 
 namespace askygg
 {
-	OpenGLGraphicsContext::OpenGLGraphicsContext(GLFWwindow* windowHandle)
-		: m_WindowHandle(windowHandle)
+	OpenGLGraphicsContext::OpenGLGraphicsContext(GLFWwindow* windowHandle, bool ownsWindow)
+		: m_WindowHandle(windowHandle), m_OwnsWindow(ownsWindow)
 	{
 		YGG_ASSERT(windowHandle, "Window handle is null!")
 	}
 
+	OpenGLGraphicsContext::~OpenGLGraphicsContext()
+	{
+		if (m_OwnsWindow)
+			glfwDestroyWindow(m_WindowHandle);
+	}
+
+	Ref<GraphicsContext> OpenGLGraphicsContext::CreateShared(GLFWwindow* shareWindow)
+	{
+		// GLFW only creates contexts together with a window; a hidden 1x1 one is never presented.
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		GLFWwindow* window = glfwCreateWindow(1, 1, "askygg worker", nullptr, shareWindow);
+		glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+		YGG_ASSERT(window, "Failed to create a shared OpenGL context!");
+		return CreateRef<OpenGLGraphicsContext>(window, true);
+	}
+
 	void OpenGLGraphicsContext::Initialize()
 	{
 		glfwMakeContextCurrent(m_WindowHandle);
@@ -31,4 +47,15 @@ namespace askygg
 	{
 		glfwSwapBuffers(m_WindowHandle);
 	}
+
+	void OpenGLGraphicsContext::MakeCurrent()
+	{
+		glfwMakeContextCurrent(m_WindowHandle);
+	}
+
+	void OpenGLGraphicsContext::DetachCurrent()
+	{
+		if (glfwGetCurrentContext() == m_WindowHandle)
+			glfwMakeContextCurrent(nullptr);
+	}
 } // namespace askygg
\ No newline at end of file
@@ -8,12 +8,18 @@ namespace askygg
 	class OpenGLGraphicsContext : public GraphicsContext
 	{
 	public:
-		explicit OpenGLGraphicsContext(GLFWwindow* windowHandle);
+		explicit OpenGLGraphicsContext(GLFWwindow* windowHandle, bool ownsWindow = false);
+		~OpenGLGraphicsContext() override;
 
 		void Initialize() override;
 		void SwapBuffers() override;
+		void MakeCurrent() override;
+		void DetachCurrent() override;
+
+		static Ref<GraphicsContext> CreateShared(GLFWwindow* shareWindow);
 
 	private:
 		GLFWwindow* m_WindowHandle;
+		bool		m_OwnsWindow;
 	};
 } // namespace askygg
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "OpenGLHeadlessContext.h"
+#include "askygg/core/Assert.h"
+
+#include "glad/glad.h"
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace askygg
+{
+	static EGLDisplay GetSurfacelessDisplay()
+	{
+		static EGLDisplay display = EGL_NO_DISPLAY;
+		if (display != EGL_NO_DISPLAY)
+			return display;
+
+		auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+		YGG_ASSERT(getPlatformDisplay, "EGL_EXT_platform_base is not available!");
+		display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+		YGG_ASSERT(display != EGL_NO_DISPLAY, "Failed to open a surfaceless EGL display!");
+
+		EGLint	  major, minor;
+		EGLBoolean initialized = eglInitialize(display, &major, &minor);
+		YGG_ASSERT(initialized, "Failed to initialize EGL!");
+		YGG_LOG_INFO("EGL {}.{}: {}", major, minor, eglQueryString(display, EGL_VENDOR));
+		return display;
+	}
+
+	OpenGLHeadlessContext::OpenGLHeadlessContext(const OpenGLHeadlessContext* shareContext)
+	{
+		m_Display = GetSurfacelessDisplay();
+		// The bound API is per thread, and contexts may be created from any thread.
+		EGLBoolean bound = eglBindAPI(EGL_OPENGL_API);
+		YGG_ASSERT(bound, "EGL does not support desktop OpenGL!");
+
+		const EGLint contextAttributes[] = {
+			EGL_CONTEXT_MAJOR_VERSION, 4,
+			EGL_CONTEXT_MINOR_VERSION, 5,
+			EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+			EGL_NONE
+		};
+		// No surface is ever bound, so no config is needed either (EGL_KHR_no_config_context).
+		m_Context = eglCreateContext(m_Display, EGL_NO_CONFIG_KHR,
+			shareContext ? shareContext->m_Context : EGL_NO_CONTEXT, contextAttributes);
+		YGG_ASSERT(m_Context != EGL_NO_CONTEXT, "Failed to create a headless OpenGL 4.5 context (EGL error {:#x})!",
+			eglGetError());
+	}
+
+	OpenGLHeadlessContext::~OpenGLHeadlessContext()
+	{
+		DetachCurrent();
+		eglDestroyContext(m_Display, m_Context);
+	}
+
+	void OpenGLHeadlessContext::Initialize()
+	{
+		MakeCurrent();
+		int status = gladLoadGLLoader((GLADloadproc)eglGetProcAddress);
+		YGG_ASSERT(status, "Failed to initialize Glad!");
+
+		YGG_LOG_INFO("OpenGL Info (headless):");
+		YGG_LOG_INFO("  Vendor: {0}", glGetString(GL_VENDOR));
+		YGG_LOG_INFO("  Renderer: {0}", glGetString(GL_RENDERER));
+		YGG_LOG_INFO("  Version: {0}", glGetString(GL_VERSION));
+
+		YGG_ASSERT(GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 5),
+			"askygg requires at least OpenGL version 4.5!");
+	}
+
+	void OpenGLHeadlessContext::MakeCurrent()
+	{
+		EGLBoolean status = eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_Context);
+		YGG_ASSERT(status, "Failed to make the headless context current!");
+	}
+
+	void OpenGLHeadlessContext::DetachCurrent()
+	{
+		if (eglGetCurrentContext() == m_Context)
+			eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	}
+} // namespace askygg
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "askygg/renderer/GraphicsContext.h"
+
+namespace askygg
+{
+	// Window-less OpenGL context on an EGL surfaceless display (Mesa llvmpipe included), for tools that never
+	// present anything.  Rendering goes to textures only; the default framebuffer does not exist.
+	class OpenGLHeadlessContext : public GraphicsContext
+	{
+	public:
+		explicit OpenGLHeadlessContext(const OpenGLHeadlessContext* shareContext = nullptr);
+		~OpenGLHeadlessContext() override;
+
+		void Initialize() override;
+		void SwapBuffers() override {}
+		void MakeCurrent() override;
+		void DetachCurrent() override;
+
+	private:
+		// EGLDisplay / EGLContext, kept opaque so the EGL headers stay out of the engine's public includes.
+		void* m_Display = nullptr;
+		void* m_Context = nullptr;
+	};
+} // namespace askygg
@@ -143,5 +143,25 @@ namespace askygg
 		glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr);
 	}
 
+	void OpenGLRenderer::InsertMemoryBarrier(MemoryBarrierFlag flags)
+	{
+		GLbitfield barriers = 0;
+
+		if ((flags & MemoryBarrierFlag::ShaderImageAccess) != MemoryBarrierFlag::None)
+			barriers |= GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+
+		if ((flags & MemoryBarrierFlag::TextureFetch) != MemoryBarrierFlag::None)
+			barriers |= GL_TEXTURE_FETCH_BARRIER_BIT;
+
+		if ((flags & MemoryBarrierFlag::TextureUpdate) != MemoryBarrierFlag::None)
+			barriers |= GL_TEXTURE_UPDATE_BARRIER_BIT;
+
+		if ((flags & MemoryBarrierFlag::Framebuffer) != MemoryBarrierFlag::None)
+			barriers |= GL_FRAMEBUFFER_BARRIER_BIT;
+
+		if (barriers != 0)
+			glMemoryBarrier(barriers);
+	}
+
 	void OpenGLRenderer::Shutdown() {}
 } // namespace askygg
\ No newline at end of file
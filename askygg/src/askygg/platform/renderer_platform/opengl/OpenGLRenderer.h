@@ -12,5 +12,6 @@ namespace askygg
 		void SetClearColor(const glm::vec4& color) override;
 		void Clear(bool colorBufferBit, bool depthBufferBit) override;
 		void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount) override;
+		void InsertMemoryBarrier(MemoryBarrierFlag flags) override;
 	};
 } // namespace askygg
\ No newline at end of file
@@ -41,6 +41,7 @@ namespace askygg
 	}
 
 	OpenGLShader::OpenGLShader(const std::string& filePath)
+		: m_FilePath(filePath)
 	{
 		const size_t shaderLocationOffset = filePath.rfind('/') + 1;
 		const size_t extensionOffset = filePath.find_first_of('.', shaderLocationOffset);
@@ -53,9 +54,49 @@ namespace askygg
 		Reflect();
 	}
 
+	OpenGLShader::OpenGLShader(const std::string& name, const std::string& filePath, uint32_t programID, bool isCompute)
+		: m_FilePath(filePath)
+	{
+		m_Name = name;
+		m_ID = programID;
+		m_IsCompute = isCompute;
+		Reflect();
+	}
+
 	OpenGLShader::~OpenGLShader()
 	{
-		glDeleteShader(m_ID);
+		glDeleteProgram(m_ID);
+	}
+
+	Ref<Shader> OpenGLShader::Clone() const
+	{
+		// Relinking from the driver's binary skips the GLSL front end; drivers that expose no binary formats get a
+		// regular compile from source instead.
+		GLint formatCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+		GLint binaryLength = 0;
+		if (formatCount > 0)
+			glGetProgramiv(m_ID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+
+		if (binaryLength > 0)
+		{
+			std::vector<uint8_t> binary(binaryLength);
+			GLenum				 binaryFormat = 0;
+			glGetProgramBinary(m_ID, binaryLength, nullptr, &binaryFormat, binary.data());
+
+			const GLuint program = glCreateProgram();
+			glProgramBinary(program, binaryFormat, binary.data(), binaryLength);
+
+			GLint isLinked = 0;
+			glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+			if (isLinked == GL_TRUE)
+				return CreateRef<OpenGLShader>(m_Name, m_FilePath, program, m_IsCompute);
+
+			glDeleteProgram(program);
+			YGG_LOG_WARN("{}: program binary was rejected, recompiling from source.", m_Name);
+		}
+
+		return CreateRef<OpenGLShader>(m_FilePath);
 	}
 
 	void OpenGLShader::Bind() const
@@ -225,6 +266,8 @@ namespace askygg
 
 		m_ID = program;
 
+		// Lets Clone() relink per-context copies from the binary.
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 		glLinkProgram(program);
 
 		GLint isLinked = 0;
@@ -459,6 +502,13 @@ namespace askygg
 		return location;
 	}
 
+	GLint OpenGLShader::UploadUniformInt2(const std::string& name, const glm::ivec2& value)
+	{
+		GLint location = glGetUniformLocation(m_ID, name.c_str());
+		glUniform2i(location, value.x, value.y);
+		return location;
+	}
+
 	GLint OpenGLShader::UploadUniformIntArray(const std::string& name, uint32_t count, int* basePtr)
 	{
 		GLint location = glGetUniformLocation(m_ID, name.c_str());
@@ -10,6 +10,8 @@ namespace askygg
 	{
 	public:
 		explicit OpenGLShader(const std::string& filePath);
+		// Adopts an already linked program.
+		OpenGLShader(const std::string& name, const std::string& filePath, uint32_t programID, bool isCompute);
 		~OpenGLShader() override;
 
 		void Bind() const override;
@@ -21,6 +23,7 @@ namespace askygg
 		int UploadUniformFloat4(const std::string& name, const glm::vec4& value) override;
 		int UploadUniformBool(const std::string& name, bool value) override;
 		int UploadUniformInt(const std::string& name, int value) override;
+		int UploadUniformInt2(const std::string& name, const glm::ivec2& value) override;
 		int UploadUniformIntArray(const std::string& name, uint32_t count, int* basePtr) override;
 		int UploadUniformMat3(const std::string& name, const glm::mat3& matrix) override;
 		int UploadUniformMat4(const std::string& name, const glm::mat4& matrix) override;
@@ -32,10 +35,15 @@ namespace askygg
 
 		void EnableShaderImageAccessBarrierBit() override;
 
+		Ref<Shader> Clone() const override;
+
 	private:
 		static std::string							   ReadFile(const std::string& filePath);
 		static std::unordered_map<GLenum, std::string> PreProcess(const std::string& source);
 		void										   Compile(const std::unordered_map<GLenum, std::string>& shaderSources);
 		void										   Reflect();
+
+	private:
+		std::string m_FilePath;
 	};
 } // namespace askygg
@@ -34,6 +34,7 @@ namespace askygg
 			// get query results
 			glGetQueryObjectui64v(queryID[0], GL_QUERY_RESULT, &startTime);
 			glGetQueryObjectui64v(queryID[1], GL_QUERY_RESULT, &stopTime);
+			glDeleteQueries(2, queryID);
 
 			return static_cast<double>(stopTime - startTime) / 1000000.0;
 		}
@@ -140,6 +140,16 @@ namespace askygg
 		m_Context->SwapBuffers();
 	}
 
+	void GLFWXPlatformWindow::WaitEvents(double timeoutSeconds)
+	{
+		glfwWaitEventsTimeout(timeoutSeconds);
+	}
+
+	void GLFWXPlatformWindow::Wake()
+	{
+		glfwPostEmptyEvent();
+	}
+
 	void GLFWXPlatformWindow::ToggleIsMaximized(bool maximize) const
 	{
 		if (maximize)
@@ -12,6 +12,8 @@ namespace askygg
 		explicit GLFWXPlatformWindow(const WindowProperties& props);
 		~GLFWXPlatformWindow() override;
 		void OnUpdate() override;
+		void WaitEvents(double timeoutSeconds) override;
+		void Wake() override;
 
 		void SetEventCallback(const EventCallbackFn& callback) override { m_Data.Callback = callback; }
 		void ToggleIsHidden(bool hidden) override;
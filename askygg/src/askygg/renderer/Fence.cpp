@@ -0,0 +1,35 @@
+#include "askygg/renderer/Fence.h"
+#include "askygg/core/Assert.h"
+#include <glad/glad.h>
+
+namespace askygg
+{
+	Fence::Fence()
+	{
+		m_Sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		glFlush();
+	}
+
+	Fence::~Fence()
+	{
+		glDeleteSync((GLsync)m_Sync);
+	}
+
+	void Fence::Wait() const
+	{
+		GLenum status = glClientWaitSync((GLsync)m_Sync, 0, UINT64_MAX);
+		YGG_ASSERT(status != GL_WAIT_FAILED, "Fence: waiting failed.");
+	}
+
+	void Fence::WaitGPU() const
+	{
+		glWaitSync((GLsync)m_Sync, 0, GL_TIMEOUT_IGNORED);
+	}
+
+	bool Fence::IsSignaled() const
+	{
+		GLint status = GL_UNSIGNALED;
+		glGetSynciv((GLsync)m_Sync, GL_SYNC_STATUS, 1, nullptr, &status);
+		return status == GL_SIGNALED;
+	}
+} // namespace askygg
@@ -0,0 +1,26 @@
+#pragma once
+
+namespace askygg
+{
+	// A point in the command stream of the context that was current when it was created.  Other contexts sharing
+	// objects with it wait for it before they use what those commands produced.  Creating one flushes the context, so
+	// the fence is guaranteed to signal without further calls there.
+	class Fence
+	{
+	public:
+		Fence();
+		~Fence();
+
+		Fence(const Fence&) = delete;
+		Fence& operator=(const Fence&) = delete;
+
+		// Blocks the calling thread until the commands before the fence completed.
+		void Wait() const;
+		// Makes the GPU hold back the current context's later commands until then; the calling thread goes on.
+		void WaitGPU() const;
+		bool IsSignaled() const;
+
+	private:
+		void* m_Sync = nullptr;
+	};
+} // namespace askygg
@@ -2,28 +2,19 @@
 #include "askygg/core/Assert.h"
 
 #include "askygg/renderer/PlatformRenderAPI.h"
-#include "askygg/platform/renderer_platform/opengl/OpenGLGraphicsContext.h"
+#ifdef YGG_HEADLESS_EGL
+	#include "askygg/platform/renderer_platform/opengl/OpenGLHeadlessContext.h"
+#endif
 
 namespace askygg
 {
-	Ref<GraphicsContext> GraphicsContext::Create(void* window)
+	Ref<GraphicsContext> GraphicsContext::CreateHeadless(const GraphicsContext* share)
 	{
-		switch (PlatformRenderAPI::GetPlatformRendererType())
-		{
-			case PlatformRenderAPI::API::None:
-				YGG_ASSERT(false, "RendererAPI::None is currently not supported!");
-				return nullptr;
-			case PlatformRenderAPI::API::Vulkan:
-				YGG_ASSERT(false, "RendererAPI::Vulkan is currently not supported!");
-				return nullptr;
-			case PlatformRenderAPI::API::Metal:
-				YGG_ASSERT(false, "RendererAPI::Metal is currently not supported!");
-				return nullptr;
-			case PlatformRenderAPI::API::OpenGL:
-				return CreateRef<OpenGLGraphicsContext>(static_cast<GLFWwindow*>(window));
-		}
-
-		YGG_ASSERT(false, "Unknown RendererAPI!");
+#ifdef YGG_HEADLESS_EGL
+		if (PlatformRenderAPI::GetPlatformRendererType() == PlatformRenderAPI::API::OpenGL)
+			return CreateRef<OpenGLHeadlessContext>(static_cast<const OpenGLHeadlessContext*>(share));
+#endif
+		YGG_ASSERT(false, "Headless contexts need OpenGL and a build with EGL (YGG_HEADLESS_EGL)!");
 		return nullptr;
 	}
 } // namespace askygg
\ No newline at end of file
@@ -10,6 +10,15 @@ namespace askygg
 		virtual ~GraphicsContext() = default;
 		virtual void				Initialize() = 0;
 		virtual void				SwapBuffers() = 0;
+		virtual void				MakeCurrent() = 0;
+		virtual void				DetachCurrent() = 0;
+		// Create() and CreateShared() are part of askygg, not askygg_core, since windows need GLFW.
 		static Ref<GraphicsContext> Create(void* windowHandle);
+		// Off-screen context sharing objects (textures, programs) with the window's context.  Must be created and
+		// destroyed on the main thread, but may be made current on any one thread at a time.
+		static Ref<GraphicsContext> CreateShared(void* shareWindowHandle);
+		// Window-less context for tools that only render to textures.  Requires a build with YGG_HEADLESS_EGL.  With
+		// share, objects are shared with that (headless) context.
+		static Ref<GraphicsContext> CreateHeadless(const GraphicsContext* share = nullptr);
 	};
 } // namespace askygg
\ No newline at end of file
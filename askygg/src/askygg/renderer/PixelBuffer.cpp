@@ -0,0 +1,53 @@
+#include "askygg/renderer/PixelBuffer.h"
+#include "askygg/core/Assert.h"
+#include <glad/glad.h>
+
+namespace askygg
+{
+	PixelPackBuffer::PixelPackBuffer(uint64_t size)
+		: m_Size(size)
+	{
+		glCreateBuffers(1, &m_ID);
+		// Only ever read by the CPU, so ask for memory on its side of the bus.
+		glNamedBufferStorage(m_ID, (GLsizeiptr)size, nullptr, GL_MAP_READ_BIT | GL_CLIENT_STORAGE_BIT);
+	}
+
+	PixelPackBuffer::~PixelPackBuffer()
+	{
+		if (m_Fence)
+			glDeleteSync((GLsync)m_Fence);
+		glDeleteBuffers(1, &m_ID);
+	}
+
+	void PixelPackBuffer::ReadTexture(const Texture2D& texture, ImageUtils::ImageDataLayout layout,
+		ImageUtils::ImageDataType type)
+	{
+		YGG_ASSERT(!m_Fence, "PixelPackBuffer: the previous readback was never mapped.");
+
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, m_ID);
+		glGetTextureImage(texture.GetID(), 0, ImageUtils::ConvertDataLayoutMode(layout),
+			ImageUtils::ConvertImageDataType(type), (GLsizei)m_Size, nullptr);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		m_Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
+	const void* PixelPackBuffer::Map()
+	{
+		if (m_Fence)
+		{
+			// The first wait flushes, so the copy is guaranteed to make progress.
+			GLenum status = glClientWaitSync((GLsync)m_Fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+			YGG_ASSERT(status != GL_WAIT_FAILED, "PixelPackBuffer: waiting for the readback failed.");
+			glDeleteSync((GLsync)m_Fence);
+			m_Fence = nullptr;
+		}
+		return glMapNamedBufferRange(m_ID, 0, (GLsizeiptr)m_Size, GL_MAP_READ_BIT);
+	}
+
+	void PixelPackBuffer::Unmap()
+	{
+		glUnmapNamedBuffer(m_ID);
+	}
+} // namespace askygg
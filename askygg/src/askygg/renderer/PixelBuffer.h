@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+
+#include "askygg/renderer/Texture.h"
+
+namespace askygg
+{
+	// Asynchronous texture readback.  The copy into the buffer is queued behind the work that produced the texture
+	// and fenced, so the CPU only blocks when it maps a copy that has not finished yet.
+	class PixelPackBuffer
+	{
+	public:
+		explicit PixelPackBuffer(uint64_t size);
+		~PixelPackBuffer();
+
+		// Queues a copy of level 0 in the given client layout; rows are tightly packed.
+		void ReadTexture(const Texture2D& texture, ImageUtils::ImageDataLayout layout, ImageUtils::ImageDataType type);
+		bool IsPending() const { return m_Fence != nullptr; }
+
+		// Waits for the queued copy and maps it.  Unmap() before queueing the next one.
+		const void* Map();
+		void		Unmap();
+
+		uint64_t GetSize() const { return m_Size; }
+
+	private:
+		uint32_t m_ID = 0;
+		uint64_t m_Size;
+		void*	 m_Fence = nullptr;
+	};
+} // namespace askygg
@@ -3,6 +3,7 @@
 #include "VertexArray.h"
 #include "Material.h"
 #include "RenderPass.h"
+#include "RenderCommand.h"
 
 #include <glm/glm.hpp>
 
@@ -32,6 +33,7 @@ namespace askygg
 		virtual void SetClearColor(const glm::vec4& color) = 0;
 		virtual void Clear(bool colorBufferBit, bool depthBufferBit) = 0;
 		virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount) = 0;
+		virtual void InsertMemoryBarrier(MemoryBarrierFlag flags) = 0;
 
 	private:
 		static Ref<PlatformRenderAPI> s_RenderAPI;
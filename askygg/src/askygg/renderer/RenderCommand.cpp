@@ -27,4 +27,11 @@ namespace askygg
 	{
 		PlatformRenderAPI::Get()->DrawIndexed(vertexArray, indexCount);
 	}
+
+	void RenderCommand::InsertMemoryBarrier(MemoryBarrierFlag flags)
+	{
+		if (flags == MemoryBarrierFlag::None)
+			return;
+		PlatformRenderAPI::Get()->InsertMemoryBarrier(flags);
+	}
 } // namespace askygg
@@ -37,6 +37,30 @@ namespace askygg
 		Back
 	};
 
+	enum class MemoryBarrierFlag : uint32_t
+	{
+		None = 0,
+		ShaderImageAccess = (1 << 0),
+		TextureFetch = (1 << 1),
+		TextureUpdate = (1 << 2),
+		Framebuffer = (1 << 3)
+	};
+
+	inline MemoryBarrierFlag operator|(MemoryBarrierFlag a, MemoryBarrierFlag b)
+	{
+		return static_cast<MemoryBarrierFlag>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+	}
+
+	inline MemoryBarrierFlag operator&(MemoryBarrierFlag a, MemoryBarrierFlag b)
+	{
+		return static_cast<MemoryBarrierFlag>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
+	}
+
+	inline MemoryBarrierFlag& operator|=(MemoryBarrierFlag& a, MemoryBarrierFlag b)
+	{
+		return a = a | b;
+	}
+
 	class RenderCommand
 	{
 	public:
@@ -45,5 +69,6 @@ namespace askygg
 		static void SetViewport(uint32_t width, uint32_t height);
 		static void ClearColor(const glm::vec4& clearColor);
 		static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0);
+		static void InsertMemoryBarrier(MemoryBarrierFlag flags);
 	};
 } // namespace askygg
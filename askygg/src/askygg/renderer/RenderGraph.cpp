@@ -0,0 +1,308 @@
+#include "askygg/renderer/RenderGraph.h"
+#include "askygg/core/Assert.h"
+#include "askygg/core/Log.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace askygg
+{
+	// Graphs on worker contexts allocate concurrently.
+	static std::atomic<uint32_t> s_TransientTextureCounter = 0;
+
+	RenderGraphResource RenderGraphBuilder::CreateTexture(const std::string& name, const RenderGraphTextureDesc& desc)
+	{
+		RenderGraph::ResourceNode resource;
+		resource.Name = name;
+		resource.Desc = desc;
+		m_Graph.m_Resources.push_back(resource);
+		return Write((RenderGraphResource)m_Graph.m_Resources.size() - 1);
+	}
+
+	RenderGraphResource RenderGraphBuilder::Import(const std::string& name, const Ref<Texture2D>& texture)
+	{
+		return m_Graph.ImportTexture(name, texture);
+	}
+
+	RenderGraphResource RenderGraphBuilder::Read(RenderGraphResource resource, RenderGraphAccess access)
+	{
+		YGG_ASSERT(resource < m_Graph.m_Resources.size(), "RenderGraph: pass reads an undeclared resource.");
+		m_Graph.m_Passes[m_PassIndex].Reads.emplace_back(resource, access);
+		auto& node = m_Graph.m_Resources[resource];
+		node.LastRead = std::max(node.LastRead, (int32_t)m_PassIndex);
+		return resource;
+	}
+
+	RenderGraphResource RenderGraphBuilder::Write(RenderGraphResource resource)
+	{
+		YGG_ASSERT(resource < m_Graph.m_Resources.size(), "RenderGraph: pass writes an undeclared resource.");
+		m_Graph.m_Passes[m_PassIndex].Writes.push_back(resource);
+		auto& node = m_Graph.m_Resources[resource];
+		if (node.FirstWrite < 0)
+			node.FirstWrite = (int32_t)m_PassIndex;
+		return resource;
+	}
+
+	RenderGraph::~RenderGraph()
+	{
+		ReleaseTransientTextures();
+	}
+
+	void RenderGraph::Reset()
+	{
+		m_Resources.clear();
+		m_Passes.clear();
+		m_Outputs.clear();
+		m_OutputBarriers = MemoryBarrierFlag::None;
+	}
+
+	RenderGraphResource RenderGraph::ImportTexture(const std::string& name, uint32_t textureID)
+	{
+		ResourceNode resource;
+		resource.Name = name;
+		resource.Imported = true;
+		resource.ImportedID = textureID;
+		m_Resources.push_back(resource);
+		return (RenderGraphResource)m_Resources.size() - 1;
+	}
+
+	RenderGraphResource RenderGraph::ImportTexture(const std::string& name, const Ref<Texture2D>& texture)
+	{
+		ResourceNode resource;
+		resource.Name = name;
+		resource.Imported = true;
+		resource.Texture = texture;
+		resource.Desc = { texture->GetWidth(), texture->GetHeight(), texture->GetSpecification().InternalFormat };
+		m_Resources.push_back(resource);
+		return (RenderGraphResource)m_Resources.size() - 1;
+	}
+
+	RenderGraphBuilder RenderGraph::AddPass(const std::string& name, ExecuteFn execute)
+	{
+		PassNode pass;
+		pass.Name = name;
+		pass.Execute = std::move(execute);
+		m_Passes.push_back(std::move(pass));
+		return { *this, (uint32_t)m_Passes.size() - 1 };
+	}
+
+	void RenderGraph::MarkOutput(RenderGraphResource resource, RenderGraphAccess access)
+	{
+		YGG_ASSERT(resource < m_Resources.size(), "RenderGraph: output is an undeclared resource.");
+		m_Outputs.emplace_back(resource, access);
+		// Outputs live until the end of the graph.
+		m_Resources[resource].LastRead = INT32_MAX;
+	}
+
+	void RenderGraph::Compile()
+	{
+		AssignTransientStorage();
+		PlaceBarriers();
+	}
+
+	void RenderGraph::Execute() const
+	{
+		for (uint32_t i = 0; i < (uint32_t)m_Passes.size(); i++)
+			ExecutePass(i);
+		FinishExecution();
+	}
+
+	void RenderGraph::ExecutePass(uint32_t passIndex) const
+	{
+		const auto& pass = m_Passes[passIndex];
+		RenderCommand::InsertMemoryBarrier(pass.Barriers);
+		pass.Execute(*this);
+	}
+
+	void RenderGraph::FinishExecution() const
+	{
+		RenderCommand::InsertMemoryBarrier(m_OutputBarriers);
+	}
+
+	uint32_t RenderGraph::GetTextureID(RenderGraphResource resource) const
+	{
+		const auto& node = m_Resources[resource];
+		if (node.Imported && !node.Texture)
+			return node.ImportedID;
+		return node.Texture->GetID();
+	}
+
+	const Ref<Texture2D>& RenderGraph::GetTexture(RenderGraphResource resource) const
+	{
+		const auto& node = m_Resources[resource];
+		YGG_ASSERT(node.Texture, "RenderGraph: '{}' was imported by ID and has no Texture2D.", node.Name);
+		return node.Texture;
+	}
+
+	uint64_t RenderGraph::GetTransientMemorySize() const
+	{
+		uint64_t size = 0;
+		for (const auto& entry : m_Pool)
+			size += entry.Texture->GetMemorySize();
+		return size;
+	}
+
+	void RenderGraph::ReleaseTransientTextures()
+	{
+		for (auto& entry : m_Pool)
+			TextureRegistry::Release(entry.Texture->GetHandle());
+		m_Pool.clear();
+	}
+
+	MemoryBarrierFlag RenderGraph::GetBarrierForAccess(RenderGraphAccess access)
+	{
+		switch (access)
+		{
+			case RenderGraphAccess::Sampled:
+				return MemoryBarrierFlag::TextureFetch;
+			case RenderGraphAccess::ImageLoad:
+				return MemoryBarrierFlag::ShaderImageAccess;
+			case RenderGraphAccess::Readback:
+				return MemoryBarrierFlag::TextureUpdate;
+		}
+		return MemoryBarrierFlag::None;
+	}
+
+	void RenderGraph::AssignTransientStorage()
+	{
+		for (auto& entry : m_Pool)
+		{
+			entry.LastUse = -1;
+			entry.Used = false;
+		}
+
+		// Passes execute in declaration order, so visiting transients by first write is enough for a greedy
+		// interval packing: a linear chain settles on two ping-pong targets.
+		std::vector<RenderGraphResource> transients;
+		for (RenderGraphResource i = 0; i < m_Resources.size(); i++)
+		{
+			if (!m_Resources[i].Imported && m_Resources[i].FirstWrite >= 0)
+				transients.push_back(i);
+		}
+		std::stable_sort(transients.begin(), transients.end(), [this](RenderGraphResource a, RenderGraphResource b)
+			{ return m_Resources[a].FirstWrite < m_Resources[b].FirstWrite; });
+
+		for (RenderGraphResource index : transients)
+		{
+			auto&	resource = m_Resources[index];
+			int32_t lastUse = std::max(resource.FirstWrite, resource.LastRead);
+			resource.PoolIndex = AcquirePooledTexture(resource, resource.FirstWrite, lastUse);
+			resource.Texture = m_Pool[resource.PoolIndex].Texture;
+		}
+
+		// Anything the graph no longer needs is freed rather than kept warm.
+		for (int32_t i = (int32_t)m_Pool.size() - 1; i >= 0; i--)
+		{
+			if (m_Pool[i].Used)
+				continue;
+
+			TextureRegistry::Release(m_Pool[i].Texture->GetHandle());
+			m_Pool.erase(m_Pool.begin() + i);
+			for (auto& resource : m_Resources)
+			{
+				if (!resource.Imported && resource.PoolIndex != UINT32_MAX && resource.PoolIndex > (uint32_t)i)
+					resource.PoolIndex--;
+			}
+		}
+	}
+
+	uint32_t RenderGraph::AcquirePooledTexture(const ResourceNode& resource, int32_t firstUse, int32_t lastUse)
+	{
+		auto matches = [&resource](const PooledTexture& entry)
+		{
+			const auto& spec = entry.Texture->GetSpecification();
+			return spec.Width == resource.Desc.Width && spec.Height == resource.Desc.Height
+				&& spec.InternalFormat == resource.Desc.Format;
+		};
+
+		uint32_t chosen = UINT32_MAX;
+		for (uint32_t i = 0; i < m_Pool.size() && chosen == UINT32_MAX; i++)
+		{
+			if (m_Pool[i].LastUse < firstUse && matches(m_Pool[i]))
+				chosen = i;
+		}
+
+		// Prefer re-purposing a texture left over from a previous frame over allocating a new one.
+		for (uint32_t i = 0; i < m_Pool.size() && chosen == UINT32_MAX; i++)
+		{
+			if (!m_Pool[i].Used && m_Pool[i].Texture->GetSpecification().InternalFormat == resource.Desc.Format)
+			{
+				m_Pool[i].Texture->Resize(resource.Desc.Width, resource.Desc.Height);
+				chosen = i;
+			}
+		}
+
+		if (chosen == UINT32_MAX)
+		{
+			Texture2DSpecification spec = {
+				ImageUtils::WrapMode::ClampToEdge,
+				ImageUtils::WrapMode::ClampToEdge,
+				ImageUtils::FilterMode::Linear,
+				ImageUtils::FilterMode::Linear,
+				resource.Desc.Format,
+				ImageUtils::ImageDataLayout::RGBA,
+				ImageUtils::ImageDataType::Float,
+				resource.Desc.Width,
+				resource.Desc.Height
+			};
+			spec.Name = "Render Graph Target " + std::to_string(s_TransientTextureCounter++);
+			// Transients are only ever read at level 0.
+			spec.MipLevels = 1;
+
+			PooledTexture entry;
+			entry.Texture = CreateRef<Texture2D>(spec);
+			TextureRegistry::Register(entry.Texture);
+			m_Pool.push_back(entry);
+			chosen = (uint32_t)m_Pool.size() - 1;
+		}
+
+		m_Pool[chosen].LastUse = lastUse;
+		m_Pool[chosen].Used = true;
+		return chosen;
+	}
+
+	void RenderGraph::PlaceBarriers()
+	{
+		// Barriers are global, so per resource it is enough to remember which bits have been issued since its last
+		// image store.  A read only pays for a bit that has not been issued yet.
+		std::vector<bool>			   written(m_Resources.size(), false);
+		std::vector<MemoryBarrierFlag> issued(m_Resources.size(), MemoryBarrierFlag::None);
+
+		auto collect = [&](RenderGraphResource resource, RenderGraphAccess access)
+		{
+			MemoryBarrierFlag bit = GetBarrierForAccess(access);
+			if (written[resource] && (issued[resource] & bit) == MemoryBarrierFlag::None)
+				return bit;
+			return MemoryBarrierFlag::None;
+		};
+
+		auto issue = [&](MemoryBarrierFlag bits)
+		{
+			if (bits == MemoryBarrierFlag::None)
+				return;
+			for (uint32_t i = 0; i < m_Resources.size(); i++)
+			{
+				if (written[i])
+					issued[i] |= bits;
+			}
+		};
+
+		for (auto& pass : m_Passes)
+		{
+			pass.Barriers = MemoryBarrierFlag::None;
+			for (auto [resource, access] : pass.Reads)
+				pass.Barriers |= collect(resource, access);
+			issue(pass.Barriers);
+
+			for (RenderGraphResource resource : pass.Writes)
+			{
+				written[resource] = true;
+				issued[resource] = MemoryBarrierFlag::None;
+			}
+		}
+
+		m_OutputBarriers = MemoryBarrierFlag::None;
+		for (auto [resource, access] : m_Outputs)
+			m_OutputBarriers |= collect(resource, access);
+	}
+} // namespace askygg
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "askygg/core/Memory.h"
+#include "askygg/renderer/Texture.h"
+#include "askygg/renderer/RenderCommand.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace askygg
+{
+	using RenderGraphResource = uint32_t;
+	constexpr RenderGraphResource InvalidRenderGraphResource = UINT32_MAX;
+
+	// How a pass (or a consumer after the graph) reads a resource.  Selects the barrier bit that makes a previous
+	// image store visible to that read.
+	enum class RenderGraphAccess
+	{
+		Sampled,
+		ImageLoad,
+		Readback
+	};
+
+	struct RenderGraphTextureDesc
+	{
+		uint32_t						Width = 0;
+		uint32_t						Height = 0;
+		ImageUtils::ImageInternalFormat Format = ImageUtils::ImageInternalFormat::RGBA32F;
+
+		bool operator==(const RenderGraphTextureDesc& other) const
+		{
+			return Width == other.Width && Height == other.Height && Format == other.Format;
+		}
+	};
+
+	class RenderGraph;
+
+	class RenderGraphBuilder
+	{
+	public:
+		RenderGraphBuilder(RenderGraph& graph, uint32_t passIndex)
+			: m_Graph(graph), m_PassIndex(passIndex) {}
+
+		// Declares a transient texture written by this pass.  Storage is assigned at compile time and may alias other
+		// transients whose lifetimes do not overlap.
+		RenderGraphResource CreateTexture(const std::string& name, const RenderGraphTextureDesc& desc);
+		// Brings a texture owned outside the graph (e.g. a pass's persistent output) into it.
+		RenderGraphResource Import(const std::string& name, const Ref<Texture2D>& texture);
+		RenderGraphResource Read(RenderGraphResource resource, RenderGraphAccess access = RenderGraphAccess::Sampled);
+		RenderGraphResource Write(RenderGraphResource resource);
+
+	private:
+		RenderGraph& m_Graph;
+		uint32_t	 m_PassIndex;
+	};
+
+	// Linear compute graph rebuilt every frame.  Passes are executed in the order they were added; Compile() works out
+	// transient lifetimes, packs them onto a pool of physical textures and places the minimal glMemoryBarrier bits in
+	// front of the first read of each image store.  The pool persists across frames and is trimmed to what the last
+	// compiled graph needed.
+	class RenderGraph
+	{
+	public:
+		using ExecuteFn = std::function<void(const RenderGraph&)>;
+
+		RenderGraph() = default;
+		~RenderGraph();
+
+		void Reset();
+
+		RenderGraphResource ImportTexture(const std::string& name, uint32_t textureID);
+		RenderGraphResource ImportTexture(const std::string& name, const Ref<Texture2D>& texture);
+		RenderGraphBuilder	AddPass(const std::string& name, ExecuteFn execute);
+
+		// Declares a consumer that runs after the graph (display, readback) so the trailing barrier covers it.
+		void MarkOutput(RenderGraphResource resource, RenderGraphAccess access);
+
+		void Compile();
+		void Execute() const;
+		// Execute() one pass at a time, e.g. spread over several frames.  A pass may run more than once; its barriers
+		// are issued every time.  Nothing may Reset() or Compile() the graph until FinishExecution().
+		void ExecutePass(uint32_t passIndex) const;
+		void FinishExecution() const;
+
+		uint32_t			  GetTextureID(RenderGraphResource resource) const;
+		const Ref<Texture2D>& GetTexture(RenderGraphResource resource) const;
+
+		uint32_t GetPassCount() const { return (uint32_t)m_Passes.size(); }
+		uint32_t GetTransientTextureCount() const { return (uint32_t)m_Pool.size(); }
+		uint64_t GetTransientMemorySize() const;
+		void	 ReleaseTransientTextures();
+
+	private:
+		friend class RenderGraphBuilder;
+
+		struct ResourceNode
+		{
+			std::string			   Name;
+			RenderGraphTextureDesc Desc;
+			bool				   Imported = false;
+			uint32_t			   ImportedID = 0;
+			Ref<Texture2D>		   Texture;
+			int32_t				   FirstWrite = -1;
+			int32_t				   LastRead = -1;
+			uint32_t			   PoolIndex = UINT32_MAX;
+		};
+
+		struct PassNode
+		{
+			std::string												 Name;
+			ExecuteFn												 Execute;
+			std::vector<std::pair<RenderGraphResource, RenderGraphAccess>> Reads;
+			std::vector<RenderGraphResource>						 Writes;
+			MemoryBarrierFlag										 Barriers = MemoryBarrierFlag::None;
+		};
+
+		struct PooledTexture
+		{
+			Ref<Texture2D> Texture;
+			int32_t		   LastUse = -1;
+			bool		   Used = false;
+		};
+
+		static MemoryBarrierFlag GetBarrierForAccess(RenderGraphAccess access);
+
+		void		  AssignTransientStorage();
+		void		  PlaceBarriers();
+		uint32_t	  AcquirePooledTexture(const ResourceNode& resource, int32_t firstUse, int32_t lastUse);
+
+	private:
+		std::vector<ResourceNode>  m_Resources;
+		std::vector<PassNode>	   m_Passes;
+		std::vector<std::pair<RenderGraphResource, RenderGraphAccess>> m_Outputs;
+		MemoryBarrierFlag		   m_OutputBarriers = MemoryBarrierFlag::None;
+		std::vector<PooledTexture> m_Pool;
+	};
+} // namespace askygg
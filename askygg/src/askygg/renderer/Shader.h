@@ -102,6 +102,7 @@ namespace askygg
 
 		virtual int	  UploadUniformBool(const std::string& name, bool value) = 0;
 		virtual int	  UploadUniformInt(const std::string& name, int value) = 0;
+		virtual int	  UploadUniformInt2(const std::string& name, const glm::ivec2& value) = 0;
 		virtual int	  UploadUniformIntArray(const std::string& name, uint32_t count, int* basePtr) = 0;
 		virtual int	  UploadUniformMat3(const std::string& name, const glm::mat3& matrix) = 0;
 		virtual int	  UploadUniformMat4(const std::string& name, const glm::mat4& matrix) = 0;
@@ -112,6 +113,9 @@ namespace askygg
 		virtual void* GetUniformData(ShaderAttributeType type, GLint location) = 0;
 		virtual void  DispatchCompute(uint32_t groupX, uint32_t groupY, uint32_t groupZ) = 0;
 		virtual void  EnableShaderImageAccessBarrierBit() = 0;
+		// A separate program object with the same code.  Uniform values live on the program, so threads driving
+		// their own contexts each need their own copy.
+		virtual Ref<Shader> Clone() const = 0;
 
 	public:
 		uint32_t	GetID() const { return m_ID; }
@@ -5,6 +5,7 @@
 #include <stbi/stb_image_write.h>
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <algorithm>
 #include <filesystem>
 
 namespace askygg
@@ -38,7 +39,8 @@ namespace askygg
 		//                    specification.Width, specification.Height);
 		glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_Specification.Width, m_Specification.Height, 0,
 			dataFormat, dataType, nullptr);
-		glGenerateMipmap(GL_TEXTURE_2D);
+		if (mips > 1)
+			glGenerateMipmap(GL_TEXTURE_2D);
 	}
 
 	Texture2D::Texture2D(const Texture2DSpecification& specification, void* data)
@@ -80,37 +82,57 @@ namespace askygg
             m_Name = specification.Name;
         }
 
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_ID);
-		glBindTexture(GL_TEXTURE_2D, m_ID);
-
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, ConvertWrapMode(specification.WrapModeS));
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, ConvertWrapMode(specification.WrapModeT));
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-			ConvertMinMagFilterMode(specification.MinFilterMode));
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
-			ConvertMinMagFilterMode(specification.MagFilterMode));
-
-		stbi_set_flip_vertically_on_load(1);
-		int width, height, channels;
-
-		if (stbi_is_hdr(filePath.c_str()))
-		{
+		// Per-thread so textures can be decoded on worker contexts.
+		stbi_set_flip_vertically_on_load_thread(1);
+		int		   width, height, channels;
+		const bool hdr = stbi_is_hdr(filePath.c_str());
+		if (hdr)
 			m_ImageData.Data = (byte*)stbi_loadf(filePath.c_str(), &width, &height, &channels, 4);
-			m_Specification.InternalFormat = ImageUtils::ImageInternalFormat::RGBA32F;
-			m_Specification.PixelLayoutFormat = ImageUtils::ImageDataLayout::RGBA;
-			m_Specification.DataType = ImageUtils::ImageDataType::Float;
-		}
 		else
-		{
 			m_ImageData.Data = stbi_load(filePath.c_str(), &width, &height, &channels, 4);
-			m_Specification.InternalFormat = ImageUtils::ImageInternalFormat::RGBA8;
-			m_Specification.PixelLayoutFormat = ImageUtils::ImageDataLayout::RGBA;
-			m_Specification.DataType = ImageUtils::ImageDataType::UByte;
-		}
 		YGG_ASSERT(m_ImageData.Data, "Failed to load image from file: {}!", filePath);
+
+		UploadDecodedImage(hdr, width, height);
+	}
+
+	Texture2D::Texture2D(const std::string& name, const void* encoded, size_t size,
+		const Texture2DSpecification& specification)
+		: m_Specification(specification), m_Name(name)
+	{
+		const auto* bytes = static_cast<const stbi_uc*>(encoded);
+		const int	length = (int)size;
+
+		stbi_set_flip_vertically_on_load_thread(1);
+		int		   width, height, channels;
+		const bool hdr = stbi_is_hdr_from_memory(bytes, length);
+		if (hdr)
+			m_ImageData.Data = (byte*)stbi_loadf_from_memory(bytes, length, &width, &height, &channels, 4);
+		else
+			m_ImageData.Data = stbi_load_from_memory(bytes, length, &width, &height, &channels, 4);
+		YGG_ASSERT(m_ImageData.Data, "Failed to decode image '{}' from memory!", name);
+
+		UploadDecodedImage(hdr, width, height);
+	}
+
+	void Texture2D::UploadDecodedImage(bool hdr, int width, int height)
+	{
+		m_Specification.InternalFormat = hdr ? ImageUtils::ImageInternalFormat::RGBA32F
+											 : ImageUtils::ImageInternalFormat::RGBA8;
+		m_Specification.PixelLayoutFormat = ImageUtils::ImageDataLayout::RGBA;
+		m_Specification.DataType = hdr ? ImageUtils::ImageDataType::Float : ImageUtils::ImageDataType::UByte;
 		m_Specification.Width = width;
 		m_Specification.Height = height;
 
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_ID);
+		glBindTexture(GL_TEXTURE_2D, m_ID);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, ConvertWrapMode(m_Specification.WrapModeS));
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, ConvertWrapMode(m_Specification.WrapModeT));
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+			ConvertMinMagFilterMode(m_Specification.MinFilterMode));
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER,
+			ConvertMinMagFilterMode(m_Specification.MagFilterMode));
+
 		GLenum internalFormat = ConvertInternalFormatMode(m_Specification.InternalFormat);
 		GLenum dataFormat = ConvertDataLayoutMode(m_Specification.PixelLayoutFormat);
 		GLenum dataType = ConvertImageDataType(m_Specification.DataType);
@@ -140,6 +162,7 @@ namespace askygg
 
 	void Texture2D::Invalidate()
 	{
+		const uint32_t previousID = m_ID;
 		if (m_ID != UINT32_MAX)
 		{
 			glDeleteTextures(1, &m_ID);
@@ -166,6 +189,10 @@ namespace askygg
 		uint32_t mips = GetMipLevelCount();
 		glTextureStorage2D(m_ID, mips, ConvertInternalFormatMode(m_Specification.InternalFormat),
 			m_Specification.Width, m_Specification.Height);
+
+		// The GL name changes on every re-creation; keep the registry's ID index pointing at this texture.
+		if (m_Handle)
+			TextureRegistry::OnTextureInvalidated(*this, previousID);
 	}
 
 	void Texture2D::ClearImage() const
@@ -197,9 +224,35 @@ namespace askygg
 
 	uint32_t Texture2D::GetMipLevelCount() const
 	{
+		if (m_Specification.MipLevels != 0)
+			return m_Specification.MipLevels;
 		return ImageUtils::CalculateMipLevelCount(m_Specification.Width, m_Specification.Height);
 	}
 
+	uint64_t Texture2D::GetMemorySize() const
+	{
+		uint64_t bytesPerPixel = ImageUtils::GetBytesPerPixel(m_Specification.InternalFormat);
+		uint64_t size = 0;
+		for (uint32_t mip = 0; mip < GetMipLevelCount(); mip++)
+		{
+			auto [width, height] = GetMipSize(mip);
+			size += (uint64_t)width * height * bytesPerPixel;
+		}
+		return size;
+	}
+
+	bool Texture2D::IsLoadable(const std::string& filePath)
+	{
+		int width, height, channels;
+		return stbi_info(filePath.c_str(), &width, &height, &channels) != 0;
+	}
+
+	bool Texture2D::IsLoadable(const void* encoded, size_t size)
+	{
+		int width, height, channels;
+		return stbi_info_from_memory(static_cast<const stbi_uc*>(encoded), (int)size, &width, &height, &channels) != 0;
+	}
+
 	void Texture2D::SaveToFile(uint32_t TextureID, const std::string& FilePath)
 	{
 		Texture2D& WriteTexture = TextureLibrary::Get2DFromID(TextureID);
@@ -226,6 +279,17 @@ namespace askygg
 		glBindTexture(GL_TEXTURE_2D, 0);
 	}
 
+	void Texture2D::CopyFrom(uint32_t sourceID, uint32_t sourceMip) const
+	{
+		for (uint32_t mip = 0; mip < GetMipLevelCount(); mip++)
+		{
+			auto [width, height] = GetMipSize(mip);
+			glCopyImageSubData(sourceID, GL_TEXTURE_2D, (GLint)(sourceMip + mip), 0, 0, 0, m_ID, GL_TEXTURE_2D, (GLint)mip,
+				0, 0, 0,
+				(GLsizei)std::max(width, 1u), (GLsizei)std::max(height, 1u), 1);
+		}
+	}
+
 	void Texture2D::BindToImageSlot(uint32_t unit, uint32_t level,
 		ImageUtils::TextureAccessLevel		access,
 		ImageUtils::TextureShaderDataFormat shaderDataFormat)
@@ -247,12 +311,14 @@ namespace askygg
 
 	void Texture2D::SetData(void* data, uint32_t size) const
 	{
-		uint32_t bytesPerPixel =
-			m_Specification.PixelLayoutFormat == ImageUtils::ImageDataLayout::RGBA ? 4 : 3;
+		uint32_t bytesPerPixel = (m_Specification.PixelLayoutFormat == ImageUtils::ImageDataLayout::RGBA ? 4 : 3)
+			* ImageUtils::GetDataTypeSize(m_Specification.DataType);
 		YGG_ASSERT(size == bytesPerPixel * m_Specification.Width * m_Specification.Height,
 			"Data size must match entire texture.");
 		GLenum pixelLayout = ConvertDataLayoutMode(m_Specification.PixelLayoutFormat);
 		GLenum type = ConvertImageDataType(m_Specification.DataType);
+		// Rows are tightly packed; RGB rows are not 4-byte aligned for odd widths.
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 		glTextureSubImage2D(m_ID, 0, 0, 0, m_Specification.Width, m_Specification.Height, pixelLayout,
 			type, data);
 	}
@@ -318,14 +384,27 @@ namespace askygg
 			ImageUtils::ConvertShaderFormatType(shaderDataFormat));
 	}
 
-	void Texture2D::Save(const std::string& filePath, bool flipVertically) const
+	std::vector<unsigned char> Texture2D::ReadPixels(bool flipVertically) const
 	{
 		std::vector<unsigned char> buffer(m_Specification.Width * m_Specification.Height * 4);
 
 		glBindTexture(GL_TEXTURE_2D, m_ID);
 		glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, buffer.data());
 
-		stbi_flip_vertically_on_write(flipVertically);
+		// Flipped here rather than through stbi_flip_vertically_on_write, which is process-wide state.
+		if (flipVertically)
+		{
+			const size_t rowSize = m_Specification.Width * 4;
+			for (uint32_t top = 0, bottom = m_Specification.Height - 1; top < bottom; top++, bottom--)
+				std::swap_ranges(buffer.begin() + top * rowSize, buffer.begin() + (top + 1) * rowSize,
+					buffer.begin() + bottom * rowSize);
+		}
+		return buffer;
+	}
+
+	void Texture2D::Save(const std::string& filePath, bool flipVertically) const
+	{
+		std::vector<unsigned char> buffer = ReadPixels(flipVertically);
 		int result = stbi_write_jpg(filePath.c_str(), m_Specification.Width, m_Specification.Height, 4,
 			buffer.data(), 0);
 
@@ -339,6 +418,23 @@ namespace askygg
 		}
 	}
 
+	bool Texture2D::EncodeJPEG(std::vector<uint8_t>& encoded, bool flipVertically) const
+	{
+		std::vector<unsigned char> buffer = ReadPixels(flipVertically);
+		return EncodeJPEG(buffer.data(), m_Specification.Width, m_Specification.Height, encoded);
+	}
+
+	bool Texture2D::EncodeJPEG(const void* pixels, uint32_t width, uint32_t height, std::vector<uint8_t>& encoded)
+	{
+		encoded.clear();
+		auto append = [](void* context, void* data, int size)
+		{
+			auto* output = static_cast<std::vector<uint8_t>*>(context);
+			output->insert(output->end(), static_cast<uint8_t*>(data), static_cast<uint8_t*>(data) + size);
+		};
+		return stbi_write_jpg_to_func(append, &encoded, (int)width, (int)height, 4, pixels, 0) != 0;
+	}
+
 	Texture2DArray::Texture2DArray(const Texture2DArraySpecification& Specification)
 		: m_Specification(Specification), m_Name((Specification.Name))
 	{
@@ -780,14 +876,105 @@ namespace askygg
 		return ImageUtils::CalculateMipLevelCount(m_Specification.Width, m_Specification.Height);
 	}
 
+	TextureHandle TextureRegistry::Register(const Ref<Texture2D>& texture)
+	{
+		std::lock_guard<std::recursive_mutex> lock(s_Mutex);
+		YGG_ASSERT(texture, "TextureRegistry: cannot register a null texture.");
+		if (texture->m_Handle)
+			return texture->m_Handle;
+
+		uint32_t index;
+		if (!s_FreeIndices.empty())
+		{
+			index = s_FreeIndices.back();
+			s_FreeIndices.pop_back();
+		}
+		else
+		{
+			YGG_ASSERT(s_Records.size() < TextureHandle::IndexMask,
+				"TextureRegistry: exceeded {} live textures.", TextureHandle::IndexMask);
+			index = static_cast<uint32_t>(s_Records.size());
+			s_Records.emplace_back();
+		}
+
+		TextureRecord& record = s_Records[index];
+		record.Texture = texture;
+
+		const TextureHandle handle(index, record.Generation);
+		texture->m_Handle = handle;
+		s_NameIndex[texture->GetName()] = handle;
+		s_IDIndex[texture->GetID()] = handle;
+		return handle;
+	}
+
+	void TextureRegistry::Release(TextureHandle handle)
+	{
+		std::lock_guard<std::recursive_mutex> lock(s_Mutex);
+		if (!IsValid(handle))
+			return;
+
+		TextureRecord& record = s_Records[handle.GetIndex()];
+		auto		   nameIt = s_NameIndex.find(record.Texture->GetName());
+		if (nameIt != s_NameIndex.end() && nameIt->second == handle)
+			s_NameIndex.erase(nameIt);
+		auto idIt = s_IDIndex.find(record.Texture->GetID());
+		if (idIt != s_IDIndex.end() && idIt->second == handle)
+			s_IDIndex.erase(idIt);
+
+		record.Texture->m_Handle = TextureHandle();
+		record.Texture = nullptr;
+		// Generation 0 is reserved for the null handle.
+		record.Generation = (record.Generation + 1) & TextureHandle::GenerationMask;
+		if (record.Generation == 0)
+			record.Generation = 1;
+		s_FreeIndices.push_back(handle.GetIndex());
+	}
+
+	void TextureRegistry::Clear()
+	{
+		std::lock_guard<std::recursive_mutex> lock(s_Mutex);
+		for (TextureRecord& record : s_Records)
+		{
+			if (record.Texture)
+				record.Texture->m_Handle = TextureHandle();
+		}
+		s_Records.clear();
+		s_FreeIndices.clear();
+		s_NameIndex.clear();
+		s_IDIndex.clear();
+	}
+
+	TextureHandle TextureRegistry::FindByName(const std::string& name)
+	{
+		std::lock_guard<std::recursive_mutex> lock(s_Mutex);
+		auto it = s_NameIndex.find(name);
+		return it != s_NameIndex.end() ? it->second : TextureHandle();
+	}
+
+	TextureHandle TextureRegistry::FindByID(uint32_t id)
+	{
+		std::lock_guard<std::recursive_mutex> lock(s_Mutex);
+		auto it = s_IDIndex.find(id);
+		return it != s_IDIndex.end() ? it->second : TextureHandle();
+	}
+
+	void TextureRegistry::OnTextureInvalidated(const Texture2D& texture, uint32_t previousID)
+	{
+		std::lock_guard<std::recursive_mutex> lock(s_Mutex);
+		auto it = s_IDIndex.find(previousID);
+		if (it != s_IDIndex.end() && it->second == texture.m_Handle)
+			s_IDIndex.erase(it);
+		s_IDIndex[texture.GetID()] = texture.m_Handle;
+	}
+
 	bool TextureLibrary::Has2DFromID(uint32_t id)
 	{
-		return s_IdToNameLibrary.find(id) != s_IdToNameLibrary.end();
+		return static_cast<bool>(TextureRegistry::FindByID(id));
 	}
 
 	bool TextureLibrary::Has2D(const std::string& Name)
 	{
-		return s_NameToTexture2DLibrary.find(Name) != s_NameToTexture2DLibrary.end();
+		return static_cast<bool>(TextureRegistry::FindByName(Name));
 	}
 
 	void TextureLibrary::AddTexture2D(const Ref<Texture2D>& texture)
@@ -799,9 +986,7 @@ namespace askygg
 			return;
 		}
 
-		s_NameToTexture2DLibrary[texture->GetName()] = texture;
-		s_IdToNameLibrary[texture->GetID()] = texture->GetName();
-		s_NameToIDLibrary[texture->GetName()] = texture->GetID();
+		TextureRegistry::Register(texture);
 		YGG_LOG_TRACE("Added Texture2D with name: '{}' to the Texture Library.", texture->GetName());
 	}
 
@@ -868,12 +1053,9 @@ namespace askygg
 
 	Texture2D& TextureLibrary::Get2DFromID(uint32_t ID)
 	{
-		YGG_ASSERT(s_IdToNameLibrary.find(ID) != s_IdToNameLibrary.end(),
-			"Unable to find Texture2D with ID: {}", ID);
-		const auto TextureName = s_IdToNameLibrary[ID];
-		YGG_ASSERT(s_NameToTexture2DLibrary.find(TextureName) != s_NameToTexture2DLibrary.end(),
-			"Unable to find Texture2D with Name: {}", TextureName);
-		return *s_NameToTexture2DLibrary[TextureName];
+		const TextureHandle handle = TextureRegistry::FindByID(ID);
+		YGG_ASSERT(handle, "Unable to find Texture2D with ID: {}", ID);
+		return TextureRegistry::Get(handle);
 	}
 
 	Ref<TextureCube> TextureLibrary::GetCubeFromID(uint32_t ID)
@@ -881,7 +1063,7 @@ namespace askygg
 		YGG_ASSERT(s_IdToNameLibrary.find(ID) != s_IdToNameLibrary.end(),
 			"Unable to find TextureCube with ID: {}", ID);
 		const auto TextureName = s_IdToNameLibrary[ID];
-		YGG_ASSERT(s_NameToTexture2DLibrary.find(TextureName) != s_NameToTexture2DLibrary.end(),
+		YGG_ASSERT(s_NameToTextureCubeLibrary.find(TextureName) != s_NameToTextureCubeLibrary.end(),
 			"Unable to find TextureCube with Name: {}", TextureName);
 		return s_NameToTextureCubeLibrary[TextureName];
 	}
@@ -964,7 +1146,7 @@ namespace askygg
 	Ref<Texture2D> TextureLibrary::LoadTexture2D(const Texture2DSpecification& Spec, void* Data)
 	{
 		if (Has2D(Spec.Name))
-			return s_NameToTexture2DLibrary[Spec.Name];
+			return TextureRegistry::GetRef(TextureRegistry::FindByName(Spec.Name));
 
 		Texture2DSpecification defaultFromFileSpec = {
 			ImageUtils::WrapMode::Repeat,
@@ -982,10 +1164,10 @@ namespace askygg
 		return texture;
 	}
 
-	const Ref<Texture2D>& TextureLibrary::Get2D(const std::string& name)
+	Ref<Texture2D> TextureLibrary::Get2D(const std::string& name)
 	{
 		YGG_ASSERT(Has2D(name), "No Texture2D with name '{}' found in Texture Library.", name)
-		return s_NameToTexture2DLibrary.at(name);
+		return TextureRegistry::GetRef(TextureRegistry::FindByName(name));
 	}
 
 	const Ref<TextureCube>& TextureLibrary::GetCube(const std::string& name)
@@ -1010,7 +1192,7 @@ namespace askygg
 		return HasCube(name) ? GetCube(name) : GetCube("Black TextureCube");
 	}
 
-	const Ref<Texture2D>& TextureLibrary::TryGet2D(const std::string& name,
+	Ref<Texture2D> TextureLibrary::TryGet2D(const std::string& name,
 		bool														  FallBackIsWhiteTexture)
 	{
 		return Has2D(name)			 ? Get2D(name)
@@ -1025,8 +1207,8 @@ namespace askygg
 			"TextureLibrary: Unable to bind Texture2D with name '{}' to slot '{}'.  This texture "
 			"has not been registered.",
 			TwoDimensionTextureName, Slot);
-		const auto& Texture2D = s_NameToTexture2DLibrary[TwoDimensionTextureName];
-		glBindTextureUnit(Slot, Texture2D->GetID());
+		const auto& Texture2D = TextureRegistry::Get(TextureRegistry::FindByName(TwoDimensionTextureName));
+		glBindTextureUnit(Slot, Texture2D.GetID());
 	}
 
 	void TextureLibrary::BindTextureCubeToSlot(const std::string& CubeTextureName, uint32_t Slot)
@@ -1046,6 +1228,8 @@ namespace askygg
 
 	std::string TextureLibrary::GetNameFromID(uint32_t TextureID)
 	{
+		if (const TextureHandle handle = TextureRegistry::FindByID(TextureID))
+			return TextureRegistry::Get(handle).GetName();
 		YGG_ASSERT(s_IdToNameLibrary.find(TextureID) != s_IdToNameLibrary.end(),
 			"TextureLibrary: Unable to find texture with ID '{}'.", TextureID);
 		return s_IdToNameLibrary[TextureID];
@@ -1053,6 +1237,8 @@ namespace askygg
 
 	uint32_t TextureLibrary::GetIDFromName(const std::string& Name)
 	{
+		if (const TextureHandle handle = TextureRegistry::FindByName(Name))
+			return TextureRegistry::GetID(handle);
 		YGG_ASSERT(s_NameToIDLibrary.find(Name) != s_NameToIDLibrary.end(),
 			"TextureLibrary: Unable to find texture with name '{}'.", Name);
 		return s_NameToIDLibrary[Name];
@@ -1138,9 +1324,14 @@ namespace askygg
 		AddTexture2DArray(WhiteTexture2DArray);
 	}
 
-	std::unordered_map<std::string, Ref<Texture2D>>		 TextureLibrary::s_NameToTexture2DLibrary;
 	std::unordered_map<std::string, Ref<TextureCube>>	 TextureLibrary::s_NameToTextureCubeLibrary;
 	std::unordered_map<std::string, Ref<Texture2DArray>> TextureLibrary::s_NameToTexture2DArrayLibrary;
 	std::unordered_map<uint32_t, std::string>			 TextureLibrary::s_IdToNameLibrary;
 	std::unordered_map<std::string, uint32_t>			 TextureLibrary::s_NameToIDLibrary;
+
+	std::deque<TextureRegistry::TextureRecord>		  TextureRegistry::s_Records;
+	std::vector<uint32_t>							  TextureRegistry::s_FreeIndices;
+	std::unordered_map<std::string, TextureHandle> TextureRegistry::s_NameIndex;
+	std::unordered_map<uint32_t, TextureHandle>	  TextureRegistry::s_IDIndex;
+	std::recursive_mutex							  TextureRegistry::s_Mutex;
 } // namespace askygg
@@ -4,6 +4,11 @@
 #include "askygg/core/Memory.h"
 #include "askygg/renderer/TextureUtils.h"
 
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 namespace askygg
 {
 	struct TextureCubeSpecification
@@ -31,6 +36,8 @@ namespace askygg
 		ImageUtils::ImageDataType		DataType;
 		uint32_t						Width, Height;
 		std::string						Name = "Texture2D";
+		// 0 allocates the full mip chain.
+		uint32_t						MipLevels = 0;
 	};
 
 	struct Texture2DArraySpecification
@@ -60,12 +67,39 @@ namespace askygg
 		std::string						Name = "Texture3D";
 	};
 
+	// Stable 32-bit reference to a Texture2D held by the TextureRegistry. The low 16 bits index the registry's dense
+	// record array and the high 16 bits carry the generation of that slot when the handle was issued, so a handle to a
+	// released texture is rejected instead of aliasing whatever reuses the slot. Unlike the GL name, a handle survives
+	// Texture2D::Resize (which re-creates the underlying GL texture).
+	struct TextureHandle
+	{
+		static constexpr uint32_t IndexBits = 16;
+		static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+		static constexpr uint32_t GenerationMask = (1u << (32 - IndexBits)) - 1;
+
+		uint32_t Value = 0;
+
+		TextureHandle() = default;
+		TextureHandle(uint32_t index, uint32_t generation)
+			: Value((generation << IndexBits) | (index & IndexMask)) {}
+
+		uint32_t GetIndex() const { return Value & IndexMask; }
+		uint32_t GetGeneration() const { return Value >> IndexBits; }
+		bool	 IsNull() const { return Value == 0; }
+		explicit operator bool() const { return Value != 0; }
+
+		bool operator==(const TextureHandle& other) const { return Value == other.Value; }
+		bool operator!=(const TextureHandle& other) const { return Value != other.Value; }
+	};
+
 	class Texture2D
 	{
 	public:
 		Texture2D(const Texture2DSpecification& specification);
 		Texture2D(const Texture2DSpecification& specification, void* data);
 		Texture2D(const std::string& filePath, const Texture2DSpecification& specification);
+		// Decodes an encoded image (anything the file constructor reads) that is already in memory.
+		Texture2D(const std::string& name, const void* encoded, size_t size, const Texture2DSpecification& specification);
 		~Texture2D();
 
 		void Invalidate();
@@ -73,17 +107,28 @@ namespace askygg
 		void Resize(uint32_t width, uint32_t height);
 
 		uint32_t					  GetID() const { return m_ID; }
+		TextureHandle				  GetHandle() const { return m_Handle; }
 		const Texture2DSpecification& GetSpecification() const { return m_Specification; }
 
 		std::pair<uint32_t, uint32_t> GetMipSize(uint32_t mip) const;
 		uint32_t					  GetMipLevelCount() const;
+		uint64_t					  GetMemorySize() const;
 		uint32_t					  GetWidth() const { return m_Specification.Width; }
 		uint32_t					  GetHeight() const { return m_Specification.Height; }
 		std::string					  GetName() const { return m_Name; }
 		std::string					  GetFilePath() const { return m_FilePath; }
 		Buffer						  GetData() const { return m_ImageData; }
 		void						  Save(const std::string& filePath, bool flipVertically = false) const;
+		// The JPEG Save() would write, into memory.  False if encoding failed.
+		bool						  EncodeJPEG(std::vector<uint8_t>& encoded, bool flipVertically = false) const;
+		// Encodes tightly packed RGBA8 pixels, top row first, like EncodeJPEG().  Needs no context, so it can run on
+		// any thread.
+		static bool					  EncodeJPEG(const void* pixels, uint32_t width, uint32_t height,
+										  std::vector<uint8_t>& encoded);
 		static void					  SaveToFile(uint32_t TextureID, const std::string& FilePath);
+		// True if filePath holds an image the file constructor can decode.  Only reads the header.
+		static bool					  IsLoadable(const std::string& filePath);
+		static bool					  IsLoadable(const void* encoded, size_t size);
 
 		static void SaveFramebufferAttachment(const std::string& filePath, uint32_t id,
 			uint32_t bytesPerPixel, uint32_t width, uint32_t height);
@@ -101,11 +146,21 @@ namespace askygg
 		static void ClearBinding();
 
 		void SetData(void* data, uint32_t size) const;
+		// Copies every level of a texture with the same format into this one, without a round trip through the CPU.
+		// The source's level sourceMip must have this texture's size; its later levels fill this one's smaller ones.
+		void CopyFrom(uint32_t sourceID, uint32_t sourceMip = 0) const;
+
+	private:
+		void					   UploadDecodedImage(bool hdr, int width, int height);
+		std::vector<unsigned char> ReadPixels(bool flipVertically) const;
 
 	private:
+		friend class TextureRegistry;
+
 		Buffer				   m_ImageData;
 		Texture2DSpecification m_Specification;
 		uint32_t			   m_ID{ UINT32_MAX };
+		TextureHandle		   m_Handle{};
 		std::string			   m_FilePath;
 		std::string			   m_Name;
 	};
@@ -229,6 +284,70 @@ namespace askygg
 		std::string				 m_Name;
 	};
 
+	// Dense, handle-indexed storage for every registered Texture2D. Get() is an index plus a generation compare with no
+	// hashing, and is what per-frame code should use. The name and GL-name indices exist for the editor, debugging and
+	// the legacy ID-based TextureLibrary API.  All entry points are serialized so pipelines on worker contexts can
+	// register and release targets concurrently.  Records live in a deque, which never moves them as it grows, and
+	// nothing hands out a reference into one: a Register() on another thread cannot leave a caller dangling.
+	class TextureRegistry
+	{
+	public:
+		struct TextureRecord
+		{
+			Ref<Texture2D> Texture;
+			uint32_t	   Generation = 1;
+		};
+
+		static TextureHandle Register(const Ref<Texture2D>& texture);
+		static void			 Release(TextureHandle handle);
+		static void			 Clear();
+
+		static bool IsValid(TextureHandle handle)
+		{
+			std::lock_guard<std::recursive_mutex> lock(s_Mutex);
+			const uint32_t index = handle.GetIndex();
+			return !handle.IsNull() && index < s_Records.size() && s_Records[index].Texture
+				&& s_Records[index].Generation == handle.GetGeneration();
+		}
+
+		static Texture2D& Get(TextureHandle handle)
+		{
+			std::lock_guard<std::recursive_mutex> lock(s_Mutex);
+			YGG_ASSERT(IsValid(handle), "TextureRegistry: stale or invalid texture handle '{}'.", handle.Value);
+			return *s_Records[handle.GetIndex()].Texture;
+		}
+
+		static Ref<Texture2D> GetRef(TextureHandle handle)
+		{
+			std::lock_guard<std::recursive_mutex> lock(s_Mutex);
+			YGG_ASSERT(IsValid(handle), "TextureRegistry: stale or invalid texture handle '{}'.", handle.Value);
+			return s_Records[handle.GetIndex()].Texture;
+		}
+
+		static uint32_t GetID(TextureHandle handle) { return Get(handle).GetID(); }
+
+		static TextureHandle FindByName(const std::string& name);
+		static TextureHandle FindByID(uint32_t id);
+
+		// A snapshot, so iterating it needs no lock.
+		static std::vector<TextureRecord> GetRecords()
+		{
+			std::lock_guard<std::recursive_mutex> lock(s_Mutex);
+			return { s_Records.begin(), s_Records.end() };
+		}
+
+	private:
+		friend class Texture2D;
+		static void OnTextureInvalidated(const Texture2D& texture, uint32_t previousID);
+
+	private:
+		static std::deque<TextureRecord>					  s_Records;
+		static std::vector<uint32_t>						  s_FreeIndices;
+		static std::unordered_map<std::string, TextureHandle> s_NameIndex;
+		static std::unordered_map<uint32_t, TextureHandle>	  s_IDIndex;
+		static std::recursive_mutex							  s_Mutex;
+	};
+
 	class TextureLibrary
 	{
 	public:
@@ -241,8 +360,8 @@ namespace askygg
 				   const std::string&											 filePath = "");
 		static Ref<Texture2D>		 LoadTexture2D(const Texture2DSpecification& Spec, void* Data);
 		static void					 AddTexture2D(const Ref<Texture2D>& texture);
-		static const Ref<Texture2D>& Get2D(const std::string& name);
-		static const Ref<Texture2D>& TryGet2D(const std::string& name,
+		static Ref<Texture2D>		 Get2D(const std::string& name);
+		static Ref<Texture2D>		 TryGet2D(const std::string& name,
 			bool												 FallBackIsWhiteTexture = true);
 		static void					 BindTexture2DToSlot(const std::string& TwoDimensionTextureName, uint32_t Slot);
 		static bool					 Has2D(const std::string& Name);
@@ -265,15 +384,11 @@ namespace askygg
 		static Ref<Texture2DArray>		  LoadTexture2DArray(const Texture2DArraySpecification& Spec);
 		static void						  AddTexture2DArray(const Ref<Texture2DArray>& texture);
 
-		static std::unordered_map<std::string, Ref<Texture2D>> Get2DLibrary()
-		{
-			return s_NameToTexture2DLibrary;
-		}
-		static std::unordered_map<std::string, Ref<TextureCube>> GetCubeLibrary()
+		static const std::unordered_map<std::string, Ref<TextureCube>>& GetCubeLibrary()
 		{
 			return s_NameToTextureCubeLibrary;
 		}
-		static std::unordered_map<std::string, Ref<Texture2DArray>> Get2DArrayLibrary()
+		static const std::unordered_map<std::string, Ref<Texture2DArray>>& Get2DArrayLibrary()
 		{
 			return s_NameToTexture2DArrayLibrary;
 		}
@@ -288,7 +403,6 @@ namespace askygg
 		static void LoadWhiteTextureArray();
 
 	private:
-		static std::unordered_map<std::string, Ref<Texture2D>>		s_NameToTexture2DLibrary;
 		static std::unordered_map<std::string, Ref<TextureCube>>	s_NameToTextureCubeLibrary;
 		static std::unordered_map<std::string, Ref<Texture2DArray>> s_NameToTexture2DArrayLibrary;
 		static std::unordered_map<uint32_t, std::string>			s_IdToNameLibrary;
@@ -10,6 +10,59 @@ namespace askygg::ImageUtils
 		return (uint32_t)std::floor(std::log2(glm::min(width, height))) + 1;
 	}
 
+	// Unsized formats (and FromImage) report 0 - the driver picks the storage.
+	uint32_t GetBytesPerPixel(ImageInternalFormat internalFormat)
+	{
+		switch (internalFormat)
+		{
+			case ImageInternalFormat::R8:
+				return 1;
+			case ImageInternalFormat::R16:
+			case ImageInternalFormat::RG8:
+			case ImageInternalFormat::R16F:
+				return 2;
+			case ImageInternalFormat::RGB8:
+				return 3;
+			case ImageInternalFormat::RG16:
+			case ImageInternalFormat::RGBA8:
+			case ImageInternalFormat::RG16F:
+			case ImageInternalFormat::R32F:
+				return 4;
+			case ImageInternalFormat::RGB16F:
+				return 6;
+			case ImageInternalFormat::RGBA16:
+			case ImageInternalFormat::RGBA16F:
+			case ImageInternalFormat::RG32F:
+				return 8;
+			case ImageInternalFormat::RGB32F:
+				return 12;
+			case ImageInternalFormat::RGBA32F:
+				return 16;
+			default:
+				return 0;
+		}
+	}
+
+	uint32_t GetDataTypeSize(ImageDataType dataType)
+	{
+		switch (dataType)
+		{
+			case ImageDataType::UByte:
+			case ImageDataType::Byte:
+				return 1;
+			case ImageDataType::UShort:
+			case ImageDataType::Short:
+			case ImageDataType::HalfFloat:
+				return 2;
+			case ImageDataType::UInt:
+			case ImageDataType::Int:
+			case ImageDataType::Float:
+				return 4;
+			default:
+				return 0;
+		}
+	}
+
 	GLenum ConvertWrapMode(WrapMode wrapMode)
 	{
 		switch (wrapMode)
@@ -216,6 +269,8 @@ namespace askygg::ImageUtils
 				return GL_R16F;
 			case TextureShaderDataFormat::RGBA8:
 				return GL_RGBA8;
+			case TextureShaderDataFormat::RGBA16:
+				return GL_RGBA16;
 			case TextureShaderDataFormat::RGBA:
 				return GL_RGBA;
 		}
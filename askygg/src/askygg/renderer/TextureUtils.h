@@ -107,10 +107,14 @@ namespace askygg::ImageUtils
 		R32F,
 		R16F,
 		RGBA8,
+		RGBA16,
 		RGBA
 	};
 
 	uint32_t CalculateMipLevelCount(uint32_t width, uint32_t height);
+	uint32_t GetBytesPerPixel(ImageInternalFormat internalFormat);
+	// Size of one channel of client-side pixel data.
+	uint32_t GetDataTypeSize(ImageDataType dataType);
 
 	GLenum ConvertWrapMode(WrapMode wrapMode);
 	GLenum ConvertMinMagFilterMode(FilterMode filterMode);
@@ -12,6 +12,18 @@
 namespace askygg::UI
 {
 	uint32_t UIProperty::s_UIDCounter = 0;
+	int		 UIProperty::s_ActiveFrame = -1;
+
+	void UIProperty::TrackActiveItem()
+	{
+		if (ImGui::IsItemActive())
+			s_ActiveFrame = ImGui::GetFrameCount();
+	}
+
+	bool UIProperty::IsAnyActive()
+	{
+		return s_ActiveFrame == ImGui::GetFrameCount();
+	}
 
 	UIPropertyType UIPropertyTypeFromShaderDataType(ShaderAttributeType ShaderDataType, bool isColor)
 	{
@@ -95,6 +107,7 @@ namespace askygg::UI
 				ImGui::InputFloat("", m_Value, m_FloatParameters.SpeedStep, m_FloatParameters.FastStep,
 					m_FloatParameters.Format);
 			ImGui::PopItemWidth();
+			TrackActiveItem();
 			DrawFloatParametersPopup(m_UUID, m_FloatParameters);
 			ImGui::EndTable();
 		}
@@ -124,6 +137,7 @@ namespace askygg::UI
 			ImGui::TableSetColumnIndex(1);
 			ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
 			ImGui::DragFloat("", value, 0.01f, 0.0f, 0.0f, "%.3f");
+			TrackActiveItem();
 			ImGui::PopItemWidth();
 			ImGui::EndTable();
 		}
@@ -152,6 +166,7 @@ namespace askygg::UI
 			ImGui::TableSetColumnIndex(1);
 			ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
 			updated |= ImGui::SliderFloat("", value, min, max, "%.3f", ImGuiSliderFlags_AlwaysClamp);
+			TrackActiveItem();
 			ImGui::PopItemWidth();
 			ImGui::EndTable();
 		}
@@ -182,6 +197,7 @@ namespace askygg::UI
 			ImGui::TableSetColumnIndex(1);
 			ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
 			updated |= ImGui::SliderAngle("", radians, min, max, "%.3f", ImGuiSliderFlags_AlwaysClamp);
+			TrackActiveItem();
 			ImGui::PopItemWidth();
 			ImGui::EndTable();
 		}
@@ -195,6 +211,7 @@ namespace askygg::UI
 	void UIInt::DrawDragInt(const std::string& label, int* value, float speed, int min, int max)
 	{
 		ImGui::DragInt(label.c_str(), value, speed, min, max);
+		TrackActiveItem();
 	}
 
     void UIVector2::Draw()
@@ -212,6 +229,7 @@ namespace askygg::UI
 
 			ImGui::DragFloat2(ssDragFloat.str().c_str(), &m_Value->x, m_FloatParameters.SpeedStep,
 				m_FloatParameters.Min, m_FloatParameters.Max, m_FloatParameters.Format);
+			TrackActiveItem();
 			DrawFloatParametersPopup(m_UUID, m_FloatParameters);
 		}
 		else
@@ -220,6 +238,7 @@ namespace askygg::UI
 			ssInputFloat << m_Label.c_str() << "##Input" << m_UUID;
 
 			ImGui::InputFloat2(ssInputFloat.str().c_str(), &m_Value->x, m_FloatParameters.Format);
+			TrackActiveItem();
 			DrawFloatParametersPopup(m_UUID, m_FloatParameters);
 		}
 
@@ -247,6 +266,7 @@ namespace askygg::UI
 
 			ImGui::DragFloat3(ssDragFloat.str().c_str(), &m_Value->x, m_FloatParameters.SpeedStep,
 				m_FloatParameters.Min, m_FloatParameters.Max, m_FloatParameters.Format);
+			TrackActiveItem();
 			DrawFloatParametersPopup(m_UUID, m_FloatParameters);
 		}
 		else
@@ -255,6 +275,7 @@ namespace askygg::UI
 			ssInputFloat << m_Label.c_str() << "##Input" << m_UUID;
 
 			ImGui::InputFloat3(ssInputFloat.str().c_str(), &m_Value->x, m_FloatParameters.Format);
+			TrackActiveItem();
 			DrawFloatParametersPopup(m_UUID, m_FloatParameters);
 		}
 
@@ -325,6 +346,7 @@ namespace askygg::UI
 			ssInputFloat << m_Label.c_str() << "##Input" << m_UUID;
 
 			ImGui::InputFloat4(ssInputFloat.str().c_str(), &m_Value->x, m_FloatParameters.Format);
+			TrackActiveItem();
 			DrawFloatParametersPopup(m_UUID, m_FloatParameters);
 		}
 
@@ -365,6 +387,7 @@ namespace askygg::UI
 			{
 				ImGuiColorEditFlags flags = ImGuiColorEditFlags_HDR | ImGuiColorEditFlags_Float;
 				ImGui::ColorPicker4(m_Label.c_str(), &m_Color->x, flags, nullptr);
+				TrackActiveItem();
 				ImGui::EndPopup();
 			}
 
@@ -410,14 +433,12 @@ namespace askygg::UI
 			{
 				if (ImGui::BeginCombo("Texture Library", CurrentTexture.GetName().c_str()))
 				{
-					std::unordered_map<std::string, Ref<Texture2D>> availableTextures =
-						TextureLibrary::Get2DLibrary();
-
-					for (auto [name, texture] : availableTextures)
+					for (const auto& record : TextureRegistry::GetRecords())
 					{
-						if (texture->GetID() == m_TextureUniform->RendererID)
+						const Ref<Texture2D>& texture = record.Texture;
+						if (!texture || texture->GetID() == m_TextureUniform->RendererID)
 							continue;
-						if (ImGui::Selectable(name.c_str(), true))
+						if (ImGui::Selectable(texture->GetName().c_str(), true))
 							m_TextureUniform->RendererID = texture->GetID();
 					}
 
@@ -437,6 +458,7 @@ namespace askygg::UI
 	void UIBool::Draw()
 	{
 		ImGui::Checkbox(m_Label.c_str(), m_Value);
+		TrackActiveItem();
 	}
 
 	bool UIBool::Draw(const std::string& label, bool* value)
@@ -454,6 +476,7 @@ namespace askygg::UI
 			ImGui::Text("%s", label.c_str());
 			ImGui::TableSetColumnIndex(1);
 			Updated |= ImGui::Checkbox("", value);
+			TrackActiveItem();
 			ImGui::EndTable();
 		}
 		ImGui::PopStyleVar();
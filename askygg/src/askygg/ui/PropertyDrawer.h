@@ -50,10 +50,19 @@ namespace askygg::UI
 
 		const std::string& GetLabel() const { return m_Label; }
 
+		// True while a value control is being dragged or held, as of the last frame that drew property controls.
+		static bool IsAnyActive();
+
+	protected:
+		// Called right after a value widget; remembers that the user is holding or dragging it this frame.
+		static void TrackActiveItem();
+
 	protected:
 		std::string		m_Label;
 		uint32_t		m_UUID;
 		static uint32_t s_UIDCounter;
+		// The ImGui frame a value control was last active in.
+		static int		s_ActiveFrame;
 	};
 
 	class UIFloat : public UIProperty
@@ -33,9 +33,10 @@ namespace askygg::UI
         // Set the cursor to the calculated position for the image
         ImGui::SetCursorPos(cursorPos);
 
-        uint32_t textureID = m_Framebuffer->GetColorAttachmentID();
-        ImGui::Image(reinterpret_cast<void*>(textureID), ImVec2{ m_ViewportSize.x, m_ViewportSize.y },
-                     ImVec2{ 0, 1 }, ImVec2{ 1, 0 });
+        uint32_t textureID = m_TextureID ? m_TextureID : m_Framebuffer ? m_Framebuffer->GetColorAttachmentID() : 0;
+        if (textureID)
+            ImGui::Image(reinterpret_cast<void*>(textureID), ImVec2{ m_ViewportSize.x, m_ViewportSize.y },
+                         ImVec2{ 0, 1 }, ImVec2{ 1, 0 });
 
 		ImGui::End();
 		ImGui::PopStyleVar();
@@ -56,7 +57,8 @@ namespace askygg::UI
 		ImVec2 viewportPanelSize = ImGui::GetContentRegionAvail();
 
         // Calculate aspect ratio of the original image
-        float aspectRatio = static_cast<float>(m_Framebuffer->GetCurrentSize().x) / static_cast<float>(m_Framebuffer->GetCurrentSize().y);
+        glm::vec2 imageSize = m_TextureID ? m_TextureSize : m_Framebuffer ? m_Framebuffer->GetCurrentSize() : glm::vec2(1.0f);
+        float aspectRatio = imageSize.x / imageSize.y;
 
         float viewportWidth = viewportPanelSize.x;
         float viewportHeight = viewportPanelSize.x / aspectRatio;
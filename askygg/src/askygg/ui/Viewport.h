@@ -13,6 +13,12 @@ namespace askygg::UI
 		Viewport(const Ref<Framebuffer>& framebuffer);
 
 		void SetFramebuffer(const Ref<Framebuffer>& framebuffer) { m_Framebuffer = framebuffer; }
+		// Shows the texture as-is instead of the framebuffer's color attachment, without rendering it anywhere first.
+		void SetTexture(uint32_t textureID, const glm::vec2& size)
+		{
+			m_TextureID = textureID;
+			m_TextureSize = size;
+		}
 		void Draw();
 
 		const glm::vec2& GetViewportSize() const { return m_ViewportSize; }
@@ -23,6 +29,8 @@ namespace askygg::UI
 
 	private:
 		Ref<Framebuffer> m_Framebuffer;
+		uint32_t		 m_TextureID = 0;
+		glm::vec2		 m_TextureSize{ 0.0f };
 		glm::vec2		 m_ViewportSize{ 0.0f };
 		glm::vec2		 m_ViewportBoundsMin{ 0.0f };
 		glm::vec2		 m_ViewportBoundsMax{ 0.0f };
@@ -6,10 +6,12 @@ layout(binding = 0, rgba32f) restrict writeonly uniform image2D o_Image;
 uniform vec2 u_Distortion; // Distortion strength, use small values like 0.02
 uniform sampler2D u_Texture;
 
+uniform ivec2 u_DispatchOffset;
+
 layout(local_size_x = 4, local_size_y = 4) in;
 void main()
 {
-    vec2 texCoords = vec2(gl_GlobalInvocationID.xy) / vec2(imageSize(o_Image));
+    vec2 texCoords = vec2(ivec2(gl_GlobalInvocationID.xy) + u_DispatchOffset) / vec2(imageSize(o_Image));
     // Map texCoords to [-1, 1]
     vec2 p = texCoords * 2.0 - vec2(1.0);
 
@@ -25,5 +27,5 @@ void main()
     }
 
     vec4 color = texture(u_Texture, texCoords);
-    imageStore(o_Image, ivec2(gl_GlobalInvocationID.xy), color);
+    imageStore(o_Image, ivec2(gl_GlobalInvocationID.xy) + u_DispatchOffset, color);
 }
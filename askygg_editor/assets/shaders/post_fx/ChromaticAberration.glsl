@@ -7,11 +7,13 @@ uniform sampler2D u_Texture;
 uniform float u_Strength;
 
 
+uniform ivec2 u_DispatchOffset;
+
 layout(local_size_x = 4, local_size_y = 4) in;
 void main()
 {
     vec2 imgSize = vec2(imageSize(o_Image));
-    ivec2 invocID = ivec2(gl_GlobalInvocationID);
+    ivec2 invocID = ivec2(gl_GlobalInvocationID.xy) + u_DispatchOffset;
     vec2 texCoords = vec2(float(invocID.x) / imgSize.x, float(invocID.y) / imgSize.y);
     texCoords += (1.0f / imgSize) * 0.5f;
 
@@ -26,11 +26,13 @@ vec3 hsv2rgb(vec3 c)
     return c.z * mix(K.xxx, clamp(p - K.xxx, 0.0, 1.0), c.y);
 }
 
+uniform ivec2 u_DispatchOffset;
+
 layout(local_size_x = 4, local_size_y = 4) in;
 void main()
 {
     vec2 imgSize = vec2(imageSize(o_Image));
-    ivec2 invocID = ivec2(gl_GlobalInvocationID);
+    ivec2 invocID = ivec2(gl_GlobalInvocationID.xy) + u_DispatchOffset;
     vec2 texCoords = vec2(float(invocID.x) / imgSize.x, float(invocID.y) / imgSize.y);
     texCoords += (1.0f / imgSize) * 0.5f;
     vec3 color = texture(u_Texture, texCoords).rgb;
@@ -45,5 +47,5 @@ void main()
 
     // Convert the modified HSV color back to RGB
     color = hsv2rgb(hsv);
-    imageStore(o_Image, ivec2(gl_GlobalInvocationID.xy), vec4(color, 1.0));
+    imageStore(o_Image, ivec2(gl_GlobalInvocationID.xy) + u_DispatchOffset, vec4(color, 1.0));
 }
\ No newline at end of file
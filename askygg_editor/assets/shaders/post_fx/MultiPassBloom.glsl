@@ -109,12 +109,14 @@ vec3 UpsampleTent9(sampler2D tex, float lod, vec2 uv, vec2 texelSize, float radi
     return result * (1.0f / u_UpsampleTightenFactor);
 }
 
+uniform ivec2 u_DispatchOffset;
+
 layout(local_size_x = 4, local_size_y = 4) in;
 void main()
 {
     vec2 imgSize = vec2(imageSize(o_Image));
 
-    ivec2 invocID = ivec2(gl_GlobalInvocationID);
+    ivec2 invocID = ivec2(gl_GlobalInvocationID.xy) + u_DispatchOffset;
     vec2 texCoords = vec2(float(invocID.x) / imgSize.x, float(invocID.y) / imgSize.y);
     texCoords += (1.0f / imgSize) * 0.5f;
 
@@ -147,5 +149,5 @@ void main()
         color.rgb = DownsampleBox13(u_Texture, u_LOD, texCoords, 1.0f / texSize);
     }
 
-    imageStore(o_Image, ivec2(gl_GlobalInvocationID), color);
+    imageStore(o_Image, ivec2(gl_GlobalInvocationID.xy) + u_DispatchOffset, color);
 }
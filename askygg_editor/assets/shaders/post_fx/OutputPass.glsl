@@ -2,7 +2,8 @@
 #version 450
 
 layout(binding = 0, rgba32f) restrict readonly uniform image2D i_EnhancedImage;
-layout(binding = 1, rgba8) restrict writeonly uniform image2D o_Composite;
+// No format qualifier: the composite is stored to whatever the output texture is (RGBA8, RGBA16).
+layout(binding = 1) restrict writeonly uniform image2D o_Composite;
 
 
 uniform sampler2D u_SensorNoisePatchTexture;
@@ -106,12 +107,14 @@ vec3 UpsampleTent9(sampler2D tex, float lod, vec2 uv, vec2 texelSize, float radi
     return result * (1.0f / u_UpsampleTightenFactor);
 }
 
+uniform ivec2 u_DispatchOffset;
+
 layout(local_size_x = 4, local_size_y = 4) in;
 void main()
 {
     const float Gamma = 2.2;
 
-    ivec2 invocID = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 invocID = ivec2(gl_GlobalInvocationID.xy) + u_DispatchOffset;
     vec2 targetSize = vec2(imageSize(i_EnhancedImage));
     vec2 texCoords = vec2(invocID) / targetSize;
 
@@ -36,10 +36,12 @@ vec3 YCbCrToRGB(in vec3 c)
     1.0000, 1.7720, 0.0000)) * (c - vec3(0.0, 0.5, 0.5));
 }
 
+uniform ivec2 u_DispatchOffset;
+
 layout(local_size_x = 4, local_size_y = 4) in;
 void main()
 {
-    ivec2 invocID = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 invocID = ivec2(gl_GlobalInvocationID.xy) + u_DispatchOffset;
     vec4 inputColor = imageLoad(i_Input, invocID);
     vec4 result = vec4(0.0);
 
@@ -8,14 +8,17 @@ uniform int u_BlurSamples;
 uniform vec2 u_BlurDirection;
 uniform sampler2D u_Texture;
 
+uniform ivec2 u_DispatchOffset;
+
 layout(local_size_x = 4, local_size_y = 4) in;
 void main()
 {
     vec2 imgSize = vec2(imageSize(o_Image));
-    ivec2 invocID = ivec2(gl_GlobalInvocationID);
+    ivec2 invocID = ivec2(gl_GlobalInvocationID.xy) + u_DispatchOffset;
     vec2 texCoords = vec2(float(invocID.x) / imgSize.x, float(invocID.y) / imgSize.y);
     texCoords += (1.0f / imgSize) * 0.5f;
-    vec4 originalColor = textureLod(u_Texture, texCoords, 0.0);
+    // The texel itself rather than a filtered sample near its centre, so strength 0 copies the input exactly.
+    vec4 originalColor = texelFetch(u_Texture, invocID, 0);
 
     vec4 blurColor = vec4(0.0);
     const int numBlurSamples = max(0, u_BlurSamples);
@@ -29,5 +32,5 @@ void main()
 
     vec4 finalColor = mix(originalColor, blurColor, u_BlurStrength);
 
-    imageStore(o_Image, ivec2(gl_GlobalInvocationID.xy), finalColor);
+    imageStore(o_Image, ivec2(gl_GlobalInvocationID.xy) + u_DispatchOffset, finalColor);
 }
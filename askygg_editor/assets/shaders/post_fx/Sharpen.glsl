@@ -4,6 +4,8 @@
 layout(binding = 0, rgba32f) restrict writeonly uniform image2D o_Image;
 
 uniform float u_SharpenStrength;
+// Kernel spacing in texels; a downscaled preview samples between its texels to match the full-size kernel.
+uniform float u_KernelScale = 1.0;
 uniform sampler2D u_Texture;
 
 const mat3 kernel = mat3(
@@ -30,14 +32,16 @@ vec3 YCbCrToRGB(in vec3 c)
 }
 
 
+uniform ivec2 u_DispatchOffset;
+
 layout(local_size_x = 4, local_size_y = 4) in;
 void main()
 {
     vec2 imgSize = vec2(imageSize(o_Image));
-    ivec2 invocID = ivec2(gl_GlobalInvocationID);
+    ivec2 invocID = ivec2(gl_GlobalInvocationID.xy) + u_DispatchOffset;
     vec2 texCoords = vec2(float(invocID.x) / imgSize.x, float(invocID.y) / imgSize.y);
     texCoords += (1.0f / imgSize) * 0.5f;
-    vec2 texelSize = 1.0 / imgSize;
+    vec2 texelSize = u_KernelScale / imgSize;
 
     vec3 color = vec3(0.0);
     float yAccum = 0.0;
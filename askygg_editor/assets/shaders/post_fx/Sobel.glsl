@@ -5,8 +5,12 @@ layout(binding = 0, rgba32f) restrict writeonly uniform image2D o_Image;
 
 uniform float u_Strength;
 uniform float u_Threshold;
+// Kernel spacing in texels; a downscaled preview samples between its texels to match the full-size kernel.
+uniform float u_KernelScale = 1.0;
 uniform sampler2D u_Texture;
 
+uniform ivec2 u_DispatchOffset;
+
 layout(local_size_x = 4, local_size_y = 4) in;
 void main()
 {
@@ -26,11 +30,11 @@ void main()
 
 
     vec2 imgSize = vec2(imageSize(o_Image));
-    ivec2 invocID = ivec2(gl_GlobalInvocationID);
+    ivec2 invocID = ivec2(gl_GlobalInvocationID.xy) + u_DispatchOffset;
     vec2 texCoords = vec2(float(invocID.x) / imgSize.x, float(invocID.y) / imgSize.y);
     texCoords += (1.0f / imgSize) * 0.5f;
 
-    vec2 texelSize = 1.0 / textureSize(u_Texture, 0);
+    vec2 texelSize = u_KernelScale / textureSize(u_Texture, 0);
     float sobelX = 0.0;
     float sobelY = 0.0;
     int kernelIndex = 0;
@@ -50,7 +54,8 @@ void main()
     }
     float sobel = sqrt(sobelX * sobelX + sobelY * sobelY);
     sobel *= step(u_Threshold, sobel);
-    vec4 originalColor = texture(u_Texture, texCoords);
+    // The texel itself rather than a filtered sample near its centre, so strength 0 copies the input exactly.
+    vec4 originalColor = texelFetch(u_Texture, invocID, 0);
     vec4 finalColor = originalColor + vec4(vec3(sobel * u_Strength), 0.0);
     imageStore(o_Image, invocID, finalColor);
 }
\ No newline at end of file
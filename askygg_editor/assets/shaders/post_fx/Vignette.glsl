@@ -6,10 +6,12 @@ uniform sampler2D u_Texture;
 uniform float u_Radius = 0.75;  // Controls the size of the vignette. Smaller values create a larger dark border.
 uniform float u_Softness = 0.45;  // Controls the falloff of the vignette effect. Larger values create a softer border.
 
+uniform ivec2 u_DispatchOffset;
+
 layout(local_size_x = 4, local_size_y = 4) in;
 void main()
 {
-    ivec2 pixelCoords = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 pixelCoords = ivec2(gl_GlobalInvocationID.xy) + u_DispatchOffset;
     vec2 imgSize = vec2(imageSize(o_Image));
     vec2 texCoords = vec2(pixelCoords) / imgSize;
 
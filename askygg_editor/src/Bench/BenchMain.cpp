@@ -0,0 +1,80 @@
+#include "PipelineBenchmark.h"
+
+#include "ImageEditor/ImagePipeline.h"
+#include "askygg/core/Log.h"
+#include "askygg/renderer/GraphicsContext.h"
+#include "askygg/renderer/PlatformRenderAPI.h"
+#include "askygg/renderer/RenderCommand.h"
+
+#include <sstream>
+
+// "512" is square, "3840x2160" is width by height.
+static std::vector<glm::uvec2> ParseSizes(const std::string& list)
+{
+	std::vector<glm::uvec2> sizes;
+	std::stringstream		stream(list);
+	std::string				entry;
+	while (std::getline(stream, entry, ','))
+	{
+		size_t separator = entry.find('x');
+		uint32_t width = std::stoul(entry.substr(0, separator));
+		uint32_t height = separator == std::string::npos ? width : std::stoul(entry.substr(separator + 1));
+		sizes.emplace_back(width, height);
+	}
+	return sizes;
+}
+
+int main(int argc, char** argv)
+{
+	askygg::Log::Init();
+
+	BenchmarkSettings settings;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string argument = argv[i];
+		const bool		  hasValue = i + 1 < argc;
+		if (argument == "--config_file" && hasValue)
+			settings.ConfigFilePath = argv[++i];
+		else if (argument == "--sizes" && hasValue)
+			settings.Sizes = ParseSizes(argv[++i]);
+		else if (argument == "--warmup" && hasValue)
+			settings.WarmupIterations = std::stoul(argv[++i]);
+		else if (argument == "--iterations" && hasValue)
+			settings.Iterations = std::stoul(argv[++i]);
+		else if (argument == "--output" && hasValue)
+			settings.OutputPath = argv[++i];
+		else if (argument == "--baseline" && hasValue)
+			settings.BaselinePath = argv[++i];
+		else if (argument == "--threshold" && hasValue)
+			settings.Threshold = std::stof(argv[++i]);
+		else if (argument == "--cpu")
+			settings.Cpu = true;
+		else if (argument == "--check_elision")
+			settings.CheckElision = true;
+		else
+			YGG_ASSERT(false, "Unknown or incomplete argument '{}'.", argument);
+	}
+
+	askygg::PlatformRenderAPI::InitializePlatformRendererType();
+	askygg::Ref<askygg::GraphicsContext> context = askygg::GraphicsContext::CreateHeadless();
+	context->Initialize();
+	askygg::RenderCommand::Initialize();
+	ImagePipeline::LoadShaders();
+
+	if (settings.CheckElision)
+	{
+		const uint32_t mismatches = PipelineBenchmark::CheckElision(settings);
+		context->DetachCurrent();
+		return mismatches > 0 ? 1 : 0;
+	}
+
+	std::vector<BenchmarkResult> results = PipelineBenchmark::Run(settings);
+	PipelineBenchmark::WriteJson(settings.OutputPath, settings, results);
+
+	uint32_t regressions = 0;
+	if (!settings.BaselinePath.empty())
+		regressions = PipelineBenchmark::CompareToBaseline(settings.BaselinePath, settings.Threshold, results);
+
+	context->DetachCurrent();
+	return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,358 @@
+#include "PipelineBenchmark.h"
+#include "SyntheticNightScene.h"
+
+#include "ImageEditor/Cpu/CpuKernels.h"
+#include "ImageEditor/Cpu/CpuThreadPool.h"
+#include "ImageEditor/ImagePipeline.h"
+#include "askygg/core/Log.h"
+#include "askygg/platform/renderer_platform/opengl/OpenGLTimer.h"
+
+#include "yaml-cpp/yaml.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+static double Median(std::vector<double> samples)
+{
+	auto middle = samples.begin() + samples.size() / 2;
+	std::nth_element(samples.begin(), middle, samples.end());
+	return *middle;
+}
+
+static std::string EscapeJson(const std::string& text)
+{
+	std::string escaped;
+	for (char c : text)
+	{
+		if (c == '"' || c == '\\')
+			escaped += '\\';
+		escaped += c;
+	}
+	return escaped;
+}
+
+static askygg::Ref<askygg::Texture2D> CreateInputTexture(const std::string& name, const glm::uvec2& size,
+	askygg::ImageUtils::ImageInternalFormat format, askygg::ImageUtils::ImageDataType dataType, void* data,
+	uint32_t dataSize)
+{
+	askygg::Texture2DSpecification spec = {
+		askygg::ImageUtils::WrapMode::ClampToEdge,
+		askygg::ImageUtils::WrapMode::ClampToEdge,
+		askygg::ImageUtils::FilterMode::Linear,
+		askygg::ImageUtils::FilterMode::Linear,
+		format,
+		askygg::ImageUtils::ImageDataLayout::RGBA,
+		dataType,
+		size.x,
+		size.y
+	};
+	spec.Name = name;
+	spec.MipLevels = 1;
+
+	auto texture = askygg::CreateRef<askygg::Texture2D>(spec);
+	texture->SetData(data, dataSize);
+	return texture;
+}
+
+std::vector<BenchmarkResult> PipelineBenchmark::Run(const BenchmarkSettings& settings)
+{
+	ImagePipeline pipeline(settings.ConfigFilePath);
+	pipeline.Initialize();
+
+	std::vector<ImagePassType> isolatedPasses = { ImagePassType::Linearize, ImagePassType::RadialBloom,
+		ImagePassType::MultiPassBloom };
+	for (ImagePassType type : ImagePass::GetAllBasicImagePassTypes())
+		isolatedPasses.push_back(type);
+	isolatedPasses.push_back(ImagePassType::OutputCompute);
+
+	std::vector<BenchmarkResult> results;
+	for (const glm::uvec2& size : settings.Sizes)
+	{
+		YGG_LOG_INFO("Benchmarking {}x{}", size.x, size.y);
+
+		// Linearize reads the clipped RGBA8 encoding, every other pass the scene-linear image it stands in for.
+		askygg::Ref<askygg::Texture2D> displayInput, linearInput;
+		{
+			std::vector<float>	 linear = SyntheticNightScene::GenerateLinear(size.x, size.y);
+			std::vector<uint8_t> display = SyntheticNightScene::EncodeDisplay(linear);
+			if (settings.Cpu)
+				MeasureCpuPointwise(linear, size, settings, results);
+			linearInput = CreateInputTexture("Bench Linear Input", size, askygg::ImageUtils::ImageInternalFormat::RGBA32F,
+				askygg::ImageUtils::ImageDataType::Float, linear.data(), (uint32_t)(linear.size() * sizeof(float)));
+			displayInput = CreateInputTexture("Bench Display Input", size, askygg::ImageUtils::ImageInternalFormat::RGBA8,
+				askygg::ImageUtils::ImageDataType::UByte, display.data(), (uint32_t)display.size());
+		}
+
+		glm::vec2 targetSize = size;
+		for (ImagePassType type : isolatedPasses)
+		{
+			uint32_t inputID = type == ImagePassType::Linearize ? displayInput->GetID() : linearInput->GetID();
+			results.push_back(Measure(ImagePass::ImagePassTypeToString(type), "pass", size, settings,
+				[&] { pipeline.SubmitPass(type, targetSize, inputID, false); }));
+		}
+
+		// The bloom pass the config doesn't use shouldn't hold memory during the chain run.
+		if (pipeline.GetBloomType() != BloomType::MultiPass)
+			pipeline.GetPass(ImagePassType::MultiPassBloom)->ReleaseTargets();
+		linearInput = nullptr;
+
+		results.push_back(Measure("Chain", "chain", size, settings,
+			[&] { pipeline.Submit(targetSize, displayInput->GetID(), askygg::RenderGraphAccess::Sampled, false); }));
+		YGG_LOG_INFO("  Chain elides {} identity pass(es), peak GPU memory {:.1f} MB", pipeline.GetElidedPasses().size(),
+			(double)pipeline.GetPeakMemorySize() / (1024.0 * 1024.0));
+	}
+
+	pipeline.Shutdown();
+	return results;
+}
+
+uint32_t PipelineBenchmark::CheckElision(const BenchmarkSettings& settings)
+{
+	ImagePipeline pipeline(settings.ConfigFilePath);
+	pipeline.Initialize();
+	// The sensor noise moves with the clock, so two submits only match without it.
+	YAML::Node config = pipeline.ExportSettings();
+	config["Output"]["Sensor Noise Beta"] = 0.0f;
+	pipeline.ApplySettings(config);
+
+	std::string identities;
+	for (ImagePassType type : pipeline.GetOrderedPassTypes())
+	{
+		if (pipeline.GetPass(type)->IsIdentity())
+			identities += (identities.empty() ? "" : ", ") + ImagePass::ImagePassTypeToString(type);
+	}
+	YGG_LOG_INFO("Identity passes in the chain: {}", identities.empty() ? "none" : identities);
+
+	uint32_t mismatches = 0;
+	for (const glm::uvec2& size : settings.Sizes)
+	{
+		std::vector<uint8_t> display =
+			SyntheticNightScene::EncodeDisplay(SyntheticNightScene::GenerateLinear(size.x, size.y));
+		const askygg::Ref<askygg::Texture2D> input = CreateInputTexture("Bench Display Input", size,
+			askygg::ImageUtils::ImageInternalFormat::RGBA8, askygg::ImageUtils::ImageDataType::UByte, display.data(),
+			(uint32_t)display.size());
+
+		std::vector<uint8_t> outputs[2];
+		for (int elide = 0; elide < 2; elide++)
+		{
+			pipeline.SetPassElision(elide == 1);
+			pipeline.Submit(size, input->GetID(), askygg::RenderGraphAccess::Readback, false);
+			const askygg::Ref<askygg::Texture2D>& output = pipeline.GetOutputTexture();
+			outputs[elide].resize((size_t)output->GetWidth() * output->GetHeight() * 4);
+			glBindTexture(GL_TEXTURE_2D, output->GetID());
+			glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, outputs[elide].data());
+		}
+
+		size_t differing = 0;
+		for (size_t i = 0; i < outputs[0].size(); i++)
+			differing += outputs[0][i] != outputs[1][i];
+		if (differing)
+		{
+			mismatches++;
+			YGG_LOG_ERROR("  {}x{}: {} of {} bytes differ with identity passes elided", size.x, size.y, differing,
+				outputs[0].size());
+		}
+		else
+			YGG_LOG_INFO("  {}x{}: identical with identity passes elided", size.x, size.y);
+	}
+
+	pipeline.SetPassElision(true);
+	pipeline.Shutdown();
+	return mismatches;
+}
+
+void PipelineBenchmark::MeasureCpuPointwise(const std::vector<float>& linear, const glm::uvec2& size,
+	const BenchmarkSettings& settings, std::vector<BenchmarkResult>& results)
+{
+	const CpuKernelTable& kernels = GetCpuKernels();
+	CpuThreadPool		  threadPool;
+	const uint32_t		  tileRows = std::max(1u, size.y / (threadPool.GetThreadCount() * 8));
+	YGG_LOG_INFO("  CPU kernels {} on {} thread(s)", kernels.Name, threadPool.GetThreadCount());
+
+	// Settings that change every pixel; the work does not depend on them otherwise.
+	CpuPointwiseOp contrastBrightness, hueShift;
+	contrastBrightness.Type = CpuPointwiseOpType::ContrastBrightness;
+	contrastBrightness.ContrastBrightness.Contrast = 1.2f;
+	contrastBrightness.ContrastBrightness.Brightness = 0.05f;
+	hueShift.Type = CpuPointwiseOpType::HueShift;
+	hueShift.HueShift.HueShift = 0.1f;
+	hueShift.HueShift.SaturationBoost = 0.2f;
+	hueShift.HueShift.ValueBoost = 0.05f;
+
+	// Images between the passes ping-pong as in CpuPipeline's frame schedule.
+	std::vector<float>	 images[2] = { std::vector<float>(linear.size()), std::vector<float>(linear.size()) };
+	const CpuImageView	 input = { linear.data(), size.x, size.y };
+	const CpuImageTarget targets[2] = { { images[0].data(), size.x, size.y }, { images[1].data(), size.x, size.y } };
+
+	// The default order's run takes its compiled chain, the repeated one the runtime chain.
+	const std::vector<std::vector<CpuPointwiseOp>> runs = { { contrastBrightness, hueShift },
+		{ contrastBrightness, hueShift, contrastBrightness, hueShift } };
+	for (const auto& run : runs)
+	{
+		CpuPointwiseParameters fused;
+		fused.Input = input;
+		fused.Output = targets[0];
+		for (const CpuPointwiseOp& op : run)
+			fused.Ops[fused.OpCount++] = op;
+
+		const auto perOp = [&] {
+			for (size_t i = 0; i < run.size(); i++)
+			{
+				const CpuImageView	  from = i == 0 ? input : CpuImageView{ images[(i + 1) % 2].data(), size.x, size.y };
+				const CpuImageTarget& to = targets[i % 2];
+				threadPool.ParallelFor(size.y, tileRows, [&](uint32_t begin, uint32_t end) {
+					if (run[i].Type == CpuPointwiseOpType::ContrastBrightness)
+					{
+						CpuContrastBrightnessParameters parameters = run[i].ContrastBrightness;
+						parameters.Input = from;
+						parameters.Output = to;
+						kernels.ContrastBrightness(parameters, begin, end);
+					}
+					else
+					{
+						CpuHueShiftParameters parameters = run[i].HueShift;
+						parameters.Input = from;
+						parameters.Output = to;
+						kernels.HueShift(parameters, begin, end);
+					}
+				});
+			}
+		};
+		const auto fusedRun = [&] {
+			threadPool.ParallelFor(size.y, tileRows,
+				[&](uint32_t begin, uint32_t end) { kernels.Pointwise(fused, begin, end); });
+		};
+
+		const auto time = [&](const std::string& name, const auto& function) {
+			for (uint32_t i = 0; i < settings.WarmupIterations; i++)
+				function();
+
+			std::vector<double> wallMs;
+			for (uint32_t i = 0; i < std::max(settings.Iterations, 1u); i++)
+			{
+				auto start = std::chrono::steady_clock::now();
+				function();
+				wallMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+			}
+			results.push_back(Summarize(name, "cpu", size, {}, wallMs));
+		};
+		time("CpuPerOp x" + std::to_string(run.size()), perOp);
+		time("CpuFused x" + std::to_string(run.size()), fusedRun);
+	}
+}
+
+BenchmarkResult PipelineBenchmark::Measure(const std::string& name, const std::string& kind, const glm::uvec2& size,
+	const BenchmarkSettings& settings, const std::function<void()>& submit)
+{
+	askygg::OpenGLFuncTimer timer;
+	for (uint32_t i = 0; i < settings.WarmupIterations; i++)
+		timer.ProfileFn(submit);
+
+	std::vector<double> gpuMs, wallMs;
+	for (uint32_t i = 0; i < std::max(settings.Iterations, 1u); i++)
+	{
+		// ProfileFn waits for the closing timestamp, so the wall clock stops once the GPU is done too.
+		auto start = std::chrono::steady_clock::now();
+		gpuMs.push_back(timer.ProfileFn(submit));
+		wallMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+	return Summarize(name, kind, size, gpuMs, wallMs);
+}
+
+BenchmarkResult PipelineBenchmark::Summarize(const std::string& name, const std::string& kind,
+	const glm::uvec2& size, std::vector<double> gpuMs, const std::vector<double>& wallMs)
+{
+	BenchmarkResult result;
+	result.Name = name;
+	result.Kind = kind;
+	result.Width = size.x;
+	result.Height = size.y;
+	result.GpuMs = gpuMs.empty() ? 0.0 : Median(gpuMs);
+	result.WallMs = Median(wallMs);
+	result.WallMinMs = *std::min_element(wallMs.begin(), wallMs.end());
+	result.MPixPerSecond = (double)size.x * size.y / (result.WallMs * 1000.0);
+
+	YGG_LOG_INFO("  {:<20} {:>9.3f} ms gpu {:>9.3f} ms wall {:>9.1f} MPix/s", name, result.GpuMs, result.WallMs,
+		result.MPixPerSecond);
+	return result;
+}
+
+void PipelineBenchmark::WriteJson(const std::string& filePath, const BenchmarkSettings& settings,
+	const std::vector<BenchmarkResult>& results)
+{
+	std::ofstream out(filePath);
+	YGG_ASSERT(out, "Unable to write benchmark results to '{}'.", filePath);
+
+	out << std::fixed << std::setprecision(4);
+	out << "{\n";
+	out << "  \"renderer\": \"" << EscapeJson((const char*)glGetString(GL_RENDERER)) << "\",\n";
+	out << "  \"version\": \"" << EscapeJson((const char*)glGetString(GL_VERSION)) << "\",\n";
+	out << "  \"config\": \"" << EscapeJson(settings.ConfigFilePath) << "\",\n";
+	out << "  \"warmup\": " << settings.WarmupIterations << ",\n";
+	out << "  \"iterations\": " << settings.Iterations << ",\n";
+	out << "  \"results\": [\n";
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const auto& result = results[i];
+		out << "    { \"name\": \"" << result.Name << "\", \"kind\": \"" << result.Kind << "\", \"width\": "
+			<< result.Width << ", \"height\": " << result.Height << ", \"gpu_ms\": " << result.GpuMs
+			<< ", \"wall_ms\": " << result.WallMs << ", \"wall_min_ms\": " << result.WallMinMs
+			<< ", \"mpix_per_s\": " << result.MPixPerSecond << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	out << "  ]\n";
+	out << "}\n";
+
+	YGG_LOG_INFO("Wrote {} benchmark results to '{}'", results.size(), filePath);
+}
+
+uint32_t PipelineBenchmark::CompareToBaseline(const std::string& baselinePath, float threshold,
+	const std::vector<BenchmarkResult>& results)
+{
+	// JSON is a subset of YAML's flow style, so the baseline goes through the parser the settings already use.
+	YAML::Node baseline = YAML::LoadFile(baselinePath);
+	const std::string renderer = (const char*)glGetString(GL_RENDERER);
+	if (baseline["renderer"] && baseline["renderer"].as<std::string>() != renderer)
+		YGG_LOG_WARN("Baseline was recorded on '{}', this run is on '{}'.", baseline["renderer"].as<std::string>(),
+			renderer);
+
+	uint32_t regressions = 0;
+	for (const auto& result : results)
+	{
+		const YAML::Node entries = baseline["results"];
+		YAML::Node		 match;
+		bool			 found = false;
+		for (std::size_t i = 0; i < entries.size() && !found; i++)
+		{
+			const YAML::Node entry = entries[i];
+			found = entry["name"].as<std::string>() == result.Name && entry["kind"].as<std::string>() == result.Kind
+				&& entry["width"].as<uint32_t>() == result.Width && entry["height"].as<uint32_t>() == result.Height;
+			if (found)
+				match = entry;
+		}
+
+		if (!found)
+		{
+			YGG_LOG_INFO("  {:<20} {}x{}: not in baseline", result.Name, result.Width, result.Height);
+			continue;
+		}
+
+		// Either clock regressing counts; the GPU clock is immune to CPU-side noise, the wall clock is what users see.
+		const double gpuChange =
+			result.GpuMs > 0.0 ? result.GpuMs / std::max(match["gpu_ms"].as<double>(), 1e-6) - 1.0 : 0.0;
+		const double wallChange = result.WallMs / std::max(match["wall_ms"].as<double>(), 1e-6) - 1.0;
+		const bool	 regressed = gpuChange > threshold || wallChange > threshold;
+		regressions += regressed ? 1 : 0;
+
+		if (regressed)
+			YGG_LOG_ERROR("  {:<20} {}x{}: gpu {:+.1f}%, wall {:+.1f}% REGRESSION", result.Name, result.Width,
+				result.Height, gpuChange * 100.0, wallChange * 100.0);
+		else
+			YGG_LOG_INFO("  {:<20} {}x{}: gpu {:+.1f}%, wall {:+.1f}%", result.Name, result.Width, result.Height,
+				gpuChange * 100.0, wallChange * 100.0);
+	}
+
+	YGG_LOG_INFO("{} of {} results regressed by more than {:.0f}% against '{}'", regressions, results.size(),
+		threshold * 100.0f, baselinePath);
+	return regressions;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+struct BenchmarkSettings
+{
+	std::string			   ConfigFilePath = "image_editor_settings.yaml";
+	std::vector<glm::uvec2> Sizes = { { 512, 512 }, { 1024, 1024 }, { 2048, 2048 }, { 3840, 2160 }, { 7680, 4320 } };
+	uint32_t			   WarmupIterations = 3;
+	uint32_t			   Iterations = 20;
+	std::string			   OutputPath = "askygg_bench.json";
+	std::string			   BaselinePath;
+	// Relative slowdown over the baseline that counts as a regression.
+	float				   Threshold = 0.10f;
+	// Also time the CPU backend's pointwise passes, fused into one loop against one pass per op.
+	bool				   Cpu = false;
+	// Instead of timing anything, check that eliding identity passes leaves the output as it is.
+	bool				   CheckElision = false;
+};
+
+struct BenchmarkResult
+{
+	std::string Name;
+	// "pass" for a single ImagePass in isolation, "chain" for the full pipeline as configured, "cpu" for CPU kernels.
+	std::string Kind;
+	uint32_t	Width = 0;
+	uint32_t	Height = 0;
+	// Medians over the measured iterations.  GPU time comes from timestamp queries around the submit, wall time also
+	// covers recording the graph and waiting for the result.  CPU kernels only have wall time.
+	double		GpuMs = 0.0;
+	double		WallMs = 0.0;
+	double		WallMinMs = 0.0;
+	double		MPixPerSecond = 0.0;
+};
+
+// Runs every ImagePass in isolation and the configured chain over synthetic night scenes.  Needs a current context
+// with the post-fx shaders loaded.
+class PipelineBenchmark
+{
+public:
+	static std::vector<BenchmarkResult> Run(const BenchmarkSettings& settings);
+	// Renders the configured chain at every size with identity passes elided and declared, and returns how many sizes
+	// differ in any output byte.
+	static uint32_t CheckElision(const BenchmarkSettings& settings);
+
+	static void WriteJson(const std::string& filePath, const BenchmarkSettings& settings,
+		const std::vector<BenchmarkResult>& results);
+	// Logs every result next to its baseline entry and returns how many regressed by more than the threshold.
+	static uint32_t CompareToBaseline(const std::string& baselinePath, float threshold,
+		const std::vector<BenchmarkResult>& results);
+
+private:
+	// Runs of ContrastBrightness and HueShift over a linear frame, each both fused and as one pass per op.
+	static void MeasureCpuPointwise(const std::vector<float>& linear, const glm::uvec2& size,
+		const BenchmarkSettings& settings, std::vector<BenchmarkResult>& results);
+	static BenchmarkResult Summarize(const std::string& name, const std::string& kind, const glm::uvec2& size,
+		std::vector<double> gpuMs, const std::vector<double>& wallMs);
+	static BenchmarkResult Measure(const std::string& name, const std::string& kind, const glm::uvec2& size,
+		const BenchmarkSettings& settings, const std::function<void()>& submit);
+};
@@ -0,0 +1,124 @@
+#include "SyntheticNightScene.h"
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+
+static uint32_t Hash(uint32_t x)
+{
+	x ^= x >> 16;
+	x *= 0x7feb352dU;
+	x ^= x >> 15;
+	x *= 0x846ca68bU;
+	x ^= x >> 16;
+	return x;
+}
+
+static float Hash01(uint32_t x, uint32_t seed)
+{
+	return (float)(Hash(x ^ Hash(seed)) & 0xFFFFFF) / (float)0x1000000;
+}
+
+std::vector<float> SyntheticNightScene::GenerateLinear(uint32_t width, uint32_t height, uint32_t seed)
+{
+	constexpr uint32_t BuildingCount = 48;
+	constexpr uint32_t StreetLightCount = 24;
+	constexpr float	   StreetLevel = 0.12f;
+
+	std::vector<float> pixels((size_t)width * height * 4);
+	const float		   aspect = (float)width / (float)height;
+
+	// Skyline heights, in units of image height.
+	float buildingHeights[BuildingCount];
+	for (uint32_t i = 0; i < BuildingCount; i++)
+		buildingHeights[i] = 0.18f + 0.32f * Hash01(i, seed) * Hash01(i + 101, seed);
+
+	for (uint32_t y = 0; y < height; y++)
+	{
+		const float v = ((float)y + 0.5f) / (float)height;
+		for (uint32_t x = 0; x < width; x++)
+		{
+			const float u = ((float)x + 0.5f) / (float)width;
+			const uint32_t pixelIndex = y * width + x;
+			glm::vec3 colour;
+
+			// Sky: deep blue overhead, sodium haze towards the horizon, sparse stars.
+			const float haze = glm::exp(-glm::max(v - StreetLevel, 0.0f) * 6.0f);
+			colour = glm::mix(glm::vec3(0.002f, 0.003f, 0.012f), glm::vec3(0.045f, 0.025f, 0.012f), haze);
+			if (Hash01(pixelIndex, seed + 7) > 0.9995f)
+				colour += glm::vec3(0.3f + 2.0f * Hash01(pixelIndex, seed + 11));
+
+			// Skyline with a grid of lit windows.
+			const uint32_t building = std::min((uint32_t)(u * BuildingCount), BuildingCount - 1);
+			if (v > StreetLevel && v < buildingHeights[building])
+			{
+				colour = glm::vec3(0.006f, 0.006f, 0.008f);
+				const float cellU = u * BuildingCount * 6.0f;
+				const float cellV = v * 60.0f;
+				const bool	inWindow = glm::fract(cellU) > 0.3f && glm::fract(cellV) > 0.35f;
+				const uint32_t cell = Hash(((uint32_t)cellU << 12) ^ (uint32_t)cellV);
+				if (inWindow && Hash01(cell, seed + 3) < 0.35f)
+					colour = glm::vec3(1.2f, 0.85f, 0.45f) * (0.3f + 1.7f * Hash01(cell, seed + 5));
+			}
+
+			// Wet street: dark asphalt with a faint reflection of the haze.
+			if (v <= StreetLevel)
+				colour = glm::vec3(0.004f, 0.004f, 0.005f) + 0.2f * colour;
+
+			// Sensor noise, heavier in the shadows.
+			const float noise = Hash01(pixelIndex, seed + 13) - 0.5f;
+			colour = glm::max(colour * (1.0f + 0.08f * noise) + 0.0015f * noise, glm::vec3(0.0f));
+
+			float* out = &pixels[(size_t)pixelIndex * 4];
+			out[0] = colour.r;
+			out[1] = colour.g;
+			out[2] = colour.b;
+			out[3] = 1.0f;
+		}
+	}
+
+	// Street lights and the moon: bright cores with wide halos, splatted over their own footprint only.
+	auto addLight = [&](float lightU, float lightV, float radius, const glm::vec3& intensity)
+	{
+		const float	  haloRadius = radius * 8.0f;
+		const int32_t minX = std::max((int32_t)((lightU - haloRadius / aspect) * width), 0);
+		const int32_t maxX = std::min((int32_t)((lightU + haloRadius / aspect) * width), (int32_t)width - 1);
+		const int32_t minY = std::max((int32_t)((lightV - haloRadius) * height), 0);
+		const int32_t maxY = std::min((int32_t)((lightV + haloRadius) * height), (int32_t)height - 1);
+		for (int32_t y = minY; y <= maxY; y++)
+		{
+			for (int32_t x = minX; x <= maxX; x++)
+			{
+				const float du = (((float)x + 0.5f) / (float)width - lightU) * aspect;
+				const float dv = ((float)y + 0.5f) / (float)height - lightV;
+				const float d = glm::sqrt(du * du + dv * dv) / radius;
+				const float falloff = glm::exp(-d * d * 4.0f) + 0.02f / (1.0f + d * d);
+
+				float* out = &pixels[((size_t)y * width + x) * 4];
+				out[0] += intensity.r * falloff;
+				out[1] += intensity.g * falloff;
+				out[2] += intensity.b * falloff;
+			}
+		}
+	};
+
+	for (uint32_t i = 0; i < StreetLightCount; i++)
+	{
+		const float lightU = ((float)i + 0.5f) / StreetLightCount + 0.01f * (Hash01(i, seed + 17) - 0.5f);
+		addLight(lightU, StreetLevel + 0.06f, 0.006f, glm::vec3(50.0f, 30.0f, 12.0f));
+	}
+	addLight(0.8f, 0.82f, 0.025f, glm::vec3(8.0f, 8.5f, 9.0f));
+
+	return pixels;
+}
+
+std::vector<uint8_t> SyntheticNightScene::EncodeDisplay(const std::vector<float>& linear)
+{
+	std::vector<uint8_t> encoded(linear.size());
+	for (size_t i = 0; i < linear.size(); i++)
+	{
+		const float value = (i % 4) == 3 ? linear[i] : std::pow(std::max(linear[i], 0.0f), 1.0f / 2.2f);
+		encoded[i] = (uint8_t)(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+	return encoded;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Procedural stand-in for the night photographs the editor is tuned for: a near-black sky, a lit skyline and sodium
+// street lights whose cores sit far above display white.  Generation is deterministic and the layout is resolution
+// independent, so every size shows the same scene.
+class SyntheticNightScene
+{
+public:
+	// Scene-linear RGBA32F, bottom row first (GL order).  Light cores reach ~50, most of the frame stays below 0.05.
+	static std::vector<float> GenerateLinear(uint32_t width, uint32_t height, uint32_t seed = 1);
+	// What a camera would have written for the same scene: gamma 2.2, clipped, RGBA8.  This is the input Linearize
+	// expects.
+	static std::vector<uint8_t> EncodeDisplay(const std::vector<float>& linear);
+};
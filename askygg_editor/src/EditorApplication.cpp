@@ -2,51 +2,168 @@
 #include "askygg/core/EntryPoint.h"
 #include "Layers/EditorLayer.h"
 #include "Layers/HeadlessLayer.h"
+#include "Layers/StreamLayer.h"
+#include "ImageEditor/ImagePipeline.h"
+#ifdef YGG_JOB_DAEMON
+	#include "Layers/DaemonLayer.h"
+#endif
 
-class EditorApplication : public askygg::Application
+enum class EditorMode
 {
-public:
-	explicit EditorApplication(const askygg::ApplicationSpecification& spec)
-		: askygg::Application(spec)
-	{
-		enum class Mode
-		{
-			Undefined,
-			Headless,
-			Editor
-		};
+	Undefined,
+	Headless,
+	Editor,
+	Stream,
+	Daemon
+};
+
+// Everything the command line selects, parsed before anything else is created.
+struct EditorOptions
+{
+	EditorMode	mode = EditorMode::Undefined;
+	std::string inputDirectory = std::string();
+	std::string outputDirectory = std::string();
+	std::string configFilePath = std::string();
+	uint32_t	workerCount = 1;
+	bool		scalingReport = false;
+	bool		continuous = false;
+	std::string streamSize = std::string();
+	std::string pixelFormat = "rgba";
+	std::string socketPath = std::string();
+	std::string outputArchive = std::string();
+	std::string variantsFileName = std::string();
+	bool		cpuBackend = false;
+	CpuPipelineSpecification cpu;
+	InputEnumeratorSpecification input;
+	OutputWriterSpecification	 output;
 
-		Mode		mode = Mode::Undefined;
-		std::string inputDirectory = std::string();
-		std::string outputDirectory = std::string();
-		std::string configFilePath = std::string();
+	static EditorOptions Parse(askygg::ApplicationCommandLineArgs args);
+};
 
-		for (int i = 0; i < spec.CommandLineArgs.Count; i++)
+EditorOptions EditorOptions::Parse(askygg::ApplicationCommandLineArgs args)
+{
+	EditorOptions options;
+	for (int i = 0; i < args.Count; i++)
+	{
+		if (std::string(args[i]) == "--headless")
+			options.mode = EditorMode::Headless;
+		else if (std::string(args[i]) == "--editor")
+			options.mode = EditorMode::Editor;
+		else if (std::string(args[i]) == "--input_dir" && i + 1 < args.Count)
+			options.inputDirectory = std::string(args[i + 1]);
+		else if (std::string(args[i]) == "--output_dir" && i + 1 < args.Count)
+			options.outputDirectory = std::string(args[i + 1]);
+		else if (std::string(args[i]) == "--config_file" && i + 1 < args.Count)
+			options.configFilePath = std::string(args[i + 1]);
+		else if (std::string(args[i]) == "--workers" && i + 1 < args.Count)
+			options.workerCount = std::stoul(args[i + 1]);
+		else if (std::string(args[i]) == "--scaling_report")
+			options.scalingReport = true;
+		else if (std::string(args[i]) == "--continuous")
+			options.continuous = true;
+		else if (std::string(args[i]) == "--recursive")
+			options.input.Recursive = true;
+		else if (std::string(args[i]) == "--include" && i + 1 < args.Count)
+			InputEnumeratorSpecification::AppendPatterns(args[i + 1], options.input.Include);
+		else if (std::string(args[i]) == "--exclude" && i + 1 < args.Count)
+			InputEnumeratorSpecification::AppendPatterns(args[i + 1], options.input.Exclude);
+		else if (std::string(args[i]) == "--manifest" && i + 1 < args.Count)
+			options.input.ManifestPath = std::string(args[i + 1]);
+		else if (std::string(args[i]) == "--input_tar" && i + 1 < args.Count)
+			options.input.ArchivePath = std::string(args[i + 1]);
+		else if (std::string(args[i]) == "--output_tar" && i + 1 < args.Count)
+			options.outputArchive = std::string(args[i + 1]);
+		else if (std::string(args[i]) == "--readers" && i + 1 < args.Count)
+			options.input.ReaderCount = std::stoul(args[i + 1]);
+		else if (std::string(args[i]) == "--write_threads" && i + 1 < args.Count)
+			options.output.ThreadCount = std::stoul(args[i + 1]);
+		else if (std::string(args[i]) == "--direct_io")
+			options.output.DirectIO = true;
+		else if (std::string(args[i]) == "--sync_every" && i + 1 < args.Count)
+			options.output.SyncInterval = std::stoul(args[i + 1]);
+		else if (std::string(args[i]) == "--variants" && i + 1 < args.Count)
+			options.variantsFileName = std::string(args[i + 1]);
+		else if (std::string(args[i]) == "--backend" && i + 1 < args.Count)
 		{
-			if (std::string(spec.CommandLineArgs[i]) == "--headless")
-				mode = Mode::Headless;
-			else if (std::string(spec.CommandLineArgs[i]) == "--editor")
-				mode = Mode::Editor;
-			else if (std::string(spec.CommandLineArgs[i]) == "--input_dir" && i + 1 < spec.CommandLineArgs.Count)
-				inputDirectory = std::string(spec.CommandLineArgs[i + 1]);
-			else if (std::string(spec.CommandLineArgs[i]) == "--output_dir" && i + 1 < spec.CommandLineArgs.Count)
-				outputDirectory = std::string(spec.CommandLineArgs[i + 1]);
-			else if (std::string(spec.CommandLineArgs[i]) == "--config_file" && i + 1 < spec.CommandLineArgs.Count)
-				configFilePath = std::string(spec.CommandLineArgs[i + 1]);
+			std::string backend = args[i + 1];
+			YGG_ASSERT(backend == "gpu" || backend == "cpu", "--backend must be gpu or cpu, got '{}'.", backend);
+			options.cpuBackend = backend == "cpu";
 		}
+		else if (std::string(args[i]) == "--cpu_threads" && i + 1 < args.Count)
+			options.cpu.ThreadCount = std::stoul(args[i + 1]);
+		else if (std::string(args[i]) == "--cpu_isa" && i + 1 < args.Count)
+		{
+			std::string isa = args[i + 1];
+			YGG_ASSERT(isa == "avx2" || isa == "baseline", "--cpu_isa must be avx2 or baseline, got '{}'.", isa);
+			options.cpu.InstructionSet = isa == "avx2" ? CpuInstructionSet::AVX2 : CpuInstructionSet::Baseline;
+		}
+		else if (std::string(args[i]) == "--cpu_schedule" && i + 1 < args.Count)
+		{
+			std::string schedule = args[i + 1];
+			YGG_ASSERT(schedule == "strips" || schedule == "frames", "--cpu_schedule must be strips or frames, got '{}'.", schedule);
+			options.cpu.Schedule = schedule == "strips" ? CpuSchedule::Strips : CpuSchedule::Frames;
+		}
+		else if (std::string(args[i]) == "--settings_snapshot" && i + 1 < args.Count)
+			ImagePipeline::SetSettingsSnapshotFileName(args[i + 1]);
+		else if (std::string(args[i]) == "--stream" && i + 1 < args.Count)
+		{
+			options.mode = EditorMode::Stream;
+			options.streamSize = std::string(args[i + 1]);
+		}
+		else if (std::string(args[i]) == "--pix_fmt" && i + 1 < args.Count)
+			options.pixelFormat = std::string(args[i + 1]);
+		else if (std::string(args[i]) == "--daemon" && i + 1 < args.Count)
+		{
+			options.mode = EditorMode::Daemon;
+			options.socketPath = std::string(args[i + 1]);
+		}
+	}
+
+	YGG_ASSERT(!options.cpuBackend || options.mode == EditorMode::Headless, "--backend cpu is only available with --headless.");
+	options.input.Root = options.inputDirectory;
+	return options;
+}
 
-		switch (mode)
+class EditorApplication : public askygg::Application
+{
+public:
+	EditorApplication(const askygg::ApplicationSpecification& spec, const EditorOptions& options)
+		: askygg::Application(spec)
+	{
+		switch (options.mode)
 		{
-			case Mode::Headless:
+			case EditorMode::Headless:
 				YGG_LOG_INFO("Running in headless mode!");
-				PushLayer(new HeadlessLayer(inputDirectory, outputDirectory, configFilePath));
+				PushLayer(new HeadlessLayer(options.input, options.outputDirectory, options.configFilePath,
+					options.workerCount, options.scalingReport, options.outputArchive, options.output,
+					options.variantsFileName));
 				break;
-			case Mode::Editor:
+			case EditorMode::Editor:
 				YGG_LOG_INFO("Running in editor mode!");
-				PushLayer(new EditorLayer(inputDirectory, outputDirectory, configFilePath));
+				PushLayer(new EditorLayer(options.inputDirectory, options.outputDirectory, options.configFilePath,
+					!options.continuous));
+				break;
+			case EditorMode::Stream:
+			{
+				FrameStreamSpecification streamSpec;
+				bool validSize = FrameStreamSpecification::ParseFrameSize(options.streamSize, streamSpec.Width, streamSpec.Height);
+				YGG_ASSERT(validSize, "--stream expects a frame size like 1920x1080, got '{}'.", options.streamSize);
+				bool validFormat = FrameStreamSpecification::ParsePixelFormat(options.pixelFormat, streamSpec.PixelFormat);
+				YGG_ASSERT(validFormat, "--pix_fmt must be rgba, rgb24 or rgba64le, got '{}'.", options.pixelFormat);
+				YGG_LOG_INFO("Running in stream mode!");
+				PushLayer(new StreamLayer(streamSpec, options.configFilePath));
+				break;
+			}
+			case EditorMode::Daemon:
+#ifdef YGG_JOB_DAEMON
+				YGG_LOG_INFO("Running in daemon mode!");
+				PushLayer(new DaemonLayer(options.socketPath, options.outputDirectory, options.configFilePath));
+#else
+				YGG_ASSERT(false, "--daemon needs Unix domain sockets and is not available on this platform.");
+#endif
 				break;
 			default:
-				YGG_ASSERT(false, "Please specify a valid mode! (--headless or --editor)");
+				YGG_ASSERT(false, "Please specify a valid mode! (--headless, --editor, --stream WxH or --daemon SOCKET)");
 		}
 	}
 
@@ -55,8 +172,29 @@ public:
 
 askygg::Application* askygg::CreateApplication(ApplicationCommandLineArgs args)
 {
+	// Stream mode and a tar written to stdout own stdout, so everything logged from here on (including context
+	// creation) goes to stderr.
+	for (int i = 0; i < args.Count; i++)
+	{
+		if (std::string(args[i]) == "--stream"
+			|| (std::string(args[i]) == "--output_tar" && i + 1 < args.Count && std::string(args[i + 1]) == "-"))
+			askygg::Log::RedirectConsoleToStderr();
+	}
+
+	EditorOptions options = EditorOptions::Parse(args);
+
+	// The CPU backend runs before any Application exists: no window, no GL context and no ImGui are created.
+	if (options.mode == EditorMode::Headless && options.cpuBackend)
+	{
+		YGG_LOG_INFO("Running in headless mode on the CPU!");
+		HeadlessLayer(options.input, options.outputDirectory, options.configFilePath, options.workerCount,
+			options.scalingReport, options.outputArchive, options.output, options.variantsFileName, &options.cpu)
+			.Run();
+		return nullptr;
+	}
+
 	ApplicationSpecification spec;
 	spec.Name = "Askygg Image Editor";
 	spec.CommandLineArgs = args;
-	return new EditorApplication(spec);
-}
\ No newline at end of file
+	return new EditorApplication(spec, options);
+}
@@ -0,0 +1,141 @@
+#include "BatchCapture.h"
+
+#include "ImagePipeline.h"
+
+#include "askygg/core/Log.h"
+#include "askygg/renderer/PixelBuffer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+
+// Rendered images waiting for an encoder; each one is a whole RGBA8 output.
+static constexpr size_t EncodeQueueCapacity = 4;
+
+BatchCapture::BatchCapture(BatchCaptureSpecification specification)
+	: m_Specification(std::move(specification)), m_Writer(askygg::CreateScope<OutputWriter>(m_Specification.Output)),
+	  m_EncodeRequests(EncodeQueueCapacity), m_Start(Clock::now())
+{
+	const uint32_t encoderCount = std::max(m_Specification.EncoderThreadCount, 1u);
+	for (uint32_t i = 0; i < encoderCount; i++)
+		m_Encoders.emplace_back(&BatchCapture::Encode, this);
+	m_Renderer = std::thread(&BatchCapture::Render, this);
+}
+
+BatchCapture::~BatchCapture()
+{
+	Cancel();
+	m_Renderer.join();
+}
+
+double BatchCapture::GetElapsedSeconds() const
+{
+	if (m_Finished)
+		return m_FinishNanoseconds * 1e-9;
+	return std::chrono::duration<double>(Clock::now() - m_Start).count();
+}
+
+double BatchCapture::GetRemainingSeconds() const
+{
+	const uint32_t done = m_CompletedCount + m_FailedCount;
+	if (done == 0)
+		return -1.0;
+	return GetElapsedSeconds() / done * (GetImageCount() - std::min(done, GetImageCount()));
+}
+
+void BatchCapture::Render()
+{
+	m_Specification.Context->MakeCurrent();
+	{
+		ImagePipeline pipeline(m_Specification.SettingsFileName);
+		pipeline.Initialize(true);
+		pipeline.ApplySettings(m_Specification.Settings);
+
+		// Two of each, so the readback of image n overlaps rendering image n + 1.
+		std::array<askygg::Scope<askygg::PixelPackBuffer>, 2> readbacks;
+		std::array<EncodeRequest, 2>						   inFlight;
+
+		// Hands a finished readback to the encoders, flipped to top row first on the way.
+		auto drain = [&](uint32_t slot)
+		{
+			EncodeRequest& request = inFlight[slot];
+			const size_t   rowSize = (size_t)request.Width * 4;
+			request.Pixels.resize(rowSize * request.Height);
+			const auto* pixels = static_cast<const uint8_t*>(readbacks[slot]->Map());
+			for (uint32_t y = 0; y < request.Height; y++)
+				std::memcpy(request.Pixels.data() + y * rowSize, pixels + (request.Height - 1 - y) * rowSize, rowSize);
+			readbacks[slot]->Unmap();
+			m_EncodeRequests.Push(std::move(request));
+		};
+
+		uint32_t submitted = 0;
+		for (const std::string& path : m_Specification.InputPaths)
+		{
+			if (m_Cancelled)
+				break;
+			if (!askygg::Texture2D::IsLoadable(path))
+			{
+				YGG_LOG_WARN("Skipping '{}': not a readable image.", path);
+				m_FailedCount++;
+				continue;
+			}
+
+			askygg::Texture2D input(path, m_Specification.InputSpecification);
+			pipeline.Submit({ input.GetWidth(), input.GetHeight() }, input.GetID(), askygg::RenderGraphAccess::Readback,
+				false);
+
+			const uint32_t slot = submitted % 2;
+			const uint64_t outputSize = (uint64_t)input.GetWidth() * input.GetHeight() * 4;
+			if (!readbacks[slot] || readbacks[slot]->GetSize() < outputSize)
+				readbacks[slot] = askygg::CreateScope<askygg::PixelPackBuffer>(outputSize);
+			readbacks[slot]->ReadTexture(*pipeline.GetOutputTexture(), askygg::ImageUtils::ImageDataLayout::RGBA,
+				askygg::ImageUtils::ImageDataType::UByte);
+			// Named like ImagePipeline::Save() names its files.
+			inFlight[slot].Path = m_Specification.OutputDirectory + std::filesystem::path(path).stem().string() + ".jpeg";
+			inFlight[slot].Width = input.GetWidth();
+			inFlight[slot].Height = input.GetHeight();
+
+			if (submitted++ > 0)
+				drain(1 - slot);
+		}
+		if (submitted > 0 && readbacks[(submitted - 1) % 2]->IsPending())
+			drain((submitted - 1) % 2);
+	}
+	m_Specification.Context->DetachCurrent();
+
+	m_EncodeRequests.Close();
+	for (auto& encoder : m_Encoders)
+		encoder.join();
+	m_Writer->Flush();
+
+	m_FinishNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_Start).count();
+	m_Finished = true;
+	if (m_Specification.OnProgress)
+		m_Specification.OnProgress();
+}
+
+void BatchCapture::Encode()
+{
+	EncodeRequest request;
+	while (m_EncodeRequests.Pop(request))
+	{
+		// Drained without encoding, so the renderer is never left blocked on a full queue.
+		if (m_Cancelled)
+			continue;
+
+		std::vector<uint8_t> encoded;
+		if (askygg::Texture2D::EncodeJPEG(request.Pixels.data(), request.Width, request.Height, encoded))
+		{
+			m_Writer->Write(std::move(request.Path), std::move(encoded));
+			m_CompletedCount++;
+		}
+		else
+		{
+			YGG_LOG_ERROR("Encoding '{}' failed.", request.Path);
+			m_FailedCount++;
+		}
+		if (m_Specification.OnProgress)
+			m_Specification.OnProgress();
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "askygg/core/BlockingQueue.h"
+#include "askygg/core/Memory.h"
+#include "askygg/renderer/GraphicsContext.h"
+#include "askygg/renderer/Texture.h"
+
+#include "OutputWriter.h"
+
+#include <yaml-cpp/yaml.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct BatchCaptureSpecification
+{
+	std::vector<std::string>	   InputPaths;
+	// Wrapping and filtering of the decoded inputs, as the editor loads them.
+	askygg::Texture2DSpecification InputSpecification;
+	// Outputs are named like ImagePipeline::Save() names them.
+	std::string				 OutputDirectory;
+	// The pipeline reads its defaults from this file and then takes Settings (ImagePipeline::ExportSettings()).
+	std::string				 SettingsFileName;
+	YAML::Node				 Settings;
+	// Shares objects with the main context; made current on the capture thread, so it must not be current elsewhere.
+	askygg::Ref<askygg::GraphicsContext> Context;
+	uint32_t							 EncoderThreadCount = 2;
+	OutputWriterSpecification			 Output;
+	// Called from a capture thread after each image and once the batch is finished.
+	std::function<void()>				 OnProgress;
+};
+
+// Renders a batch of images to JPEG files in the background, so the thread that started it stays responsive.  One
+// thread owns a complete pipeline on the shared context; its outputs come back through double-buffered pixel pack
+// buffers while the next image renders, and are encoded and written on separate threads.
+class BatchCapture
+{
+public:
+	explicit BatchCapture(BatchCaptureSpecification specification);
+	// Cancels what is left and waits for the threads.
+	~BatchCapture();
+
+	BatchCapture(const BatchCapture&) = delete;
+	BatchCapture& operator=(const BatchCapture&) = delete;
+
+	// Stops after the image being rendered.  Outputs already encoded are still written.
+	void Cancel() { m_Cancelled = true; }
+	bool IsCancelled() const { return m_Cancelled; }
+	// True once every output is written, or the batch was cancelled and the threads are done.
+	bool IsFinished() const { return m_Finished; }
+
+	uint32_t GetImageCount() const { return (uint32_t)m_Specification.InputPaths.size(); }
+	// Outputs handed to the writer.
+	uint32_t GetCompletedCount() const { return m_CompletedCount; }
+	uint32_t GetFailedCount() const { return m_FailedCount; }
+	double	 GetElapsedSeconds() const;
+	// Seconds left at the rate so far; negative before the first image is done.
+	double	 GetRemainingSeconds() const;
+
+private:
+	struct EncodeRequest
+	{
+		std::string			 Path;
+		uint32_t			 Width = 0, Height = 0;
+		// RGBA8, top row first.
+		std::vector<uint8_t> Pixels;
+	};
+
+	void Render();
+	void Encode();
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	BatchCaptureSpecification		   m_Specification;
+	askygg::Scope<OutputWriter>		   m_Writer;
+	// Bounded: every waiting request holds a whole image.
+	askygg::BlockingQueue<EncodeRequest> m_EncodeRequests;
+	std::vector<std::thread>		   m_Encoders;
+	std::thread						   m_Renderer;
+
+	std::atomic<bool>	  m_Cancelled = false;
+	std::atomic<bool>	  m_Finished = false;
+	std::atomic<uint32_t> m_CompletedCount = 0;
+	std::atomic<uint32_t> m_FailedCount = 0;
+	Clock::time_point	  m_Start;
+	std::atomic<int64_t>  m_FinishNanoseconds = 0;
+};
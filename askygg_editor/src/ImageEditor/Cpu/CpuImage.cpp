@@ -0,0 +1,59 @@
+#include "CpuImage.h"
+
+#include <stbi/stb_image.h>
+
+#include <cstring>
+#include <filesystem>
+
+namespace
+{
+	// Takes over what stb_image returned; rows are already flipped.
+	bool Adopt(void* pixels, bool hdr, int width, int height, CpuInputImage& image)
+	{
+		if (!pixels)
+			return false;
+
+		const size_t count = (size_t)width * height * 4;
+		image.Width = (uint32_t)width;
+		image.Height = (uint32_t)height;
+		image.Bytes.clear();
+		image.Floats.clear();
+		if (hdr)
+		{
+			image.Floats.resize(count);
+			std::memcpy(image.Floats.data(), pixels, count * sizeof(float));
+		}
+		else
+		{
+			image.Bytes.resize(count);
+			std::memcpy(image.Bytes.data(), pixels, count);
+		}
+		stbi_image_free(pixels);
+		return true;
+	}
+}
+
+bool CpuInputImage::DecodeFile(const std::string& filePath, CpuInputImage& image)
+{
+	stbi_set_flip_vertically_on_load_thread(1);
+	int		   width, height, channels;
+	const bool hdr = stbi_is_hdr(filePath.c_str());
+	void*	   pixels = hdr ? (void*)stbi_loadf(filePath.c_str(), &width, &height, &channels, 4)
+							: (void*)stbi_load(filePath.c_str(), &width, &height, &channels, 4);
+	image.Name = std::filesystem::path(filePath).filename().string();
+	return Adopt(pixels, hdr, width, height, image);
+}
+
+bool CpuInputImage::DecodeMemory(const std::string& name, const void* encoded, size_t size, CpuInputImage& image)
+{
+	const auto* bytes = static_cast<const stbi_uc*>(encoded);
+	const int	length = (int)size;
+
+	stbi_set_flip_vertically_on_load_thread(1);
+	int		   width, height, channels;
+	const bool hdr = stbi_is_hdr_from_memory(bytes, length);
+	void*	   pixels = hdr ? (void*)stbi_loadf_from_memory(bytes, length, &width, &height, &channels, 4)
+							: (void*)stbi_load_from_memory(bytes, length, &width, &height, &channels, 4);
+	image.Name = name;
+	return Adopt(pixels, hdr, width, height, image);
+}
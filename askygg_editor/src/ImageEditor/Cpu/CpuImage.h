@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CpuKernels.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Tightly packed RGBA32F pixels, bottom row first like the GL textures the GPU passes work on, so texture coordinates
+// mean the same thing on both backends.
+struct CpuImage
+{
+	uint32_t		   Width = 0;
+	uint32_t		   Height = 0;
+	std::vector<float> Pixels;
+
+	// Keeps the allocation when the size does not grow; the contents are undefined afterwards.
+	void Resize(uint32_t width, uint32_t height)
+	{
+		Width = width;
+		Height = height;
+		Pixels.resize((size_t)width * height * 4);
+	}
+
+	float*		 GetRow(uint32_t y) { return Pixels.data() + (size_t)y * Width * 4; }
+	const float* GetRow(uint32_t y) const { return Pixels.data() + (size_t)y * Width * 4; }
+	uint64_t	 GetMemorySize() const { return Pixels.capacity() * sizeof(float); }
+
+	CpuImageView   GetView() const { return { Pixels.data(), Width, Height }; }
+	CpuImageTarget GetTarget() { return { Pixels.data(), Width, Height }; }
+	// This image as rows firstRow onwards of one imageHeight tall: a line buffer.
+	CpuImageView   GetBandView(uint32_t firstRow, uint32_t imageHeight) const
+	{
+		return { Pixels.data(), Width, imageHeight, firstRow };
+	}
+	CpuImageTarget GetBandTarget(uint32_t firstRow, uint32_t imageHeight)
+	{
+		return { Pixels.data(), Width, imageHeight, firstRow };
+	}
+};
+
+// An image as decoded from its file, before Linearize: RGBA8, or RGBA32F for HDR formats.  Rows are flipped to
+// bottom first, as Texture2D uploads them.
+struct CpuInputImage
+{
+	std::string			 Name;
+	uint32_t			 Width = 0;
+	uint32_t			 Height = 0;
+	std::vector<uint8_t> Bytes;
+	std::vector<float>	 Floats;
+
+	bool IsHDR() const { return !Floats.empty(); }
+
+	// False if the file or buffer is not an image stb_image reads.
+	static bool DecodeFile(const std::string& filePath, CpuInputImage& image);
+	static bool DecodeMemory(const std::string& name, const void* encoded, size_t size, CpuInputImage& image);
+};
@@ -0,0 +1,50 @@
+#include "CpuKernels.h"
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+namespace baseline
+{
+	const CpuKernelTable& GetKernelTable();
+}
+
+#if defined(YGG_CPU_AVX2)
+namespace avx2
+{
+	const CpuKernelTable& GetKernelTable();
+}
+#endif
+
+namespace
+{
+#if defined(YGG_CPU_AVX2)
+	bool SupportsAVX2()
+	{
+	#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 1);
+		const bool fma = info[2] & (1 << 12), osxsave = info[2] & (1 << 27), avx = info[2] & (1 << 28);
+		// The OS has to save the YMM registers too.
+		if (!fma || !osxsave || !avx || (_xgetbv(0) & 6) != 6)
+			return false;
+		__cpuidex(info, 7, 0);
+		return info[1] & (1 << 5);
+	#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	#endif
+	}
+#endif
+}
+
+const CpuKernelTable& GetCpuKernels(CpuInstructionSet maximum)
+{
+#if defined(YGG_CPU_AVX2)
+	static const bool avx2 = SupportsAVX2();
+	if (avx2 && maximum == CpuInstructionSet::AVX2)
+		return avx2::GetKernelTable();
+#endif
+	(void)maximum;
+	return baseline::GetKernelTable();
+}
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <cstdint>
+
+// The CPU backend's kernels, one per GPU dispatch, each a C++ transcription of its shader.  They are compiled once per
+// instruction set (CpuKernelsAVX2.cpp, CpuKernelsBaseline.cpp) and picked at runtime by GetCpuKernels().  Every kernel
+// computes the output rows [rowBegin, rowEnd), so row tiles can run on any thread.  Images are RGBA32F, bottom row
+// first.  Only plain data crosses this header: the AVX2 unit must not instantiate anything it shares with the rest of
+// the program.
+
+// Width and Height are the whole image's; Pixels may hold only a band of its rows, from FirstRow on, as the strip
+// schedule's line buffers do.  Kernels address rows in image coordinates either way.
+struct CpuImageView
+{
+	const float* Pixels = nullptr;
+	uint32_t	 Width = 0;
+	uint32_t	 Height = 0;
+	uint32_t	 FirstRow = 0;
+};
+
+struct CpuImageTarget
+{
+	float*	 Pixels = nullptr;
+	uint32_t Width = 0;
+	uint32_t Height = 0;
+	uint32_t FirstRow = 0;
+};
+
+struct CpuLinearizeParameters
+{
+	// RGBA8 through Table (256 entries of pow(i / 255, 2.2)), or RGBA32F when Bytes is null.
+	const uint8_t* Bytes = nullptr;
+	const float*   Floats = nullptr;
+	const float*   Table = nullptr;
+	CpuImageTarget Output;
+};
+
+struct CpuContrastBrightnessParameters
+{
+	CpuImageView   Input;
+	CpuImageTarget Output;
+	float		   Contrast = 1.0f;
+	float		   Brightness = 0.0f;
+};
+
+struct CpuHueShiftParameters
+{
+	CpuImageView   Input;
+	CpuImageTarget Output;
+	float		   HueShift = 0.0f;
+	float		   SaturationBoost = 0.0f;
+	float		   ValueBoost = 0.0f;
+};
+
+// Passes whose every output pixel depends on the same input pixel alone, which a pointwise run can chain.
+enum class CpuPointwiseOpType : uint8_t
+{
+	ContrastBrightness,
+	HueShift
+};
+
+// One pass of a pointwise run: its type and the settings of that type.  Input and Output of these go unused.
+struct CpuPointwiseOp
+{
+	CpuPointwiseOpType				Type = CpuPointwiseOpType::ContrastBrightness;
+	CpuContrastBrightnessParameters ContrastBrightness;
+	CpuHueShiftParameters			HueShift;
+};
+
+// Consecutive pointwise passes applied to each pixel in turn, with one load and store per pixel for all of them.
+struct CpuPointwiseParameters
+{
+	static constexpr uint32_t MaxOpCount = 8;
+
+	CpuImageView   Input;
+	CpuImageTarget Output;
+	CpuPointwiseOp Ops[MaxOpCount];
+	uint32_t	   OpCount = 0;
+};
+
+struct CpuSobelParameters
+{
+	CpuImageView   Input;
+	CpuImageTarget Output;
+	float		   Strength = 0.0f;
+	float		   Threshold = 0.0f;
+	float		   KernelScale = 1.0f;
+};
+
+struct CpuSharpenParameters
+{
+	CpuImageView   Input;
+	CpuImageTarget Output;
+	float		   Strength = 0.0f;
+	float		   KernelScale = 1.0f;
+};
+
+struct CpuRadialBlurParameters
+{
+	CpuImageView   Input;
+	CpuImageTarget Output;
+	float		   Strength = 0.0f;
+	float		   DirectionX = 0.0f;
+	float		   DirectionY = 0.0f;
+	int32_t		   Samples = 0;
+};
+
+struct CpuChromaticAberrationParameters
+{
+	CpuImageView   Input;
+	CpuImageTarget Output;
+	float		   Strength = 0.0f;
+};
+
+struct CpuBarrelDistortionParameters
+{
+	CpuImageView   Input;
+	CpuImageTarget Output;
+	float		   DistortionX = 0.0f;
+	float		   DistortionY = 0.0f;
+};
+
+struct CpuVignetteParameters
+{
+	CpuImageView   Input;
+	CpuImageTarget Output;
+	float		   Radius = 0.75f;
+	float		   Softness = 0.45f;
+};
+
+struct CpuRadialBloomParameters
+{
+	CpuImageView   Input;
+	CpuImageTarget Output;
+	float		   LuminanceThreshold = 1.0f;
+	float		   Amplitude = 1.0f;
+	float		   SigmaScaleFactor = 3.0f;
+	float		   BlurColorWeight = 0.5f;
+	int32_t		   RadiusPixels = 1;
+	// RadialBloomBlur: GaussianFn() of taps -RadiusPixels to RadiusPixels.
+	const float*   Weights = nullptr;
+	bool		   Vertical = false;
+};
+
+// MultiPassBloom.glsl's prefilter and downsample modes: a 13-tap box filter from Input, at Output's resolution.
+struct CpuBloomDownsampleParameters
+{
+	CpuImageView   Input;
+	CpuImageTarget Output;
+	bool		   Prefilter = false;
+	float		   Threshold = 0.0f;
+	float		   Knee = 0.0f;
+};
+
+// MultiPassBloom.glsl's upsample modes: Existing (Output's size) plus the tent-filtered smaller level Lower.
+struct CpuBloomUpsampleParameters
+{
+	CpuImageView   Existing;
+	CpuImageView   Lower;
+	CpuImageTarget Output;
+	float		   Radius = 1.0f;
+	float		   TightenFactor = 16.0f;
+};
+
+struct CpuCompositeParameters
+{
+	CpuImageView Input;
+	// 0 none, 1 radial (Input's size), 2 multi-pass (level 0 of the upsampled chain).
+	int32_t		 BloomType = 0;
+	CpuImageView Bloom;
+	CpuImageView BloomDirt;
+	CpuImageView SensorNoise;
+	float		 BloomIntensity = 1.0f;
+	float		 BloomDirtIntensity = 0.0f;
+	float		 UpsampleRadius = 1.0f;
+	float		 UpsampleTightenFactor = 16.0f;
+	float		 Exposure = 1.0f;
+	int32_t		 Tonemapper = 0;
+	float		 WhitePoint = 1.0f;
+	float		 NoiseAlpha = 1.0f;
+	float		 NoiseBeta = 1.0f;
+	float		 NoiseGamma = 0.0f;
+	float		 NoiseAmplitude = 1.0f;
+	// hash21(time * frequency), the frame's offset into the noise patch.
+	float		 NoiseOffsetX = 0.0f;
+	float		 NoiseOffsetY = 0.0f;
+	// RGBA8, Input's size, top row first as encoders expect it.
+	uint8_t*	 Output = nullptr;
+};
+
+struct CpuKernelTable
+{
+	const char* Name = "";
+	uint32_t	LaneCount = 1;
+
+	void (*Linearize)(const CpuLinearizeParameters& parameters, uint32_t rowBegin, uint32_t rowEnd) = nullptr;
+	void (*ContrastBrightness)(const CpuContrastBrightnessParameters& parameters, uint32_t rowBegin,
+		uint32_t rowEnd) = nullptr;
+	void (*HueShift)(const CpuHueShiftParameters& parameters, uint32_t rowBegin, uint32_t rowEnd) = nullptr;
+	void (*Pointwise)(const CpuPointwiseParameters& parameters, uint32_t rowBegin, uint32_t rowEnd) = nullptr;
+	void (*Sobel)(const CpuSobelParameters& parameters, uint32_t rowBegin, uint32_t rowEnd) = nullptr;
+	void (*Sharpen)(const CpuSharpenParameters& parameters, uint32_t rowBegin, uint32_t rowEnd) = nullptr;
+	void (*RadialBlur)(const CpuRadialBlurParameters& parameters, uint32_t rowBegin, uint32_t rowEnd) = nullptr;
+	void (*ChromaticAberration)(const CpuChromaticAberrationParameters& parameters, uint32_t rowBegin,
+		uint32_t rowEnd) = nullptr;
+	void (*BarrelDistortion)(const CpuBarrelDistortionParameters& parameters, uint32_t rowBegin,
+		uint32_t rowEnd) = nullptr;
+	void (*Vignette)(const CpuVignetteParameters& parameters, uint32_t rowBegin, uint32_t rowEnd) = nullptr;
+	void (*RadialBloomExtract)(const CpuRadialBloomParameters& parameters, uint32_t rowBegin, uint32_t rowEnd) = nullptr;
+	void (*RadialBloomBlur)(const CpuRadialBloomParameters& parameters, uint32_t rowBegin, uint32_t rowEnd) = nullptr;
+	void (*BloomDownsample)(const CpuBloomDownsampleParameters& parameters, uint32_t rowBegin,
+		uint32_t rowEnd) = nullptr;
+	void (*BloomUpsample)(const CpuBloomUpsampleParameters& parameters, uint32_t rowBegin, uint32_t rowEnd) = nullptr;
+	void (*Composite)(const CpuCompositeParameters& parameters, uint32_t rowBegin, uint32_t rowEnd) = nullptr;
+};
+
+enum class CpuInstructionSet
+{
+	// SSE2 on x86-64, plain scalar code elsewhere.
+	Baseline,
+	AVX2
+};
+
+// The widest kernels this CPU runs, but no wider than maximum.  AVX2 needs AVX2 and FMA.
+const CpuKernelTable& GetCpuKernels(CpuInstructionSet maximum = CpuInstructionSet::AVX2);
@@ -0,0 +1,858 @@
+// The bodies of the CPU kernels, included by CpuKernelsBaseline.cpp and CpuKernelsAVX2.cpp with YGG_CPU_ISA naming the
+// instruction set.  Each kernel is the shader of the same name over Lanes::Count pixels at a time, with the shader's
+// arithmetic in the shader's order.  Only CpuKernels.h and CpuSimd.h may be included here; see CpuKernels.h.
+
+#include "CpuKernels.h"
+#include "CpuSimd.h"
+
+namespace YGG_CPU_ISA
+{
+	namespace
+	{
+		inline int32_t ClampIndex(int32_t i, int32_t size) { return i < 0 ? 0 : (i >= size ? size - 1 : i); }
+		inline int32_t WrapIndex(int32_t i, int32_t size)
+		{
+			i %= size;
+			return i < 0 ? i + size : i;
+		}
+		// NaN comes out as low.
+		inline float ClampCoordinate(float x, float low, float high) { return x > low ? (x < high ? x : high) : low; }
+		inline uint32_t GroupSize(uint32_t x, uint32_t width)
+		{
+			return width - x < Lanes::Count ? width - x : Lanes::Count;
+		}
+
+		inline const float* Row(const CpuImageView& image, int32_t y)
+		{
+			return image.Pixels + (size_t)(y - (int32_t)image.FirstRow) * image.Width * 4;
+		}
+		inline float* Row(const CpuImageTarget& image, uint32_t y)
+		{
+			return image.Pixels + (size_t)(y - image.FirstRow) * image.Width * 4;
+		}
+		inline Lanes Column(uint32_t x) { return Lanes((float)x) + Lanes::Sequence(); }
+
+		// texture() with linear filtering from level 0, for coordinates that differ from pixel to pixel: texel centres on
+		// half-integers, the four nearest weighted by distance, ClampToEdge or Repeat wrapping.  Only the texel
+		// addresses are worked out per lane.
+		Pixels Sample(const CpuImageView& image, Lanes u, Lanes v, uint32_t count, bool repeat = false)
+		{
+			const int32_t width = (int32_t)image.Width, height = (int32_t)image.Height;
+			if (repeat)
+			{
+				u = Fract(u);
+				v = Fract(v);
+			}
+			// Beyond one texel out every coordinate lands on the edge, which keeps the conversions below defined.  NaN
+			// lanes come out of Max() as the low end.
+			const Lanes x = Clamp(u * Lanes((float)width) - Lanes(0.5f), Lanes(-1.0f), Lanes((float)width));
+			const Lanes y = Clamp(v * Lanes((float)height) - Lanes(0.5f), Lanes(-1.0f), Lanes((float)height));
+			const Lanes fx = Floor(x), fy = Floor(y);
+			const Lanes ax = x - fx, ay = y - fy;
+
+			alignas(32) float columns[Lanes::Count], rows[Lanes::Count];
+			alignas(32) float texels[4][Lanes::Count * 4];
+			fx.Store(columns);
+			fy.Store(rows);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				int32_t x0 = (int32_t)columns[i], y0 = (int32_t)rows[i], x1 = x0 + 1, y1 = y0 + 1;
+				if (repeat)
+				{
+					x0 = WrapIndex(x0, width);
+					x1 = WrapIndex(x1, width);
+					y0 = WrapIndex(y0, height);
+					y1 = WrapIndex(y1, height);
+				}
+				else
+				{
+					x0 = ClampIndex(x0, width);
+					x1 = ClampIndex(x1, width);
+					y0 = ClampIndex(y0, height);
+					y1 = ClampIndex(y1, height);
+				}
+				std::memcpy(texels[0] + i * 4, Row(image, y0) + x0 * 4, 4 * sizeof(float));
+				std::memcpy(texels[1] + i * 4, Row(image, y0) + x1 * 4, 4 * sizeof(float));
+				std::memcpy(texels[2] + i * 4, Row(image, y1) + x0 * 4, 4 * sizeof(float));
+				std::memcpy(texels[3] + i * 4, Row(image, y1) + x1 * 4, 4 * sizeof(float));
+			}
+
+			const Lanes one = 1.0f;
+			return LoadPixels(texels[0], count) * ((one - ax) * (one - ay)) + LoadPixels(texels[1], count) * (ax * (one - ay)) +
+				LoadPixels(texels[2], count) * ((one - ax) * ay) + LoadPixels(texels[3], count) * (ax * ay);
+		}
+
+		// Texels x to x + count - 1 of row y, coordinates clamped to the edge.
+		Pixels Fetch(const CpuImageView& image, int32_t x, int32_t y, uint32_t count)
+		{
+			const float* row = Row(image, ClampIndex(y, (int32_t)image.Height));
+			if (x >= 0 && x + (int32_t)count <= (int32_t)image.Width)
+				return LoadPixels(row + (size_t)x * 4, count);
+
+			alignas(32) float texels[Lanes::Count * 4];
+			for (uint32_t i = 0; i < count; i++)
+				std::memcpy(texels + i * 4, row + ClampIndex(x + (int32_t)i, (int32_t)image.Width) * 4, 4 * sizeof(float));
+			return LoadPixels(texels, count);
+		}
+
+		// As Fetch(), but zero outside the image like imageLoad().
+		Pixels Load(const CpuImageView& image, int32_t x, int32_t y, uint32_t count)
+		{
+			if (y < 0 || y >= (int32_t)image.Height)
+				return { 0.0f, 0.0f, 0.0f, 0.0f };
+			const float* row = Row(image, y);
+			if (x >= 0 && x + (int32_t)count <= (int32_t)image.Width)
+				return LoadPixels(row + (size_t)x * 4, count);
+
+			alignas(32) float texels[Lanes::Count * 4] = {};
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const int32_t column = x + (int32_t)i;
+				if (column >= 0 && column < (int32_t)image.Width)
+					std::memcpy(texels + i * 4, row + column * 4, 4 * sizeof(float));
+			}
+			return LoadPixels(texels, count);
+		}
+
+		// Bilinear filtering at one sub-texel offset shared by every pixel of the group: between texels (x, y) and
+		// (x + 1, y + 1), weighted ax and ay.  Offsets from the pixel centre are the same across an image, so the
+		// shaders' texture() calls at texCoords + offset come down to this.
+		Pixels FetchBilinear(const CpuImageView& image, int32_t x, int32_t y, float ax, float ay, uint32_t count)
+		{
+			const Pixels t00 = Fetch(image, x, y, count), t10 = Fetch(image, x + 1, y, count);
+			if (ay == 0.0f)
+				return t00 * Lanes(1.0f - ax) + t10 * Lanes(ax);
+			const Pixels t01 = Fetch(image, x, y + 1, count), t11 = Fetch(image, x + 1, y + 1, count);
+			return t00 * Lanes((1.0f - ax) * (1.0f - ay)) + t10 * Lanes(ax * (1.0f - ay)) +
+				t01 * Lanes((1.0f - ax) * ay) + t11 * Lanes(ax * ay);
+		}
+
+		// Splits a texel offset into the whole texels and the filter weight FetchBilinear() takes.
+		inline void SplitOffset(float offset, int32_t limit, int32_t& whole, float& fraction)
+		{
+			offset = ClampCoordinate(offset, -(float)limit - 1.0f, (float)limit + 1.0f);
+			const float floored = floorf(offset);
+			whole = (int32_t)floored;
+			fraction = offset - floored;
+		}
+
+		struct YCbCr
+		{
+			Lanes Y, Cb, Cr;
+		};
+
+		// RGBToYCbCr() and YCbCrToRGB() of Sharpen.glsl and RadialBloom.glsl.
+		inline YCbCr ToYCbCr(Lanes r, Lanes g, Lanes b)
+		{
+			return { Lanes(0.2990f) * r + Lanes(0.5870f) * g + Lanes(0.1140f) * b,
+				Lanes(0.5f) + (Lanes(-0.1687f) * r + Lanes(-0.3313f) * g + Lanes(0.5000f) * b),
+				Lanes(0.5f) + (Lanes(0.5000f) * r + Lanes(-0.4187f) * g + Lanes(-0.0813f) * b) };
+		}
+		inline void ToRGB(const YCbCr& c, Lanes& r, Lanes& g, Lanes& b)
+		{
+			const Lanes cb = c.Cb - Lanes(0.5f), cr = c.Cr - Lanes(0.5f);
+			r = c.Y + Lanes(1.4020f) * cr;
+			g = c.Y + Lanes(-0.3441f) * cb + Lanes(-0.7141f) * cr;
+			b = c.Y + Lanes(1.7720f) * cb;
+		}
+
+		// UpsampleTent9() of MultiPassBloom.glsl and OutputPass.glsl, before the tighten factor.
+		Pixels UpsampleTent9(const CpuImageView& image, Lanes u, Lanes v, float radius, uint32_t count)
+		{
+			const Lanes ox = (1.0f / image.Width) * radius, oy = (1.0f / image.Height) * radius;
+			Pixels		result = Sample(image, u, v, count) * Lanes(4.0f);
+			result = result + Sample(image, u - ox, v - oy, count);
+			result = result + Sample(image, u, v - oy, count) * Lanes(2.0f);
+			result = result + Sample(image, u + ox, v - oy, count);
+			result = result + Sample(image, u - ox, v, count) * Lanes(2.0f);
+			result = result + Sample(image, u + ox, v, count) * Lanes(2.0f);
+			result = result + Sample(image, u - ox, v + oy, count);
+			result = result + Sample(image, u, v + oy, count) * Lanes(2.0f);
+			result = result + Sample(image, u + ox, v + oy, count);
+			return result;
+		}
+
+		// DownsampleBox13() of MultiPassBloom.glsl, including its repeated taps (J is I, L is F).
+		Pixels DownsampleBox13(const CpuImageView& image, Lanes u, Lanes v, uint32_t count)
+		{
+			const float hx = (1.0f / image.Width) * 0.5f, hy = (1.0f / image.Height) * 0.5f;
+			const auto	at = [&](float x, float y) { return Sample(image, u + Lanes(hx * x), v + Lanes(hy * y), count); };
+
+			const Pixels A = Sample(image, u, v, count);
+			const Pixels B = at(-1.0f, -1.0f), C = at(-1.0f, 1.0f), D = at(1.0f, 1.0f), E = at(1.0f, -1.0f);
+			const Pixels F = at(-2.0f, -2.0f), G = at(-2.0f, 0.0f), H = at(0.0f, 2.0f), I = at(2.0f, 2.0f);
+			const Pixels J = I, K = at(2.0f, 0.0f), L = F, M = at(0.0f, -2.0f);
+
+			Pixels result = (B + C + D + E) * Lanes(0.5f);
+			result = result + (F + G + A + M) * Lanes(0.125f);
+			result = result + (G + H + I + A) * Lanes(0.125f);
+			result = result + (A + I + J + K) * Lanes(0.125f);
+			result = result + (M + A + K + L) * Lanes(0.125f);
+			return result * Lanes(0.25f);
+		}
+
+		void Linearize(const CpuLinearizeParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			const CpuImageTarget& output = parameters.Output;
+			const size_t		  rowLength = (size_t)output.Width * 4;
+			for (uint32_t y = rowBegin; y < rowEnd; y++)
+			{
+				float* out = Row(output, y);
+				if (parameters.Bytes)
+				{
+					// 256 possible inputs: a table beats any pow().
+					const uint8_t* in = parameters.Bytes + y * rowLength;
+					const float*   table = parameters.Table;
+					for (size_t i = 0; i < rowLength; i += 4)
+					{
+						out[i + 0] = table[in[i + 0]];
+						out[i + 1] = table[in[i + 1]];
+						out[i + 2] = table[in[i + 2]];
+						out[i + 3] = 1.0f;
+					}
+					continue;
+				}
+
+				const float* in = parameters.Floats + y * rowLength;
+				for (uint32_t x = 0; x < output.Width; x += Lanes::Count)
+				{
+					const uint32_t count = GroupSize(x, output.Width);
+					Pixels		   p = LoadPixels(in + (size_t)x * 4, count);
+					p.R = Pow(p.R, 2.2f);
+					p.G = Pow(p.G, 2.2f);
+					p.B = Pow(p.B, 2.2f);
+					p.A = 1.0f;
+					StorePixels(p, out + (size_t)x * 4, count);
+				}
+			}
+		}
+
+		// The pointwise passes as ops on a group of pixels, so that runs of them fuse into one loop (Chain).
+		struct ContrastBrightnessOp
+		{
+			Lanes Contrast, Brightness;
+
+			explicit ContrastBrightnessOp(const CpuContrastBrightnessParameters& parameters)
+				: Contrast(parameters.Contrast), Brightness(parameters.Brightness)
+			{
+			}
+			explicit ContrastBrightnessOp(const CpuPointwiseOp& op) : ContrastBrightnessOp(op.ContrastBrightness) {}
+
+			void Apply(Pixels& p) const
+			{
+				const Lanes half = 0.5f;
+				p.R = (p.R - half) * Contrast + half + Brightness;
+				p.G = (p.G - half) * Contrast + half + Brightness;
+				p.B = (p.B - half) * Contrast + half + Brightness;
+			}
+		};
+
+		struct HueShiftOp
+		{
+			Lanes HueShift, SaturationBoost, ValueBoost;
+
+			explicit HueShiftOp(const CpuHueShiftParameters& parameters)
+				: HueShift(parameters.HueShift), SaturationBoost(parameters.SaturationBoost),
+				  ValueBoost(parameters.ValueBoost)
+			{
+			}
+			explicit HueShiftOp(const CpuPointwiseOp& op) : HueShiftOp(op.HueShift) {}
+
+			void Apply(Pixels& c) const
+			{
+				const Lanes zero = 0.0f, one = 1.0f;
+
+				// rgb2hsv(): the two mix()es by step() pick between whole vectors.
+				const Lanes greenAbove = c.G >= c.B;
+				const Lanes px = Select(greenAbove, c.G, c.B), py = Select(greenAbove, c.B, c.G);
+				const Lanes pz = Select(greenAbove, zero, Lanes(-1.0f));
+				const Lanes pw = Select(greenAbove, Lanes(-1.0f / 3.0f), Lanes(2.0f / 3.0f));
+				const Lanes redAbove = c.R >= px;
+				const Lanes qx = Select(redAbove, c.R, px), qy = py, qz = Select(redAbove, pz, pw);
+				const Lanes qw = Select(redAbove, px, c.R);
+				const Lanes d = qx - Min(qw, qy), e = 1.0e-10f;
+				Lanes		h = Abs(qz + (qw - qy) / (Lanes(6.0f) * d + e));
+				Lanes		s = d / (qx + e);
+				Lanes		v = qx;
+
+				h = Fract(h + HueShift);
+				s = Clamp(s + SaturationBoost, zero, one);
+				v = Clamp(v + ValueBoost, zero, one);
+
+				// hsv2rgb()
+				const auto channel = [&](float k) {
+					const Lanes p = Abs(Fract(h + Lanes(k)) * Lanes(6.0f) - Lanes(3.0f));
+					return v * Mix(one, Clamp(p - one, zero, one), s);
+				};
+				c.R = channel(1.0f);
+				c.G = channel(2.0f / 3.0f);
+				c.B = channel(1.0f / 3.0f);
+				c.A = one;
+			}
+		};
+
+		template <CpuPointwiseOpType Type>
+		struct PointwiseOp;
+		template <>
+		struct PointwiseOp<CpuPointwiseOpType::ContrastBrightness>
+		{
+			using Type = ContrastBrightnessOp;
+		};
+		template <>
+		struct PointwiseOp<CpuPointwiseOpType::HueShift>
+		{
+			using Type = HueShiftOp;
+		};
+
+		// Ops one after another on each group of pixels, inlined into a single loop body.
+		template <typename... Ops>
+		struct Chain
+		{
+			explicit Chain(const CpuPointwiseOp*) {}
+			void Apply(Pixels&) const {}
+		};
+		template <typename Op, typename... Rest>
+		struct Chain<Op, Rest...>
+		{
+			Op			   First;
+			Chain<Rest...> Others;
+
+			explicit Chain(const CpuPointwiseOp* ops) : First(ops[0]), Others(ops + 1) {}
+			void Apply(Pixels& p) const
+			{
+				First.Apply(p);
+				Others.Apply(p);
+			}
+		};
+
+		// Any run, switching on each op's type for every group of pixels.
+		struct RuntimeChain
+		{
+			const CpuPointwiseParameters& Parameters;
+
+			void Apply(Pixels& p) const
+			{
+				for (uint32_t i = 0; i < Parameters.OpCount; i++)
+				{
+					const CpuPointwiseOp& op = Parameters.Ops[i];
+					switch (op.Type)
+					{
+					case CpuPointwiseOpType::ContrastBrightness:
+						ContrastBrightnessOp(op).Apply(p);
+						break;
+					case CpuPointwiseOpType::HueShift:
+						HueShiftOp(op).Apply(p);
+						break;
+					}
+				}
+			}
+		};
+
+		template <typename Op>
+		void ApplyRows(const CpuImageView& input, const CpuImageTarget& output, const Op& op, uint32_t rowBegin,
+			uint32_t rowEnd)
+		{
+			for (uint32_t y = rowBegin; y < rowEnd; y++)
+			{
+				const float* in = Row(input, (int32_t)y);
+				float*		 out = Row(output, y);
+				for (uint32_t x = 0; x < output.Width; x += Lanes::Count)
+				{
+					const uint32_t count = GroupSize(x, output.Width);
+					Pixels		   p = LoadPixels(in + (size_t)x * 4, count);
+					op.Apply(p);
+					StorePixels(p, out + (size_t)x * 4, count);
+				}
+			}
+		}
+
+		// Runs the Chain of Types if the run is made of exactly those, in that order.
+		template <CpuPointwiseOpType... Types>
+		bool ApplyChain(const CpuPointwiseParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			static constexpr CpuPointwiseOpType types[] = { Types... };
+			if (parameters.OpCount != sizeof...(Types))
+				return false;
+			for (uint32_t i = 0; i < sizeof...(Types); i++)
+			{
+				if (parameters.Ops[i].Type != types[i])
+					return false;
+			}
+
+			const Chain<typename PointwiseOp<Types>::Type...> chain(parameters.Ops);
+			ApplyRows(parameters.Input, parameters.Output, chain, rowBegin, rowEnd);
+			return true;
+		}
+
+		void ContrastBrightness(const CpuContrastBrightnessParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			ApplyRows(parameters.Input, parameters.Output, ContrastBrightnessOp(parameters), rowBegin, rowEnd);
+		}
+
+		void HueShift(const CpuHueShiftParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			ApplyRows(parameters.Input, parameters.Output, HueShiftOp(parameters), rowBegin, rowEnd);
+		}
+
+		void Pointwise(const CpuPointwiseParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			// Every run the passes make when PassOrder holds each of them once, as the default order does.  Repeats
+			// take the runtime chain.
+			using Type = CpuPointwiseOpType;
+			if (ApplyChain<Type::ContrastBrightness>(parameters, rowBegin, rowEnd) ||
+				ApplyChain<Type::HueShift>(parameters, rowBegin, rowEnd) ||
+				ApplyChain<Type::ContrastBrightness, Type::HueShift>(parameters, rowBegin, rowEnd) ||
+				ApplyChain<Type::HueShift, Type::ContrastBrightness>(parameters, rowBegin, rowEnd))
+				return;
+			ApplyRows(parameters.Input, parameters.Output, RuntimeChain{ parameters }, rowBegin, rowEnd);
+		}
+
+		void Sobel(const CpuSobelParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			static constexpr float Kx[9] = { -1, 0, 1, -2, 0, 2, -1, 0, 1 };
+			static constexpr float Ky[9] = { -1, -2, -1, 0, 0, 0, 1, 2, 1 };
+
+			const CpuImageView& input = parameters.Input;
+			const uint32_t		width = parameters.Output.Width, height = parameters.Output.Height;
+			const float			texelX = parameters.KernelScale / input.Width;
+			const float			texelY = parameters.KernelScale / input.Height;
+			const bool			fullScale = parameters.KernelScale == 1.0f;
+
+			for (uint32_t y = rowBegin; y < rowEnd; y++)
+			{
+				// Taps land on texel centres unless the clamp to [texel, 1 - texel] moves them, at the border.
+				const bool	interiorRow = fullScale && y >= 1 && y + 1 < height;
+				const float v = (float)y / height + (1.0f / height) * 0.5f;
+				const Lanes clampedV = ClampCoordinate(v, texelY, 1.0f - texelY);
+				float*		out = Row(parameters.Output, y);
+				for (uint32_t x = 0; x < width; x += Lanes::Count)
+				{
+					const uint32_t count = GroupSize(x, width);
+					const bool	   direct = interiorRow && x >= 1 && x + count + 1 <= width;
+					const Lanes	   clampedU =
+						direct ? Lanes(0.0f)
+								  : Clamp(Column(x) / Lanes((float)width) + Lanes((1.0f / width) * 0.5f), texelX,
+									  1.0f - texelX);
+
+					Lanes sobelX = 0.0f, sobelY = 0.0f;
+					int	  kernelIndex = 0;
+					for (int j = -1; j <= 1; j++)
+					{
+						for (int i = -1; i <= 1; i++)
+						{
+							const Pixels color = direct
+								? Fetch(input, (int32_t)x + i, (int32_t)y + j, count)
+								: Sample(input, clampedU + Lanes(i * texelX), clampedV + Lanes(j * texelY), count);
+							const Lanes I = Lanes(0.21f) * color.R + Lanes(0.72f) * color.G + Lanes(0.07f) * color.B;
+							sobelX += I * Lanes(Kx[kernelIndex]);
+							sobelY += I * Lanes(Ky[kernelIndex]);
+							kernelIndex++;
+						}
+					}
+					Lanes sobel = Sqrt(sobelX * sobelX + sobelY * sobelY);
+					sobel *= Step(parameters.Threshold, sobel);
+					const Lanes edge = sobel * Lanes(parameters.Strength);
+
+					Pixels color = Fetch(input, (int32_t)x, (int32_t)y, count);
+					color.R += edge;
+					color.G += edge;
+					color.B += edge;
+					StorePixels(color, out + (size_t)x * 4, count);
+				}
+			}
+		}
+
+		void Sharpen(const CpuSharpenParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			const CpuImageView& input = parameters.Input;
+			const uint32_t		width = parameters.Output.Width, height = parameters.Output.Height;
+			const float			texelX = parameters.KernelScale / width, texelY = parameters.KernelScale / height;
+			// At full scale every tap is a texel centre, clamped at the border like ClampToEdge.
+			const bool fullScale = parameters.KernelScale == 1.0f;
+
+			for (uint32_t y = rowBegin; y < rowEnd; y++)
+			{
+				const float v = (float)y / height + (1.0f / height) * 0.5f;
+				float*		out = Row(parameters.Output, y);
+				for (uint32_t x = 0; x < width; x += Lanes::Count)
+				{
+					const uint32_t count = GroupSize(x, width);
+					const Lanes	   u = Column(x) / Lanes((float)width) + Lanes((1.0f / width) * 0.5f);
+
+					Lanes r = 0.0f, g = 0.0f, b = 0.0f, yAccum = 0.0f, yOriginal = 0.0f;
+					for (int j = -1; j <= 1; j++)
+					{
+						for (int i = -1; i <= 1; i++)
+						{
+							const Pixels texel = fullScale
+								? Fetch(input, (int32_t)x + i, (int32_t)y + j, count)
+								: Sample(input, u + Lanes(i * texelX), Lanes(v + j * texelY), count);
+							const Lanes luma =
+								Lanes(0.2990f) * texel.R + Lanes(0.5870f) * texel.G + Lanes(0.1140f) * texel.B;
+							yAccum += luma * Lanes(i == 0 && j == 0 ? 9.0f : -1.0f);
+							r += texel.R;
+							g += texel.G;
+							b += texel.B;
+							if (i == 0 && j == 0)
+								yOriginal = luma;
+						}
+					}
+
+					YCbCr average = ToYCbCr(r / Lanes(9.0f), g / Lanes(9.0f), b / Lanes(9.0f));
+					average.Y = Mix(yOriginal, yAccum, parameters.Strength);
+					Pixels result;
+					ToRGB(average, result.R, result.G, result.B);
+					result.A = 1.0f;
+					StorePixels(result, out + (size_t)x * 4, count);
+				}
+			}
+		}
+
+		void RadialBlur(const CpuRadialBlurParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			const CpuImageView& input = parameters.Input;
+			const uint32_t		width = parameters.Output.Width, height = parameters.Output.Height;
+			const int32_t		samples = parameters.Samples;
+			const float			sampleCount = (float)(samples > 0 ? samples : 0);
+
+			for (uint32_t y = rowBegin; y < rowEnd; y++)
+			{
+				float* out = Row(parameters.Output, y);
+				for (uint32_t x = 0; x < width; x += Lanes::Count)
+				{
+					const uint32_t count = GroupSize(x, width);
+					Pixels		   blur = { 0.0f, 0.0f, 0.0f, 0.0f };
+					for (int32_t i = 0; i < samples; i++)
+					{
+						const float t = (float)i / (sampleCount - 1.0f);
+						int32_t		dx, dy;
+						float		ax, ay;
+						SplitOffset((t - 0.5f) * parameters.DirectionX * parameters.Strength * width, (int32_t)width, dx,
+							ax);
+						SplitOffset((t - 0.5f) * parameters.DirectionY * parameters.Strength * height, (int32_t)height,
+							dy, ay);
+						blur = blur + FetchBilinear(input, (int32_t)x + dx, (int32_t)y + dy, ax, ay, count);
+					}
+					const Lanes	 n = sampleCount, strength = parameters.Strength;
+					const Pixels original = Fetch(input, (int32_t)x, (int32_t)y, count);
+					const Pixels result = { Mix(original.R, blur.R / n, strength), Mix(original.G, blur.G / n, strength),
+						Mix(original.B, blur.B / n, strength), Mix(original.A, blur.A / n, strength) };
+					StorePixels(result, out + (size_t)x * 4, count);
+				}
+			}
+		}
+
+		void ChromaticAberration(const CpuChromaticAberrationParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			const CpuImageView& input = parameters.Input;
+			const uint32_t		width = parameters.Output.Width;
+			int32_t				redX, blueX;
+			float				redWeight, blueWeight;
+			SplitOffset(parameters.Strength * width, (int32_t)width, redX, redWeight);
+			SplitOffset(-parameters.Strength * width, (int32_t)width, blueX, blueWeight);
+
+			for (uint32_t y = rowBegin; y < rowEnd; y++)
+			{
+				float* out = Row(parameters.Output, y);
+				for (uint32_t x = 0; x < width; x += Lanes::Count)
+				{
+					const uint32_t count = GroupSize(x, width);
+					Pixels		   result = Fetch(input, (int32_t)x, (int32_t)y, count);
+					result.R = FetchBilinear(input, (int32_t)x + redX, (int32_t)y, redWeight, 0.0f, count).R;
+					result.B = FetchBilinear(input, (int32_t)x + blueX, (int32_t)y, blueWeight, 0.0f, count).B;
+					result.A = 1.0f;
+					StorePixels(result, out + (size_t)x * 4, count);
+				}
+			}
+		}
+
+		void BarrelDistortion(const CpuBarrelDistortionParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			const uint32_t width = parameters.Output.Width, height = parameters.Output.Height;
+			const Lanes	   one = 1.0f, half = 0.5f, distortionX = parameters.DistortionX,
+						distortionY = parameters.DistortionY;
+
+			for (uint32_t y = rowBegin; y < rowEnd; y++)
+			{
+				const Lanes v = (float)y / height;
+				const Lanes py = v * Lanes(2.0f) - one;
+				float*		out = Row(parameters.Output, y);
+				for (uint32_t x = 0; x < width; x += Lanes::Count)
+				{
+					const uint32_t count = GroupSize(x, width);
+					const Lanes	   u = Column(x) / Lanes((float)width);
+					const Lanes	   px = u * Lanes(2.0f) - one;
+					const Lanes	   r = Sqrt(px * px + py * py);
+					const Lanes	   inside = r < one;
+					const Lanes	   scale = one + r * (distortionX + distortionY * r);
+					const Lanes	   distortedU = Select(inside, px * scale * half + half, u);
+					const Lanes	   distortedV = Select(inside, py * scale * half + half, v);
+					StorePixels(Sample(parameters.Input, distortedU, distortedV, count), out + (size_t)x * 4, count);
+				}
+			}
+		}
+
+		void Vignette(const CpuVignetteParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			const uint32_t width = parameters.Output.Width, height = parameters.Output.Height;
+			const Lanes	   radius = parameters.Radius, inner = parameters.Radius - parameters.Softness;
+
+			for (uint32_t y = rowBegin; y < rowEnd; y++)
+			{
+				const Lanes dy = Lanes((float)y / height) - Lanes(0.5f);
+				float*		out = Row(parameters.Output, y);
+				for (uint32_t x = 0; x < width; x += Lanes::Count)
+				{
+					const uint32_t count = GroupSize(x, width);
+					const Lanes	   dx = Column(x) / Lanes((float)width) - Lanes(0.5f);
+					const Lanes	   distance = Sqrt(dx * dx + dy * dy);
+					// smoothstep(radius, radius - softness, distance)
+					const Lanes t = Clamp((distance - radius) / (inner - radius), 0.0f, 1.0f);
+					const Lanes vignette = t * t * (Lanes(3.0f) - Lanes(2.0f) * t);
+
+					// texture() at x / width rather than the texel centre: the box of four texels around the pixel's
+					// lower-left corner.
+					Pixels color = FetchBilinear(parameters.Input, (int32_t)x - 1, (int32_t)y - 1, 0.5f, 0.5f, count);
+					color.R *= vignette;
+					color.G *= vignette;
+					color.B *= vignette;
+					StorePixels(color, out + (size_t)x * 4, count);
+				}
+			}
+		}
+
+		void RadialBloomExtract(const CpuRadialBloomParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			for (uint32_t y = rowBegin; y < rowEnd; y++)
+			{
+				const float* in = Row(parameters.Input, (int32_t)y);
+				float*		 out = Row(parameters.Output, y);
+				for (uint32_t x = 0; x < parameters.Output.Width; x += Lanes::Count)
+				{
+					const uint32_t count = GroupSize(x, parameters.Output.Width);
+					const Pixels   color = LoadPixels(in + (size_t)x * 4, count);
+					const Lanes	   luminance =
+						color.R * Lanes(0.299f) + color.G * Lanes(0.587f) + color.B * Lanes(0.114f);
+					StorePixels(color * Step(parameters.LuminanceThreshold, luminance), out + (size_t)x * 4, count);
+				}
+			}
+		}
+
+		void RadialBloomBlur(const CpuRadialBloomParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			const CpuImageView& input = parameters.Input;
+			const int32_t		radius = parameters.RadiusPixels;
+			const Lanes			colorWeight = parameters.BlurColorWeight;
+
+			for (uint32_t y = rowBegin; y < rowEnd; y++)
+			{
+				float* out = Row(parameters.Output, y);
+				for (uint32_t x = 0; x < parameters.Output.Width; x += Lanes::Count)
+				{
+					const uint32_t count = GroupSize(x, parameters.Output.Width);
+					Pixels		   sum = { 0.0f, 0.0f, 0.0f, 0.0f };
+					for (int32_t i = -radius; i <= radius; i++)
+					{
+						const Pixels neighbor = parameters.Vertical ? Load(input, (int32_t)x, (int32_t)y + i, count)
+																	: Load(input, (int32_t)x + i, (int32_t)y, count);
+						sum = sum + neighbor * Lanes(parameters.Weights[i + radius]);
+					}
+
+					const Pixels color = Load(input, (int32_t)x, (int32_t)y, count);
+					const YCbCr	 original = ToYCbCr(color.R, color.G, color.B);
+					const YCbCr	 blur = ToYCbCr(sum.R, sum.G, sum.B);
+					const YCbCr	 blended = { blur.Y, original.Cb + colorWeight * (blur.Cb - original.Cb),
+						 original.Cr + colorWeight * (blur.Cr - original.Cr) };
+					Pixels		 result;
+					ToRGB(blended, result.R, result.G, result.B);
+					result.A = 0.0f;
+					StorePixels(result, out + (size_t)x * 4, count);
+				}
+			}
+		}
+
+		void BloomDownsample(const CpuBloomDownsampleParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			const uint32_t width = parameters.Output.Width, height = parameters.Output.Height;
+			// Prefilter()'s curve: u_Params of MultiPassBloomPass.
+			const float threshold = parameters.Threshold, curveX = threshold - parameters.Knee,
+						curveY = parameters.Knee * 2.0f, curveZ = 0.25f / parameters.Knee;
+
+			for (uint32_t y = rowBegin; y < rowEnd; y++)
+			{
+				const Lanes v = (float)y / height + (1.0f / height) * 0.5f;
+				float*		out = Row(parameters.Output, y);
+				for (uint32_t x = 0; x < width; x += Lanes::Count)
+				{
+					const uint32_t count = GroupSize(x, width);
+					const Lanes	   u = Column(x) / Lanes((float)width) + Lanes((1.0f / width) * 0.5f);
+					Pixels		   color = DownsampleBox13(parameters.Input, u, v, count);
+					color.A = 1.0f;
+					if (parameters.Prefilter)
+					{
+						color.R = Min(20.0f, color.R);
+						color.G = Min(20.0f, color.G);
+						color.B = Min(20.0f, color.B);
+						const Lanes brightness = Max(Max(color.R, color.G), color.B);
+						Lanes		rq = Clamp(brightness - Lanes(curveX), 0.0f, curveY);
+						rq = rq * rq * Lanes(curveZ);
+						const Lanes factor = Max(rq, brightness - Lanes(threshold)) / Max(brightness, 1.0e-4f);
+						color = color * factor;
+						color.A = 1.0f;
+					}
+					StorePixels(color, out + (size_t)x * 4, count);
+				}
+			}
+		}
+
+		void BloomUpsample(const CpuBloomUpsampleParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			const uint32_t width = parameters.Output.Width, height = parameters.Output.Height;
+			const Lanes	   tighten = 1.0f / parameters.TightenFactor;
+
+			for (uint32_t y = rowBegin; y < rowEnd; y++)
+			{
+				const Lanes v = (float)y / height + (1.0f / height) * 0.5f;
+				float*		out = Row(parameters.Output, y);
+				for (uint32_t x = 0; x < width; x += Lanes::Count)
+				{
+					const uint32_t count = GroupSize(x, width);
+					const Lanes	   u = Column(x) / Lanes((float)width) + Lanes((1.0f / width) * 0.5f);
+					const Pixels   upsampled = UpsampleTent9(parameters.Lower, u, v, parameters.Radius, count) * tighten;
+					Pixels		   color = Fetch(parameters.Existing, (int32_t)x, (int32_t)y, count) + upsampled;
+					color.A = 1.0f;
+					StorePixels(color, out + (size_t)x * 4, count);
+				}
+			}
+		}
+
+		void Tonemap(int32_t tonemapper, Lanes whitePoint, Lanes& r, Lanes& g, Lanes& b)
+		{
+			if (tonemapper == 1)
+			{
+				const Lanes vr = Lanes(0.59719f) * r + Lanes(0.35458f) * g + Lanes(0.04823f) * b;
+				const Lanes vg = Lanes(0.07600f) * r + Lanes(0.90834f) * g + Lanes(0.01566f) * b;
+				const Lanes vb = Lanes(0.02840f) * r + Lanes(0.13383f) * g + Lanes(0.83777f) * b;
+				const auto	curve = [](Lanes v) {
+					 const Lanes a = v * (v + Lanes(0.0245786f)) - Lanes(0.000090537f);
+					 const Lanes b = v * (Lanes(0.983729f) * v + Lanes(0.4329510f)) + Lanes(0.238081f);
+					 return a / b;
+				};
+				const Lanes cr = curve(vr), cg = curve(vg), cb = curve(vb);
+				r = Clamp(Lanes(1.60475f) * cr + Lanes(-0.53108f) * cg + Lanes(-0.07367f) * cb, 0.0f, 1.0f);
+				g = Clamp(Lanes(-0.10208f) * cr + Lanes(1.10813f) * cg + Lanes(-0.00605f) * cb, 0.0f, 1.0f);
+				b = Clamp(Lanes(-0.00327f) * cr + Lanes(-0.07276f) * cg + Lanes(1.07602f) * cb, 0.0f, 1.0f);
+			}
+			else if (tonemapper == 2)
+			{
+				r = r / (r + whitePoint);
+				g = g / (g + whitePoint);
+				b = b / (b + whitePoint);
+			}
+			else if (tonemapper == 3)
+			{
+				const Lanes whiteSquared = whitePoint * whitePoint, one = 1.0f;
+				r = r * (one + r / whiteSquared) / (one + r);
+				g = g * (one + g / whiteSquared) / (one + g);
+				b = b * (one + b / whiteSquared) / (one + b);
+			}
+		}
+
+		void Composite(const CpuCompositeParameters& parameters, uint32_t rowBegin, uint32_t rowEnd)
+		{
+			const CpuImageView& input = parameters.Input;
+			const uint32_t		width = input.Width, height = input.Height;
+			const Lanes			intensity = parameters.BloomIntensity, exposure = parameters.Exposure;
+			const Lanes			tighten = 1.0f / parameters.UpsampleTightenFactor;
+			const Lanes			inverseGamma = 1.0f / 2.2f;
+			const float			noiseScaleX = (float)width / parameters.SensorNoise.Width;
+			const float			noiseScaleY = (float)height / parameters.SensorNoise.Height;
+
+			for (uint32_t y = rowBegin; y < rowEnd; y++)
+			{
+				const Lanes v = (float)y / height + (1.0f / height) * 0.5f;
+				const Lanes noiseV = ((float)y / height + parameters.NoiseOffsetY) * parameters.NoiseAmplitude * noiseScaleY;
+				uint8_t*	out = parameters.Output + (size_t)(height - 1 - y) * width * 4;
+				for (uint32_t x = 0; x < width; x += Lanes::Count)
+				{
+					const uint32_t count = GroupSize(x, width);
+					const Lanes	   column = Column(x) / Lanes((float)width);
+					const Pixels   color = Fetch(input, (int32_t)x, (int32_t)y, count);
+					Lanes		   r = color.R, g = color.G, b = color.B;
+
+					if (parameters.BloomType == 1)
+					{
+						const Pixels bloom = Fetch(parameters.Bloom, (int32_t)x, (int32_t)y, count);
+						r = Mix(r, r + bloom.R, intensity);
+						g = Mix(g, g + bloom.G, intensity);
+						b = Mix(b, b + bloom.B, intensity);
+					}
+					else if (parameters.BloomType == 2)
+					{
+						const Lanes	 u = column + Lanes((1.0f / width) * 0.5f);
+						const Pixels bloom =
+							UpsampleTent9(parameters.Bloom, u, v, parameters.UpsampleRadius, count) * tighten * intensity;
+						const Pixels dirt =
+							Sample(parameters.BloomDirt, u, v, count, true) * Lanes(parameters.BloomDirtIntensity);
+						r += bloom.R + bloom.R * dirt.R;
+						g += bloom.G + bloom.G * dirt.G;
+						b += bloom.B + bloom.B * dirt.B;
+					}
+
+					r *= exposure;
+					g *= exposure;
+					b *= exposure;
+					Tonemap(parameters.Tonemapper, parameters.WhitePoint, r, g, b);
+
+					const Lanes	 noiseU = (column + Lanes(parameters.NoiseOffsetX)) * Lanes(parameters.NoiseAmplitude) *
+						Lanes(noiseScaleX);
+					const Pixels noise = Sample(parameters.SensorNoise, noiseU, noiseV, count, true);
+					const Lanes	 alpha = parameters.NoiseAlpha, beta = parameters.NoiseBeta, gamma = parameters.NoiseGamma;
+					r = Pow(alpha * r + beta * noise.R + gamma, inverseGamma);
+					g = Pow(alpha * g + beta * noise.G + gamma, inverseGamma);
+					b = Pow(alpha * b + beta * noise.B + gamma, inverseGamma);
+
+					// UNORM conversion: clamped (NaN to 0), scaled and rounded.
+					alignas(32) float channels[3][Lanes::Count];
+					Floor(Clamp(r, 0.0f, 1.0f) * Lanes(255.0f) + Lanes(0.5f)).Store(channels[0]);
+					Floor(Clamp(g, 0.0f, 1.0f) * Lanes(255.0f) + Lanes(0.5f)).Store(channels[1]);
+					Floor(Clamp(b, 0.0f, 1.0f) * Lanes(255.0f) + Lanes(0.5f)).Store(channels[2]);
+					uint8_t* pixel = out + (size_t)x * 4;
+					for (uint32_t i = 0; i < count; i++, pixel += 4)
+					{
+						pixel[0] = (uint8_t)channels[0][i];
+						pixel[1] = (uint8_t)channels[1][i];
+						pixel[2] = (uint8_t)channels[2][i];
+						pixel[3] = 255;
+					}
+				}
+			}
+		}
+	}
+
+	const CpuKernelTable& GetKernelTable()
+	{
+		static const CpuKernelTable table = [] {
+			CpuKernelTable kernels;
+			kernels.Name = YGG_CPU_ISA_NAME;
+			kernels.LaneCount = Lanes::Count;
+			kernels.Linearize = Linearize;
+			kernels.ContrastBrightness = ContrastBrightness;
+			kernels.HueShift = HueShift;
+			kernels.Pointwise = Pointwise;
+			kernels.Sobel = Sobel;
+			kernels.Sharpen = Sharpen;
+			kernels.RadialBlur = RadialBlur;
+			kernels.ChromaticAberration = ChromaticAberration;
+			kernels.BarrelDistortion = BarrelDistortion;
+			kernels.Vignette = Vignette;
+			kernels.RadialBloomExtract = RadialBloomExtract;
+			kernels.RadialBloomBlur = RadialBloomBlur;
+			kernels.BloomDownsample = BloomDownsample;
+			kernels.BloomUpsample = BloomUpsample;
+			kernels.Composite = Composite;
+			return kernels;
+		}();
+		return table;
+	}
+}
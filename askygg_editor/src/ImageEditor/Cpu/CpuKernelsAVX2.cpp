@@ -0,0 +1,7 @@
+// The kernels with AVX2 and FMA, which CMake enables for this file alone.  Only called once GetCpuKernels() has seen
+// the CPU support both.
+#if defined(__AVX2__)
+	#define YGG_CPU_ISA_NAME "avx2"
+	#define YGG_CPU_ISA avx2
+	#include "CpuKernels.inl"
+#endif
@@ -0,0 +1,8 @@
+// The kernels at the compiler's default instruction set: SSE2 on x86-64, scalar elsewhere.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define YGG_CPU_ISA_NAME "sse2"
+#else
+	#define YGG_CPU_ISA_NAME "scalar"
+#endif
+#define YGG_CPU_ISA baseline
+#include "CpuKernels.inl"
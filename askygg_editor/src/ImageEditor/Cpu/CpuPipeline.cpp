@@ -0,0 +1,710 @@
+#include "CpuPipeline.h"
+
+#include "ImagePipeline.h"
+#include "Passes/BarrelDistortionPass.h"
+#include "Passes/ChromaticAberrationPass.h"
+#include "Passes/ContrastBrightnessPass.h"
+#include "Passes/HSVAdjustmentPass.h"
+#include "Passes/MultiPassBloomPass.h"
+#include "Passes/OutputComputePass.h"
+#include "Passes/RadialBloomPass.h"
+#include "Passes/RadialBlurPass.h"
+#include "Passes/SharpenPass.h"
+#include "Passes/SobelPass.h"
+#include "Passes/VignettePass.h"
+
+#include "askygg/core/Log.h"
+#include "askygg/platform/PlatformDetection.h"
+#include "askygg/renderer/Texture.h"
+#include "platform/PlatformPath.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#if defined(E_PLATFORM_LINUX)
+	#include <unistd.h>
+#endif
+
+namespace
+{
+	// RGBA8 texture as the GPU samples it: normalized floats, rows bottom first.
+	void LoadTexture(const std::string& filePath, CpuImage& texture)
+	{
+		CpuInputImage image;
+		if (!CpuInputImage::DecodeFile(filePath, image) || image.IsHDR())
+		{
+			YGG_LOG_WARN("CPU pipeline: could not load {}, using black", filePath);
+			texture.Resize(1, 1);
+			std::fill(texture.Pixels.begin(), texture.Pixels.end(), 0.0f);
+			return;
+		}
+
+		texture.Resize(image.Width, image.Height);
+		for (size_t i = 0; i < image.Bytes.size(); i++)
+			texture.Pixels[i] = image.Bytes[i] / 255.0f;
+	}
+
+	float Fract(float x) { return x - std::floor(x); }
+
+	// hash21() of OutputPass.glsl.
+	void Hash21(float p, float& x, float& y)
+	{
+		float p3x = Fract(p * 0.1031f), p3y = Fract(p * 0.1030f), p3z = Fract(p * 0.0973f);
+		const float dot = p3x * (p3y + 33.33f) + p3y * (p3z + 33.33f) + p3z * (p3x + 33.33f);
+		p3x += dot;
+		p3y += dot;
+		p3z += dot;
+		x = Fract((p3x + p3y) * p3z);
+		y = Fract((p3x + p3z) * p3y);
+	}
+
+	template <typename T>
+	const auto& GetSettings(ImagePipeline& pipeline, ImagePassType type)
+	{
+		return std::dynamic_pointer_cast<T>(pipeline.GetPass(type))->GetSettings();
+	}
+
+	// kernel with parameters, on whatever input and output it is handed.
+	template <typename Parameters>
+	auto Bind(void (*kernel)(const Parameters&, uint32_t, uint32_t), const Parameters& parameters)
+	{
+		return [kernel, parameters](const CpuImageView& input, const CpuImageTarget& output, uint32_t rowBegin,
+				   uint32_t rowEnd) {
+			Parameters bound = parameters;
+			bound.Input = input;
+			bound.Output = output;
+			kernel(bound, rowBegin, rowEnd);
+		};
+	}
+
+	CpuImageView AsView(const CpuImageTarget& target)
+	{
+		return { target.Pixels, target.Width, target.Height, target.FirstRow };
+	}
+
+	// The rows of need a line buffer holding held would still have to compute.
+	template <typename RowRange>
+	RowRange Remaining(const RowRange& held, const RowRange& need)
+	{
+		if (held.Begin <= need.Begin && need.Begin < held.End)
+			return { std::min(held.End, need.End), need.End };
+		return need;
+	}
+
+	// Makes band hold rows need of its image, keeping the rows it holds already in the buffer, and returns the rows
+	// that still have to be computed.  Strips go down the image, so need never starts above what band holds.
+	template <typename LineBuffer, typename RowRange>
+	RowRange Slide(LineBuffer& band, const RowRange& need, uint32_t width)
+	{
+		const RowRange fresh = Remaining(band.Held, need);
+		if (fresh.Begin > need.Begin)
+			std::memmove(band.Image.Pixels.data(), band.Image.GetRow(need.Begin - band.Held.Begin),
+				(size_t)(fresh.Begin - need.Begin) * width * 4 * sizeof(float));
+		band.Image.Resize(width, need.End - need.Begin);
+		band.Held = need;
+		return fresh;
+	}
+
+	uint32_t GetL2CacheSize()
+	{
+#if defined(E_PLATFORM_LINUX)
+		const long size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+		if (size > 0)
+			return (uint32_t)size;
+#endif
+		return 1u << 20;
+	}
+}
+
+CpuPipeline::CpuPipeline(const CpuPipelineSpecification& specification)
+	: m_Kernels(GetCpuKernels(specification.InstructionSet)), m_ThreadPool(specification.ThreadCount),
+	  m_Schedule(specification.Schedule),
+	  m_StripBytes(specification.StripBytes ? specification.StripBytes : GetL2CacheSize()),
+	  m_Start(std::chrono::high_resolution_clock::now())
+{
+	for (int i = 0; i < 256; i++)
+		m_LinearizeTable[i] = std::pow(i / 255.0f, 2.2f);
+
+	LoadTexture(GetExecutablePath() + "/assets/textures/sensor-noise.jpg", m_SensorNoise);
+	LoadTexture(GetExecutablePath() + "/assets/textures/dirt-mask.png", m_BloomDirt);
+}
+
+template <typename Parameters>
+void CpuPipeline::Run(void (*kernel)(const Parameters&, uint32_t, uint32_t), const Parameters& parameters,
+	uint32_t rows)
+{
+	RunTiles(rows, [kernel, &parameters](uint32_t begin, uint32_t end) { kernel(parameters, begin, end); });
+}
+
+template <typename Function>
+void CpuPipeline::RunTiles(uint32_t rows, const Function& function)
+{
+	// Several tiles per thread, so a thread that falls behind does not hold up the rest.
+	const uint32_t tileRows = std::max(1u, rows / (m_ThreadPool.GetThreadCount() * 8));
+	m_ThreadPool.ParallelFor(rows, tileRows, function);
+}
+
+template <typename Function>
+void CpuPipeline::ForEachStrip(uint32_t rows, uint32_t stripRows, const Function& function)
+{
+	// Only the first strip of a run computes its halo from scratch; a couple of runs per thread even out the load.
+	const uint32_t threads = m_ThreadPool.GetThreadCount();
+	const uint32_t runRows = std::max(stripRows, (rows + threads * 2 - 1) / (threads * 2));
+	const uint32_t runCount = threads == 1 ? 1 : (rows + runRows - 1) / runRows;
+	const uint32_t slotCount = std::min(threads, runCount);
+	if (m_StripBuffers.size() < slotCount)
+		m_StripBuffers.resize(slotCount);
+
+	// A chunk per set of buffers, taking runs until none are left, so no two threads share buffers.
+	std::atomic<uint32_t> nextRun = 0;
+	m_ThreadPool.ParallelFor(slotCount, 1, [&](uint32_t slot, uint32_t) {
+		StripBuffers& buffers = m_StripBuffers[slot];
+		for (uint32_t run = nextRun++; run < runCount; run = nextRun++)
+		{
+			const uint32_t runBegin = runCount == 1 ? 0 : run * runRows;
+			const uint32_t runEnd = runCount == 1 ? rows : std::min(rows, runBegin + runRows);
+			buffers.Reset();
+			for (uint32_t begin = runBegin; begin < runEnd; begin += stripRows)
+				function(buffers, begin, std::min(runEnd, begin + stripRows));
+		}
+	});
+}
+
+uint32_t CpuPipeline::GetStripRows(uint32_t width, uint32_t halo, uint32_t bands) const
+{
+	// Each band holds a strip and its share of the halo.
+	const uint64_t rowBytes = (uint64_t)width * 4 * sizeof(float);
+	const uint64_t fit = m_StripBytes / rowBytes;
+	const uint64_t rows = fit > halo ? (fit - halo) / std::max(bands, 1u) : 0;
+	// Tall stencils cannot fit the cache anyway.  Moving the halo rows along costs a copy each per strip, so then the
+	// strips grow with the halo instead.  Much under four rows, the per-strip overhead shows.
+	return (uint32_t)std::max<uint64_t>({ rows, halo, 4 });
+}
+
+void CpuPipeline::Linearize(const CpuInputImage& image, const CpuImageTarget& output, uint32_t rowBegin,
+	uint32_t rowEnd)
+{
+	CpuLinearizeParameters parameters;
+	parameters.Bytes = image.IsHDR() ? nullptr : image.Bytes.data();
+	parameters.Floats = image.IsHDR() ? image.Floats.data() : nullptr;
+	parameters.Table = m_LinearizeTable;
+	parameters.Output = output;
+	m_Kernels.Linearize(parameters, rowBegin, rowEnd);
+}
+
+void CpuPipeline::Process(ImagePipeline& pipeline, const CpuInputImage& image, std::vector<uint8_t>& output)
+{
+	// Linearize first and OutputCompute last, as ApplySettings() orders them.
+	const std::vector<ImagePassType>& passTypes = pipeline.GetOrderedPassTypes();
+	m_Stages.clear();
+	for (size_t i = 1; i + 1 < passTypes.size(); i++)
+	{
+		Stage stage;
+		if (BuildStage(pipeline, passTypes[i], image.Height, stage))
+			AddStage(std::move(stage));
+	}
+
+	const auto& settings = GetSettings<OutputComputePass>(pipeline, ImagePassType::OutputCompute);
+	const float time = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - m_Start).count();
+
+	CpuCompositeParameters composite;
+	composite.BloomType = (int32_t)pipeline.GetBloomType();
+	composite.BloomDirt = m_BloomDirt.GetView();
+	composite.SensorNoise = m_SensorNoise.GetView();
+	composite.BloomIntensity = settings.BloomIntensity;
+	composite.BloomDirtIntensity = settings.BloomDirtIntensity;
+	composite.UpsampleRadius = settings.BloomUpsampleRadius;
+	composite.UpsampleTightenFactor = settings.BloomUpsampleTightenFactor;
+	composite.Exposure = settings.Exposure;
+	composite.Tonemapper = (int32_t)settings.Tonemap;
+	composite.WhitePoint = settings.WhitePoint;
+	composite.NoiseAlpha = settings.NoiseAlpha;
+	composite.NoiseBeta = settings.NoiseBeta;
+	composite.NoiseGamma = settings.NoiseGamma;
+	composite.NoiseAmplitude = settings.NoiseAmplitude;
+	Hash21(time * settings.NoiseFrequency, composite.NoiseOffsetX, composite.NoiseOffsetY);
+
+	output.resize((size_t)image.Width * image.Height * 4);
+	composite.Output = output.data();
+	if (m_Schedule == CpuSchedule::Frames)
+		ProcessFrames(pipeline, image, composite);
+	else
+		ProcessStrips(pipeline, image, composite);
+}
+
+void CpuPipeline::ProcessFrames(ImagePipeline& pipeline, const CpuInputImage& image,
+	CpuCompositeParameters& composite)
+{
+	const uint32_t width = image.Width, height = image.Height;
+	CpuImage*	   current = &m_Images[0];
+	CpuImage*	   next = &m_Images[1];
+
+	current->Resize(width, height);
+	RunTiles(height, [&](uint32_t begin, uint32_t end) { Linearize(image, current->GetTarget(), begin, end); });
+
+	// Bloom works on the linear image, as in ImagePipeline::DeclareGraph().
+	if (pipeline.GetBloomType() == BloomType::Radial)
+	{
+		PrepareRadialBloom(GetSettings<RadialBloomPass>(pipeline, ImagePassType::RadialBloom));
+		composite.Bloom = RunRadialBloom(*current);
+	}
+	else if (pipeline.GetBloomType() == BloomType::MultiPass)
+	{
+		composite.Bloom = RunMultiPassBloom(GetSettings<MultiPassBloomPass>(pipeline, ImagePassType::MultiPassBloom),
+			image, current);
+	}
+
+	for (const Stage& stage : m_Stages)
+	{
+		next->Resize(width, height);
+		RunTiles(height,
+			[&](uint32_t begin, uint32_t end) { stage.Run(current->GetView(), next->GetTarget(), begin, end); });
+		std::swap(current, next);
+	}
+
+	composite.Input = current->GetView();
+	Run(m_Kernels.Composite, composite, height);
+}
+
+void CpuPipeline::ProcessStrips(ImagePipeline& pipeline, const CpuInputImage& image,
+	CpuCompositeParameters& composite)
+{
+	const uint32_t width = image.Width, height = image.Height;
+	if (pipeline.GetBloomType() == BloomType::Radial)
+		PrepareRadialBloom(GetSettings<RadialBloomPass>(pipeline, ImagePassType::RadialBloom));
+	else if (pipeline.GetBloomType() == BloomType::MultiPass)
+		composite.Bloom = RunMultiPassBloom(GetSettings<MultiPassBloomPass>(pipeline, ImagePassType::MultiPassBloom),
+			image, nullptr);
+
+	// A whole-frame stage needs all of its input first, so the run before it streams into a frame, and it heads the
+	// next run, reading that.
+	const CpuImage* source = nullptr;
+	size_t			firstStage = 0;
+	for (size_t i = 0; i < m_Stages.size(); i++)
+	{
+		if (!m_Stages[i].WholeFrame || (i == firstStage && source))
+			continue;
+
+		CpuImage& frame = source == &m_Images[0] ? m_Images[1] : m_Images[0];
+		frame.Resize(width, height);
+		RunStrips(image, source, firstStage, i, &frame, composite);
+		source = &frame;
+		firstStage = i;
+	}
+	RunStrips(image, source, firstStage, m_Stages.size(), nullptr, composite);
+}
+
+void CpuPipeline::RunStrips(const CpuInputImage& image, const CpuImage* source, size_t firstStage, size_t endStage,
+	CpuImage* frame, const CpuCompositeParameters& composite)
+{
+	const uint32_t width = image.Width, height = image.Height;
+	const size_t   stageCount = endStage - firstStage;
+	// Only the composite reads radial bloom, so it streams with the last run, from the linearized input.
+	const bool	   radialBloom = !frame && composite.BloomType == (int32_t)BloomType::Radial;
+	const uint32_t bloomRows = radialBloom ? (uint32_t)m_RadialBloomParameters.RadiusPixels : 0;
+
+	uint32_t halo = bloomRows * 2, bands = (source ? 0 : 1) + (radialBloom ? 1 : 0);
+	// The first stage reads a frame, if there is one, not a line buffer.
+	for (size_t i = source ? firstStage + 1 : firstStage; i < endStage; i++)
+		halo += m_Stages[i].RowsBefore + m_Stages[i].RowsAfter;
+	bands += stageCount > 0 ? (uint32_t)stageCount - 1 : 0;
+
+	const auto strip = [&](StripBuffers& buffers, uint32_t rowBegin, uint32_t rowEnd) {
+		if (buffers.Bands.size() < stageCount + 1)
+			buffers.Bands.resize(stageCount + 1);
+
+		// From the last stage back, the rows each has to compute for this strip, and so the rows its input has to
+		// hold.  The line buffers still hold most of those from the strip before.
+		std::vector<RowRange>& needed = buffers.Needed;
+		std::vector<RowRange>& fresh = buffers.Fresh;
+		needed.resize(stageCount + 1);
+		fresh.resize(stageCount + 1);
+		needed[stageCount] = fresh[stageCount] = { rowBegin, rowEnd };
+		for (size_t k = stageCount; k > 0; k--)
+		{
+			const Stage& stage = m_Stages[firstStage + k - 1];
+			LineBuffer&	 band = buffers.Bands[k - 1];
+			if (fresh[k].IsEmpty())
+			{
+				needed[k - 1] = band.Held;
+				fresh[k - 1] = {};
+				continue;
+			}
+			needed[k - 1] = { fresh[k].Begin - std::min(fresh[k].Begin, stage.RowsBefore),
+				std::min(height, fresh[k].End + stage.RowsAfter) };
+			fresh[k - 1] = Remaining(band.Held, needed[k - 1]);
+		}
+
+		// The horizontal bloom blur keeps the rows the vertical one reads, and needs new linear rows for the rest.
+		const RowRange bloomNeed = { rowBegin - std::min(rowBegin, bloomRows), std::min(height, rowEnd + bloomRows) };
+		RowRange	   bloomFresh;
+		if (radialBloom)
+			bloomFresh = Slide(buffers.BloomBlur, bloomNeed, width);
+
+		RowRange linearNeed = source ? RowRange() : needed[0];
+		if (!bloomFresh.IsEmpty())
+			linearNeed = linearNeed.IsEmpty() ? bloomFresh
+											  : RowRange { std::min(linearNeed.Begin, bloomFresh.Begin),
+													std::max(linearNeed.End, bloomFresh.End) };
+
+		CpuImageView input = source ? source->GetView() : CpuImageView();
+		if (!source && stageCount == 0 && frame)
+			Linearize(image, frame->GetTarget(), rowBegin, rowEnd);
+		else if (!linearNeed.IsEmpty())
+		{
+			LineBuffer&	   linear = buffers.Bands[0];
+			const RowRange linearFresh = Slide(linear, linearNeed, width);
+			if (!linearFresh.IsEmpty())
+				Linearize(image, linear.Image.GetBandTarget(linearNeed.Begin, height), linearFresh.Begin,
+					linearFresh.End);
+			if (!source)
+				input = linear.Image.GetBandView(linearNeed.Begin, height);
+		}
+
+		CpuImageView bloom;
+		if (radialBloom)
+		{
+			CpuRadialBloomParameters parameters = m_RadialBloomParameters;
+			if (!bloomFresh.IsEmpty())
+			{
+				const LineBuffer& linear = buffers.Bands[0];
+				buffers.BloomExtract.Resize(width, bloomFresh.End - bloomFresh.Begin);
+				parameters.Input = linear.Image.GetBandView(linear.Held.Begin, height);
+				parameters.Output = buffers.BloomExtract.GetBandTarget(bloomFresh.Begin, height);
+				m_Kernels.RadialBloomExtract(parameters, bloomFresh.Begin, bloomFresh.End);
+
+				parameters.Input = buffers.BloomExtract.GetBandView(bloomFresh.Begin, height);
+				parameters.Output = buffers.BloomBlur.Image.GetBandTarget(bloomNeed.Begin, height);
+				m_Kernels.RadialBloomBlur(parameters, bloomFresh.Begin, bloomFresh.End);
+			}
+
+			buffers.Bloom.Resize(width, rowEnd - rowBegin);
+			parameters.Vertical = true;
+			parameters.Input = buffers.BloomBlur.Image.GetBandView(bloomNeed.Begin, height);
+			parameters.Output = buffers.Bloom.GetBandTarget(rowBegin, height);
+			m_Kernels.RadialBloomBlur(parameters, rowBegin, rowEnd);
+			bloom = buffers.Bloom.GetBandView(rowBegin, height);
+		}
+
+		for (size_t k = 1; k <= stageCount; k++)
+		{
+			CpuImageTarget output;
+			if (k == stageCount && frame)
+				output = frame->GetTarget();
+			else if (k == stageCount)
+			{
+				buffers.Output.Resize(width, rowEnd - rowBegin);
+				output = buffers.Output.GetBandTarget(rowBegin, height);
+			}
+			else
+			{
+				LineBuffer& band = buffers.Bands[k];
+				fresh[k] = fresh[k].IsEmpty() ? fresh[k] : Slide(band, needed[k], width);
+				output = band.Image.GetBandTarget(band.Held.Begin, height);
+			}
+			if (!fresh[k].IsEmpty())
+				m_Stages[firstStage + k - 1].Run(input, output, fresh[k].Begin, fresh[k].End);
+			input = AsView(output);
+		}
+		if (frame)
+			return;
+
+		CpuCompositeParameters parameters = composite;
+		parameters.Input = input;
+		if (radialBloom)
+			parameters.Bloom = bloom;
+		m_Kernels.Composite(parameters, rowBegin, rowEnd);
+	};
+	ForEachStrip(height, GetStripRows(width, halo, std::max(bands, 1u)), strip);
+}
+
+bool CpuPipeline::Encode(ImagePipeline& pipeline, const CpuInputImage& image, std::vector<uint8_t>& encoded)
+{
+	Process(pipeline, image, m_EncodeBuffer);
+	return askygg::Texture2D::EncodeJPEG(m_EncodeBuffer.data(), image.Width, image.Height, encoded);
+}
+
+uint64_t CpuPipeline::GetMemorySize() const
+{
+	uint64_t size = m_SensorNoise.GetMemorySize() + m_BloomDirt.GetMemorySize() + m_EncodeBuffer.capacity();
+	for (const CpuImage& image : m_Images)
+		size += image.GetMemorySize();
+	for (const StripBuffers& buffers : m_StripBuffers)
+	{
+		for (const LineBuffer& band : buffers.Bands)
+			size += band.Image.GetMemorySize();
+		size += buffers.BloomBlur.Image.GetMemorySize() + buffers.BloomExtract.GetMemorySize() +
+			buffers.Bloom.GetMemorySize() + buffers.Output.GetMemorySize();
+	}
+	for (const CpuImage& image : m_RadialBloom)
+		size += image.GetMemorySize();
+	for (const auto& chain : m_BloomChains)
+		for (const CpuImage& level : chain)
+			size += level.GetMemorySize();
+	return size;
+}
+
+bool CpuPipeline::BuildStage(ImagePipeline& pipeline, ImagePassType type, uint32_t height, Stage& stage)
+{
+	if (pipeline.GetPass(type)->IsIdentity())
+	{
+		m_SkippedPassCount++;
+		return false;
+	}
+
+	switch (type)
+	{
+	case ImagePassType::ContrastBrightness:
+	{
+		const auto&		settings = GetSettings<ContrastBrightnessPass>(pipeline, type);
+		CpuPointwiseOp& op = stage.Pointwise.Ops[stage.Pointwise.OpCount++];
+		op.Type = CpuPointwiseOpType::ContrastBrightness;
+		op.ContrastBrightness.Contrast = settings.ContrastStrength;
+		op.ContrastBrightness.Brightness = settings.Brightness;
+		stage.Run = Bind(m_Kernels.Pointwise, stage.Pointwise);
+		break;
+	}
+	case ImagePassType::HueShift:
+	{
+		// Clamped as HSVAdjustmentPass::Submit() clamps them.
+		const auto&		settings = GetSettings<HSVAdjustmentPass>(pipeline, type);
+		CpuPointwiseOp& op = stage.Pointwise.Ops[stage.Pointwise.OpCount++];
+		op.Type = CpuPointwiseOpType::HueShift;
+		op.HueShift.HueShift = std::clamp(settings.HueShift, -1.0f, 1.0f);
+		op.HueShift.SaturationBoost = std::clamp(settings.SaturationBoost, -1.0f, 1.0f);
+		op.HueShift.ValueBoost = std::clamp(settings.ValueBoost, -1.0f, 1.0f);
+		stage.Run = Bind(m_Kernels.Pointwise, stage.Pointwise);
+		break;
+	}
+	case ImagePassType::Sobel:
+	{
+		const auto&		   settings = GetSettings<SobelPass>(pipeline, type);
+		CpuSobelParameters parameters;
+		parameters.Strength = settings.SobelStrength;
+		parameters.Threshold = settings.Threshold;
+		parameters.KernelScale = m_ResolutionScale;
+		stage.Run = Bind(m_Kernels.Sobel, parameters);
+		// Filtered taps (the border columns', and all of them when scaled) may touch the row past the one they are on,
+		// and the clamp to [texel, 1 - texel] pulls border rows in by up to a tap.
+		stage.RowsBefore = stage.RowsAfter =
+			m_ResolutionScale == 1.0f ? 2 : 2 * (uint32_t)std::ceil(m_ResolutionScale) + 2;
+		break;
+	}
+	case ImagePassType::Sharpen:
+	{
+		const auto&			 settings = GetSettings<SharpenPass>(pipeline, type);
+		CpuSharpenParameters parameters;
+		parameters.Strength = settings.SharpenStrength;
+		parameters.KernelScale = m_ResolutionScale;
+		stage.Run = Bind(m_Kernels.Sharpen, parameters);
+		stage.RowsBefore = stage.RowsAfter =
+			m_ResolutionScale == 1.0f ? 1 : (uint32_t)std::ceil(m_ResolutionScale) + 2;
+		break;
+	}
+	case ImagePassType::RadialBlur:
+	{
+		const auto&				settings = GetSettings<RadialBlurPass>(pipeline, type);
+		CpuRadialBlurParameters parameters;
+		parameters.Strength = settings.BlurStrength;
+		parameters.DirectionX = settings.BlurDirection.x;
+		parameters.DirectionY = settings.BlurDirection.y;
+		parameters.Samples = settings.BlurSamples;
+		stage.Run = Bind(m_Kernels.RadialBlur, parameters);
+		// Taps reach half the blur's length either way, plus the filter's second row.  A single tap divides by zero
+		// and lands anywhere.
+		const float reach = 0.5f * std::abs(parameters.DirectionY * parameters.Strength) * height;
+		stage.RowsBefore = stage.RowsAfter = (uint32_t)std::min(std::ceil(reach), (float)height) + 2;
+		stage.WholeFrame = parameters.Samples < 2 || !std::isfinite(reach);
+		break;
+	}
+	case ImagePassType::ChromaticAberration:
+	{
+		const auto&						 settings = GetSettings<ChromaticAberrationPass>(pipeline, type);
+		CpuChromaticAberrationParameters parameters;
+		parameters.Strength = settings.Strength;
+		stage.Run = Bind(m_Kernels.ChromaticAberration, parameters);
+		break;
+	}
+	case ImagePassType::BarrelDistortion:
+	{
+		const auto&					  settings = GetSettings<BarrelDistortionPass>(pipeline, type);
+		CpuBarrelDistortionParameters parameters;
+		parameters.DistortionX = settings.DistortionStrength.x;
+		parameters.DistortionY = settings.DistortionStrength.y;
+		stage.Run = Bind(m_Kernels.BarrelDistortion, parameters);
+		// Maps every pixel to anywhere in the frame.
+		stage.WholeFrame = true;
+		break;
+	}
+	case ImagePassType::Vignette:
+	{
+		const auto&			  settings = GetSettings<VignettePass>(pipeline, type);
+		CpuVignetteParameters parameters;
+		parameters.Radius = settings.Radius;
+		parameters.Softness = settings.Softness;
+		stage.Run = Bind(m_Kernels.Vignette, parameters);
+		// Filters between each row and the one below it.
+		stage.RowsBefore = 1;
+		break;
+	}
+	default:
+		// Bloom is not an ordered pass; ValidateSettings() keeps anything else out of the order.
+		return false;
+	}
+
+	// Past this, a strip would mostly compute rows for its neighbours.
+	if (stage.RowsBefore + stage.RowsAfter > height / 4)
+		stage.WholeFrame = true;
+	return true;
+}
+
+void CpuPipeline::AddStage(Stage&& stage)
+{
+	// A run of pointwise passes loads and stores each pixel once, and needs no image between its passes.
+	Stage* last = m_Stages.empty() ? nullptr : &m_Stages.back();
+	if (!last || !stage.Pointwise.OpCount || !last->Pointwise.OpCount ||
+		last->Pointwise.OpCount == CpuPointwiseParameters::MaxOpCount)
+	{
+		m_Stages.push_back(std::move(stage));
+		return;
+	}
+
+	last->Pointwise.Ops[last->Pointwise.OpCount++] = stage.Pointwise.Ops[0];
+	last->Run = Bind(m_Kernels.Pointwise, last->Pointwise);
+}
+
+void CpuPipeline::PrepareRadialBloom(const RadialBloomSettings& settings)
+{
+	// RadialBloomPass::Submit()'s footprint for a downscaled preview.
+	int radiusPixels = settings.BloomRadiusPixels;
+	if (radiusPixels > 0 && m_ResolutionScale < 1.0f)
+		radiusPixels = std::max(1, (int)std::lround((float)radiusPixels * m_ResolutionScale));
+
+	// GaussianFn() per tap; the shader's pow(x, 2.0) is x * x.
+	const float sigma = (float)radiusPixels / std::max(0.0001f, settings.SigmaScaleFactor);
+	m_RadialBloomWeights.clear();
+	for (int i = -radiusPixels; i <= radiusPixels; i++)
+	{
+		const float x = (float)i / sigma;
+		m_RadialBloomWeights.push_back(settings.BloomAmplitude * std::exp(-0.5f * (x * x)));
+	}
+
+	CpuRadialBloomParameters& parameters = m_RadialBloomParameters;
+	parameters = {};
+	parameters.LuminanceThreshold = settings.LuminanceThreshold;
+	parameters.Amplitude = settings.BloomAmplitude;
+	parameters.SigmaScaleFactor = settings.SigmaScaleFactor;
+	parameters.BlurColorWeight = settings.BlurColorWeight;
+	parameters.RadiusPixels = radiusPixels;
+	parameters.Weights = m_RadialBloomWeights.data();
+}
+
+CpuImageView CpuPipeline::RunRadialBloom(const CpuImage& input)
+{
+	for (CpuImage& image : m_RadialBloom)
+		image.Resize(input.Width, input.Height);
+
+	CpuRadialBloomParameters parameters = m_RadialBloomParameters;
+	parameters.Input = input.GetView();
+	parameters.Output = m_RadialBloom[0].GetTarget();
+	Run(m_Kernels.RadialBloomExtract, parameters, input.Height);
+
+	parameters.Input = m_RadialBloom[0].GetView();
+	parameters.Output = m_RadialBloom[1].GetTarget();
+	Run(m_Kernels.RadialBloomBlur, parameters, input.Height);
+
+	parameters.Vertical = true;
+	parameters.Input = m_RadialBloom[1].GetView();
+	parameters.Output = m_RadialBloom[0].GetTarget();
+	Run(m_Kernels.RadialBloomBlur, parameters, input.Height);
+	return m_RadialBloom[0].GetView();
+}
+
+CpuImageView CpuPipeline::RunMultiPassBloom(const MultiPassBloomSettings& settings, const CpuInputImage& image,
+	const CpuImage* linear)
+{
+	// MultiPassBloomPass::CreateTargets(): half size, padded up past a multiple of the work group size.
+	uint32_t width = image.Width / 2, height = image.Height / 2;
+	width += 4 - width % 4;
+	height += 4 - height % 4;
+	const uint32_t levelCount = (uint32_t)std::floor(std::log2((float)std::min(width, height))) + 1;
+	const uint32_t mips = levelCount - 2;
+
+	const auto level = [&](uint32_t chain, uint32_t mip) -> CpuImage& {
+		std::vector<CpuImage>& levels = m_BloomChains[chain];
+		levels.resize(levelCount);
+		levels[mip].Resize(std::max(1u, width >> mip), std::max(1u, height >> mip));
+		return levels[mip];
+	};
+
+	CpuBloomDownsampleParameters downsample;
+	downsample.Prefilter = true;
+	downsample.Threshold = settings.BloomThreshold;
+	downsample.Knee = settings.BloomKnee;
+	downsample.Output = level(0, 0).GetTarget();
+	if (linear)
+	{
+		downsample.Input = linear->GetView();
+		Run(m_Kernels.BloomDownsample, downsample, downsample.Output.Height);
+	}
+	else
+	{
+		// Level 0's row y reads the input a texel either side of (y + 0.5) * image.Height / height, filtered.
+		const uint32_t levelHeight = downsample.Output.Height;
+		const uint32_t stripRows = std::max(1u, GetStripRows(image.Width, 8, 1) * levelHeight / image.Height);
+		ForEachStrip(levelHeight, stripRows, [&](StripBuffers& buffers, uint32_t rowBegin, uint32_t rowEnd) {
+			if (buffers.Bands.empty())
+				buffers.Bands.resize(1);
+			const double   scale = (double)image.Height / levelHeight;
+			const RowRange need = { (uint32_t)std::max(std::floor(rowBegin * scale) - 3.0, 0.0),
+				(uint32_t)std::min(std::ceil(rowEnd * scale) + 3.0, (double)image.Height) };
+			LineBuffer&	   linear = buffers.Bands[0];
+			const RowRange fresh = Slide(linear, need, image.Width);
+			if (!fresh.IsEmpty())
+				Linearize(image, linear.Image.GetBandTarget(need.Begin, image.Height), fresh.Begin, fresh.End);
+
+			CpuBloomDownsampleParameters parameters = downsample;
+			parameters.Input = linear.Image.GetBandView(need.Begin, image.Height);
+			m_Kernels.BloomDownsample(parameters, rowBegin, rowEnd);
+		});
+	}
+
+	downsample.Prefilter = false;
+	for (uint32_t mip = 1; mip < mips; mip++)
+	{
+		downsample.Input = m_BloomChains[0][mip - 1].GetView();
+		downsample.Output = level(1, mip).GetTarget();
+		Run(m_Kernels.BloomDownsample, downsample, downsample.Output.Height);
+
+		downsample.Input = m_BloomChains[1][mip].GetView();
+		downsample.Output = level(0, mip).GetTarget();
+		Run(m_Kernels.BloomDownsample, downsample, downsample.Output.Height);
+	}
+
+	CpuImage& result = level(2, 0);
+	// Too small for the chain; the GPU pass leaves its output undefined.
+	if (mips < 2)
+	{
+		std::fill(result.Pixels.begin(), result.Pixels.end(), 0.0f);
+		return result.GetView();
+	}
+
+	CpuBloomUpsampleParameters upsample;
+	upsample.Radius = settings.Radius;
+	upsample.TightenFactor = settings.UpsampleTightenFactor;
+	upsample.Existing = m_BloomChains[0][mips - 2].GetView();
+	upsample.Lower = m_BloomChains[0][mips - 1].GetView();
+	upsample.Output = level(2, mips - 2).GetTarget();
+	Run(m_Kernels.BloomUpsample, upsample, upsample.Output.Height);
+
+	for (int32_t mip = (int32_t)mips - 3; mip >= 0; mip--)
+	{
+		upsample.Existing = m_BloomChains[0][mip].GetView();
+		upsample.Lower = m_BloomChains[2][mip + 1].GetView();
+		upsample.Output = level(2, mip).GetTarget();
+		Run(m_Kernels.BloomUpsample, upsample, upsample.Output.Height);
+	}
+	return m_BloomChains[2][0].GetView();
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "CpuImage.h"
+#include "CpuKernels.h"
+#include "CpuThreadPool.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class ImagePipeline;
+struct MultiPassBloomSettings;
+struct RadialBloomSettings;
+enum class ImagePassType;
+
+enum class CpuSchedule
+{
+	// Each pass over the whole frame before the next, every intermediate a full RGBA32F frame.
+	Frames,
+	// The passes fused over horizontal strips sized to the L2 cache, each strip on one thread from the input bytes to
+	// the output bytes, holding only the rows of each intermediate that the stencils downstream read.
+	Strips
+};
+
+struct CpuPipelineSpecification
+{
+	// Threads the row tiles or strips are spread over, the calling thread included.  0 uses every hardware thread.
+	uint32_t		  ThreadCount = 0;
+	// Narrower kernels than the CPU could run, e.g. to compare instruction sets.
+	CpuInstructionSet InstructionSet = CpuInstructionSet::AVX2;
+	CpuSchedule		  Schedule = CpuSchedule::Strips;
+	// What one strip's line buffers should take up.  0 is the L2 cache size, or 1 MiB where it is not known.
+	uint32_t		  StripBytes = 0;
+};
+
+// The passes of an ImagePipeline on the CPU, for hosts without a usable GPU.  Takes the pass order, bloom type and
+// every pass's settings from the pipeline, which only has to be initialized for the CPU (InitializeForCpu()), and runs
+// the same graph Submit() would, on a thread pool, frame by frame or strip by strip (CpuSchedule).  Both schedules
+// give the same bytes, and match the GPU within the tolerance README.md gives.  One image at a time per instance.
+class CpuPipeline
+{
+public:
+	explicit CpuPipeline(const CpuPipelineSpecification& specification = {});
+
+	// Runs pipeline's passes, with its settings as they stand, over image.  output becomes RGBA8, top row first.
+	void Process(ImagePipeline& pipeline, const CpuInputImage& image, std::vector<uint8_t>& output);
+	// Process() and the JPEG ImagePipeline::Encode() would write.  False if encoding failed.
+	bool Encode(ImagePipeline& pipeline, const CpuInputImage& image, std::vector<uint8_t>& encoded);
+
+	// See ImagePass::SetResolutionScale().
+	void SetResolutionScale(float scale) { m_ResolutionScale = scale; }
+
+	const CpuKernelTable& GetKernels() const { return m_Kernels; }
+	uint32_t			  GetThreadCount() const { return m_ThreadPool.GetThreadCount(); }
+	// Identity passes Process() did not run, like ImagePipeline::GetElidedDispatchCount().
+	uint64_t			  GetSkippedPassCount() const { return m_SkippedPassCount; }
+	// Every intermediate image and line buffer this instance holds on to.
+	uint64_t			  GetMemorySize() const;
+
+private:
+	using StageFunction = std::function<void(const CpuImageView& input, const CpuImageTarget& output,
+		uint32_t rowBegin, uint32_t rowEnd)>;
+
+	// One of the ordered passes, bound to its settings.  Run() computes output rows [rowBegin, rowEnd) and reads
+	// input rows rowBegin - RowsBefore to rowEnd - 1 + RowsAfter, clamped to the image.
+	struct Stage
+	{
+		StageFunction Run;
+		uint32_t	  RowsBefore = 0;
+		uint32_t	  RowsAfter = 0;
+		// Reads too far from its output rows to be worth streaming; the strip schedule gives it whole frames.
+		bool		  WholeFrame = false;
+		// The pointwise passes Run() applies, for a stage made of them; OpCount is 0 for any other.
+		CpuPointwiseParameters Pointwise;
+	};
+
+	struct RowRange
+	{
+		uint32_t Begin = 0;
+		uint32_t End = 0;
+
+		bool IsEmpty() const { return Begin >= End; }
+	};
+
+	// Rows Held of an intermediate, from the front of Image, for the strips after the one that computed them.
+	struct LineBuffer
+	{
+		CpuImage Image;
+		RowRange Held;
+	};
+
+	// One thread's line buffers for the strip schedule.  Bands[0] is the linearized input and Bands[k] the output of
+	// the k-th streamed stage; the last stage's output goes straight on.
+	struct StripBuffers
+	{
+		std::vector<LineBuffer> Bands;
+		LineBuffer				BloomBlur;
+		// This strip's rows only.
+		CpuImage				BloomExtract;
+		CpuImage				Bloom;
+		CpuImage				Output;
+		std::vector<RowRange>	Needed;
+		std::vector<RowRange>	Fresh;
+
+		void Reset()
+		{
+			for (LineBuffer& band : Bands)
+				band.Held = {};
+			BloomBlur.Held = {};
+		}
+	};
+
+	// Runs kernel over rows, a tile of rows per thread pool chunk.
+	template <typename Parameters>
+	void Run(void (*kernel)(const Parameters&, uint32_t, uint32_t), const Parameters& parameters, uint32_t rows);
+	// Calls function(rowBegin, rowEnd) for tiles of rows.
+	template <typename Function>
+	void RunTiles(uint32_t rows, const Function& function);
+	// Calls function(buffers, rowBegin, rowEnd) for strips of stripRows rows, in order within runs of them that each
+	// go to one thread, with buffers reset at the start of each run.
+	template <typename Function>
+	void ForEachStrip(uint32_t rows, uint32_t stripRows, const Function& function);
+	// Rows per strip of an image width wide, for bands line buffers holding halo rows beyond their strips in total.
+	uint32_t GetStripRows(uint32_t width, uint32_t halo, uint32_t bands) const;
+
+	// False when the pass's settings make it an identity.
+	bool BuildStage(ImagePipeline& pipeline, ImagePassType type, uint32_t height, Stage& stage);
+	// Appends stage to the last of m_Stages when both are pointwise and the run has room, else adds it.
+	void AddStage(Stage&& stage);
+	void Linearize(const CpuInputImage& image, const CpuImageTarget& output, uint32_t rowBegin, uint32_t rowEnd);
+
+	void ProcessFrames(ImagePipeline& pipeline, const CpuInputImage& image, CpuCompositeParameters& composite);
+	void ProcessStrips(ImagePipeline& pipeline, const CpuInputImage& image, CpuCompositeParameters& composite);
+	// Streams m_Stages[firstStage, endStage) over strips, from source (the linearized input when null) into frame,
+	// or through the composite when frame is null.
+	void RunStrips(const CpuInputImage& image, const CpuImage* source, size_t firstStage, size_t endStage,
+		CpuImage* frame, const CpuCompositeParameters& composite);
+
+	void		 PrepareRadialBloom(const RadialBloomSettings& settings);
+	CpuImageView RunRadialBloom(const CpuImage& input);
+	// Returns level 0 of the upsampled chain.  The prefilter reads linear, or linearizes image strip by strip when
+	// linear is null.
+	CpuImageView RunMultiPassBloom(const MultiPassBloomSettings& settings, const CpuInputImage& image,
+		const CpuImage* linear);
+
+private:
+	const CpuKernelTable& m_Kernels;
+	CpuThreadPool		  m_ThreadPool;
+	CpuSchedule			  m_Schedule;
+	uint32_t			  m_StripBytes;
+	float				  m_ResolutionScale = 1.0f;
+	uint64_t			  m_SkippedPassCount = 0;
+	// Drives the sensor noise like OutputComputePass's clock.
+	std::chrono::time_point<std::chrono::high_resolution_clock> m_Start;
+
+	float	 m_LinearizeTable[256];
+	CpuImage m_SensorNoise;
+	CpuImage m_BloomDirt;
+
+	// The active ordered passes of the image being processed.
+	std::vector<Stage> m_Stages;
+
+	// The image between passes, ping-ponged; on the strip schedule, only the input of a whole-frame stage.
+	CpuImage				  m_Images[2];
+	std::vector<StripBuffers> m_StripBuffers;
+	// Radial bloom's extraction and its two blur directions take turns in these.
+	CpuImage				  m_RadialBloom[2];
+	std::vector<float>		  m_RadialBloomWeights;
+	CpuRadialBloomParameters  m_RadialBloomParameters;
+	// MultiPassBloomPass's three mip chains, a level per image.
+	std::vector<CpuImage> m_BloomChains[3];
+	std::vector<uint8_t>  m_EncodeBuffer;
+};
@@ -0,0 +1,354 @@
+#pragma once
+
+// Lanes of floats for the CPU kernels, as wide as the instruction set the including translation unit is compiled for:
+// 8 with AVX2, 4 with SSE2, 1 elsewhere.  Every kernel unit names its own namespace with YGG_CPU_ISA before including
+// this, so the differently compiled copies never meet at link time.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+	#define YGG_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define YGG_SIMD_SSE2
+#endif
+
+#ifndef YGG_CPU_ISA
+	#error "Define YGG_CPU_ISA to the namespace of this instruction set's kernels."
+#endif
+
+namespace YGG_CPU_ISA
+{
+#if defined(YGG_SIMD_AVX2)
+	struct Lanes
+	{
+		static constexpr uint32_t Count = 8;
+		__m256					  Value;
+
+		Lanes() = default;
+		Lanes(__m256 value) : Value(value) {}
+		Lanes(float value) : Value(_mm256_set1_ps(value)) {}
+
+		static Lanes Load(const float* data) { return _mm256_loadu_ps(data); }
+		void		 Store(float* data) const { _mm256_storeu_ps(data, Value); }
+		static Lanes Sequence() { return _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f); }
+	};
+
+	inline Lanes operator+(Lanes a, Lanes b) { return _mm256_add_ps(a.Value, b.Value); }
+	inline Lanes operator-(Lanes a, Lanes b) { return _mm256_sub_ps(a.Value, b.Value); }
+	inline Lanes operator*(Lanes a, Lanes b) { return _mm256_mul_ps(a.Value, b.Value); }
+	inline Lanes operator/(Lanes a, Lanes b) { return _mm256_div_ps(a.Value, b.Value); }
+	inline Lanes operator-(Lanes a) { return _mm256_xor_ps(a.Value, _mm256_set1_ps(-0.0f)); }
+	// Comparisons give masks of all-one lanes for Select().
+	inline Lanes operator<(Lanes a, Lanes b) { return _mm256_cmp_ps(a.Value, b.Value, _CMP_LT_OQ); }
+	inline Lanes operator<=(Lanes a, Lanes b) { return _mm256_cmp_ps(a.Value, b.Value, _CMP_LE_OQ); }
+	inline Lanes operator>(Lanes a, Lanes b) { return _mm256_cmp_ps(a.Value, b.Value, _CMP_GT_OQ); }
+	inline Lanes operator>=(Lanes a, Lanes b) { return _mm256_cmp_ps(a.Value, b.Value, _CMP_GE_OQ); }
+	inline Lanes operator&(Lanes a, Lanes b) { return _mm256_and_ps(a.Value, b.Value); }
+	inline Lanes operator|(Lanes a, Lanes b) { return _mm256_or_ps(a.Value, b.Value); }
+
+	inline Lanes Select(Lanes mask, Lanes a, Lanes b) { return _mm256_blendv_ps(b.Value, a.Value, mask.Value); }
+	// NaN lanes of a come out as b, like an image store clamps them.
+	inline Lanes Min(Lanes a, Lanes b) { return _mm256_min_ps(a.Value, b.Value); }
+	inline Lanes Max(Lanes a, Lanes b) { return _mm256_max_ps(a.Value, b.Value); }
+	inline Lanes Abs(Lanes a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.Value); }
+	inline Lanes Floor(Lanes a) { return _mm256_floor_ps(a.Value); }
+	inline Lanes Round(Lanes a) { return _mm256_round_ps(a.Value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+	inline Lanes Sqrt(Lanes a) { return _mm256_sqrt_ps(a.Value); }
+	inline Lanes Fma(Lanes a, Lanes b, Lanes c) { return _mm256_fmadd_ps(a.Value, b.Value, c.Value); }
+
+	// x = m * 2^e with m in [1, 2).
+	inline Lanes SplitExponent(Lanes x, Lanes& exponent)
+	{
+		const __m256i bits = _mm256_castps_si256(x.Value);
+		exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+		return _mm256_castsi256_ps(
+			_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x3f800000)));
+	}
+	// 2^n for integral n in [-126, 127].
+	inline Lanes PowerOfTwo(Lanes n)
+	{
+		const __m256i exponent = _mm256_add_epi32(_mm256_cvtps_epi32(n.Value), _mm256_set1_epi32(127));
+		return _mm256_castsi256_ps(_mm256_slli_epi32(exponent, 23));
+	}
+#elif defined(YGG_SIMD_SSE2)
+	struct Lanes
+	{
+		static constexpr uint32_t Count = 4;
+		__m128					  Value;
+
+		Lanes() = default;
+		Lanes(__m128 value) : Value(value) {}
+		Lanes(float value) : Value(_mm_set1_ps(value)) {}
+
+		static Lanes Load(const float* data) { return _mm_loadu_ps(data); }
+		void		 Store(float* data) const { _mm_storeu_ps(data, Value); }
+		static Lanes Sequence() { return _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f); }
+	};
+
+	inline Lanes operator+(Lanes a, Lanes b) { return _mm_add_ps(a.Value, b.Value); }
+	inline Lanes operator-(Lanes a, Lanes b) { return _mm_sub_ps(a.Value, b.Value); }
+	inline Lanes operator*(Lanes a, Lanes b) { return _mm_mul_ps(a.Value, b.Value); }
+	inline Lanes operator/(Lanes a, Lanes b) { return _mm_div_ps(a.Value, b.Value); }
+	inline Lanes operator-(Lanes a) { return _mm_xor_ps(a.Value, _mm_set1_ps(-0.0f)); }
+	inline Lanes operator<(Lanes a, Lanes b) { return _mm_cmplt_ps(a.Value, b.Value); }
+	inline Lanes operator<=(Lanes a, Lanes b) { return _mm_cmple_ps(a.Value, b.Value); }
+	inline Lanes operator>(Lanes a, Lanes b) { return _mm_cmpgt_ps(a.Value, b.Value); }
+	inline Lanes operator>=(Lanes a, Lanes b) { return _mm_cmpge_ps(a.Value, b.Value); }
+	inline Lanes operator&(Lanes a, Lanes b) { return _mm_and_ps(a.Value, b.Value); }
+	inline Lanes operator|(Lanes a, Lanes b) { return _mm_or_ps(a.Value, b.Value); }
+
+	// SSE2 has no blend; and/andnot/or does the same with a full-lane mask.
+	inline Lanes Select(Lanes mask, Lanes a, Lanes b)
+	{
+		return _mm_or_ps(_mm_and_ps(mask.Value, a.Value), _mm_andnot_ps(mask.Value, b.Value));
+	}
+	inline Lanes Min(Lanes a, Lanes b) { return _mm_min_ps(a.Value, b.Value); }
+	inline Lanes Max(Lanes a, Lanes b) { return _mm_max_ps(a.Value, b.Value); }
+	inline Lanes Abs(Lanes a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.Value); }
+	// Truncation corrected towards -inf; lanes beyond 2^23 are integral already and pass through.
+	inline Lanes Floor(Lanes a)
+	{
+		const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.Value));
+		const __m128 floored = _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, a.Value), _mm_set1_ps(1.0f)));
+		return Select(_mm_cmplt_ps(Abs(a).Value, _mm_set1_ps(8388608.0f)), floored, a);
+	}
+	inline Lanes Round(Lanes a)
+	{
+		const __m128 rounded = _mm_cvtepi32_ps(_mm_cvtps_epi32(a.Value));
+		return Select(_mm_cmplt_ps(Abs(a).Value, _mm_set1_ps(8388608.0f)), rounded, a);
+	}
+	inline Lanes Sqrt(Lanes a) { return _mm_sqrt_ps(a.Value); }
+	inline Lanes Fma(Lanes a, Lanes b, Lanes c) { return a * b + c; }
+
+	inline Lanes SplitExponent(Lanes x, Lanes& exponent)
+	{
+		const __m128i bits = _mm_castps_si128(x.Value);
+		exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+		return _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000)));
+	}
+	inline Lanes PowerOfTwo(Lanes n)
+	{
+		const __m128i exponent = _mm_add_epi32(_mm_cvtps_epi32(n.Value), _mm_set1_epi32(127));
+		return _mm_castsi128_ps(_mm_slli_epi32(exponent, 23));
+	}
+#else
+	struct Lanes
+	{
+		static constexpr uint32_t Count = 1;
+		float					  Value;
+
+		Lanes() = default;
+		Lanes(float value) : Value(value) {}
+
+		static Lanes Load(const float* data) { return *data; }
+		void		 Store(float* data) const { *data = Value; }
+		static Lanes Sequence() { return 0.0f; }
+	};
+
+	inline float MaskOf(bool condition)
+	{
+		const uint32_t bits = condition ? 0xffffffffu : 0u;
+		float		   mask;
+		std::memcpy(&mask, &bits, sizeof(mask));
+		return mask;
+	}
+	inline uint32_t BitsOf(float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+	inline float FloatOf(uint32_t bits)
+	{
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	inline Lanes operator+(Lanes a, Lanes b) { return a.Value + b.Value; }
+	inline Lanes operator-(Lanes a, Lanes b) { return a.Value - b.Value; }
+	inline Lanes operator*(Lanes a, Lanes b) { return a.Value * b.Value; }
+	inline Lanes operator/(Lanes a, Lanes b) { return a.Value / b.Value; }
+	inline Lanes operator-(Lanes a) { return -a.Value; }
+	inline Lanes operator<(Lanes a, Lanes b) { return MaskOf(a.Value < b.Value); }
+	inline Lanes operator<=(Lanes a, Lanes b) { return MaskOf(a.Value <= b.Value); }
+	inline Lanes operator>(Lanes a, Lanes b) { return MaskOf(a.Value > b.Value); }
+	inline Lanes operator>=(Lanes a, Lanes b) { return MaskOf(a.Value >= b.Value); }
+	inline Lanes operator&(Lanes a, Lanes b) { return FloatOf(BitsOf(a.Value) & BitsOf(b.Value)); }
+	inline Lanes operator|(Lanes a, Lanes b) { return FloatOf(BitsOf(a.Value) | BitsOf(b.Value)); }
+
+	inline Lanes Select(Lanes mask, Lanes a, Lanes b) { return BitsOf(mask.Value) ? a : b; }
+	inline Lanes Min(Lanes a, Lanes b) { return a.Value < b.Value ? a : b; }
+	inline Lanes Max(Lanes a, Lanes b) { return a.Value > b.Value ? a : b; }
+	inline Lanes Abs(Lanes a) { return std::fabs(a.Value); }
+	inline Lanes Floor(Lanes a) { return std::floor(a.Value); }
+	inline Lanes Round(Lanes a) { return std::nearbyint(a.Value); }
+	inline Lanes Sqrt(Lanes a) { return std::sqrt(a.Value); }
+	inline Lanes Fma(Lanes a, Lanes b, Lanes c) { return a.Value * b.Value + c.Value; }
+
+	inline Lanes SplitExponent(Lanes x, Lanes& exponent)
+	{
+		const uint32_t bits = BitsOf(x.Value);
+		exponent = (float)((int32_t)(bits >> 23) - 127);
+		return FloatOf((bits & 0x007fffffu) | 0x3f800000u);
+	}
+	inline Lanes PowerOfTwo(Lanes n) { return FloatOf((uint32_t)((int32_t)n.Value + 127) << 23); }
+#endif
+
+	inline Lanes& operator+=(Lanes& a, Lanes b) { return a = a + b; }
+	inline Lanes& operator-=(Lanes& a, Lanes b) { return a = a - b; }
+	inline Lanes& operator*=(Lanes& a, Lanes b) { return a = a * b; }
+
+	inline Lanes Clamp(Lanes x, Lanes low, Lanes high) { return Min(Max(x, low), high); }
+	inline Lanes Fract(Lanes x) { return x - Floor(x); }
+	inline Lanes Mix(Lanes a, Lanes b, Lanes t) { return a + (b - a) * t; }
+	// GLSL step(): 0 below the edge, 1 from it on.
+	inline Lanes Step(Lanes edge, Lanes x) { return (x >= edge) & Lanes(1.0f); }
+
+	// Natural log for positive normal x, to about 2 ulp (Cephes logf).
+	inline Lanes Log(Lanes x)
+	{
+		Lanes exponent;
+		Lanes m = SplitExponent(x, exponent);
+		// Mantissa into [sqrt(1/2), sqrt(2)), where the polynomial holds.
+		const Lanes large = m > Lanes(1.41421356f);
+		m = Select(large, m * Lanes(0.5f), m);
+		exponent = Select(large, exponent + Lanes(1.0f), exponent);
+		const Lanes z = m - Lanes(1.0f);
+
+		Lanes p = Lanes(7.0376836292e-2f);
+		p = Fma(p, z, Lanes(-1.1514610310e-1f));
+		p = Fma(p, z, Lanes(1.1676998740e-1f));
+		p = Fma(p, z, Lanes(-1.2420140846e-1f));
+		p = Fma(p, z, Lanes(1.4249322787e-1f));
+		p = Fma(p, z, Lanes(-1.6668057665e-1f));
+		p = Fma(p, z, Lanes(2.0000714765e-1f));
+		p = Fma(p, z, Lanes(-2.4999993993e-1f));
+		p = Fma(p, z, Lanes(3.3333331174e-1f));
+		const Lanes z2 = z * z;
+		const Lanes y = Fma(z * z2, p, Lanes(-0.5f) * z2);
+		return Fma(exponent, Lanes(0.693147180559945f), z + y);
+	}
+
+	// e^x to about 2 ulp (Cephes expf); underflows to 0 below -87 and saturates above 88.
+	inline Lanes Exp(Lanes x)
+	{
+		x = Clamp(x, Lanes(-87.0f), Lanes(88.0f));
+		const Lanes n = Round(x * Lanes(1.44269504088896f));
+		// x - n ln 2 in two steps, so r keeps its low bits.
+		Lanes r = Fma(n, Lanes(-0.693359375f), x);
+		r = Fma(n, Lanes(2.12194440e-4f), r);
+
+		Lanes p = Lanes(1.9875691500e-4f);
+		p = Fma(p, r, Lanes(1.3981999507e-3f));
+		p = Fma(p, r, Lanes(8.3334519073e-3f));
+		p = Fma(p, r, Lanes(4.1665795894e-2f));
+		p = Fma(p, r, Lanes(1.6666665459e-1f));
+		p = Fma(p, r, Lanes(5.0000001201e-1f));
+		const Lanes y = Fma(p, r * r, r + Lanes(1.0f));
+		return y * PowerOfTwo(n);
+	}
+
+	// GLSL pow() for x >= 0; 0 where x is 0, negative or NaN.
+	inline Lanes Pow(Lanes x, Lanes y)
+	{
+		const Lanes positive = x > Lanes(0.0f);
+		const Lanes safe = Select(positive, x, Lanes(1.0f));
+		return Select(positive, Exp(y * Log(safe)), Lanes(0.0f));
+	}
+
+	// RGBA of Lanes::Count consecutive pixels, one lane per pixel.
+	struct Pixels
+	{
+		Lanes R, G, B, A;
+	};
+
+	inline Pixels operator+(const Pixels& a, const Pixels& b) { return { a.R + b.R, a.G + b.G, a.B + b.B, a.A + b.A }; }
+	inline Pixels operator*(const Pixels& a, Lanes s) { return { a.R * s, a.G * s, a.B * s, a.A * s }; }
+
+	// De-interleaves count (at most Lanes::Count) RGBA32F pixels; lanes past count are zero.
+	inline Pixels LoadPixels(const float* data, uint32_t count = Lanes::Count)
+	{
+#if defined(YGG_SIMD_AVX2)
+		if (count == Lanes::Count)
+		{
+			// Two pixels per register; a 4x4 transpose in each half leaves the lanes in 0 2 4 6 1 3 5 7 order.
+			const __m256 m0 = _mm256_loadu_ps(data), m1 = _mm256_loadu_ps(data + 8), m2 = _mm256_loadu_ps(data + 16),
+						 m3 = _mm256_loadu_ps(data + 24);
+			const __m256  t0 = _mm256_unpacklo_ps(m0, m1), t1 = _mm256_unpackhi_ps(m0, m1);
+			const __m256  t2 = _mm256_unpacklo_ps(m2, m3), t3 = _mm256_unpackhi_ps(m2, m3);
+			const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+			return { _mm256_permutevar8x32_ps(_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)), order),
+				_mm256_permutevar8x32_ps(_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)), order),
+				_mm256_permutevar8x32_ps(_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)), order),
+				_mm256_permutevar8x32_ps(_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)), order) };
+		}
+#elif defined(YGG_SIMD_SSE2)
+		if (count == Lanes::Count)
+		{
+			__m128 p0 = _mm_loadu_ps(data), p1 = _mm_loadu_ps(data + 4), p2 = _mm_loadu_ps(data + 8),
+				   p3 = _mm_loadu_ps(data + 12);
+			_MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+			return { p0, p1, p2, p3 };
+		}
+#endif
+		alignas(32) float channels[4][Lanes::Count] = {};
+		for (uint32_t i = 0; i < count; i++)
+		{
+			channels[0][i] = data[i * 4 + 0];
+			channels[1][i] = data[i * 4 + 1];
+			channels[2][i] = data[i * 4 + 2];
+			channels[3][i] = data[i * 4 + 3];
+		}
+		return { Lanes::Load(channels[0]), Lanes::Load(channels[1]), Lanes::Load(channels[2]),
+			Lanes::Load(channels[3]) };
+	}
+
+	inline void StorePixels(const Pixels& pixels, float* data, uint32_t count = Lanes::Count)
+	{
+#if defined(YGG_SIMD_AVX2)
+		if (count == Lanes::Count)
+		{
+			const __m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+			const __m256  r = _mm256_permutevar8x32_ps(pixels.R.Value, order);
+			const __m256  g = _mm256_permutevar8x32_ps(pixels.G.Value, order);
+			const __m256  b = _mm256_permutevar8x32_ps(pixels.B.Value, order);
+			const __m256  a = _mm256_permutevar8x32_ps(pixels.A.Value, order);
+			const __m256  u0 = _mm256_unpacklo_ps(r, g), u1 = _mm256_unpacklo_ps(b, a);
+			const __m256  u2 = _mm256_unpackhi_ps(r, g), u3 = _mm256_unpackhi_ps(b, a);
+			_mm256_storeu_ps(data, _mm256_shuffle_ps(u0, u1, _MM_SHUFFLE(1, 0, 1, 0)));
+			_mm256_storeu_ps(data + 8, _mm256_shuffle_ps(u0, u1, _MM_SHUFFLE(3, 2, 3, 2)));
+			_mm256_storeu_ps(data + 16, _mm256_shuffle_ps(u2, u3, _MM_SHUFFLE(1, 0, 1, 0)));
+			_mm256_storeu_ps(data + 24, _mm256_shuffle_ps(u2, u3, _MM_SHUFFLE(3, 2, 3, 2)));
+			return;
+		}
+#elif defined(YGG_SIMD_SSE2)
+		if (count == Lanes::Count)
+		{
+			__m128 p0 = pixels.R.Value, p1 = pixels.G.Value, p2 = pixels.B.Value, p3 = pixels.A.Value;
+			_MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+			_mm_storeu_ps(data, p0);
+			_mm_storeu_ps(data + 4, p1);
+			_mm_storeu_ps(data + 8, p2);
+			_mm_storeu_ps(data + 12, p3);
+			return;
+		}
+#endif
+		alignas(32) float channels[4][Lanes::Count];
+		pixels.R.Store(channels[0]);
+		pixels.G.Store(channels[1]);
+		pixels.B.Store(channels[2]);
+		pixels.A.Store(channels[3]);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			data[i * 4 + 0] = channels[0][i];
+			data[i * 4 + 1] = channels[1][i];
+			data[i * 4 + 2] = channels[2][i];
+			data[i * 4 + 3] = channels[3][i];
+		}
+	}
+}
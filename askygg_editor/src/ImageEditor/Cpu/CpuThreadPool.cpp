@@ -0,0 +1,80 @@
+#include "CpuThreadPool.h"
+
+#include <algorithm>
+
+CpuThreadPool::CpuThreadPool(uint32_t threadCount)
+{
+	if (threadCount == 0)
+		threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+	for (uint32_t i = 1; i < threadCount; i++)
+		m_Threads.emplace_back(&CpuThreadPool::Run, this);
+}
+
+CpuThreadPool::~CpuThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopped = true;
+	}
+	m_Condition.notify_all();
+	for (auto& thread : m_Threads)
+		thread.join();
+}
+
+void CpuThreadPool::ParallelFor(uint32_t count, uint32_t chunkSize,
+	const std::function<void(uint32_t, uint32_t)>& function)
+{
+	chunkSize = std::max(chunkSize, 1u);
+	const uint32_t chunkCount = (count + chunkSize - 1) / chunkSize;
+	if (m_Threads.empty() || chunkCount <= 1)
+	{
+		for (uint32_t begin = 0; begin < count; begin += chunkSize)
+			function(begin, std::min(begin + chunkSize, count));
+		return;
+	}
+
+	std::lock_guard<std::mutex>	 rangeLock(m_RangeMutex);
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	m_Function = &function;
+	m_Count = count;
+	m_ChunkSize = chunkSize;
+	m_NextChunk = 0;
+	m_ChunkCount = chunkCount;
+	m_DoneChunks = 0;
+	const uint64_t generation = ++m_Generation;
+	m_Condition.notify_all();
+
+	RunChunks(lock, generation);
+	m_DoneCondition.wait(lock, [this] { return m_DoneChunks == m_ChunkCount; });
+	m_Function = nullptr;
+}
+
+void CpuThreadPool::RunChunks(std::unique_lock<std::mutex>& lock, uint64_t generation)
+{
+	// A worker that woke up late for a finished range finds the next one's generation and leaves it to its own wake-up.
+	while (m_Generation == generation && m_NextChunk < m_ChunkCount)
+	{
+		const uint32_t								   begin = m_NextChunk++ * m_ChunkSize;
+		const uint32_t								   end = std::min(begin + m_ChunkSize, m_Count);
+		const std::function<void(uint32_t, uint32_t)>& function = *m_Function;
+		lock.unlock();
+		function(begin, end);
+		lock.lock();
+		if (++m_DoneChunks == m_ChunkCount)
+			m_DoneCondition.notify_all();
+	}
+}
+
+void CpuThreadPool::Run()
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	uint64_t					 seenGeneration = 0;
+	while (true)
+	{
+		m_Condition.wait(lock, [&] { return m_Stopped || m_Generation != seenGeneration; });
+		if (m_Stopped)
+			break;
+		seenGeneration = m_Generation;
+		RunChunks(lock, seenGeneration);
+	}
+}
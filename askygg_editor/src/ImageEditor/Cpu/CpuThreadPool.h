@@ -0,0 +1,50 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Worker threads for the CPU backend's row tiles.  ParallelFor() hands out chunks of a range to the workers and the
+// calling thread until all of it is done; one range runs at a time.
+class CpuThreadPool
+{
+public:
+	// 0 uses every hardware thread.  The calling thread counts as one of them.
+	explicit CpuThreadPool(uint32_t threadCount = 0);
+	~CpuThreadPool();
+
+	CpuThreadPool(const CpuThreadPool&) = delete;
+	CpuThreadPool& operator=(const CpuThreadPool&) = delete;
+
+	// Calls function(begin, end) for consecutive chunks of [0, count), chunkSize long but for the last, and returns
+	// once every chunk is done.  Safe from several threads; their ranges take turns.  Not from inside a chunk.
+	void ParallelFor(uint32_t count, uint32_t chunkSize, const std::function<void(uint32_t, uint32_t)>& function);
+
+	uint32_t GetThreadCount() const { return (uint32_t)m_Threads.size() + 1; }
+
+private:
+	void Run();
+	// Runs chunks of the range started as generation until none are left.  Needs m_Mutex locked.
+	void RunChunks(std::unique_lock<std::mutex>& lock, uint64_t generation);
+
+private:
+	std::vector<std::thread> m_Threads;
+
+	// Held for the whole of a ParallelFor().
+	std::mutex				m_RangeMutex;
+	std::mutex				m_Mutex;
+	std::condition_variable m_Condition;
+	std::condition_variable m_DoneCondition;
+	uint64_t				m_Generation = 0;
+	bool					m_Stopped = false;
+
+	const std::function<void(uint32_t, uint32_t)>* m_Function = nullptr;
+	uint32_t									   m_Count = 0;
+	uint32_t									   m_ChunkSize = 1;
+	uint32_t									   m_NextChunk = 0;
+	uint32_t									   m_ChunkCount = 0;
+	uint32_t									   m_DoneChunks = 0;
+};
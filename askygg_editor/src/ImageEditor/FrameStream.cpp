@@ -0,0 +1,283 @@
+#include "FrameStream.h"
+
+#include "askygg/core/Log.h"
+#include "askygg/platform/PlatformDetection.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+
+#if defined(E_PLATFORM_WINDOWS)
+	#include <fcntl.h>
+	#include <io.h>
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <poll.h>
+	#include <unistd.h>
+#endif
+
+uint64_t FrameStreamSpecification::GetFrameSize() const
+{
+	uint64_t bytesPerPixel = 4;
+	switch (PixelFormat)
+	{
+		case StreamPixelFormat::RGBA:		bytesPerPixel = 4; break;
+		case StreamPixelFormat::RGB24:		bytesPerPixel = 3; break;
+		case StreamPixelFormat::RGBA64LE:	bytesPerPixel = 8; break;
+	}
+	return (uint64_t)Width * Height * bytesPerPixel;
+}
+
+askygg::ImageUtils::ImageDataLayout FrameStreamSpecification::GetDataLayout() const
+{
+	return PixelFormat == StreamPixelFormat::RGB24 ? askygg::ImageUtils::ImageDataLayout::RGB
+		: askygg::ImageUtils::ImageDataLayout::RGBA;
+}
+
+askygg::ImageUtils::ImageDataType FrameStreamSpecification::GetDataType() const
+{
+	// GL transfers 16-bit channels in host order, which is little endian on every platform askygg builds for.
+	return PixelFormat == StreamPixelFormat::RGBA64LE ? askygg::ImageUtils::ImageDataType::UShort
+		: askygg::ImageUtils::ImageDataType::UByte;
+}
+
+askygg::ImageUtils::ImageInternalFormat FrameStreamSpecification::GetInternalFormat() const
+{
+	return PixelFormat == StreamPixelFormat::RGBA64LE ? askygg::ImageUtils::ImageInternalFormat::RGBA16
+		: askygg::ImageUtils::ImageInternalFormat::RGBA8;
+}
+
+bool FrameStreamSpecification::ParseFrameSize(const std::string& text, uint32_t& width, uint32_t& height)
+{
+	size_t separator = text.find('x');
+	if (separator == std::string::npos)
+		return false;
+
+	try
+	{
+		width = std::stoul(text.substr(0, separator));
+		height = std::stoul(text.substr(separator + 1));
+	}
+	catch (const std::exception&)
+	{
+		return false;
+	}
+	return width > 0 && height > 0;
+}
+
+bool FrameStreamSpecification::ParsePixelFormat(const std::string& text, StreamPixelFormat& format)
+{
+	if (text == "rgba")
+		format = StreamPixelFormat::RGBA;
+	else if (text == "rgb24")
+		format = StreamPixelFormat::RGB24;
+	else if (text == "rgba64le")
+		format = StreamPixelFormat::RGBA64LE;
+	else
+		return false;
+	return true;
+}
+
+FrameStream::FrameStream(const FrameStreamSpecification& specification, uint32_t bufferCount)
+	: m_Specification(specification)
+{
+#if defined(E_PLATFORM_WINDOWS)
+	_setmode(_fileno(stdin), _O_BINARY);
+	_setmode(_fileno(stdout), _O_BINARY);
+#else
+	if (pipe(m_WakePipe) != 0)
+		YGG_LOG_WARN("Stream: no wake-up pipe ({}); stopping early waits for the input to end", std::strerror(errno));
+	m_PreviousSigPipeHandler = std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+	for (uint32_t i = 0; i < bufferCount; i++)
+	{
+		Frame input, output;
+		input.Data.resize(m_Specification.GetFrameSize());
+		output.Data.resize(m_Specification.GetFrameSize());
+		m_FreeInputs.Push(std::move(input));
+		m_FreeOutputs.Push(std::move(output));
+	}
+
+	YGG_LOG_INFO("Streaming {}x{} frames of {} bytes", m_Specification.Width, m_Specification.Height,
+		m_Specification.GetFrameSize());
+	m_Start = m_LastReport = Clock::now();
+	m_Reader = std::thread(&FrameStream::ReadFrames, this);
+	m_Writer = std::thread(&FrameStream::WriteFrames, this);
+}
+
+FrameStream::~FrameStream()
+{
+	Finish();
+}
+
+bool FrameStream::AcquireInput(Frame& frame)
+{
+	return m_FilledInputs.Pop(frame);
+}
+
+void FrameStream::ReleaseInput(Frame&& frame)
+{
+	m_FreeInputs.Push(std::move(frame));
+}
+
+FrameStream::Frame FrameStream::AcquireOutput()
+{
+	Frame frame;
+	m_FreeOutputs.Pop(frame);
+	return frame;
+}
+
+void FrameStream::SubmitOutput(Frame&& frame)
+{
+	m_FilledOutputs.Push(std::move(frame));
+}
+
+void FrameStream::Finish()
+{
+	if (m_Finished)
+		return;
+	m_Finished = true;
+
+	// The reader may still be blocked on a free buffer, or on stdin, if the consumer stopped early.
+	m_Stopping = true;
+	m_FreeInputs.Close();
+	m_FilledOutputs.Close();
+#if defined(E_PLATFORM_WINDOWS)
+	CancelSynchronousIo(m_Reader.native_handle());
+#else
+	if (m_WakePipe[1] >= 0)
+	{
+		const char wake = 0;
+		(void)!write(m_WakePipe[1], &wake, 1);
+	}
+#endif
+	m_Reader.join();
+	m_Writer.join();
+
+#if !defined(E_PLATFORM_WINDOWS)
+	for (int& fd : m_WakePipe)
+	{
+		if (fd >= 0)
+			close(fd);
+		fd = -1;
+	}
+	std::signal(SIGPIPE, m_PreviousSigPipeHandler == SIG_ERR ? SIG_DFL : m_PreviousSigPipeHandler);
+#endif
+	ReportStatistics(true);
+}
+
+void FrameStream::ReadFrames()
+{
+	const uint64_t frameSize = m_Specification.GetFrameSize();
+	Frame		   frame;
+	while (m_FreeInputs.Pop(frame))
+	{
+		size_t bytesRead = ReadInput(frame.Data.data(), frameSize);
+		if (bytesRead != frameSize)
+		{
+			if (bytesRead != 0 && !m_Stopping)
+				YGG_LOG_WARN("Stream: dropped a truncated frame of {} bytes at the end of the input", bytesRead);
+			break;
+		}
+
+		frame.Index = m_FramesRead++;
+		frame.ReadTime = Clock::now();
+		m_FilledInputs.Push(std::move(frame));
+	}
+	m_FilledInputs.Close();
+}
+
+size_t FrameStream::ReadInput(uint8_t* data, size_t size)
+{
+#if defined(E_PLATFORM_WINDOWS)
+	// Finish() cancels a ReadFile() that is still waiting.
+	return m_Stopping ? 0 : std::fread(data, 1, size, stdin);
+#else
+	size_t bytesRead = 0;
+	while (bytesRead < size && !m_Stopping)
+	{
+		pollfd fds[2] = { { STDIN_FILENO, POLLIN, 0 }, { m_WakePipe[0], POLLIN, 0 } };
+		if (poll(fds, m_WakePipe[0] >= 0 ? 2 : 1, -1) < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			YGG_LOG_ERROR("Stream: waiting for stdin failed: {}", std::strerror(errno));
+			break;
+		}
+		if (fds[1].revents != 0)
+			break;
+
+		ssize_t result = read(STDIN_FILENO, data + bytesRead, size - bytesRead);
+		if (result < 0 && (errno == EINTR || errno == EAGAIN))
+			continue;
+		if (result < 0)
+			YGG_LOG_ERROR("Stream: reading stdin failed: {}", std::strerror(errno));
+		if (result <= 0)
+			break;
+		bytesRead += (size_t)result;
+	}
+	return bytesRead;
+#endif
+}
+
+void FrameStream::WriteFrames()
+{
+	const uint64_t frameSize = m_Specification.GetFrameSize();
+	Frame		   frame;
+	while (m_FilledOutputs.Pop(frame))
+	{
+		if (std::fwrite(frame.Data.data(), 1, frameSize, stdout) != frameSize)
+		{
+			if (errno == EPIPE)
+				YGG_LOG_ERROR("Stream: the consumer closed stdout before frame {}", frame.Index);
+			else
+				YGG_LOG_ERROR("Stream: writing frame {} to stdout failed: {}", frame.Index, std::strerror(errno));
+			break;
+		}
+
+		m_Latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - frame.ReadTime).count());
+		m_FramesWritten++;
+		m_FreeOutputs.Push(std::move(frame));
+		ReportStatistics(false);
+	}
+	std::fflush(stdout);
+
+	// Unblock the GL thread if the consumer is gone.
+	m_FreeOutputs.Close();
+}
+
+void FrameStream::ReportStatistics(bool final)
+{
+	const Clock::time_point now = Clock::now();
+	const double			sinceReport = std::chrono::duration<double>(now - m_LastReport).count();
+	if (!final && sinceReport < 2.0)
+		return;
+
+	const uint64_t written = m_FramesWritten;
+	if (!final)
+	{
+		YGG_LOG_INFO("Stream: {} frames, {:.1f} fps, last frame latency {:.1f} ms", written,
+			(double)(written - m_FramesAtLastReport) / sinceReport, m_Latencies.empty() ? 0.0 : m_Latencies.back());
+		m_LastReport = now;
+		m_FramesAtLastReport = written;
+		return;
+	}
+
+	std::vector<double> latencies = m_Latencies;
+	std::sort(latencies.begin(), latencies.end());
+	auto percentile = [&latencies](double p)
+	{ return latencies.empty() ? 0.0 : latencies[std::min((size_t)(p * latencies.size()), latencies.size() - 1)]; };
+
+	const double seconds = std::max(std::chrono::duration<double>(now - m_Start).count(), 1e-9);
+	YGG_LOG_INFO("Stream finished: {} of {} frames written in {:.2f}s, {:.1f} fps, {:.1f} MPix/s", written,
+		m_FramesRead.load(), seconds, written / seconds,
+		(double)written * m_Specification.Width * m_Specification.Height / (seconds * 1e6));
+	YGG_LOG_INFO("Stream latency (read to written): p50 {:.1f} ms, p95 {:.1f} ms, max {:.1f} ms", percentile(0.5),
+		percentile(0.95), latencies.empty() ? 0.0 : latencies.back());
+}
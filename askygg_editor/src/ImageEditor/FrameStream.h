@@ -0,0 +1,100 @@
+#pragma once
+
+#include "askygg/core/BlockingQueue.h"
+#include "askygg/renderer/TextureUtils.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Raw pixel layouts understood on stdin/stdout, named as in ffmpeg's -pix_fmt.
+enum class StreamPixelFormat
+{
+	RGBA,
+	RGB24,
+	RGBA64LE
+};
+
+struct FrameStreamSpecification
+{
+	uint32_t		  Width = 0;
+	uint32_t		  Height = 0;
+	StreamPixelFormat PixelFormat = StreamPixelFormat::RGBA;
+
+	uint64_t GetFrameSize() const;
+	// Client-side layout of a frame, for uploads and readbacks.
+	askygg::ImageUtils::ImageDataLayout GetDataLayout() const;
+	askygg::ImageUtils::ImageDataType	GetDataType() const;
+	// Texture format that holds a frame without losing precision.
+	askygg::ImageUtils::ImageInternalFormat GetInternalFormat() const;
+
+	// "1920x1080" and "rgba" / "rgb24" / "rgba64le".  Return false on malformed input.
+	static bool ParseFrameSize(const std::string& text, uint32_t& width, uint32_t& height);
+	static bool ParsePixelFormat(const std::string& text, StreamPixelFormat& format);
+};
+
+// Reads fixed-size raw frames from stdin and writes them back to stdout, each on its own thread.  Buffers circulate
+// between the threads and the GL thread, so reading frame n+1, processing frame n and writing frame n-1 overlap.
+// Rate and latency statistics go to the log, which is on stderr in stream mode.  SIGPIPE is ignored while a stream
+// runs, so a consumer that goes away ends it with EPIPE instead of killing the process.
+class FrameStream
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Frame
+	{
+		std::vector<uint8_t> Data;
+		uint64_t			 Index = 0;
+		Clock::time_point	 ReadTime;
+	};
+
+	explicit FrameStream(const FrameStreamSpecification& specification, uint32_t bufferCount = 3);
+	~FrameStream();
+
+	// Next frame from stdin, or false once the input ended.  Hand the buffer back with ReleaseInput().
+	bool AcquireInput(Frame& frame);
+	void ReleaseInput(Frame&& frame);
+
+	// Empty buffer for a processed frame; Index and ReadTime of the source frame must be carried over.
+	Frame AcquireOutput();
+	void  SubmitOutput(Frame&& frame);
+
+	// Flushes the remaining output, joins both threads and logs the run's summary.  A reader still waiting on stdin is
+	// woken and stops.
+	void Finish();
+
+	const FrameStreamSpecification& GetSpecification() const { return m_Specification; }
+
+private:
+	void ReadFrames();
+	// Fills data from stdin.  Returns the bytes read, fewer than size at the end of the input or once Finish() ran.
+	size_t ReadInput(uint8_t* data, size_t size);
+	void WriteFrames();
+	void ReportStatistics(bool final);
+
+private:
+	FrameStreamSpecification m_Specification;
+
+	askygg::BlockingQueue<Frame> m_FreeInputs;
+	askygg::BlockingQueue<Frame> m_FilledInputs;
+	askygg::BlockingQueue<Frame> m_FreeOutputs;
+	askygg::BlockingQueue<Frame> m_FilledOutputs;
+	std::thread					 m_Reader;
+	std::thread					 m_Writer;
+	bool						 m_Finished = false;
+	std::atomic<bool>			 m_Stopping = false;
+	// Written to by Finish() to wake a reader polling stdin.  Unused on Windows.
+	int							 m_WakePipe[2] = { -1, -1 };
+	void (*m_PreviousSigPipeHandler)(int) = nullptr;
+
+	Clock::time_point	  m_Start;
+	Clock::time_point	  m_LastReport;
+	uint64_t			  m_FramesAtLastReport = 0;
+	std::atomic<uint64_t> m_FramesRead = 0;
+	std::atomic<uint64_t> m_FramesWritten = 0;
+	// Read-to-written latency of every frame, in milliseconds.  Only touched by the writer.
+	std::vector<double>	  m_Latencies;
+};
@@ -1,140 +1,81 @@
 #include "ImageEditor.h"
 
-#include "Passes/MultiPassBloomPass.h"
-#include "Passes/BarrelDistortionPass.h"
-#include "Passes/ChromaticAberrationPass.h"
-#include "Passes/SobelPass.h"
-#include "Passes/ContrastBrightnessPass.h"
-#include "Passes/RadialBlurPass.h"
-#include "Passes/SharpenPass.h"
-#include "Passes/HSVAdjustmentPass.h"
-#include "Passes/VignettePass.h"
-#include "Passes/LinearizePass.h"
-
 #include "askygg/renderer/Renderer.h"
 #include "askygg/renderer/Framebuffer.h"
+#include "askygg/renderer/GraphicsContext.h"
 #include "askygg/renderer/Shader.h"
+#include "askygg/renderer/PixelBuffer.h"
 #include "askygg/core/Application.h"
 #include "askygg/ui/PropertyDrawer.h"
-#include "askygg/platform/renderer_platform/opengl/OpenGLTimer.h"
 
 #include <imgui.h>
 #include <glm/glm.hpp>
-#include <fstream>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <thread>
 #include <vector>
 #include "yaml-cpp/yaml.h"
 #include "askygg/core/Timer.h"
-#include "Passes/RadialBloomPass.h"
 #include "imgui_internal.h"
 #include <filesystem>
+#include <mutex>
+#include <unordered_set>
 
-std::vector<ImagePassType>                                  ImageEditor::s_OrderedPassTypes;
-std::unordered_map<ImagePassType, askygg::Ref<ImagePass>>   ImageEditor::s_AllPasses;
-askygg::Ref<ImagePass>                                      ImageEditor::s_ActiveBloomPass;
-BloomType                                                   ImageEditor::s_ActiveBloomPassType;
-askygg::Ref<askygg::RenderPass>                             ImageEditor::s_DisplayRenderPass;
+askygg::Ref<ImagePipeline>                                  ImageEditor::s_Pipeline;
 
-std::unordered_map<ImagePassType, double>                   ImageEditor::s_PassExecutionTime;
 std::vector<std::pair<ImagePassType, double>>               ImageEditor::s_SortedExecutionTimes;
 std::chrono::high_resolution_clock::time_point              ImageEditor::s_LastSortTime = std::chrono::high_resolution_clock::now();
 
 std::string ImageEditor::s_SettingsFileName;
+askygg::Ref<SettingsStore> ImageEditor::s_Settings;
 std::string ImageEditor::s_InputDirectory;
 std::string ImageEditor::s_OutputDirectory;
 
 uint32_t              ImageEditor::s_ActiveTextureIndex = 0;
-std::vector<uint32_t> ImageEditor::s_TextureSet{};
-
-
-std::vector<std::string> GetDefaultPassOrderToString()
-{
-    std::vector<ImagePassType> defaultPassOrder =
-    {
-            ImagePassType::ContrastBrightness,
-            ImagePassType::HueShift,
-            ImagePassType::Sobel,
-            ImagePassType::RadialBlur,
-            ImagePassType::ChromaticAberration,
-            ImagePassType::BarrelDistortion,
-            ImagePassType::Vignette,
-            ImagePassType::Sharpen,
-    };
-    // Load active passes
-    std::vector<std::string> defaultPassOrderStrings;
-    for(auto & i : defaultPassOrder)
-        defaultPassOrderStrings.push_back(ImagePass::ImagePassTypeToString(i));
-
-    return defaultPassOrderStrings;
-}
-
-void ImageEditor::SetBloomPass(BloomType bloomType)
-{
-    switch(bloomType)
-    {
-        case BloomType::Radial:     s_ActiveBloomPass = s_AllPasses[ImagePassType::RadialBloom]; break;
-        case BloomType::MultiPass:  s_ActiveBloomPass = s_AllPasses[ImagePassType::MultiPassBloom]; break;
-        default: s_ActiveBloomPass = nullptr; break;
-    }
-
-    // Notify the output shader of the change.
-    auto outputPass = std::dynamic_pointer_cast<OutputComputePass>(s_AllPasses[ImagePassType::OutputCompute]);
-    outputPass->SetBloomType(bloomType);
-
-    s_ActiveBloomPassType = bloomType;
-}
+askygg::Scope<ImageLoader> ImageEditor::s_Images;
 
 void ImageEditor::InitializeImageEditor(const std::string &inputDirectory,
                                         const std::string &outputDirectory,
-                                        const std::string &settingsFileName)
-{
-    askygg::ShaderLibrary::Load("assets/shaders/post_fx/Linearize.glsl");
-    askygg::ShaderLibrary::Load("assets/shaders/post_fx/MultiPassBloom.glsl");
-    askygg::ShaderLibrary::Load("assets/shaders/post_fx/RadialBloom.glsl");
-    askygg::ShaderLibrary::Load("assets/shaders/post_fx/Sobel.glsl");
-    askygg::ShaderLibrary::Load("assets/shaders/post_fx/RadialBlur.glsl");
-    askygg::ShaderLibrary::Load("assets/shaders/post_fx/ContrastAdjust.glsl");
-    askygg::ShaderLibrary::Load("assets/shaders/post_fx/ChromaticAberration.glsl");
-    askygg::ShaderLibrary::Load("assets/shaders/post_fx/BarrelDistortion.glsl");
-    askygg::ShaderLibrary::Load("assets/shaders/post_fx/Vignette.glsl");
-    askygg::ShaderLibrary::Load("assets/shaders/post_fx/Sharpen.glsl");
-    askygg::ShaderLibrary::Load("assets/shaders/post_fx/HSVAdjust.glsl");
-    askygg::ShaderLibrary::Load("assets/shaders/post_fx/OutputPass.glsl");
-    askygg::ShaderLibrary::Load("assets/shaders/DisplayTexture.glsl");
-    InitializeOutputDisplayPass();
+                                        const std::string &settingsFileName,
+                                        const CpuPipelineSpecification *cpuBackend)
+{
+    // The CPU backend never touches the context.
+    if (cpuBackend)
+        s_CpuBackend = askygg::CreateScope<CpuPipelineSpecification>(*cpuBackend);
+    else
+        ImagePipeline::LoadShaders();
 
     s_SettingsFileName = settingsFileName;
+    // Every pipeline in the process opens the same store; holding it here keeps the document parsed between them.
+    s_Settings = SettingsStore::Open(s_SettingsFileName);
     s_InputDirectory = inputDirectory;
     s_OutputDirectory = outputDirectory;
+    if (!s_OutputDirectory.empty() && s_OutputDirectory.back() != '/')
+        s_OutputDirectory += '/';
 
-    s_AllPasses[ImagePassType::Linearize] = askygg::CreateRef<LinearizePass>(s_SettingsFileName);
-    s_AllPasses[ImagePassType::BarrelDistortion] = askygg::CreateRef<BarrelDistortionPass>(s_SettingsFileName);
-    s_AllPasses[ImagePassType::RadialBloom] = askygg::CreateRef<RadialBloomPass>(s_SettingsFileName);
-    s_AllPasses[ImagePassType::MultiPassBloom] = askygg::CreateRef<MultiPassBloomPass>(s_SettingsFileName);
-    s_AllPasses[ImagePassType::RadialBloom] = askygg::CreateRef<RadialBloomPass>(s_SettingsFileName);
-    s_AllPasses[ImagePassType::ChromaticAberration] = askygg::CreateRef<ChromaticAberrationPass>(s_SettingsFileName);
-    s_AllPasses[ImagePassType::ContrastBrightness] = askygg::CreateRef<ContrastBrightnessPass>(s_SettingsFileName);
-    s_AllPasses[ImagePassType::HueShift] = askygg::CreateRef<HSVAdjustmentPass>(s_SettingsFileName);
-    s_AllPasses[ImagePassType::RadialBlur] = askygg::CreateRef<RadialBlurPass>(s_SettingsFileName);
-    s_AllPasses[ImagePassType::Sharpen] = askygg::CreateRef<SharpenPass>(s_SettingsFileName);
-    s_AllPasses[ImagePassType::Sobel] = askygg::CreateRef<SobelPass>(s_SettingsFileName);
-    s_AllPasses[ImagePassType::Vignette] = askygg::CreateRef<VignettePass>(s_SettingsFileName);
-    s_AllPasses[ImagePassType::OutputCompute] = askygg::CreateRef<OutputComputePass>(s_SettingsFileName);
-    for(auto [passType, pass] : s_AllPasses)
-    {
-        pass->Initialize();
-        pass->Load();
-    }
-
-    YAML::Node config = YAML::LoadFile(settingsFileName);
-    std::vector<std::string> configPassOrder = config["PassOrder"] ? config["PassOrder"].as<std::vector<std::string>>() : GetDefaultPassOrderToString();
-    int bloomTypeInt = config["Bloom Pass Type"] ? config["Bloom Pass Type"].as<int>() : 1;
-    auto bloomType = static_cast<BloomType>(bloomTypeInt);
-    SetBloomPass(bloomType);
-
-    s_OrderedPassTypes.push_back(ImagePassType::Linearize);
-    for(const auto& passString : configPassOrder)
-        s_OrderedPassTypes.push_back(ImagePass::ImagePassTypeFromString(passString));
-    s_OrderedPassTypes.push_back(ImagePassType::OutputCompute);
+    s_Pipeline = askygg::CreateRef<ImagePipeline>(s_SettingsFileName);
+    if (s_CpuBackend)
+        s_Pipeline->InitializeForCpu();
+    else
+        s_Pipeline->Initialize();
+}
+
+// Input images are decoded as-is; the Linearize pass takes care of the encoding.
+static askygg::Texture2DSpecification GetFileTextureSpecification()
+{
+    return {
+            askygg::ImageUtils::WrapMode::Repeat,
+            askygg::ImageUtils::WrapMode::Repeat,
+            askygg::ImageUtils::FilterMode::Linear,
+            askygg::ImageUtils::FilterMode::Linear,
+            askygg::ImageUtils::ImageInternalFormat::FromImage,
+            askygg::ImageUtils::ImageDataLayout::FromImage,
+            askygg::ImageUtils::ImageDataType::UByte,
+    };
 }
 
 void SortDirectoryEntries(const std::string &directoryPath,
@@ -153,214 +94,820 @@ void SortDirectoryEntries(const std::string &directoryPath,
     });
 }
 
-void ImageEditor::HeadlessProcessDirectory()
+// Files a run writes besides the outputs, e.g. the contact sheet; relativePath is under the output root or archive.
+static void WriteRunFile(const std::string &outputRoot, TarWriter *outputArchive, OutputWriter *outputWriter,
+                         const std::string &relativePath, const std::string &contents)
 {
-    askygg::ScopedTimer timer("Process Image Directory", askygg::ScopedTimer::Unit::Minutes);
+    if (outputArchive)
+    {
+        outputArchive->Write(relativePath, contents.data(), contents.size());
+        return;
+    }
 
-    askygg::Texture2DSpecification fileTexSpec = {
-            askygg::ImageUtils::WrapMode::Repeat,
-            askygg::ImageUtils::WrapMode::Repeat,
-            askygg::ImageUtils::FilterMode::Linear,
-            askygg::ImageUtils::FilterMode::Linear,
-            askygg::ImageUtils::ImageInternalFormat::FromImage,
-            askygg::ImageUtils::ImageDataLayout::FromImage,
-            askygg::ImageUtils::ImageDataType::UByte,
-    };
+    const std::filesystem::path path = outputRoot + relativePath;
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    outputWriter->Write(path.string(), std::vector<uint8_t>(contents.begin(), contents.end()));
+}
 
-    std::vector<std::filesystem::directory_entry> entries;
-    SortDirectoryEntries(s_InputDirectory, entries);
+void ImageEditor::HeadlessProcessDirectory(const InputEnumeratorSpecification &input, uint32_t workerCount,
+                                           bool scalingReport, const std::string &outputArchive,
+                                           const OutputWriterSpecification &output, const std::string &variantsFileName)
+{
+    askygg::Scope<VariantSweep> sweep;
+    if (!variantsFileName.empty())
+    {
+        sweep = askygg::CreateScope<VariantSweep>();
+        std::string error;
+        if (!sweep->Load(variantsFileName, s_Settings->GetDocument(), error) || !sweep->SortForReuse(*s_Pipeline, error))
+        {
+            YGG_LOG_ERROR("Cannot render the variants in '{}': {}", variantsFileName, error);
+            return;
+        }
+        YGG_LOG_INFO("Rendering {} variants of every input.", sweep->GetVariants().size());
+    }
 
-    for (const auto &entry: entries)
+    askygg::Scope<TarWriter> archive;
+    if (!outputArchive.empty())
+    {
+        archive = askygg::CreateScope<TarWriter>(outputArchive);
+        if (!archive->IsOpen())
+            return;
+    }
+
+    workerCount = std::max(workerCount, 1u);
+    if (s_CpuBackend && workerCount > 1)
     {
-        const std::string &filePath = entry.path().string();
-        if (std::filesystem::is_regular_file(entry.status()))
+        YGG_LOG_WARN("--workers is ignored by the CPU backend; --cpu_threads sets how many threads it uses.");
+        workerCount = 1;
+    }
+    double singleWorkerRate = 0.0;
+    for (uint32_t workers = scalingReport ? 1 : workerCount; workers <= workerCount; workers++)
+    {
+        askygg::ScopedTimer timer("Process Image Directory", askygg::ScopedTimer::Unit::Minutes);
+        // Enumeration runs alongside processing, so the first images are done before the tree has been walked.
+        InputEnumerator inputs(input);
+        // Files are written behind the GL threads; the run is only done once they are on storage.
+        askygg::Scope<OutputWriter> writer;
+        if (!archive)
+            writer = askygg::CreateScope<OutputWriter>(output);
+        // Each variant's folder gets the complete settings it was rendered with, to pick up where a look left off.
+        if (sweep)
         {
-            auto *texture = new askygg::Texture2D(filePath, fileTexSpec);
-            SaveTexture(*texture, s_OutputDirectory, false);
-            delete texture;
+            for (const SettingsVariant &variant: sweep->GetVariants())
+            {
+                YAML::Emitter settings;
+                settings << variant.Settings;
+                WriteRunFile(s_OutputDirectory, archive.get(), writer.get(), variant.Name + "/settings.yaml",
+                             settings.c_str());
+            }
         }
+        uint64_t elidedDispatches = ProcessFiles(inputs, workers, archive.get(), writer.get(), sweep.get());
+        if (sweep)
+            WriteRunFile(s_OutputDirectory, archive.get(), writer.get(), "contact_sheet.html", sweep->GetContactSheet());
+        if (writer)
+            writer->Flush();
+        timer.Stop();
+
+        double seconds = std::max(timer.GetNanoSeconds() * 1e-9, 1e-9);
+        float processedPerSecond = static_cast<float>(inputs.GetFileCount() / seconds);
+        constexpr float PreviousProcessedPerMinute = 81.0f;
+        YGG_LOG_INFO("{} images/s, {} images/min, {}x faster", processedPerSecond, processedPerSecond * 60.0f, processedPerSecond * 60.0f / PreviousProcessedPerMinute);
+        YGG_LOG_INFO("Skipped {} identity pass dispatches", elidedDispatches);
+        if (sweep)
+            YGG_LOG_INFO("{} outputs/s over {} variants, {} pass outputs reused from the previous variant",
+                         processedPerSecond * sweep->GetVariants().size(), sweep->GetVariants().size(),
+                         sweep->GetReusedPassCount());
+        if (writer)
+            writer->LogStatistics();
+
+        if (workers == 1)
+            singleWorkerRate = processedPerSecond;
+        if (scalingReport)
+            YGG_LOG_INFO("Scaling: {} worker(s): {:.2f} images/s, {:.2f}x speedup, {:.0f}% efficiency", workers,
+                         processedPerSecond, processedPerSecond / singleWorkerRate,
+                         100.0 * processedPerSecond / (singleWorkerRate * workers));
     }
 
-    timer.Stop();
-    long long int seconds = timer.GetNanoSeconds() * 1e-9;
-    int numProcessed = entries.size();
-    float processedPerSecond = static_cast<float>(numProcessed) / static_cast<float>(seconds);
-    constexpr float PreviousProcessedPerMinute = 81.0f;
-    YGG_LOG_INFO("{} images/s, {} images/min, {}x faster", processedPerSecond, processedPerSecond * 60.0f, processedPerSecond * 60.0f / PreviousProcessedPerMinute);
+    if (archive)
+        archive->Finish();
 }
 
-void ImageEditor::LoadTextureSet(const std::string &directoryPath)
+// Output directories the current run has created; ProcessFiles() starts every run with an empty set.
+static std::mutex                      s_CreatedMutex;
+static std::unordered_set<std::string> s_CreatedDirectories;
+
+// Where an input's output goes: the output directory plus the input's subdirectory under the input root, created on
+// first use.  Every directory is created once per run, not once per image.
+static std::string GetMirroredOutputDirectory(const std::string &outputRoot, const InputEnumerator::InputFile &file)
 {
-    YGG_ASSERT(!std::filesystem::is_empty(directoryPath),
-               "No input images in '{}' - please add at least one image before starting askygg.",
-               directoryPath);
+    std::string outputDirectory = outputRoot;
+    size_t nameStart = file.RelativePath.rfind('/');
+    if (nameStart == std::string::npos)
+        return outputDirectory;
+
+    outputDirectory += file.RelativePath.substr(0, nameStart + 1);
+    std::lock_guard<std::mutex> lock(s_CreatedMutex);
+    if (s_CreatedDirectories.insert(outputDirectory).second)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(outputDirectory, error);
+        if (error)
+            YGG_LOG_ERROR("Cannot create output directory '{}': {}", outputDirectory, error.message());
+    }
+    return outputDirectory;
+}
 
-    askygg::Texture2DSpecification fileTexSpec = {
-            askygg::ImageUtils::WrapMode::Repeat,
-            askygg::ImageUtils::WrapMode::Repeat,
-            askygg::ImageUtils::FilterMode::Linear,
-            askygg::ImageUtils::FilterMode::Linear,
-            askygg::ImageUtils::ImageInternalFormat::FromImage,
-            askygg::ImageUtils::ImageDataLayout::FromImage,
-            askygg::ImageUtils::ImageDataType::UByte,
-    };
+// Archive members are decoded from memory; null if a member is not an image.
+static askygg::Scope<askygg::Texture2D> LoadInput(const InputEnumerator::InputFile &file,
+                                                  const askygg::Texture2DSpecification &fileTexSpec)
+{
+    if (file.Data.empty())
+        return askygg::CreateScope<askygg::Texture2D>(file.Path, fileTexSpec);
 
-    std::vector<std::filesystem::directory_entry> entries;
-    SortDirectoryEntries(directoryPath, entries);
+    if (!askygg::Texture2D::IsLoadable(file.Data.data(), file.Data.size()))
+    {
+        YGG_LOG_WARN("Skipping '{}': not a readable image.", file.Path);
+        return nullptr;
+    }
+    return askygg::CreateScope<askygg::Texture2D>(std::filesystem::path(file.RelativePath).filename().string(),
+                                                  file.Data.data(), file.Data.size(), fileTexSpec);
+}
 
-    for (const auto &entry: entries)
+// Outputs are JPEGs; members that already are keep their name, others get a .jpeg extension.
+static std::string GetOutputMemberName(const std::string &relativePath)
+{
+    std::filesystem::path path(relativePath);
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+    if (extension == ".jpg" || extension == ".jpeg")
+        return relativePath;
+    return path.replace_extension(".jpeg").generic_string();
+}
+
+// Whether relativePath, resolved against the output root (or archive), stays under it.
+static bool IsInsideOutputRoot(const std::string &relativePath)
+{
+    const std::filesystem::path path = std::filesystem::path(relativePath).lexically_normal();
+    return !path.empty() && !path.has_root_path() && *path.begin() != "..";
+}
+
+// With an output archive the result is appended to it under the input's name; otherwise it is handed to the output
+// writer for the mirrored output directory, named after the input (name without its extension).  A variant's outputs
+// go under a directory (or archive prefix) named after it.  Returns where the output went relative to the output root.
+static std::string StoreOutput(std::vector<uint8_t> encoded, const std::string &name,
+                               const InputEnumerator::InputFile &file, const std::string &outputRoot,
+                               TarWriter *outputArchive, OutputWriter *outputWriter, const std::string &variantName)
+{
+    const std::string prefix = variantName.empty() ? std::string() : variantName + "/";
+    // The enumerator already drops such inputs; this is the last line before anything is written outside the root.
+    if (!IsInsideOutputRoot(prefix + file.RelativePath))
+    {
+        YGG_LOG_ERROR("Not writing the output of '{}': '{}' is outside the output root.", file.Path,
+                      prefix + file.RelativePath);
+        return std::string();
+    }
+
+    if (outputArchive)
+    {
+        std::string memberName = prefix + GetOutputMemberName(file.RelativePath);
+        outputArchive->Write(memberName, encoded.data(), encoded.size());
+        return memberName;
+    }
+
+    // Named like ImagePipeline::Save() names its files.
+    std::string outputPath = GetMirroredOutputDirectory(outputRoot + prefix, file) + name + ".jpeg";
+    outputWriter->Write(outputPath, std::move(encoded));
+    return outputPath.substr(outputRoot.size());
+}
+
+// StoreOutput() of the pipeline's result; only the encoding happens on the GL thread.  Returns nothing if encoding
+// failed.
+static std::string WriteOutput(ImagePipeline &pipeline, const askygg::Texture2D &texture,
+                               const InputEnumerator::InputFile &file, const std::string &outputRoot,
+                               TarWriter *outputArchive, OutputWriter *outputWriter,
+                               const std::string &variantName = std::string())
+{
+    std::vector<uint8_t> encoded;
+    if (!pipeline.Encode(texture, encoded, false))
+    {
+        YGG_LOG_ERROR("Encoding the output of '{}' failed.", file.Path);
+        return std::string();
+    }
+
+    return StoreOutput(std::move(encoded), std::filesystem::path(texture.GetName()).stem().string(), file, outputRoot,
+                       outputArchive, outputWriter, variantName);
+}
+
+// Renders every variant of one decoded input, writing each with write(variantName).  Going through them in the sweep's
+// render order lets the pipeline's pass cache carry everything upstream of the first pass two neighbouring variants
+// differ in.
+static void WriteVariants(ImagePipeline &pipeline, const InputEnumerator::InputFile &file, VariantSweep &sweep,
+                          const std::function<std::string(const std::string &)> &write)
+{
+    // The previous input's texture name may have come back for this one.
+    pipeline.InvalidatePassCache();
+    for (uint32_t index : sweep.GetRenderOrder())
+    {
+        const SettingsVariant &variant = sweep.GetVariants()[index];
+        pipeline.ApplySettings(variant.Settings);
+        std::string outputPath = write(variant.Name);
+        if (!outputPath.empty())
+            sweep.AddOutput(file.RelativePath, index, outputPath, (uint32_t)pipeline.GetCachedPasses().size());
+    }
+}
+
+// CpuInputImage counterpart of LoadInput(); false if the file is not an image.
+static bool LoadCpuInput(const InputEnumerator::InputFile &file, CpuInputImage &image)
+{
+    const bool decoded = file.Data.empty()
+        ? CpuInputImage::DecodeFile(file.Path, image)
+        : CpuInputImage::DecodeMemory(std::filesystem::path(file.RelativePath).filename().string(), file.Data.data(),
+                                      file.Data.size(), image);
+    if (!decoded)
+        YGG_LOG_WARN("Skipping '{}': not a readable image.", file.Path);
+    return decoded;
+}
+
+uint64_t ImageEditor::ProcessFiles(InputEnumerator &inputs, uint32_t workerCount, TarWriter *outputArchive,
+                                   OutputWriter *outputWriter, VariantSweep *sweep)
+{
     {
-        const std::string &filePath = entry.path().string();
-        if (std::filesystem::is_regular_file(entry.status()))
+        // The output tree may have changed since the last run, e.g. between the runs of a scaling report.
+        std::lock_guard<std::mutex> lock(s_CreatedMutex);
+        s_CreatedDirectories.clear();
+    }
+
+    if (s_CpuBackend)
+        return ProcessFilesOnCpu(inputs, outputArchive, outputWriter, sweep);
+
+    const askygg::Texture2DSpecification fileTexSpec = GetFileTextureSpecification();
+    auto writeOutputs = [&](ImagePipeline &pipeline, const askygg::Texture2D &texture,
+                            const InputEnumerator::InputFile &file)
+    {
+        if (!sweep)
         {
-            uint32_t textureID = askygg::TextureLibrary::LoadTexture2D(fileTexSpec, filePath)->GetID();
-            s_TextureSet.push_back(textureID);
+            WriteOutput(pipeline, texture, file, s_OutputDirectory, outputArchive, outputWriter);
+            return;
         }
+        WriteVariants(pipeline, file, *sweep, [&](const std::string &variantName)
+        {
+            return WriteOutput(pipeline, texture, file, s_OutputDirectory, outputArchive, outputWriter, variantName);
+        });
+    };
+
+    if (workerCount == 1)
+    {
+        s_Pipeline->ResetElidedDispatchCount();
+        s_Pipeline->SetPassCaching(sweep != nullptr);
+        InputEnumerator::InputFile file;
+        while (inputs.Next(file))
+        {
+            askygg::Scope<askygg::Texture2D> texture = LoadInput(file, fileTexSpec);
+            if (!texture || askygg::ShaderLibrary::IsEmpty())
+                continue;
+
+            askygg::Renderer::BeginScene({texture->GetWidth(), texture->GetHeight()});
+            writeOutputs(*s_Pipeline, *texture, file);
+            askygg::Renderer::EndScene();
+        }
+        return s_Pipeline->GetElidedDispatchCount();
+    }
+
+    // GLFW only creates contexts on the main thread; the workers just make theirs current.  Every worker owns a
+    // complete pipeline (passes, graph, targets, program copies) and pulls the next image off the enumerator.
+    std::vector<askygg::Ref<askygg::GraphicsContext>> contexts;
+    for (uint32_t i = 0; i < workerCount; i++)
+        contexts.push_back(askygg::GraphicsContext::CreateShared(askygg::Application::GetWindow().GetNativeWindow()));
+
+    std::atomic<uint64_t> elidedDispatches = 0;
+    std::vector<std::thread> workers;
+    for (uint32_t i = 0; i < workerCount; i++)
+    {
+        workers.emplace_back([&, context = contexts[i]]
+        {
+            context->MakeCurrent();
+            {
+                ImagePipeline pipeline(s_SettingsFileName);
+                pipeline.Initialize(true);
+                pipeline.SetPassCaching(sweep != nullptr);
+
+                InputEnumerator::InputFile file;
+                while (inputs.Next(file))
+                {
+                    askygg::Scope<askygg::Texture2D> texture = LoadInput(file, fileTexSpec);
+                    if (texture)
+                        writeOutputs(pipeline, *texture, file);
+                }
+                elidedDispatches += pipeline.GetElidedDispatchCount();
+            }
+            context->DetachCurrent();
+        });
     }
+
+    for (auto &worker: workers)
+        worker.join();
+    contexts.clear();
+
+    return elidedDispatches;
 }
 
-void ImageEditor::InitializeOutputDisplayPass()
+uint64_t ImageEditor::ProcessFilesOnCpu(InputEnumerator &inputs, TarWriter *outputArchive, OutputWriter *outputWriter,
+                                        VariantSweep *sweep)
 {
-    askygg::FramebufferSpecification OutputPassFBOSpec;
-    const auto &Window = askygg::Application::GetWindow();
-    OutputPassFBOSpec.AttachmentSpecification = {askygg::FramebufferTextureFormat::RGBA8};
-    OutputPassFBOSpec.Width = Window.GetWidth();
-    OutputPassFBOSpec.Height = Window.GetHeight();
+    // One image at a time, each kernel spread over every thread; s_Pipeline only holds the settings.
+    CpuPipeline cpu(*s_CpuBackend);
+    YGG_LOG_INFO("CPU backend: {} kernels on {} threads", cpu.GetKernels().Name, cpu.GetThreadCount());
+
+    InputEnumerator::InputFile file;
+    CpuInputImage image;
+    while (inputs.Next(file))
+    {
+        if (!LoadCpuInput(file, image))
+            continue;
 
-    askygg::RenderPassSpecification DisplayPassSpec;
-    DisplayPassSpec.PassFramebuffer = askygg::Framebuffer::Create(OutputPassFBOSpec);
-    DisplayPassSpec.PassMaterial = askygg::CreateRef<askygg::Material>(
-            "Display Texture Pass Material", askygg::ShaderLibrary::Get("DisplayTexture"));
+        auto write = [&](const std::string &variantName)
+        {
+            std::vector<uint8_t> encoded;
+            if (!cpu.Encode(*s_Pipeline, image, encoded))
+            {
+                YGG_LOG_ERROR("Encoding the output of '{}' failed.", file.Path);
+                return std::string();
+            }
+            return StoreOutput(std::move(encoded), std::filesystem::path(image.Name).stem().string(), file,
+                               s_OutputDirectory, outputArchive, outputWriter, variantName);
+        };
+        if (sweep)
+            WriteVariants(*s_Pipeline, file, *sweep, write);
+        else
+            write(std::string());
+    }
 
-    s_DisplayRenderPass = askygg::CreateRef<askygg::RenderPass>(DisplayPassSpec);
+    YGG_LOG_INFO("CPU backend held {:.1f} MB of images", cpu.GetMemorySize() / (1024.0 * 1024.0));
+    return cpu.GetSkippedPassCount();
 }
 
-void ImageEditor::SubmitOutputDisplayPass(uint32_t displayTextureID)
+void ImageEditor::LoadTextureSet(const std::string &directoryPath)
 {
-    askygg::Renderer::BeginPass(s_DisplayRenderPass);
-    const askygg::TextureUniform displayTextureUniform{displayTextureID, 0, 1};
-    s_DisplayRenderPass->GetSpecification().PassMaterial->Set<askygg::TextureUniform>("u_Texture", displayTextureUniform);
-    askygg::Renderer::DrawFullScreenQuad(s_DisplayRenderPass->GetSpecification().PassMaterial);
-    askygg::Renderer::EndPass(s_DisplayRenderPass);
+    std::vector<std::filesystem::directory_entry> entries;
+    SortDirectoryEntries(directoryPath, entries);
+
+    std::vector<std::string> paths;
+    for (const auto &entry: entries)
+    {
+        if (entry.is_regular_file())
+            paths.push_back(entry.path().string());
+    }
+
+    const YAML::Node settings = s_Settings->GetDocument();
+    if (settings["Progressive Frame Budget"])
+        s_ProgressiveFrameBudget = std::max(settings["Progressive Frame Budget"].as<float>(), 0.0f);
+
+    ImageLoaderSpecification loaderSpec;
+    loaderSpec.TextureSpecification = GetFileTextureSpecification();
+    if (settings["Image Memory Budget (MB)"])
+        loaderSpec.MemoryBudget = (uint64_t)std::max(settings["Image Memory Budget (MB)"].as<double>(), 0.0) << 20;
+    // Decodes finish while the editor may be idling between events.
+    loaderSpec.OnDecoded = [] { askygg::Application::RequestFrames(1); };
+
+    ThumbnailStripSpecification thumbnailSpec;
+    thumbnailSpec.InputPaths = paths;
+    thumbnailSpec.InputSpecification = GetFileTextureSpecification();
+    thumbnailSpec.SettingsFileName = s_SettingsFileName;
+    thumbnailSpec.Context = askygg::GraphicsContext::CreateShared(askygg::Application::GetWindow().GetNativeWindow());
+    if (settings["Thumbnail Size"])
+        thumbnailSpec.ThumbnailSize = std::max(settings["Thumbnail Size"].as<uint32_t>(), 1u);
+    thumbnailSpec.OnRendered = [] { askygg::Application::RequestFrames(1); };
+    s_Thumbnails = askygg::CreateScope<ThumbnailStrip>(std::move(thumbnailSpec));
+
+    ViewportRendererSpecification rendererSpec;
+    rendererSpec.SettingsFileName = s_SettingsFileName;
+    rendererSpec.Context = askygg::GraphicsContext::CreateShared(askygg::Application::GetWindow().GetNativeWindow());
+    // The UI idles between events; every step and output needs a frame to show it.
+    rendererSpec.OnProgress = [] { askygg::Application::RequestFrames(1); };
+    s_Renderer = askygg::CreateScope<ViewportRenderer>(std::move(rendererSpec));
+
+    s_Images = askygg::CreateScope<ImageLoader>(std::move(paths), loaderSpec);
 }
 
-float Execute(const std::function<void()>& operation, bool profile)
+void ImageEditor::StreamFrames(const FrameStreamSpecification &specification)
 {
-    if (profile)
+    FrameStream stream(specification);
+    const glm::vec2 frameSize = {specification.Width, specification.Height};
+    s_Pipeline->SetOutputFormat(specification.GetInternalFormat());
+
+    askygg::Texture2DSpecification inputSpec = {
+            askygg::ImageUtils::WrapMode::ClampToEdge,
+            askygg::ImageUtils::WrapMode::ClampToEdge,
+            askygg::ImageUtils::FilterMode::Linear,
+            askygg::ImageUtils::FilterMode::Linear,
+            specification.GetInternalFormat(),
+            specification.GetDataLayout(),
+            specification.GetDataType(),
+            specification.Width,
+            specification.Height
+    };
+    inputSpec.MipLevels = 1;
+
+    // Two of each, so uploading and recording frame n overlaps the GPU finishing frame n-1 and the writer draining it.
+    // Frames stay top row first on the GPU; nothing in the pipeline depends on orientation.
+    std::array<askygg::Ref<askygg::Texture2D>, 2>      inputs;
+    std::array<askygg::Scope<askygg::PixelPackBuffer>, 2> readbacks;
+    std::array<FrameStream::Frame, 2>                  inFlight;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        inputSpec.Name = "Stream Input " + std::to_string(i);
+        inputs[i] = askygg::CreateRef<askygg::Texture2D>(inputSpec);
+        readbacks[i] = askygg::CreateScope<askygg::PixelPackBuffer>(specification.GetFrameSize());
+    }
+
+    // Copies a finished readback into an output buffer and queues it for the writer.  False once stdout is gone.
+    auto drain = [&](uint32_t slot)
+    {
+        FrameStream::Frame output = stream.AcquireOutput();
+        if (output.Data.empty())
+            return false;
+
+        std::memcpy(output.Data.data(), readbacks[slot]->Map(), specification.GetFrameSize());
+        readbacks[slot]->Unmap();
+        output.Index = inFlight[slot].Index;
+        output.ReadTime = inFlight[slot].ReadTime;
+        stream.SubmitOutput(std::move(output));
+        return true;
+    };
+
+    uint64_t submitted = 0;
+    FrameStream::Frame input;
+    while (stream.AcquireInput(input))
     {
-        askygg::OpenGLFuncTimer timer;
-        return timer.ProfileFn(operation);
+        const uint32_t slot = submitted % 2;
+        inputs[slot]->SetData(input.Data.data(), (uint32_t)input.Data.size());
+        SubmitPipeline(frameSize, inputs[slot]->GetID(), false, false);
+        readbacks[slot]->ReadTexture(*s_Pipeline->GetOutputTexture(), specification.GetDataLayout(),
+                                     specification.GetDataType());
+
+        inFlight[slot].Index = input.Index;
+        inFlight[slot].ReadTime = input.ReadTime;
+        stream.ReleaseInput(std::move(input));
+
+        if (submitted++ > 0 && !drain(1 - slot))
+            break;
     }
+    if (submitted > 0 && readbacks[(submitted - 1) % 2]->IsPending())
+        drain((submitted - 1) % 2);
 
-    operation();
-    return -1.0f;
+    stream.Finish();
+    s_Pipeline->SetOutputFormat(askygg::ImageUtils::ImageInternalFormat::RGBA8);
 }
 
-void ImageEditor::SubmitPipeline(const glm::vec2 &targetSize, uint32_t targetTextureID, bool display, bool profile)
+#ifdef YGG_JOB_DAEMON
+void ImageEditor::ServeJobs(const std::string &socketPath)
 {
-    if (askygg::ShaderLibrary::IsEmpty())
+    JobServer server(socketPath);
+    if (!server.Start())
         return;
 
-    askygg::Renderer::BeginScene(targetSize);
+    // Parsed once; jobs with overrides get a merged copy and the pipeline goes back to these afterwards.
+    const YAML::Node settings = s_Settings->GetDocument();
+    askygg::Ref<askygg::Texture2D>         frameInput;
+    askygg::Scope<askygg::PixelPackBuffer> frameReadback;
 
-    auto linearizePass = s_AllPasses[ImagePassType::Linearize];
-    linearizePass->OnResize(targetSize);
-    auto linearizeSubmitFn =
-            [object = linearizePass, targetTextureID]
+    JobServer::Job job;
+    while (server.AcquireJob(job))
+    {
+        JobServer::JobResult result;
+        const bool overridden = job.Overrides.IsMap() && job.Overrides.size() > 0;
+        try
+        {
+            YAML::Node jobSettings;
+            if (overridden)
             {
-                object->Submit(targetTextureID);
-            };
-    s_PassExecutionTime[ImagePassType::Linearize] = Execute(linearizeSubmitFn, profile);
-    uint32_t linearizeOutput = linearizePass->GetOutputID();
+                jobSettings = ImagePipeline::MergeSettings(settings, job.Overrides);
+                result.Success = ImagePipeline::ValidateSettings(jobSettings, result.Message);
+            }
+            if (result.Success && overridden)
+                s_Pipeline->ApplySettings(jobSettings);
+            if (result.Success)
+                result = job.Type == JobServer::JobType::Files ? ProcessFileJob(job)
+                                                               : ProcessFrameJob(job, frameInput, frameReadback);
+        }
+        catch (const YAML::Exception &e)
+        {
+            result.Success = false;
+            result.Message = std::string("invalid overrides: ") + e.what();
+        }
 
-    if(s_ActiveBloomPassType != BloomType::None)
-    {
-        s_ActiveBloomPass->OnResize(targetSize);
-        ImagePassType bloomImagePassType = s_ActiveBloomPassType == BloomType::Radial ? ImagePassType::RadialBloom : ImagePassType::MultiPassBloom;
-        auto bloomSubmitFn =
-                [object = s_ActiveBloomPass, linearizeOutput]
-                {
-                    object->Submit(linearizeOutput);
-                };
-        s_PassExecutionTime[bloomImagePassType] = Execute(bloomSubmitFn, profile);
+        if (overridden)
+            s_Pipeline->ApplySettings(settings);
+        server.Complete(job, result);
     }
+    server.Stop();
+}
 
-    for(int i = 1; i < s_OrderedPassTypes.size(); i++)
+JobServer::JobResult ImageEditor::ProcessFileJob(const JobServer::Job &job)
+{
+    JobServer::JobResult result;
+    std::string outputDirectory = job.OutputDirectory.empty() ? s_OutputDirectory : job.OutputDirectory;
+    if (outputDirectory.empty())
+        return {false, "no output_dir given and the daemon was started without --output_dir"};
+    if (outputDirectory.back() != '/')
+        outputDirectory += '/';
+
+    std::error_code error;
+    std::filesystem::create_directories(outputDirectory, error);
+    if (error)
+        return {false, "cannot create '" + outputDirectory + "': " + error.message()};
+
+    // A bad input fails the job but does not stop the others from being written.
+    const askygg::Texture2DSpecification fileTexSpec = GetFileTextureSpecification();
+    for (const auto &filePath: job.Inputs)
     {
-        auto currentPassType = s_OrderedPassTypes[i];
-        auto currentPass = s_AllPasses[currentPassType];
-        currentPass->OnResize(targetSize);
+        if (!askygg::Texture2D::IsLoadable(filePath))
+        {
+            if (result.Success)
+                result = {false, "cannot decode '" + filePath + "'", result.Processed};
+            continue;
+        }
 
-        uint32_t previousPassOutput = s_AllPasses[s_OrderedPassTypes[i - 1]]->GetOutputID();
+        askygg::Texture2D texture(filePath, fileTexSpec);
+        SaveTexture(texture, outputDirectory, false);
+        result.Processed++;
+    }
+    return result;
+}
 
-        auto submitFn =
-                [object = currentPass, previousPassOutput]
-                {
-                    object->Submit(previousPassOutput);
-                };
-        s_PassExecutionTime[currentPassType] = Execute(submitFn, profile);
+JobServer::JobResult ImageEditor::ProcessFrameJob(const JobServer::Job &job, askygg::Ref<askygg::Texture2D> &input,
+                                                  askygg::Scope<askygg::PixelPackBuffer> &readback)
+{
+    const FrameStreamSpecification &specification = job.FrameSpecification;
+    const glm::vec2 frameSize = {specification.Width, specification.Height};
+    const uint64_t frameBytes = specification.GetFrameSize();
+
+    if (!input || input->GetWidth() != specification.Width || input->GetHeight() != specification.Height
+        || input->GetSpecification().InternalFormat != specification.GetInternalFormat()
+        || input->GetSpecification().PixelLayoutFormat != specification.GetDataLayout())
+    {
+        askygg::Texture2DSpecification inputSpec = {
+                askygg::ImageUtils::WrapMode::ClampToEdge,
+                askygg::ImageUtils::WrapMode::ClampToEdge,
+                askygg::ImageUtils::FilterMode::Linear,
+                askygg::ImageUtils::FilterMode::Linear,
+                specification.GetInternalFormat(),
+                specification.GetDataLayout(),
+                specification.GetDataType(),
+                specification.Width,
+                specification.Height
+        };
+        inputSpec.MipLevels = 1;
+        inputSpec.Name = "Daemon Frame Input";
+        input = askygg::CreateRef<askygg::Texture2D>(inputSpec);
     }
+    if (!readback || readback->GetSize() != frameBytes)
+        readback = askygg::CreateScope<askygg::PixelPackBuffer>(frameBytes);
 
-    if (display)
+    JobServer::JobResult result;
+    s_Pipeline->SetOutputFormat(specification.GetInternalFormat());
+    for (size_t i = 0; i < job.FrameFds.size(); i++)
     {
-        uint32_t outputComputeOutID = s_AllPasses[ImagePassType::OutputCompute]->GetOutputID();
-        s_DisplayRenderPass->GetSpecification().PassFramebuffer->Resize(targetSize.x, targetSize.y);
-        SubmitOutputDisplayPass(outputComputeOutID);
+        // The client's memory is read by the upload and overwritten with the result; nothing crosses the socket.
+        SharedFrame frame(job.FrameFds[i], frameBytes);
+        if (!frame.IsValid())
+        {
+            result = {false, "frame " + std::to_string(i) + " cannot be mapped or is smaller than " +
+                             std::to_string(frameBytes) + " bytes", result.Processed};
+            break;
+        }
+
+        input->SetData(frame.GetData(), (uint32_t)frameBytes);
+        SubmitPipeline(frameSize, input->GetID(), false, false);
+        readback->ReadTexture(*s_Pipeline->GetOutputTexture(), specification.GetDataLayout(),
+                              specification.GetDataType());
+        std::memcpy(frame.GetData(), readback->Map(), frameBytes);
+        readback->Unmap();
+        result.Processed++;
     }
+    s_Pipeline->SetOutputFormat(askygg::ImageUtils::ImageInternalFormat::RGBA8);
+    return result;
+}
+#endif
+
+void ImageEditor::SubmitPipeline(const glm::vec2 &targetSize, uint32_t targetTextureID, bool display, bool profile)
+{
+    if (askygg::ShaderLibrary::IsEmpty())
+        return;
+
+    askygg::Renderer::BeginScene(targetSize);
+    s_Pipeline->Submit(targetSize, targetTextureID,
+                       display ? askygg::RenderGraphAccess::Sampled : askygg::RenderGraphAccess::Readback, profile);
     askygg::Renderer::EndScene();
 }
 
+// Everything the displayed image depends on: the active input, what is shown and each pass's place and settings.
+static uint64_t GetDisplayStateHash(ImagePipeline &pipeline, askygg::TextureHandle activeTexture, bool unprocessed)
+{
+    const uint64_t display[3] = {(uint64_t)activeTexture.Value, (uint64_t)unprocessed, (uint64_t)pipeline.GetBloomType()};
+    uint64_t hash = ImagePass::HashBytes(display, sizeof(display));
+
+    std::vector<ImagePassType> passTypes = pipeline.GetOrderedPassTypes();
+    if (pipeline.GetBloomType() != BloomType::None)
+        passTypes.push_back(ImagePass::ImagePassTypeFromBloomType(pipeline.GetBloomType()));
+    for (ImagePassType passType : passTypes)
+    {
+        const uint64_t pass[2] = {(uint64_t)passType, pipeline.GetPass(passType)->GetSettingsHash()};
+        hash = ImagePass::HashBytes(pass, sizeof(pass), hash);
+    }
+    return hash;
+}
+
 void ImageEditor::DrawActiveTexture()
 {
-    if (s_TextureSet.empty())
+    if (!s_Images || s_Images->GetImageCount() == 0)
         return;
-    auto &activeTexture = askygg::TextureLibrary::Get2DFromID(s_TextureSet[s_ActiveTextureIndex]);
-    auto activeTextureSize = glm::vec2(activeTexture.GetWidth(), activeTexture.GetHeight());
+    if (s_Images->Update(s_ActiveTextureIndex))
+        s_DisplayDirty = true;
+    UpdateThumbnails();
+    s_Renderer->Update();
+    // The strip holds back for as long as the render thread has the viewport's image to render.
+    if (s_Renderer->IsBusy())
+        s_Thumbnails->NotifyViewportRendered();
+    // Nothing to show before the first decode finishes; it requests the frame that shows it.
+    const askygg::TextureHandle activeHandle = s_Images->GetTexture(s_ActiveTextureIndex);
+    if (!activeHandle)
+        return;
+    auto &activeTexture = askygg::TextureRegistry::Get(activeHandle);
+
+    // While a setting is being dragged, a preview sized to the viewport stands in for the full-size image; the
+    // full size renders once the control is released.
+    uint32_t previewMip = 0;
+    if (!s_DisplayUnprocessedInput && askygg::UI::UIProperty::IsAnyActive())
+        previewMip = GetPreviewMip(activeTexture);
+
+    // The viewport shows the last output until something it depends on changes; the display size does not count,
+    // the viewport scales the image itself.
+    uint64_t displayState = GetDisplayStateHash(*s_Pipeline, activeHandle, s_DisplayUnprocessedInput);
+    displayState = ImagePass::HashBytes(&previewMip, sizeof(previewMip), displayState);
+    if (!s_DisplayDirty && displayState == s_DisplayState)
+    {
+        s_SkippedFrameCount++;
+        return;
+    }
+    s_DisplayState = displayState;
+    s_DisplayDirty = false;
+    s_RenderedFrameCount++;
 
-    if(s_DisplayUnprocessedInput)
+    if (s_DisplayUnprocessedInput)
+        return;
+
+    const uint64_t settings = GetDisplayStateHash(*s_Pipeline, askygg::TextureHandle(), false);
+    if (settings != s_RequestSettings)
     {
-        askygg::Renderer::BeginScene(activeTextureSize);
-        s_DisplayRenderPass->GetSpecification().PassFramebuffer->Resize(activeTextureSize.x, activeTextureSize.y);
-        SubmitOutputDisplayPass(s_TextureSet[s_ActiveTextureIndex]);
-        askygg::Renderer::EndScene();
+        s_RequestSettings = settings;
+        // Rebinds the handle; assigning would overwrite the document requests still in flight share.
+        s_RequestSettingsNode.reset(s_Pipeline->ExportSettings());
     }
+
+    ViewportRenderRequest request;
+    request.Settings = s_RequestSettingsNode;
+    request.SettingsHash = settings;
+    request.Input = askygg::TextureRegistry::GetRef(activeHandle);
+    // Until the full resolution is decoded, a JPEG's reduced-scale preview stands in for it.
+    request.ImageWidth = (float)s_Images->GetImageSize(s_ActiveTextureIndex).x;
+    request.PreviewMip = previewMip;
+    request.StepBudget = s_ProgressiveFrameBudget;
+    // The input may have been uploaded this very frame.
+    request.Ready = askygg::CreateRef<askygg::Fence>();
+    s_Renderer->Submit(std::move(request));
+}
+
+void ImageEditor::StartCaptureAll()
+{
+    BatchCaptureSpecification capture;
+    for (uint32_t i = 0; i < s_Images->GetImageCount(); i++)
+        capture.InputPaths.push_back(s_Images->GetPath(i));
+    capture.InputSpecification = GetFileTextureSpecification();
+    capture.OutputDirectory = s_OutputDirectory;
+    capture.SettingsFileName = s_SettingsFileName;
+    // Unsaved edits included: the outputs match what the viewport shows.
+    capture.Settings = s_Pipeline->ExportSettings();
+    capture.Context = askygg::GraphicsContext::CreateShared(askygg::Application::GetWindow().GetNativeWindow());
+    // Progress is drawn by the UI, which otherwise idles until the next event.
+    capture.OnProgress = [] { askygg::Application::RequestFrames(1); };
+    s_Capture = askygg::CreateScope<BatchCapture>(std::move(capture));
+}
+
+void ImageEditor::UpdateThumbnails()
+{
+    s_Thumbnails->Update(s_ActiveTextureIndex);
+    // While a control is dragged the strip would only start sweeps it never finishes.
+    if (askygg::UI::UIProperty::IsAnyActive())
+        return;
+    const uint64_t settings = GetDisplayStateHash(*s_Pipeline, askygg::TextureHandle(), false);
+    if (settings == s_ThumbnailSettings)
+        return;
+    s_ThumbnailSettings = settings;
+    s_Thumbnails->SetSettings(s_Pipeline->ExportSettings());
+}
+
+void ImageEditor::DrawThumbnailStrip()
+{
+    ImGui::Begin("Thumbnails", nullptr, ImGuiWindowFlags_HorizontalScrollbar);
+    if (s_Thumbnails->GetPendingCount() > 0)
+        ImGui::Text("Updating: %u of %u left", s_Thumbnails->GetPendingCount(), s_Thumbnails->GetImageCount());
     else
+        ImGui::Text("%u images, %.1f ms per thumbnail", s_Thumbnails->GetImageCount(), s_Thumbnails->GetRenderTime());
+
+    const float height = std::max(ImGui::GetContentRegionAvail().y - ImGui::GetStyle().ScrollbarSize
+                                  - 2.0f * ImGui::GetStyle().FramePadding.y, 32.0f);
+    for (uint32_t i = 0; i < s_Thumbnails->GetImageCount(); i++)
     {
-        SubmitPipeline(activeTextureSize, s_TextureSet[s_ActiveTextureIndex], true, true);
+        if (i > 0)
+            ImGui::SameLine();
+        ImGui::PushID((int)i);
+        const glm::uvec2 size = s_Thumbnails->GetThumbnailSize(i);
+        const float width = size.y > 0 ? height * (float)size.x / (float)size.y : height * 16.0f / 9.0f;
+        const bool active = i == s_ActiveTextureIndex;
+        if (active)
+            ImGui::PushStyleColor(ImGuiCol_Button, ImGui::GetStyleColorVec4(ImGuiCol_ButtonActive));
+
+        bool clicked;
+        if (const uint32_t textureID = s_Thumbnails->GetTextureID(i))
+        {
+            // Thumbnails from earlier settings stay up, dimmed, until theirs is rendered.
+            const ImVec4 tint = s_Thumbnails->IsCurrent(i) ? ImVec4(1, 1, 1, 1) : ImVec4(1, 1, 1, 0.5f);
+            clicked = ImGui::ImageButton("##Thumbnail", reinterpret_cast<ImTextureID>(textureID), {width, height},
+                                         {0, 1}, {1, 0}, ImVec4(0, 0, 0, 0), tint);
+        }
+        else
+            clicked = ImGui::Button(s_Thumbnails->IsFailed(i) ? "Unreadable" : "...", {width, height});
+        if (clicked)
+            s_ActiveTextureIndex = i;
+
+        if (active)
+            ImGui::PopStyleColor();
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("%s", std::filesystem::path(s_Images->GetPath(i)).filename().string().c_str());
+        ImGui::PopID();
     }
+    ImGui::End();
+}
+
+uint32_t ImageEditor::GetPreviewMip(const askygg::Texture2D &texture)
+{
+    if (s_LastRecordedViewportSize.x < 1.0f || s_LastRecordedViewportSize.y < 1.0f)
+        return 0;
+    glm::vec2 framebufferScale = {ImGui::GetIO().DisplayFramebufferScale.x, ImGui::GetIO().DisplayFramebufferScale.y};
+    glm::vec2 screenPixels = s_LastRecordedViewportSize * framebufferScale;
+    float downscale = std::min((float)texture.GetWidth() / screenPixels.x, (float)texture.GetHeight() / screenPixels.y);
+    if (downscale < 2.0f)
+        return 0;
+    return std::min((uint32_t)std::floor(std::log2(downscale)), texture.GetMipLevelCount() - 1);
+}
+
+uint32_t ImageEditor::GetDisplayTextureID()
+{
+    if (!s_Images || s_Images->GetImageCount() == 0)
+        return 0;
+    const askygg::TextureHandle activeHandle = s_Images->GetTexture(s_ActiveTextureIndex);
+    if (!activeHandle)
+        return 0;
+    if (s_DisplayUnprocessedInput)
+        return askygg::TextureRegistry::Get(activeHandle).GetID();
+    return s_Renderer->GetOutputTextureID();
+}
+
+glm::vec2 ImageEditor::GetDisplayTextureSize()
+{
+    if (!s_Images || s_Images->GetImageCount() == 0)
+        return glm::vec2(1.0f);
+    const glm::uvec2 imageSize = s_Images->GetImageSize(s_ActiveTextureIndex);
+    if (imageSize.x == 0 || imageSize.y == 0)
+        return glm::vec2(1.0f);
+    return imageSize;
 }
 
 void ImageEditor::SaveTexture(const askygg::Texture2D &texture,
                               const std::string &outputDirectory,
                               bool profile)
 {
-    glm::vec2 textureSize{texture.GetWidth(), texture.GetHeight()};
-    SubmitPipeline(textureSize, texture.GetID(), false, profile);
-
-    std::filesystem::path path(texture.GetName());
-    // Removes the previous extension - keeps just the name.
-    std::string name = path.stem().string();
-
-    std::string filePath = outputDirectory + name + ".jpeg";
+    if (askygg::ShaderLibrary::IsEmpty())
+        return;
 
-    uint32_t outputID = s_AllPasses[ImagePassType::OutputCompute]->GetOutputID();
-    auto &outputTexture = askygg::TextureLibrary::Get2DFromID(outputID);
-    outputTexture.Save(filePath, true);
+    askygg::Renderer::BeginScene({texture.GetWidth(), texture.GetHeight()});
+    s_Pipeline->Save(texture, outputDirectory, profile);
+    askygg::Renderer::EndScene();
 }
 
 void ImageEditor::SavePassOrder()
 {
-    YAML::Node existingConfig;
-    existingConfig = YAML::LoadFile(s_SettingsFileName);
     std::vector<std::string> orderedPassesToString;
-    for(int i = 1; i < s_OrderedPassTypes.size() - 1; i++)
+    const auto& orderedPassTypes = s_Pipeline->GetOrderedPassTypes();
+    for(size_t i = 1; i + 1 < orderedPassTypes.size(); i++)
     {
-        std::string passToString = ImagePass::ImagePassTypeToString(s_OrderedPassTypes[i]);
+        std::string passToString = ImagePass::ImagePassTypeToString(orderedPassTypes[i]);
         orderedPassesToString.push_back(passToString);
     }
-    existingConfig["PassOrder"] = orderedPassesToString;
-    std::ofstream outFile(s_SettingsFileName);
-    outFile << existingConfig;
+    // Runs on every drop while reordering; the store writes once the reordering settles.
+    s_Settings->Edit([&](YAML::Node& document) { document["PassOrder"] = orderedPassesToString; });
 }
 
 void DrawDisabledButton(const std::string& label)
@@ -374,29 +921,35 @@ void DrawDisabledButton(const std::string& label)
 
 void ImageEditor::DrawImageEditorUI()
 {
+    auto& orderedPassTypes = s_Pipeline->GetOrderedPassTypes();
+    // Measured by the render thread for the output on display.
+    const ViewportRenderStatistics& statistics = s_Renderer->GetStatistics();
+    const auto& elidedPasses = statistics.ElidedPasses;
+    const auto& cachedPasses = statistics.CachedPasses;
+
     ImGui::Begin("Pass Inspector");
     // Draw the output compute pass first for convenience.
-    auto outputComputePass = s_AllPasses[ImagePassType::OutputCompute];
+    auto outputComputePass = s_Pipeline->GetPass(ImagePassType::OutputCompute);
     outputComputePass->DrawUI();
-    if(s_ActiveBloomPassType != BloomType::None && s_ActiveBloomPass != nullptr)
-        s_ActiveBloomPass->DrawUI();
+    if(s_Pipeline->GetBloomType() != BloomType::None && s_Pipeline->GetActiveBloomPass() != nullptr)
+        s_Pipeline->GetActiveBloomPass()->DrawUI();
     // Skip the last element - which will be the output compute pass.
-    for(int i = 0; i < s_OrderedPassTypes.size() - 1; i++)
-        s_AllPasses[s_OrderedPassTypes[i]]->DrawUI();
+    for(size_t i = 0; i + 1 < orderedPassTypes.size(); i++)
+        s_Pipeline->GetPass(orderedPassTypes[i])->DrawUI();
     ImGui::End();
 
     ImGui::Begin("Capture Controls");
     if (ImGui::Button("Previous"))
     {
         if (s_ActiveTextureIndex == 0)
-            s_ActiveTextureIndex = s_TextureSet.size() - 1;
+            s_ActiveTextureIndex = s_Images->GetImageCount() - 1;
         else
             s_ActiveTextureIndex--;
     }
     ImGui::SameLine(75);
     if (ImGui::Button("Next"))
     {
-        s_ActiveTextureIndex = (s_ActiveTextureIndex + 1) % s_TextureSet.size();
+        s_ActiveTextureIndex = (s_ActiveTextureIndex + 1) % s_Images->GetImageCount();
     }
     ImGui::SameLine(150);
 
@@ -408,32 +961,49 @@ void ImageEditor::DrawImageEditorUI()
 
     if (ImGui::CollapsingHeader("Capture Frame"), ImGuiTreeNodeFlags_DefaultOpen)
     {
+        // Captures always run on the full resolution, decoded on the spot if it is not resident yet.
         if (ImGui::Button("Capture Current"))
         {
-            const askygg::Texture2D &activeTexture =
-                    askygg::TextureLibrary::Get2DFromID(s_TextureSet[s_ActiveTextureIndex]);
-            SaveTexture(activeTexture, s_OutputDirectory);
+            askygg::TextureHandle handle = s_Images->LoadFullResolution(s_ActiveTextureIndex);
+            if (handle)
+                SaveTexture(askygg::TextureRegistry::Get(handle), s_OutputDirectory);
         }
 
-        if (ImGui::Button("Capture All"))
+        if (s_Capture && s_Capture->IsFinished())
         {
-            std::chrono::high_resolution_clock::time_point start =
-                    std::chrono::high_resolution_clock::now();
-            for (unsigned int i: s_TextureSet)
-            {
-                const askygg::Texture2D &activeTexture =
-                        askygg::TextureLibrary::Get2DFromID(s_TextureSet[i]);
-                SaveTexture(activeTexture, s_OutputDirectory);
-            }
+            YGG_LOG_INFO("'Capture All' {} {} of {} images in {:.2f} s, {} failed",
+                         s_Capture->IsCancelled() ? "was cancelled after" : "wrote", s_Capture->GetCompletedCount(),
+                         s_Capture->GetImageCount(), s_Capture->GetElapsedSeconds(), s_Capture->GetFailedCount());
+            s_Capture = nullptr;
+        }
 
-            std::chrono::high_resolution_clock::time_point end =
-                    std::chrono::high_resolution_clock::now();
-            std::chrono::duration<double, std::milli> time_span = end - start;
-            YGG_LOG_INFO("'Capture All' command completed in: {} ms", std::to_string(time_span.count()));
+        if (!s_Capture)
+        {
+            if (ImGui::Button("Capture All"))
+                StartCaptureAll();
+        }
+        else
+        {
+            const uint32_t done = s_Capture->GetCompletedCount() + s_Capture->GetFailedCount();
+            const double seconds = s_Capture->GetElapsedSeconds();
+            const std::string overlay = std::to_string(done) + " / " + std::to_string(s_Capture->GetImageCount());
+            ImGui::ProgressBar((float)done / (float)std::max(s_Capture->GetImageCount(), 1u), ImVec2(-1.0f, 0.0f),
+                               overlay.c_str());
+            const double remaining = s_Capture->GetRemainingSeconds();
+            if (remaining >= 0.0)
+                ImGui::Text("%.2f images/s, %.0f s left", done / std::max(seconds, 1e-9), remaining);
+            else
+                ImGui::Text("Starting...");
+            if (s_Capture->IsCancelled())
+                ImGui::Text("Cancelling...");
+            else if (ImGui::Button("Cancel"))
+                s_Capture->Cancel();
         }
     }
     ImGui::End();
 
+    DrawThumbnailStrip();
+
     ImGui::Begin("Performance Monitor");
     if (ImGui::TreeNode("Image Pass Types"))
     {
@@ -442,7 +1012,7 @@ void ImageEditor::DrawImageEditorUI()
         auto elapsedSeconds = std::chrono::duration<double>(currentTime - s_LastSortTime).count();
         if (elapsedSeconds >= updateSeconds)
         {
-            s_SortedExecutionTimes.assign(s_PassExecutionTime.begin(), s_PassExecutionTime.end());
+            s_SortedExecutionTimes.assign(statistics.PassExecutionTimes.begin(), statistics.PassExecutionTimes.end());
 
             std::sort(s_SortedExecutionTimes.begin(), s_SortedExecutionTimes.end(),
                       [](const auto &a, const auto &b)
@@ -451,34 +1021,84 @@ void ImageEditor::DrawImageEditorUI()
             s_LastSortTime = currentTime;
         }
 
-        ImagePassType bloomImagePassType = ImagePass::ImagePassTypeFromBloomType(s_ActiveBloomPassType);
+        ImagePassType bloomImagePassType = ImagePass::ImagePassTypeFromBloomType(s_Pipeline->GetBloomType());
         for (auto [passType, time]: s_SortedExecutionTimes)
         {
-            auto it = std::find(s_OrderedPassTypes.begin(), s_OrderedPassTypes.end(), passType);
-            if(passType == bloomImagePassType || it != s_OrderedPassTypes.end())
+            auto it = std::find(orderedPassTypes.begin(), orderedPassTypes.end(), passType);
+            if(elidedPasses.count(passType) || cachedPasses.count(passType))
+                continue;
+            if(passType == bloomImagePassType || it != orderedPassTypes.end())
                 ImGui::BulletText("%s: %fms", ImagePass::ImagePassTypeToString(passType).c_str(), time);
         }
+        for (ImagePassType passType : orderedPassTypes)
+        {
+            if (elidedPasses.count(passType))
+                ImGui::BulletText("%s: elided", ImagePass::ImagePassTypeToString(passType).c_str());
+            else if (cachedPasses.count(passType))
+                ImGui::BulletText("%s: cached", ImagePass::ImagePassTypeToString(passType).c_str());
+        }
+        if (cachedPasses.count(bloomImagePassType))
+            ImGui::BulletText("%s: cached", ImagePass::ImagePassTypeToString(bloomImagePassType).c_str());
         ImGui::TreePop();
     }
 
+    ImGui::Text("GPU Memory: %.1f MB (peak %.1f MB)", (double)statistics.MemorySize / (1024.0 * 1024.0),
+                (double)statistics.PeakMemorySize / (1024.0 * 1024.0));
+    ImGui::Text("Pooled Targets: %u", statistics.TransientTextureCount);
+    ImGui::Text("Input Images: %u of %u resident, %.1f MB (budget %.0f MB), %llu released",
+                s_Images->GetResidentCount(), s_Images->GetImageCount(),
+                (double)s_Images->GetResidentMemory() / (1024.0 * 1024.0),
+                (double)(s_Images->GetMemoryBudget() >> 20), (unsigned long long)s_Images->GetEvictionCount());
+    ImGui::Text("Image Decode: %.1f ms preview, %.1f ms full size", s_Images->GetPreviewDecodeTime(),
+                s_Images->GetFullDecodeTime());
+    ImGui::Text("Elided Passes: %zu", elidedPasses.size());
+    ImGui::Text("Pipeline Requests: %llu submitted, %llu skipped", (unsigned long long)s_RenderedFrameCount,
+                (unsigned long long)s_SkippedFrameCount);
+    ImGui::Text("Render Thread: %llu published, %llu superseded, %llu abandoned",
+                (unsigned long long)s_Renderer->GetPublishedCount(), (unsigned long long)s_Renderer->GetSupersededCount(),
+                (unsigned long long)s_Renderer->GetAbandonedCount());
+    ImGui::Text("Render Time: %.2f ms full size, %.2f ms preview%s", statistics.FullRenderTime,
+                statistics.PreviewRenderTime, statistics.Preview ? " (showing preview)" : "");
+    const float progress = s_Renderer->GetProgress();
+    if (progress >= 0.0f)
+        ImGui::Text("Progressive Render: %.0f%%", 100.0f * progress);
+    else if (statistics.StepCount > 1)
+        ImGui::Text("Progressive Render: last took %u steps", statistics.StepCount);
+    ImGui::SetNextItemWidth(120.0f);
+    ImGui::DragFloat("Step Budget (ms)", &s_ProgressiveFrameBudget, 0.25f, 0.0f, 100.0f, "%.2f");
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("GPU time a full-size render may use before newer settings are looked at; 0 renders in one go.");
+    if (ImGui::IsItemDeactivatedAfterEdit())
+    {
+        s_ProgressiveFrameBudget = std::max(s_ProgressiveFrameBudget, 0.0f);
+        s_DisplayDirty = true;
+        s_Settings->Edit([](YAML::Node& document) { document["Progressive Frame Budget"] = s_ProgressiveFrameBudget; });
+    }
+    const askygg::Application &application = askygg::Application::GetApplication();
+    // The UI thread only draws; how long the pipeline takes shows up in the latency, not the frame time.
+    ImGui::Text("UI Frame: %.2f ms CPU, Pipeline Latency: %.1f ms", application.GetFrameTime(), statistics.Latency);
+    if (application.IsRenderOnDemand())
+        ImGui::Text("UI Frames: %llu drawn, %llu idle waits", (unsigned long long)application.GetFrameCount(),
+                    (unsigned long long)application.GetIdleWaitCount());
+    uint64_t cacheLookups = statistics.PassCacheHits + statistics.PassCacheMisses;
+    ImGui::Text("Pass Cache: %zu cached last render, %llu hits / %llu misses (%.1f%% hit rate)", cachedPasses.size(),
+                (unsigned long long)statistics.PassCacheHits, (unsigned long long)statistics.PassCacheMisses,
+                cacheLookups ? 100.0 * (double)statistics.PassCacheHits / (double)cacheLookups : 0.0);
+
     ImGui::End();
 
     ImGui::Begin("Execution Definition");
 
     static const char* items[] = { "None", "Radial", "Multi-Pass" };
-    static int		   currentItem = static_cast<int>(s_ActiveBloomPassType);
+    static int		   currentItem = static_cast<int>(s_Pipeline->GetBloomType());
 
     if (ImGui::Combo("Bloom Type", &currentItem, items, IM_ARRAYSIZE(items)))
     {
         auto type = static_cast<BloomType>(currentItem);
 
-        SetBloomPass(type);
+        s_Pipeline->SetBloomPass(type);
         // Update the config with the new bloom type.
-        YAML::Node existingConfig;
-        existingConfig = YAML::LoadFile(s_SettingsFileName);
-        existingConfig["Bloom Pass Type"] = static_cast<int>(type);
-        std::ofstream outFile(s_SettingsFileName);
-        outFile << existingConfig;
+        s_Settings->Edit([type](YAML::Node& document) { document["Bloom Pass Type"] = static_cast<int>(type); });
     }
 
     float windowWidth = ImGui::GetContentRegionAvail().x;
@@ -486,16 +1106,23 @@ void ImageEditor::DrawImageEditorUI()
 
     ImGui::BeginChild("ActivePasses", ImVec2(panelWidth, 0), true);
     {
-        DrawDisabledButton(ImagePass::ImagePassTypeToString(s_OrderedPassTypes[0]));
+        DrawDisabledButton(ImagePass::ImagePassTypeToString(orderedPassTypes[0]));
 
-        for (size_t i = 1; i < s_OrderedPassTypes.size() - 1; ++i)
+        for (size_t i = 1; i < orderedPassTypes.size() - 1; ++i)
         {
-            std::string typeString = ImagePass::ImagePassTypeToString(s_OrderedPassTypes[i]);
-            ImGui::Button(typeString.c_str());
+            std::string typeString = ImagePass::ImagePassTypeToString(orderedPassTypes[i]);
+            // Elided passes stay in the order (and draggable) but are dimmed so it is clear they cost nothing.
+            bool elided = elidedPasses.count(orderedPassTypes[i]) > 0;
+            if (elided)
+                ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyleColorVec4(ImGuiCol_TextDisabled));
+            bool cached = cachedPasses.count(orderedPassTypes[i]) > 0;
+            ImGui::Button((typeString + (elided ? " (elided)" : cached ? " (cached)" : "") + "###" + typeString).c_str());
+            if (elided)
+                ImGui::PopStyleColor();
 
             if(ImGui::BeginDragDropSource())
             {
-                ImGui::SetDragDropPayload("ACTIVE_PASS", &s_OrderedPassTypes[i], sizeof(ImagePassType));
+                ImGui::SetDragDropPayload("ACTIVE_PASS", &orderedPassTypes[i], sizeof(ImagePassType));
                 ImGui::EndDragDropSource();
             }
 
@@ -505,11 +1132,11 @@ void ImageEditor::DrawImageEditorUI()
                 {
                     IM_ASSERT(payload->DataSize == sizeof(size_t));
                     ImagePassType swapType = *(const ImagePassType*)payload->Data;
-                    auto it = std::find(s_OrderedPassTypes.begin(), s_OrderedPassTypes.end(), swapType);
-                    if (it != s_OrderedPassTypes.end())
+                    auto it = std::find(orderedPassTypes.begin(), orderedPassTypes.end(), swapType);
+                    if (it != orderedPassTypes.end())
                     {
-                        size_t index = std::distance(s_OrderedPassTypes.begin(), it);
-                        std::swap(s_OrderedPassTypes[i], s_OrderedPassTypes[index]);
+                        size_t index = std::distance(orderedPassTypes.begin(), it);
+                        std::swap(orderedPassTypes[i], orderedPassTypes[index]);
                         SavePassOrder();
                     }
                 }
@@ -517,7 +1144,7 @@ void ImageEditor::DrawImageEditorUI()
             }
         }
 
-        DrawDisabledButton(ImagePass::ImagePassTypeToString(s_OrderedPassTypes[s_OrderedPassTypes.size() - 1]));
+        DrawDisabledButton(ImagePass::ImagePassTypeToString(orderedPassTypes[orderedPassTypes.size() - 1]));
 
         // Drop inactive pass types here
         ImGui::InvisibleButton("DropAreaActive", ImVec2(-1, -1));
@@ -527,7 +1154,7 @@ void ImageEditor::DrawImageEditorUI()
             {
                 IM_ASSERT(payload->DataSize == sizeof(ImagePassType));
                 ImagePassType newType = *(const ImagePassType*)payload->Data;
-                s_OrderedPassTypes.insert(s_OrderedPassTypes.end() - 1, newType);
+                orderedPassTypes.insert(orderedPassTypes.end() - 1, newType);
                 SavePassOrder();
             }
             ImGui::EndDragDropTarget();
@@ -542,7 +1169,7 @@ void ImageEditor::DrawImageEditorUI()
     {
         for (const auto& type : ImagePass::GetAllBasicImagePassTypes())
         {
-            if (std::find(s_OrderedPassTypes.begin(), s_OrderedPassTypes.end(), type) == s_OrderedPassTypes.end())
+            if (std::find(orderedPassTypes.begin(), orderedPassTypes.end(), type) == orderedPassTypes.end())
             {
                 ImGui::Button(ImagePass::ImagePassTypeToString(type).c_str());
                 if (ImGui::BeginDragDropSource())
@@ -561,8 +1188,8 @@ void ImageEditor::DrawImageEditorUI()
             {
                 IM_ASSERT(payload->DataSize == sizeof(ImagePassType));
                 ImagePassType newType = *static_cast<const ImagePassType*>(payload->Data);
-                if (auto it = std::find(s_OrderedPassTypes.begin(), s_OrderedPassTypes.end(), newType); it != s_OrderedPassTypes.end())
-                    s_OrderedPassTypes.erase(it);
+                if (auto it = std::find(orderedPassTypes.begin(), orderedPassTypes.end(), newType); it != orderedPassTypes.end())
+                    orderedPassTypes.erase(it);
                 SavePassOrder();
             }
             ImGui::EndDragDropTarget();
@@ -573,12 +1200,17 @@ void ImageEditor::DrawImageEditorUI()
     ImGui::End();
 }
 
-const askygg::Ref<askygg::Framebuffer> &ImageEditor::GetOutputFBO()
-{
-    return s_DisplayRenderPass->GetSpecification().PassFramebuffer;
-}
+
 
 void ImageEditor::ShutdownImageEditor()
 {
-    s_AllPasses.clear();
+    s_Renderer = nullptr;
+    s_Capture = nullptr;
+    s_Thumbnails = nullptr;
+    s_Images = nullptr;
+    s_Pipeline->Shutdown();
+    s_Pipeline = nullptr;
+    s_CpuBackend = nullptr;
+    // The last reference; writes edits still waiting for the debounce interval.
+    s_Settings = nullptr;
 }
@@ -6,58 +6,139 @@
 #include "askygg/renderer/Camera.h"
 #include "askygg/event/Event.h"
 #include "askygg/renderer/Texture.h"
+#include "askygg/renderer/RenderGraph.h"
 #include "askygg/ui/Viewport.h"
 
 #include "ImagePass.h"
-#include "Passes/OutputComputePass.h"
+#include "ImagePipeline.h"
+#include "SettingsStore.h"
+#include "FrameStream.h"
+#include "InputEnumerator.h"
+#include "TarStream.h"
+#include "OutputWriter.h"
+#include "ImageLoader.h"
+#include "BatchCapture.h"
+#include "ThumbnailStrip.h"
+#include "ViewportRenderer.h"
+#include "VariantSweep.h"
+#include "Cpu/CpuPipeline.h"
+
+#ifdef YGG_JOB_DAEMON
+	#include "askygg/renderer/PixelBuffer.h"
+	#include "JobServer.h"
+#endif
 
 #include <chrono>
 
 class ImageEditor
 {
 public:
+	// With cpuBackend no shaders are compiled and headless runs process on a CpuPipeline instead; the other modes need
+	// the GPU.
 	static void InitializeImageEditor(const std::string& inputDirectory,
 		const std::string&								 outputDirectory,
-		const std::string&								 settingsFileName);
+		const std::string&								 settingsFileName,
+		const CpuPipelineSpecification*					 cpuBackend = nullptr);
 	static void ShutdownImageEditor();
 
+	// Hands the render thread a new request if anything the displayed image depends on changed since last time, and
+	// takes the newest output it finished.
 	static void DrawActiveTexture();
 	static void DrawImageEditorUI();
 
-	static void HeadlessProcessDirectory();
+	// Spreads the inputs over workerCount pipelines, each on its own shared GL context, while they are still being
+	// enumerated.  Outputs mirror the inputs' subdirectories, or are appended to outputArchive ("-" for stdout) under
+	// the inputs' names when one is given.  Files are written in the background as specified by output.  With
+	// scalingReport the inputs are processed once per worker count from 1 to workerCount and the throughput of each
+	// run is logged.  With variantsFileName (see VariantSweep) every input is decoded once and rendered with each
+	// variant into a folder of its own, and a contact sheet of all of them is written next to the folders.
+	static void HeadlessProcessDirectory(const InputEnumeratorSpecification& input, uint32_t workerCount = 1,
+		bool scalingReport = false, const std::string& outputArchive = "",
+		const OutputWriterSpecification& output = OutputWriterSpecification(),
+		const std::string& variantsFileName = "");
+	// Lists the images in directoryPath; each is decoded once it is shown or about to be.
 	static void LoadTextureSet(const std::string& directoryPath);
-
-	static const askygg::Ref<askygg::Framebuffer>& GetOutputFBO();
+	// Pipes raw frames from stdin through the pipeline to stdout until stdin ends.
+	static void StreamFrames(const FrameStreamSpecification& specification);
+#ifdef YGG_JOB_DAEMON
+	// Keeps the pipeline warm and runs jobs from a Unix domain socket until a client asks it to shut down.
+	static void ServeJobs(const std::string& socketPath);
+#endif
+
+	// What the viewport shows: the render thread's last output, or the active input while the original is displayed.
+	static uint32_t	 GetDisplayTextureID();
+	static glm::vec2 GetDisplayTextureSize();
+	// On-screen size of the viewport, which the interactive preview resolution is matched to.
+	static void		 SetViewportSize(const glm::vec2& viewportSize) { s_LastRecordedViewportSize = viewportSize; }
 
 private:
 	static void SubmitPipeline(const glm::vec2& targetSize, uint32_t targetTextureID, bool display = false, bool profile = true);
 	static void SaveTexture(const askygg::Texture2D& texture, const std::string& outputDirectory, bool profile = true);
+	// Starts capturing every input with the settings as they are now; the editor stays usable meanwhile.
+	static void StartCaptureAll();
+	// Uploads finished thumbnails and hands the strip the settings once they changed and no control is dragged.
+	static void UpdateThumbnails();
+	static void DrawThumbnailStrip();
+	// The input mip a preview renders from: the smallest one that still covers the viewport, 0 for full size.
+	static uint32_t GetPreviewMip(const askygg::Texture2D& texture);
+	// Returns the number of identity pass dispatches the run skipped.
+	static uint64_t ProcessFiles(InputEnumerator& inputs, uint32_t workerCount, TarWriter* outputArchive,
+		OutputWriter* outputWriter, VariantSweep* sweep = nullptr);
+	// ProcessFiles() on the CPU backend: inputs one after another, each spread over the CpuPipeline's threads.
+	static uint64_t ProcessFilesOnCpu(InputEnumerator& inputs, TarWriter* outputArchive, OutputWriter* outputWriter,
+		VariantSweep* sweep);
+#ifdef YGG_JOB_DAEMON
+	static JobServer::JobResult ProcessFileJob(const JobServer::Job& job);
+	// Frame targets are kept across jobs and only recreated when the frame size or format changes.
+	static JobServer::JobResult ProcessFrameJob(const JobServer::Job& job, askygg::Ref<askygg::Texture2D>& input,
+		askygg::Scope<askygg::PixelPackBuffer>& readback);
+#endif
 
-    static void SetBloomPass(BloomType bloomType);
-
-	static void InitializeOutputDisplayPass();
-	static void SubmitOutputDisplayPass(uint32_t displayTextureID);
     static void SavePassOrder();
 
 private:
-	static askygg::Ref<askygg::RenderPass> s_DisplayRenderPass;
+	// The pipeline driven by the main thread's context (single-worker headless runs); in the editor it holds the
+	// settings being edited and renders "Capture Current", while the viewport renders on s_Renderer.
+	static askygg::Ref<ImagePipeline>	   s_Pipeline;
 
 	static std::string s_SettingsFileName;
+	// The parsed settings file, shared with every pipeline; edits are written back in the background.
+	static askygg::Ref<SettingsStore> s_Settings;
 	static std::string s_InputDirectory;
 	static std::string s_OutputDirectory;
 
 	static uint32_t				 s_ActiveTextureIndex;
-	static std::vector<uint32_t> s_TextureSet;
+	// The input directory's images, decoded in the background as they are shown or about to be.
+	static askygg::Scope<ImageLoader> s_Images;
+	// Set for --backend cpu.
+	inline static askygg::Scope<CpuPipelineSpecification> s_CpuBackend;
 
-	static std::unordered_map<ImagePassType, double>				 s_PassExecutionTime;
 	static std::vector<std::pair<ImagePassType, double>>			 s_SortedExecutionTimes;
 	static std::chrono::high_resolution_clock::time_point			 s_LastSortTime;
 
-    static std::unordered_map<ImagePassType, askygg::Ref<ImagePass>> s_AllPasses;
-    static std::vector<ImagePassType> s_OrderedPassTypes;
-    static askygg::Ref<ImagePass> s_ActiveBloomPass;
-    static BloomType s_ActiveBloomPassType;
-
     inline static bool s_DisplayUnprocessedInput = false;
     inline static glm::vec2 s_LastRecordedViewportSize{};
+
+	// GetDisplayStateHash() of the last request, or dirty when the active input changed in the meantime.
+	inline static uint64_t s_DisplayState = 0;
+	inline static bool	   s_DisplayDirty = true;
+	inline static uint64_t s_RenderedFrameCount = 0;
+	inline static uint64_t s_SkippedFrameCount = 0;
+
+	// Renders the viewport's image on its own thread and context; requests carry the settings exported for the
+	// settings hash last seen, which are only exported again once it changes.
+	inline static askygg::Scope<ViewportRenderer> s_Renderer;
+	inline static uint64_t						  s_RequestSettings = 0;
+	inline static YAML::Node					  s_RequestSettingsNode;
+
+	// GPU milliseconds per step a full-size render may use before the render thread looks for a newer request; 0
+	// renders in one go.
+	inline static float							 s_ProgressiveFrameBudget = 8.0f;
+
+	// The running "Capture All", until its outputs are written or it is cancelled.
+	inline static askygg::Scope<BatchCapture>	 s_Capture;
+
+	// Every input processed at thumbnail size in the background, and the settings it was last given.
+	inline static askygg::Scope<ThumbnailStrip>	 s_Thumbnails;
+	inline static uint64_t						 s_ThumbnailSettings = 0;
 };
@@ -0,0 +1,422 @@
+#include "ImageLoader.h"
+
+#include "askygg/core/Log.h"
+
+#include <stbi/stb_image.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+
+#ifdef YGG_HAS_LIBJPEG
+	#include <csetjmp>
+	#include <jpeglib.h>
+#endif
+
+static bool IsJPEGPath(const std::string& path)
+{
+	std::string extension = std::filesystem::path(path).extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+	return extension == ".jpg" || extension == ".jpeg" || extension == ".jpe";
+}
+
+ImageLoader::ImageLoader(std::vector<std::string> paths, const ImageLoaderSpecification& specification)
+	: m_Specification(specification)
+{
+	m_Images.resize(paths.size());
+	for (size_t i = 0; i < paths.size(); i++)
+	{
+		m_Images[i].IsJPEG = IsJPEGPath(paths[i]);
+		m_Images[i].Path = std::move(paths[i]);
+	}
+
+	const uint32_t threadCount = std::max(m_Specification.ThreadCount, 1u);
+	for (uint32_t i = 0; i < threadCount; i++)
+		m_Threads.emplace_back(&ImageLoader::Run, this);
+}
+
+ImageLoader::~ImageLoader()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopped = true;
+	}
+	m_Condition.notify_all();
+	for (auto& thread : m_Threads)
+		thread.join();
+
+	for (auto& image : m_Images)
+	{
+		Release(image.Preview);
+		Release(image.Full);
+	}
+}
+
+bool ImageLoader::Update(uint32_t activeIndex)
+{
+	const uint32_t imageCount = GetImageCount();
+	if (imageCount == 0)
+		return false;
+	activeIndex %= imageCount;
+	m_UpdateCount++;
+
+	std::vector<DecodedImage> decoded;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		decoded.swap(m_Decoded);
+	}
+
+	// Uploading a full resolution and building its mips takes milliseconds; one per call keeps the frames even.
+	std::vector<DecodedImage> deferred;
+	std::vector<uint64_t>	  finished;
+	bool					  uploadedFull = false;
+	for (auto& image : decoded)
+	{
+		if (!image.Source.Preview && image.Pixels)
+		{
+			if (uploadedFull)
+			{
+				deferred.push_back(std::move(image));
+				continue;
+			}
+			uploadedFull = true;
+		}
+		Upload(image);
+		finished.push_back(image.Source.GetKey());
+	}
+
+	// The active image and its neighbours, nearest first.
+	std::vector<uint32_t> wanted = { activeIndex };
+	for (uint32_t distance = 1; distance <= m_Specification.PrefetchCount && distance < imageCount; distance++)
+	{
+		for (uint32_t index : { (activeIndex + distance) % imageCount, (activeIndex + imageCount - distance) % imageCount })
+		{
+			if (std::find(wanted.begin(), wanted.end(), index) == wanted.end())
+				wanted.push_back(index);
+		}
+	}
+	std::vector<bool> isProtected(imageCount, false);
+	for (uint32_t index : wanted)
+	{
+		isProtected[index] = true;
+		m_Images[index].LastUse = m_UpdateCount;
+	}
+	const bool released = Evict(isProtected);
+
+	// Previews of everything wanted come before the full resolutions of the neighbours, which are only prefetched
+	// while there is room for them.
+	std::vector<Request> requests;
+	for (uint32_t index : wanted)
+	{
+		const Image& image = m_Images[index];
+		if (image.IsJPEG && !image.PreviewDone && !image.Full)
+			requests.push_back({ index, true });
+		if (index == activeIndex && !image.Full && !image.FullFailed)
+			requests.push_back({ index, false });
+	}
+	for (uint32_t index : wanted)
+	{
+		const Image& image = m_Images[index];
+		if (index != activeIndex && !image.Full && !image.FullFailed && m_ResidentMemory < m_Specification.MemoryBudget)
+			requests.push_back({ index, false });
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Requests = std::move(requests);
+		for (uint64_t key : finished)
+			m_BusyRequests.erase(key);
+		m_Decoded.insert(m_Decoded.begin(), std::make_move_iterator(deferred.begin()),
+			std::make_move_iterator(deferred.end()));
+	}
+	m_Condition.notify_all();
+	// The deferred uploads need another call even if no decode finishes in the meantime.
+	if (!deferred.empty() && m_Specification.OnDecoded)
+		m_Specification.OnDecoded();
+
+	return released;
+}
+
+askygg::TextureHandle ImageLoader::GetTexture(uint32_t index) const
+{
+	const Image& image = m_Images[index];
+	return image.Full ? image.Full : image.Preview;
+}
+
+askygg::TextureHandle ImageLoader::LoadFullResolution(uint32_t index)
+{
+	Image& image = m_Images[index];
+	image.LastUse = m_UpdateCount;
+	if (image.Full || image.FullFailed)
+		return image.Full;
+
+	DecodedImage decoded = Decode({ index, false });
+	return Upload(decoded);
+}
+
+uint32_t ImageLoader::GetResidentCount() const
+{
+	return (uint32_t)std::count_if(m_Images.begin(), m_Images.end(), [](const Image& image) { return (bool)image.Full; });
+}
+
+double ImageLoader::GetPreviewDecodeTime() const
+{
+	const uint64_t count = m_PreviewDecodeCount;
+	return count ? m_PreviewDecodeNanoseconds * 1e-6 / (double)count : 0.0;
+}
+
+double ImageLoader::GetFullDecodeTime() const
+{
+	const uint64_t count = m_FullDecodeCount;
+	return count ? m_FullDecodeNanoseconds * 1e-6 / (double)count : 0.0;
+}
+
+void ImageLoader::Run()
+{
+	while (true)
+	{
+		Request request;
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			auto						 next = m_Requests.end();
+			m_Condition.wait(lock, [this, &next]
+			{
+				next = std::find_if(m_Requests.begin(), m_Requests.end(), [this](const Request& request)
+				{
+					return m_BusyRequests.count(request.GetKey()) == 0;
+				});
+				return m_Stopped || next != m_Requests.end();
+			});
+			if (m_Stopped)
+				return;
+			request = *next;
+			m_BusyRequests.insert(request.GetKey());
+		}
+
+		DecodedImage decoded = Decode(request);
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Decoded.push_back(std::move(decoded));
+		}
+		if (m_Specification.OnDecoded)
+			m_Specification.OnDecoded();
+	}
+}
+
+#ifdef YGG_HAS_LIBJPEG
+struct JPEGErrorManager
+{
+	jpeg_error_mgr Base;
+	std::jmp_buf   Jump;
+};
+
+// libjpeg's default handler exits the process.
+static void OnJPEGError(j_common_ptr info)
+{
+	std::longjmp(reinterpret_cast<JPEGErrorManager*>(info->err)->Jump, 1);
+}
+
+static void OnJPEGMessage(j_common_ptr)
+{
+}
+
+// libjpeg scales by 1/2, 1/4 and 1/8 in the inverse DCT itself, so the skipped resolution is never decoded at all.
+// Sets the full size either way; the pixels only if scaling down was possible.
+static bool DecodeJPEGPreview(const std::string& path, uint32_t previewSize, uint8_t*& pixels, uint32_t& width,
+	uint32_t& height, uint32_t& fullWidth, uint32_t& fullHeight)
+{
+	std::FILE* file = std::fopen(path.c_str(), "rb");
+	if (!file)
+		return false;
+
+	jpeg_decompress_struct info;
+	JPEGErrorManager	   error;
+	info.err = jpeg_std_error(&error.Base);
+	error.Base.error_exit = OnJPEGError;
+	error.Base.output_message = OnJPEGMessage;
+	if (setjmp(error.Jump))
+	{
+		jpeg_destroy_decompress(&info);
+		std::fclose(file);
+		std::free(pixels);
+		pixels = nullptr;
+		return false;
+	}
+
+	jpeg_create_decompress(&info);
+	jpeg_stdio_src(&info, file);
+	jpeg_read_header(&info, TRUE);
+	fullWidth = info.image_width;
+	fullHeight = info.image_height;
+
+	uint32_t denominator = 1;
+	while (denominator < 8 && std::max(fullWidth, fullHeight) / (denominator * 2) >= previewSize)
+		denominator *= 2;
+	if (denominator == 1)
+	{
+		jpeg_destroy_decompress(&info);
+		std::fclose(file);
+		return false;
+	}
+
+	info.scale_num = 1;
+	info.scale_denom = denominator;
+	info.out_color_space = JCS_RGB;
+	info.dct_method = JDCT_IFAST;
+	info.do_fancy_upsampling = FALSE;
+	jpeg_start_decompress(&info);
+	width = info.output_width;
+	height = info.output_height;
+
+	const size_t rowSize = (size_t)width * 4;
+	pixels = static_cast<uint8_t*>(std::malloc(rowSize * height));
+	if (!pixels)
+		error.Base.error_exit((j_common_ptr)&info);
+	while (info.output_scanline < height)
+	{
+		// Bottom row first, as stb_image loads with vertical flipping; RGB expanded to RGBA in place, back to front.
+		uint8_t* row = pixels + (height - 1 - info.output_scanline) * rowSize;
+		jpeg_read_scanlines(&info, &row, 1);
+		for (uint32_t x = width; x-- > 0;)
+		{
+			const uint8_t r = row[x * 3], g = row[x * 3 + 1], b = row[x * 3 + 2];
+			row[x * 4] = r;
+			row[x * 4 + 1] = g;
+			row[x * 4 + 2] = b;
+			row[x * 4 + 3] = 255;
+		}
+	}
+	jpeg_finish_decompress(&info);
+	jpeg_destroy_decompress(&info);
+	std::fclose(file);
+	return true;
+}
+#endif
+
+ImageLoader::DecodedImage ImageLoader::Decode(const Request& request)
+{
+	const auto	 start = std::chrono::steady_clock::now();
+	const Image& image = m_Images[request.Index];
+	DecodedImage decoded;
+	decoded.Source = request;
+
+	if (request.Preview)
+	{
+#ifdef YGG_HAS_LIBJPEG
+		uint8_t* pixels = nullptr;
+		DecodeJPEGPreview(image.Path, m_Specification.PreviewSize, pixels, decoded.Width, decoded.Height,
+			decoded.FullWidth, decoded.FullHeight);
+		decoded.Pixels.reset(pixels);
+#endif
+	}
+	else
+	{
+		// The same decode as Texture2D's file constructor, so the editor's input matches a headless run's.
+		stbi_set_flip_vertically_on_load_thread(1);
+		int width = 0, height = 0, channels = 0;
+		decoded.Hdr = stbi_is_hdr(image.Path.c_str());
+		void* pixels = decoded.Hdr ? (void*)stbi_loadf(image.Path.c_str(), &width, &height, &channels, 4)
+								   : (void*)stbi_load(image.Path.c_str(), &width, &height, &channels, 4);
+		decoded.Pixels.reset(static_cast<uint8_t*>(pixels));
+		if (pixels)
+		{
+			decoded.Width = decoded.FullWidth = (uint32_t)width;
+			decoded.Height = decoded.FullHeight = (uint32_t)height;
+		}
+	}
+
+	const uint64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - start).count();
+	if (request.Preview && decoded.Pixels)
+	{
+		m_PreviewDecodeCount++;
+		m_PreviewDecodeNanoseconds += nanoseconds;
+	}
+	else if (!request.Preview)
+	{
+		m_FullDecodeCount++;
+		m_FullDecodeNanoseconds += nanoseconds;
+	}
+	return decoded;
+}
+
+askygg::TextureHandle ImageLoader::Upload(DecodedImage& decoded)
+{
+	Image& image = m_Images[decoded.Source.Index];
+	if (decoded.FullWidth > 0)
+		image.Size = { decoded.FullWidth, decoded.FullHeight };
+	if (decoded.Source.Preview)
+		image.PreviewDone = true;
+	else if (!decoded.Pixels)
+	{
+		image.FullFailed = true;
+		YGG_LOG_ERROR("Cannot decode input image '{}'.", image.Path);
+		return {};
+	}
+
+	// Decoded twice when LoadFullResolution() got there first, and previews are pointless next to the full image.
+	if (!decoded.Pixels || image.Full)
+		return image.Full;
+	askygg::TextureHandle& handle = decoded.Source.Preview ? image.Preview : image.Full;
+	if (handle)
+		return handle;
+
+	askygg::Texture2DSpecification specification = m_Specification.TextureSpecification;
+	specification.InternalFormat = decoded.Hdr ? askygg::ImageUtils::ImageInternalFormat::RGBA32F
+											   : askygg::ImageUtils::ImageInternalFormat::RGBA8;
+	specification.PixelLayoutFormat = askygg::ImageUtils::ImageDataLayout::RGBA;
+	specification.DataType = decoded.Hdr ? askygg::ImageUtils::ImageDataType::Float
+										 : askygg::ImageUtils::ImageDataType::UByte;
+	specification.Width = decoded.Width;
+	specification.Height = decoded.Height;
+	// Outputs are named after the input, so the full resolution carries the file name.
+	specification.Name = std::filesystem::path(image.Path).filename().string();
+	if (decoded.Source.Preview)
+		specification.Name += " (Preview)";
+
+	auto texture = askygg::CreateRef<askygg::Texture2D>(specification, decoded.Pixels.get());
+	m_ResidentMemory += texture->GetMemorySize();
+	handle = askygg::TextureRegistry::Register(texture);
+	return handle;
+}
+
+bool ImageLoader::Evict(const std::vector<bool>& isProtected)
+{
+	bool released = false;
+	while (m_ResidentMemory > m_Specification.MemoryBudget)
+	{
+		// Full resolutions go first; a preview is all that is left of an image when it is shown again.
+		Image* victim = nullptr;
+		for (bool preview : { false, true })
+		{
+			for (size_t i = 0; i < m_Images.size(); i++)
+			{
+				Image& image = m_Images[i];
+				if (!isProtected[i] && (preview ? image.Preview : image.Full)
+					&& (!victim || image.LastUse < victim->LastUse))
+					victim = &image;
+			}
+			if (victim)
+			{
+				Release(preview ? victim->Preview : victim->Full);
+				break;
+			}
+		}
+		if (!victim)
+			break;
+		m_EvictionCount++;
+		released = true;
+	}
+	return released;
+}
+
+void ImageLoader::Release(askygg::TextureHandle& handle)
+{
+	if (!handle)
+		return;
+	m_ResidentMemory -= askygg::TextureRegistry::Get(handle).GetMemorySize();
+	askygg::TextureRegistry::Release(handle);
+	handle = askygg::TextureHandle();
+}
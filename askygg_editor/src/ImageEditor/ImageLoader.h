@@ -0,0 +1,139 @@
+#pragma once
+
+#include "askygg/renderer/Texture.h"
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+struct ImageLoaderSpecification
+{
+	// Wrapping and filtering of the uploaded textures; format and size come from each image.
+	askygg::Texture2DSpecification TextureSpecification;
+	uint32_t ThreadCount = 2;
+	// GPU memory of the resident textures, mip chains included.  The least recently shown images are released
+	// beyond it; the active image and its neighbours are not, so they alone may exceed it.
+	uint64_t MemoryBudget = 1ull << 30;
+	// A JPEG shows a preview first, decoded at the smallest of 1/2, 1/4 and 1/8 scale whose longer edge still has
+	// this many pixels.  Images too small to be scaled down load at full resolution only.
+	uint32_t PreviewSize = 1024;
+	// Images on either side of the active one that are decoded ahead of navigation.
+	uint32_t PrefetchCount = 1;
+	// Called on a decoding thread whenever a decode finished, e.g. to wake a main loop that idles.
+	std::function<void()> OnDecoded;
+};
+
+// Loads the editor's input images on demand: decoding happens on background threads, uploading on the thread that
+// calls Update().  The active image is decoded first, then its neighbours, each preview before any full resolution.
+class ImageLoader
+{
+public:
+	ImageLoader(std::vector<std::string> paths, const ImageLoaderSpecification& specification);
+	// Releases every texture; needs the GL context.
+	~ImageLoader();
+
+	ImageLoader(const ImageLoader&) = delete;
+	ImageLoader& operator=(const ImageLoader&) = delete;
+
+	// Uploads finished decodes, queues what activeIndex and its neighbours still lack and releases textures beyond
+	// the budget.  Needs the GL context.  True if a texture was released, whose GL name may be reused from then on.
+	bool Update(uint32_t activeIndex);
+
+	// The full resolution if resident, else the preview, else a null handle.
+	askygg::TextureHandle GetTexture(uint32_t index) const;
+	// Decodes and uploads the full resolution on the calling thread unless it is resident.  Null if the image cannot
+	// be decoded.  Nothing is released here; the next Update() restores the budget.
+	askygg::TextureHandle LoadFullResolution(uint32_t index);
+	bool				  IsFullResolution(uint32_t index) const { return (bool)m_Images[index].Full; }
+	// Full-resolution size, once the preview or the image itself was decoded; zero before.
+	glm::uvec2			  GetImageSize(uint32_t index) const { return m_Images[index].Size; }
+	const std::string&	  GetPath(uint32_t index) const { return m_Images[index].Path; }
+	uint32_t			  GetImageCount() const { return (uint32_t)m_Images.size(); }
+
+	uint64_t GetMemoryBudget() const { return m_Specification.MemoryBudget; }
+	uint64_t GetResidentMemory() const { return m_ResidentMemory; }
+	uint32_t GetResidentCount() const;
+	uint64_t GetEvictionCount() const { return m_EvictionCount; }
+	// Average decode time in milliseconds.
+	double	 GetPreviewDecodeTime() const;
+	double	 GetFullDecodeTime() const;
+
+private:
+	struct Image
+	{
+		std::string			  Path;
+		bool				  IsJPEG = false;
+		askygg::TextureHandle Preview;
+		askygg::TextureHandle Full;
+		glm::uvec2			  Size{ 0 };
+		// Update() count when last shown or protected, for the least recently used order.
+		uint64_t			  LastUse = 0;
+		// Decodes that are not worth retrying.
+		bool				  PreviewDone = false;
+		bool				  FullFailed = false;
+	};
+
+	struct Request
+	{
+		uint32_t Index = 0;
+		bool	 Preview = false;
+
+		uint64_t GetKey() const { return (uint64_t)Index << 1 | (uint64_t)Preview; }
+	};
+
+	// stb_image and the JPEG preview both allocate with malloc.
+	struct PixelDeleter
+	{
+		void operator()(void* pixels) const { std::free(pixels); }
+	};
+
+	struct DecodedImage
+	{
+		Request								   Source;
+		// RGBA, bottom row first; null if decoding failed or, for a preview, was not worth it.
+		std::unique_ptr<uint8_t, PixelDeleter> Pixels;
+		bool								   Hdr = false;
+		uint32_t							   Width = 0, Height = 0;
+		uint32_t							   FullWidth = 0, FullHeight = 0;
+		double								   Milliseconds = 0.0;
+	};
+
+	void		 Run();
+	DecodedImage Decode(const Request& request);
+	// Returns the uploaded texture, or a null handle.
+	askygg::TextureHandle Upload(DecodedImage& decoded);
+	bool				  Evict(const std::vector<bool>& isProtected);
+	void				  Release(askygg::TextureHandle& handle);
+
+private:
+	ImageLoaderSpecification m_Specification;
+	std::vector<Image>		 m_Images;
+	std::vector<std::thread> m_Threads;
+
+	// Shared with the decoding threads.  Requests are in priority order; busy ones are being decoded or wait in
+	// m_Decoded for the next Update().
+	std::mutex					 m_Mutex;
+	std::condition_variable		 m_Condition;
+	std::vector<Request>		 m_Requests;
+	std::unordered_set<uint64_t> m_BusyRequests;
+	std::vector<DecodedImage>	 m_Decoded;
+	bool						 m_Stopped = false;
+
+	uint64_t			  m_UpdateCount = 0;
+	uint64_t			  m_ResidentMemory = 0;
+	uint64_t			  m_EvictionCount = 0;
+	std::atomic<uint64_t> m_PreviewDecodeCount = 0;
+	std::atomic<uint64_t> m_PreviewDecodeNanoseconds = 0;
+	std::atomic<uint64_t> m_FullDecodeCount = 0;
+	std::atomic<uint64_t> m_FullDecodeNanoseconds = 0;
+};
@@ -1,11 +1,13 @@
 #include "ImagePass.h"
-#include "askygg/core/Application.h"
 
-ImagePass::ImagePass(std::string settingsFilePath)
-	: m_SettingsFilePath(std::move(settingsFilePath))
+#include <algorithm>
+
+ImagePass::ImagePass(SettingsStore& settings)
+	: m_SettingsStore(settings) {}
+
+void ImagePass::Save()
 {
-	const auto& Window = askygg::Application::GetWindow();
-	m_OutputSize = { Window.GetWidth(), Window.GetHeight() };
+	m_SettingsStore.Edit([this](YAML::Node& document) { SaveSettings(document); });
 }
 
 void ImagePass::OnResize(const glm::vec2& targetSize)
@@ -13,6 +15,59 @@ void ImagePass::OnResize(const glm::vec2& targetSize)
 	m_OutputSize = targetSize;
 }
 
+askygg::RenderGraphResource ImagePass::Declare(askygg::RenderGraphBuilder& builder, askygg::RenderGraphResource input)
+{
+	askygg::RenderGraphTextureDesc outputDesc = { (uint32_t)m_OutputSize.x, (uint32_t)m_OutputSize.y,
+		askygg::ImageUtils::ImageInternalFormat::RGBA32F };
+
+	m_InputResource = builder.Read(input, m_InputAccess);
+	m_OutputResource = builder.CreateTexture(GetOutputName(), outputDesc);
+	return m_OutputResource;
+}
+
+void ImagePass::Execute(const askygg::RenderGraph& graph)
+{
+	m_Output = graph.GetTexture(m_OutputResource);
+	Submit(graph.GetTextureID(m_InputResource));
+	// The target belongs to the graph's pool and may back a different pass next frame.
+	m_Output = nullptr;
+}
+
+void ImagePass::Dispatch(uint32_t groupsX, uint32_t groupsY)
+{
+	if (!m_DispatchCursor)
+	{
+		m_Shader->UploadUniformInt2("u_DispatchOffset", glm::ivec2(0));
+		m_Shader->DispatchCompute(groupsX, groupsY, 1);
+		return;
+	}
+
+	if (m_DispatchCursor->DispatchCount++ != m_DispatchCursor->Dispatch)
+		return;
+
+	const uint32_t tileGroups = std::max(DispatchTileSize / m_WorkGroupSize, 1u);
+	const uint32_t tilesX = std::max((groupsX + tileGroups - 1) / tileGroups, 1u);
+	const uint32_t tilesY = std::max((groupsY + tileGroups - 1) / tileGroups, 1u);
+	m_DispatchCursor->TileCount = tilesX * tilesY;
+
+	const uint32_t firstX = (m_DispatchCursor->Tile % tilesX) * tileGroups;
+	const uint32_t firstY = (m_DispatchCursor->Tile / tilesX) * tileGroups;
+	if (firstX >= groupsX || firstY >= groupsY)
+		return;
+	m_Shader->UploadUniformInt2("u_DispatchOffset",
+		glm::ivec2(firstX * m_WorkGroupSize, firstY * m_WorkGroupSize));
+	m_Shader->DispatchCompute(std::min(tileGroups, groupsX - firstX), std::min(tileGroups, groupsY - firstY), 1);
+}
+
+uint64_t ImagePass::HashBytes(const void* data, size_t size, uint64_t seed)
+{
+	const auto* bytes = static_cast<const uint8_t*>(data);
+	uint64_t	hash = seed;
+	for (size_t i = 0; i < size; i++)
+		hash = (hash ^ bytes[i]) * 1099511628211ull;
+	return hash;
+}
+
 std::string ImagePass::ImagePassTypeToString(ImagePassType type)
 {
 	switch (type)
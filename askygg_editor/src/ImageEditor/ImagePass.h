@@ -2,7 +2,11 @@
 
 #include "askygg/renderer/Texture.h"
 #include "askygg/renderer/Shader.h"
+#include "askygg/renderer/RenderGraph.h"
 #include "PassHelper.h"
+#include "SettingsStore.h"
+
+#include <type_traits>
 
 enum class ImagePassType
 {
@@ -41,30 +45,109 @@ class SobelPass;
 class VignettePass;
 class OutputComputePass;
 
+// A pass's settings struct as raw bytes, for binary settings snapshots.
+struct SettingsBytes
+{
+	void*  Data = nullptr;
+	size_t Size = 0;
+};
+
+// Where a progressive render stands inside one pass: which of the dispatches its Submit() issues runs next, and which
+// tile of it.  The pass fills in the counts as it goes.
+struct DispatchCursor
+{
+	uint32_t Dispatch = 0;
+	uint32_t Tile = 0;
+	uint32_t DispatchCount = 0;
+	uint32_t TileCount = 0;
+};
+
 class ImagePass
 {
 public:
-	explicit ImagePass(std::string settingsFilePath);
+	// Edge length in pixels of the tiles a progressive render splits each dispatch into.
+	static constexpr uint32_t DispatchTileSize = 256;
+
+	explicit ImagePass(SettingsStore& settings);
 	virtual ~ImagePass() = default;
 
-	virtual uint32_t	GetOutputID() = 0;
+	virtual uint32_t	GetOutputID() { return m_Output ? m_Output->GetID() : 0; }
+	virtual askygg::TextureHandle GetOutputHandle() { return m_Output ? m_Output->GetHandle() : askygg::TextureHandle(); }
 	virtual std::string GetOutputName() = 0;
 	virtual void		Initialize() = 0;
+	// Records the pass's reads and writes and returns the resource holding its result.  By default the output is a
+	// full-size RGBA32F transient owned by the graph.
+	virtual askygg::RenderGraphResource Declare(askygg::RenderGraphBuilder& builder, askygg::RenderGraphResource input);
+	virtual void		Execute(const askygg::RenderGraph& graph);
 	virtual void		Submit(uint32_t textureID) = 0;
 	virtual void		DrawUI() = 0;
-	virtual void		Save() = 0;
-	virtual void		Load() = 0;
+	// Writes the pass's values into the settings store, keeping everything else in it; the file follows shortly.
+	void				Save();
+	// Writes the pass's values into a settings document, laid out the way LoadSettings() reads them.
+	virtual void		SaveSettings(YAML::Node& config) = 0;
+	// Takes the pass's values from an already parsed settings document; missing entries fall back to defaults.  Only
+	// reads it, so pipelines on several threads can load the same document.
+	virtual void		LoadSettings(const YAML::Node& config) = 0;
+	// Changes whenever a setting that affects the output changes.  Part of the key a cached output is reused under.
+	virtual uint64_t	GetSettingsHash() = 0;
+	// Empty for passes without settings.
+	virtual SettingsBytes GetSettingsData() { return {}; }
 	virtual void		OnResize(const glm::vec2& targetSize);
-    virtual bool        IsActive() { return true; }
+    // True when the current settings make the pass write its input unchanged, bit for bit.  Such passes are elided
+    // from the graph and their input is handed straight to the next pass.  A pass that clamps, rounds, resamples or
+    // sets alpha at its neutral settings is not an identity.
+    virtual bool        IsIdentity() { return false; }
+    virtual void        ReleaseTargets() {}
+    virtual uint64_t    GetOwnedMemorySize() { return 0; }
+
+	// Output width over the width the settings were tuned at; below 1 for a downscaled preview.  Passes with
+	// footprints in pixels shrink them by it so a preview looks like the full-size result.
+	void							   SetResolutionScale(float scale) { m_ResolutionScale = scale; }
+	// While set, Submit() issues only the cursor's tile of the cursor's dispatch and skips every other dispatch, so a
+	// render can be spread over several calls.  Null dispatches everything.
+	void							   SetDispatchCursor(DispatchCursor* cursor) { m_DispatchCursor = cursor; }
+
+	const askygg::Ref<askygg::Shader>& GetShader() const { return m_Shader; }
+	void							   SetShader(const askygg::Ref<askygg::Shader>& shader) { m_Shader = shader; }
 
 	static std::string ImagePassTypeToString(ImagePassType type);
+	// FNV-1a over the bytes of a settings struct.  Padding can turn an unchanged struct into a different hash (a
+	// needless recompute), never a changed one into the same hash.
+	template <typename T>
+	static uint64_t HashSettings(const T& settings)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Settings are hashed by their bytes.");
+		return HashBytes(&settings, sizeof(T));
+	}
+	static uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 14695981039346656037ull);
+	template <typename T>
+	static SettingsBytes GetSettingsBytes(T& settings)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Settings are snapshotted by their bytes.");
+		return { &settings, sizeof(T) };
+	}
     static ImagePassType ImagePassTypeFromBloomType(BloomType bloomType);
     static ImagePassType ImagePassTypeFromString(const std::string& inString);
     static std::vector<ImagePassType> GetAllBasicImagePassTypes();
 
+protected:
+	// Dispatches the bound program over groupsX x groupsY work groups, or the part of it the dispatch cursor selects.
+	// Shaders offset gl_GlobalInvocationID by u_DispatchOffset.
+	void Dispatch(uint32_t groupsX, uint32_t groupsY);
+	// True when this Submit() continues a dispatch an earlier call started; per-render values must not change then.
+	bool IsResumingDispatch() const { return m_DispatchCursor && (m_DispatchCursor->Dispatch > 0 || m_DispatchCursor->Tile > 0); }
+
 protected:
 	uint32_t					m_WorkGroupSize = 4;
 	askygg::Ref<askygg::Shader> m_Shader;
-	std::string					m_SettingsFilePath;
-	glm::vec2					m_OutputSize{};
+	SettingsStore&				m_SettingsStore;
+	// Set by OnResize before the pass is first declared; passes never look at the window.
+	glm::vec2					m_OutputSize{ 1.0f, 1.0f };
+	float						m_ResolutionScale = 1.0f;
+	DispatchCursor*				m_DispatchCursor = nullptr;
+
+	askygg::RenderGraphAccess	   m_InputAccess = askygg::RenderGraphAccess::Sampled;
+	askygg::RenderGraphResource	   m_InputResource = askygg::InvalidRenderGraphResource;
+	askygg::RenderGraphResource	   m_OutputResource = askygg::InvalidRenderGraphResource;
+	askygg::Ref<askygg::Texture2D> m_Output;
 };
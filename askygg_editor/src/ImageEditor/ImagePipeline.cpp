@@ -0,0 +1,736 @@
+#include "ImagePipeline.h"
+
+#include "Passes/MultiPassBloomPass.h"
+#include "Passes/BarrelDistortionPass.h"
+#include "Passes/ChromaticAberrationPass.h"
+#include "Passes/SobelPass.h"
+#include "Passes/ContrastBrightnessPass.h"
+#include "Passes/RadialBlurPass.h"
+#include "Passes/SharpenPass.h"
+#include "Passes/HSVAdjustmentPass.h"
+#include "Passes/VignettePass.h"
+#include "Passes/LinearizePass.h"
+#include "Passes/RadialBloomPass.h"
+#include "Passes/OutputComputePass.h"
+
+#include "askygg/platform/renderer_platform/opengl/OpenGLTimer.h"
+#include "askygg/renderer/Shader.h"
+
+#include "yaml-cpp/yaml.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+static std::vector<std::string> GetDefaultPassOrderToString()
+{
+    std::vector<ImagePassType> defaultPassOrder =
+    {
+            ImagePassType::ContrastBrightness,
+            ImagePassType::HueShift,
+            ImagePassType::Sobel,
+            ImagePassType::RadialBlur,
+            ImagePassType::ChromaticAberration,
+            ImagePassType::BarrelDistortion,
+            ImagePassType::Vignette,
+            ImagePassType::Sharpen,
+    };
+    // Load active passes
+    std::vector<std::string> defaultPassOrderStrings;
+    for(auto & i : defaultPassOrder)
+        defaultPassOrderStrings.push_back(ImagePass::ImagePassTypeToString(i));
+
+    return defaultPassOrderStrings;
+}
+
+static float Execute(const std::function<void()>& operation, bool profile)
+{
+    if (profile)
+    {
+        askygg::OpenGLFuncTimer timer;
+        return timer.ProfileFn(operation);
+    }
+
+    operation();
+    return -1.0f;
+}
+
+void ImagePipeline::LoadShaders()
+{
+    askygg::ShaderLibrary::Load("assets/shaders/post_fx/Linearize.glsl");
+    askygg::ShaderLibrary::Load("assets/shaders/post_fx/MultiPassBloom.glsl");
+    askygg::ShaderLibrary::Load("assets/shaders/post_fx/RadialBloom.glsl");
+    askygg::ShaderLibrary::Load("assets/shaders/post_fx/Sobel.glsl");
+    askygg::ShaderLibrary::Load("assets/shaders/post_fx/RadialBlur.glsl");
+    askygg::ShaderLibrary::Load("assets/shaders/post_fx/ContrastAdjust.glsl");
+    askygg::ShaderLibrary::Load("assets/shaders/post_fx/ChromaticAberration.glsl");
+    askygg::ShaderLibrary::Load("assets/shaders/post_fx/BarrelDistortion.glsl");
+    askygg::ShaderLibrary::Load("assets/shaders/post_fx/Vignette.glsl");
+    askygg::ShaderLibrary::Load("assets/shaders/post_fx/Sharpen.glsl");
+    askygg::ShaderLibrary::Load("assets/shaders/post_fx/HSVAdjust.glsl");
+    askygg::ShaderLibrary::Load("assets/shaders/post_fx/OutputPass.glsl");
+}
+
+ImagePipeline::ImagePipeline(std::string settingsFileName)
+    : m_SettingsFileName(std::move(settingsFileName)), m_SettingsStore(SettingsStore::Open(m_SettingsFileName)) {}
+
+ImagePipeline::~ImagePipeline()
+{
+    Shutdown();
+}
+
+void ImagePipeline::Initialize(bool privateShaderPrograms)
+{
+    CreatePasses();
+    for(auto [passType, pass] : m_AllPasses)
+    {
+        pass->Initialize();
+
+        if (privateShaderPrograms)
+        {
+            // Programs compiled by the library are shared across contexts; only their uniform state must not be.
+            auto& shader = m_PrivateShaders[pass->GetShader()->GetName()];
+            if (!shader)
+                shader = pass->GetShader()->Clone();
+            pass->SetShader(shader);
+        }
+    }
+    LoadInitialSettings();
+}
+
+void ImagePipeline::InitializeForCpu()
+{
+    // Pass constructors only read settings; shaders and targets are left to Initialize().
+    CreatePasses();
+    LoadInitialSettings();
+}
+
+void ImagePipeline::CreatePasses()
+{
+    m_AllPasses[ImagePassType::Linearize] = askygg::CreateRef<LinearizePass>(*m_SettingsStore);
+    m_AllPasses[ImagePassType::BarrelDistortion] = askygg::CreateRef<BarrelDistortionPass>(*m_SettingsStore);
+    m_AllPasses[ImagePassType::RadialBloom] = askygg::CreateRef<RadialBloomPass>(*m_SettingsStore);
+    m_AllPasses[ImagePassType::MultiPassBloom] = askygg::CreateRef<MultiPassBloomPass>(*m_SettingsStore);
+    m_AllPasses[ImagePassType::ChromaticAberration] = askygg::CreateRef<ChromaticAberrationPass>(*m_SettingsStore);
+    m_AllPasses[ImagePassType::ContrastBrightness] = askygg::CreateRef<ContrastBrightnessPass>(*m_SettingsStore);
+    m_AllPasses[ImagePassType::HueShift] = askygg::CreateRef<HSVAdjustmentPass>(*m_SettingsStore);
+    m_AllPasses[ImagePassType::RadialBlur] = askygg::CreateRef<RadialBlurPass>(*m_SettingsStore);
+    m_AllPasses[ImagePassType::Sharpen] = askygg::CreateRef<SharpenPass>(*m_SettingsStore);
+    m_AllPasses[ImagePassType::Sobel] = askygg::CreateRef<SobelPass>(*m_SettingsStore);
+    m_AllPasses[ImagePassType::Vignette] = askygg::CreateRef<VignettePass>(*m_SettingsStore);
+    m_AllPasses[ImagePassType::OutputCompute] = askygg::CreateRef<OutputComputePass>(*m_SettingsStore);
+}
+
+void ImagePipeline::LoadInitialSettings()
+{
+    if (!s_SettingsSnapshotFileName.empty() && LoadSettingsSnapshot(s_SettingsSnapshotFileName))
+        return;
+
+    // The store parses the file once for every pipeline in the process.
+    ApplySettings(m_SettingsStore->GetDocument());
+    if (!s_SettingsSnapshotFileName.empty())
+        SaveSettingsSnapshot(s_SettingsSnapshotFileName);
+}
+
+namespace
+{
+    constexpr char     SnapshotMagic[4] = { 'Y', 'G', 'G', 'S' };
+    // Bump whenever a settings struct changes layout.
+    constexpr uint32_t SnapshotVersion = 1;
+
+    struct SnapshotHeader
+    {
+        char     Magic[4];
+        uint32_t Version;
+        uint64_t SourceHash;
+        int32_t  BloomType;
+        uint32_t PassOrderCount;
+        uint32_t PassCount;
+    };
+
+    struct SnapshotPassHeader
+    {
+        uint32_t Type;
+        uint32_t Size;
+    };
+
+    template <typename T>
+    void AppendBytes(std::string& buffer, const T& value)
+    {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    bool ReadBytes(const std::string& buffer, size_t& offset, void* data, size_t size)
+    {
+        if (buffer.size() - offset < size)
+            return false;
+        std::memcpy(data, buffer.data() + offset, size);
+        offset += size;
+        return true;
+    }
+
+    bool ReadFile(const std::string& fileName, std::string& contents)
+    {
+        std::ifstream in(fileName, std::ios::binary);
+        if (!in)
+            return false;
+        std::ostringstream stream;
+        stream << in.rdbuf();
+        contents = stream.str();
+        return !in.bad();
+    }
+}
+
+uint64_t ImagePipeline::GetSettingsSourceHash() const
+{
+    std::string text;
+    if (!ReadFile(m_SettingsFileName, text))
+        return 0;
+    return ImagePass::HashBytes(text.data(), text.size());
+}
+
+bool ImagePipeline::SaveSettingsSnapshot(const std::string& fileName) const
+{
+    SnapshotHeader header = {};
+    std::memcpy(header.Magic, SnapshotMagic, sizeof(SnapshotMagic));
+    header.Version = SnapshotVersion;
+    header.SourceHash = GetSettingsSourceHash();
+    header.BloomType = static_cast<int32_t>(m_ActiveBloomPassType);
+    // Linearize and OutputCompute are implied, as in the settings file.
+    header.PassOrderCount = (uint32_t)(m_OrderedPassTypes.size() - 2);
+
+    std::string body;
+    for (size_t i = 1; i + 1 < m_OrderedPassTypes.size(); i++)
+        AppendBytes(body, static_cast<uint32_t>(m_OrderedPassTypes[i]));
+    for (const auto& [passType, pass] : m_AllPasses)
+    {
+        const SettingsBytes settings = pass->GetSettingsData();
+        if (settings.Size == 0)
+            continue;
+        AppendBytes(body, SnapshotPassHeader{ static_cast<uint32_t>(passType), (uint32_t)settings.Size });
+        body.append(static_cast<const char*>(settings.Data), settings.Size);
+        header.PassCount++;
+    }
+
+    // Worker pipelines initialize concurrently; one of them writing is enough.
+    static std::mutex s_WriteMutex;
+    std::lock_guard<std::mutex> lock(s_WriteMutex);
+    const std::string temporaryFileName = fileName + ".tmp";
+    bool written = false;
+    {
+        std::ofstream out(temporaryFileName, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(body.data(), (std::streamsize)body.size());
+        out.close();
+        written = !out.fail();
+    }
+    std::error_code error;
+    if (written)
+        std::filesystem::rename(temporaryFileName, fileName, error);
+    if (!written || error)
+    {
+        YGG_LOG_WARN("Could not write the settings snapshot '{}'.", fileName);
+        std::filesystem::remove(temporaryFileName, error);
+        return false;
+    }
+    return true;
+}
+
+bool ImagePipeline::LoadSettingsSnapshot(const std::string& fileName)
+{
+    std::string buffer;
+    if (!ReadFile(fileName, buffer))
+        return false;
+
+    size_t         offset = 0;
+    SnapshotHeader header;
+    if (!ReadBytes(buffer, offset, &header, sizeof(header))
+        || std::memcmp(header.Magic, SnapshotMagic, sizeof(SnapshotMagic)) != 0 || header.Version != SnapshotVersion
+        || header.BloomType < (int32_t)BloomType::None || header.BloomType > (int32_t)BloomType::MultiPass)
+    {
+        YGG_LOG_WARN("Ignoring the settings snapshot '{}': not a snapshot this build can read.", fileName);
+        return false;
+    }
+    if (header.SourceHash != GetSettingsSourceHash())
+    {
+        YGG_LOG_INFO("Ignoring the settings snapshot '{}': '{}' changed since it was taken.", fileName, m_SettingsFileName);
+        return false;
+    }
+
+    // Nothing is applied until the whole snapshot checked out.
+    const auto                 basicTypes = ImagePass::GetAllBasicImagePassTypes();
+    std::vector<ImagePassType> passOrder;
+    for (uint32_t i = 0; i < header.PassOrderCount; i++)
+    {
+        uint32_t type;
+        if (!ReadBytes(buffer, offset, &type, sizeof(type))
+            || std::find(basicTypes.begin(), basicTypes.end(), static_cast<ImagePassType>(type)) == basicTypes.end())
+            return false;
+        passOrder.push_back(static_cast<ImagePassType>(type));
+    }
+
+    std::vector<std::pair<SettingsBytes, size_t>> passSettings;
+    for (uint32_t i = 0; i < header.PassCount; i++)
+    {
+        SnapshotPassHeader passHeader;
+        if (!ReadBytes(buffer, offset, &passHeader, sizeof(passHeader)))
+            return false;
+        auto pass = m_AllPasses.find(static_cast<ImagePassType>(passHeader.Type));
+        if (pass == m_AllPasses.end())
+            return false;
+        const SettingsBytes settings = pass->second->GetSettingsData();
+        if (settings.Size != passHeader.Size || buffer.size() - offset < settings.Size)
+            return false;
+        passSettings.emplace_back(settings, offset);
+        offset += settings.Size;
+    }
+    const size_t passesWithSettings = std::count_if(m_AllPasses.begin(), m_AllPasses.end(),
+        [](const auto& entry) { return entry.second->GetSettingsData().Size > 0; });
+    if (offset != buffer.size() || passSettings.size() != passesWithSettings)
+    {
+        YGG_LOG_WARN("Ignoring the settings snapshot '{}': it does not match this build's passes.", fileName);
+        return false;
+    }
+
+    for (const auto& [settings, settingsOffset] : passSettings)
+        std::memcpy(settings.Data, buffer.data() + settingsOffset, settings.Size);
+    SetBloomPass(static_cast<BloomType>(header.BloomType));
+    m_OrderedPassTypes.clear();
+    m_OrderedPassTypes.push_back(ImagePassType::Linearize);
+    m_OrderedPassTypes.insert(m_OrderedPassTypes.end(), passOrder.begin(), passOrder.end());
+    m_OrderedPassTypes.push_back(ImagePassType::OutputCompute);
+    return true;
+}
+
+void ImagePipeline::ApplySettings(const YAML::Node& config)
+{
+    for(auto [passType, pass] : m_AllPasses)
+        pass->LoadSettings(config);
+
+    std::vector<std::string> configPassOrder = config["PassOrder"] ? config["PassOrder"].as<std::vector<std::string>>() : GetDefaultPassOrderToString();
+    int bloomTypeInt = config["Bloom Pass Type"] ? config["Bloom Pass Type"].as<int>() : 1;
+    SetBloomPass(static_cast<BloomType>(bloomTypeInt));
+
+    m_OrderedPassTypes.clear();
+    m_OrderedPassTypes.push_back(ImagePassType::Linearize);
+    for(const auto& passString : configPassOrder)
+        m_OrderedPassTypes.push_back(ImagePass::ImagePassTypeFromString(passString));
+    m_OrderedPassTypes.push_back(ImagePassType::OutputCompute);
+}
+
+YAML::Node ImagePipeline::ExportSettings()
+{
+    YAML::Node config;
+    for (auto& [passType, pass] : m_AllPasses)
+        pass->SaveSettings(config);
+
+    // Linearize and OutputCompute are implied, as in the settings file.
+    std::vector<std::string> passOrder;
+    for (size_t i = 1; i + 1 < m_OrderedPassTypes.size(); i++)
+        passOrder.push_back(ImagePass::ImagePassTypeToString(m_OrderedPassTypes[i]));
+    config["PassOrder"] = passOrder;
+    config["Bloom Pass Type"] = static_cast<int>(m_ActiveBloomPassType);
+    return config;
+}
+
+bool ImagePipeline::ValidateSettings(const YAML::Node& config, std::string& error)
+{
+    if (!config.IsMap())
+    {
+        error = "settings must be a map";
+        return false;
+    }
+
+    if (config["PassOrder"])
+    {
+        if (!config["PassOrder"].IsSequence())
+        {
+            error = "PassOrder must be a list of pass names";
+            return false;
+        }
+
+        const auto basicTypes = ImagePass::GetAllBasicImagePassTypes();
+        for (size_t i = 0; i < config["PassOrder"].size(); i++)
+        {
+            const std::string name = config["PassOrder"][i].as<std::string>();
+            bool known = std::any_of(basicTypes.begin(), basicTypes.end(),
+                                     [&name](ImagePassType type) { return ImagePass::ImagePassTypeToString(type) == name; });
+            if (!known)
+            {
+                error = "unknown pass '" + name + "' in PassOrder";
+                return false;
+            }
+        }
+    }
+
+    if (config["Bloom Pass Type"])
+    {
+        int bloomTypeInt = config["Bloom Pass Type"].as<int>();
+        if (bloomTypeInt < (int)BloomType::None || bloomTypeInt > (int)BloomType::MultiPass)
+        {
+            error = "Bloom Pass Type must be 0, 1 or 2";
+            return false;
+        }
+    }
+    return true;
+}
+
+YAML::Node ImagePipeline::MergeSettings(const YAML::Node& base, const YAML::Node& overrides)
+{
+    YAML::Node merged = YAML::Clone(base);
+    for (auto it = overrides.begin(); it != overrides.end(); ++it)
+    {
+        const std::string key = it->first.as<std::string>();
+        // Sections merge key by key; anything else (values, PassOrder) is replaced wholesale.
+        if (it->second.IsMap() && merged[key].IsMap())
+            merged[key] = MergeSettings(merged[key], it->second);
+        else
+            merged[key] = YAML::Clone(it->second);
+    }
+    return merged;
+}
+
+void ImagePipeline::Shutdown()
+{
+    InvalidatePassCache();
+    m_RenderGraph.ReleaseTransientTextures();
+    for (auto& [passType, pass] : m_AllPasses)
+        pass->ReleaseTargets();
+    m_ActiveBloomPass = nullptr;
+    m_AllPasses.clear();
+    m_PrivateShaders.clear();
+}
+
+void ImagePipeline::SetResolutionScale(float scale)
+{
+    m_ResolutionScale = scale;
+    for (auto& [passType, pass] : m_AllPasses)
+        pass->SetResolutionScale(scale);
+}
+
+void ImagePipeline::SetPassCaching(bool enabled)
+{
+    if (!enabled)
+        InvalidatePassCache();
+    m_PassCaching = enabled;
+    m_PassCacheHits = 0;
+    m_PassCacheMisses = 0;
+}
+
+void ImagePipeline::InvalidatePassCache()
+{
+    for (auto& [passType, cached] : m_PassCache)
+        askygg::TextureRegistry::Release(cached.Texture->GetHandle());
+    m_PassCache.clear();
+    m_CachedPasses.clear();
+}
+
+void ImagePipeline::SetBloomPass(BloomType bloomType)
+{
+    // Don't keep the previous bloom pass's targets alive while it is unused.
+    if (m_ActiveBloomPass != nullptr && m_ActiveBloomPassType != bloomType)
+        m_ActiveBloomPass->ReleaseTargets();
+
+    switch(bloomType)
+    {
+        case BloomType::Radial:     m_ActiveBloomPass = m_AllPasses[ImagePassType::RadialBloom]; break;
+        case BloomType::MultiPass:  m_ActiveBloomPass = m_AllPasses[ImagePassType::MultiPassBloom]; break;
+        default: m_ActiveBloomPass = nullptr; break;
+    }
+
+    // Notify the output shader of the change.
+    auto outputPass = std::dynamic_pointer_cast<OutputComputePass>(m_AllPasses[ImagePassType::OutputCompute]);
+    outputPass->SetBloomType(bloomType);
+
+    m_ActiveBloomPassType = bloomType;
+}
+
+void ImagePipeline::SetOutputFormat(askygg::ImageUtils::ImageInternalFormat format)
+{
+    std::dynamic_pointer_cast<OutputComputePass>(m_AllPasses[ImagePassType::OutputCompute])->SetOutputFormat(format);
+}
+
+const askygg::Ref<askygg::Texture2D>& ImagePipeline::GetOutputTexture() const
+{
+    return std::dynamic_pointer_cast<OutputComputePass>(m_AllPasses.at(ImagePassType::OutputCompute))->GetOutputTexture();
+}
+
+void ImagePipeline::Submit(const glm::vec2& targetSize, uint32_t targetTextureID, askygg::RenderGraphAccess outputAccess,
+    bool profile)
+{
+    DeclareGraph(targetSize, targetTextureID, outputAccess, profile);
+    m_RenderGraph.Execute();
+    UpdatePeakMemory();
+}
+
+void ImagePipeline::BeginProgressive(const glm::vec2& targetSize, uint32_t targetTextureID,
+    askygg::RenderGraphAccess outputAccess)
+{
+    // Steps are timed as a whole in ContinueProgressive(), so the passes do not time themselves.
+    DeclareGraph(targetSize, targetTextureID, outputAccess, false);
+    m_Progressive = ProgressiveRender();
+    m_Progressive.Active = true;
+}
+
+bool ImagePipeline::ContinueProgressive(double budgetMilliseconds)
+{
+    if (!m_Progressive.Active)
+        return false;
+    m_Progressive.CallCount++;
+
+    DispatchCursor& cursor = m_Progressive.Cursor;
+    for (auto& [passType, pass] : m_AllPasses)
+        pass->SetDispatchCursor(&cursor);
+
+    // Each step is waited for, so the GPU never has more than the budget queued when this returns.  A step is not
+    // started if one like the last would overrun the budget, but every call makes progress.
+    askygg::OpenGLFuncTimer timer;
+    double                  spent = 0.0;
+    while (m_Progressive.PassIndex < m_RenderGraph.GetPassCount()
+           && (spent == 0.0 || spent + m_Progressive.LastStepTime <= budgetMilliseconds))
+    {
+        const uint32_t passIndex = m_Progressive.PassIndex;
+        const bool     firstStep = cursor.Dispatch == 0 && cursor.Tile == 0;
+        cursor.DispatchCount = 0;
+        cursor.TileCount = 0;
+        const double time = timer.ProfileFn([this, passIndex] { m_RenderGraph.ExecutePass(passIndex); });
+        spent += time;
+        m_Progressive.LastStepTime = time;
+
+        if (passIndex < m_GraphPassTypes.size() && m_GraphPassTypes[passIndex] != ImagePassType::Invalid)
+        {
+            double& passTime = m_PassExecutionTime[m_GraphPassTypes[passIndex]];
+            passTime = (firstStep ? 0.0 : passTime) + time;
+        }
+
+        // Graph passes that are not image passes (cache copies) never touch the cursor and are done after one step.
+        if (++cursor.Tile >= cursor.TileCount)
+        {
+            cursor.Tile = 0;
+            if (++cursor.Dispatch >= cursor.DispatchCount)
+            {
+                cursor.Dispatch = 0;
+                m_Progressive.PassIndex++;
+            }
+        }
+    }
+
+    for (auto& [passType, pass] : m_AllPasses)
+        pass->SetDispatchCursor(nullptr);
+    m_Progressive.Time += spent;
+
+    if (m_Progressive.PassIndex < m_RenderGraph.GetPassCount())
+        return false;
+    m_RenderGraph.FinishExecution();
+    m_Progressive.Active = false;
+    UpdatePeakMemory();
+    return true;
+}
+
+void ImagePipeline::CancelProgressive()
+{
+    m_Progressive.Active = false;
+}
+
+float ImagePipeline::GetProgressiveProgress() const
+{
+    const uint32_t passCount = m_RenderGraph.GetPassCount();
+    if (!m_Progressive.Active || passCount == 0)
+        return 1.0f;
+
+    const DispatchCursor& cursor = m_Progressive.Cursor;
+    float				  passProgress = 0.0f;
+    if (cursor.DispatchCount > 0)
+        passProgress = ((float)cursor.Dispatch + (cursor.TileCount > 0 ? (float)cursor.Tile / (float)cursor.TileCount : 0.0f))
+                       / (float)cursor.DispatchCount;
+    return ((float)m_Progressive.PassIndex + passProgress) / (float)passCount;
+}
+
+void ImagePipeline::DeclareGraph(const glm::vec2& targetSize, uint32_t targetTextureID,
+    askygg::RenderGraphAccess outputAccess, bool profile)
+{
+    // Resetting the graph throws away whatever a progressive render had not finished yet.
+    CancelProgressive();
+
+    // Only passes that take part in this submit are declared, so inactive passes never own GPU memory.
+    m_RenderGraph.Reset();
+    m_GraphPassTypes.clear();
+    m_ElidedPasses.clear();
+    m_CachedPasses.clear();
+    auto declarePass = [this, &targetSize, profile](ImagePassType passType, askygg::RenderGraphResource input,
+                                                    uint64_t& key)
+    {
+        // A pass that would copy its input is skipped and its input is wired to the next pass instead.  The key stays
+        // as it is: the image has not changed.
+        if (m_PassElision && m_AllPasses[passType]->IsIdentity())
+        {
+            m_ElidedPasses.insert(passType);
+            m_PassExecutionTime.erase(passType);
+            return input;
+        }
+        return DeclareCachedPass(passType, input, key, targetSize, profile);
+    };
+
+    // Identifies the image flowing between passes: the input, then every pass it went through and its settings.
+    uint32_t scaleBits;
+    std::memcpy(&scaleBits, &m_ResolutionScale, sizeof(scaleBits));
+    const uint32_t inputKey[4] = { targetTextureID, (uint32_t)targetSize.x, (uint32_t)targetSize.y, scaleBits };
+    uint64_t key = ImagePass::HashBytes(inputKey, sizeof(inputKey));
+
+    askygg::RenderGraphResource input = m_RenderGraph.ImportTexture("Pipeline Input", targetTextureID);
+    askygg::RenderGraphResource current = declarePass(ImagePassType::Linearize, input, key);
+
+    askygg::RenderGraphResource bloomOutput = askygg::InvalidRenderGraphResource;
+    if(m_ActiveBloomPassType != BloomType::None)
+    {
+        uint64_t bloomKey = key;
+        bloomOutput = declarePass(ImagePass::ImagePassTypeFromBloomType(m_ActiveBloomPassType), current, bloomKey);
+    }
+    std::dynamic_pointer_cast<OutputComputePass>(m_AllPasses[ImagePassType::OutputCompute])->SetBloomInput(bloomOutput);
+
+    for(size_t i = 1; i < m_OrderedPassTypes.size(); i++)
+        current = declarePass(m_OrderedPassTypes[i], current, key);
+
+    m_RenderGraph.MarkOutput(current, outputAccess);
+    m_RenderGraph.Compile();
+    m_ElidedDispatchCount += m_ElidedPasses.size();
+    m_GraphTargetSize = targetSize;
+}
+
+void ImagePipeline::UpdatePeakMemory()
+{
+    uint64_t pipelineMemory = GetMemorySize();
+    if (pipelineMemory > m_PeakMemory)
+    {
+        m_PeakMemory = pipelineMemory;
+        YGG_LOG_INFO("Image pipeline peak GPU memory: {:.1f} MB ({} pooled targets at {}x{})",
+                     (double)pipelineMemory / (1024.0 * 1024.0), m_RenderGraph.GetTransientTextureCount(),
+                     m_GraphTargetSize.x, m_GraphTargetSize.y);
+    }
+}
+
+void ImagePipeline::SubmitPass(ImagePassType passType, const glm::vec2& targetSize, uint32_t inputTextureID, bool profile)
+{
+    CancelProgressive();
+    m_RenderGraph.Reset();
+    m_GraphPassTypes.clear();
+    m_ElidedPasses.clear();
+    if (passType == ImagePassType::OutputCompute)
+        std::dynamic_pointer_cast<OutputComputePass>(m_AllPasses[ImagePassType::OutputCompute])->SetBloomInput(askygg::InvalidRenderGraphResource);
+
+    askygg::RenderGraphResource input = m_RenderGraph.ImportTexture("Pass Input", inputTextureID);
+    m_RenderGraph.MarkOutput(DeclarePass(passType, input, targetSize, profile), askygg::RenderGraphAccess::Sampled);
+    m_RenderGraph.Compile();
+    m_RenderGraph.Execute();
+}
+
+askygg::RenderGraphResource ImagePipeline::DeclarePass(ImagePassType passType, askygg::RenderGraphResource input,
+    const glm::vec2& targetSize, bool profile)
+{
+    auto pass = m_AllPasses[passType];
+    pass->OnResize(targetSize);
+    m_GraphPassTypes.resize(m_RenderGraph.GetPassCount(), ImagePassType::Invalid);
+    m_GraphPassTypes.push_back(passType);
+    auto builder = m_RenderGraph.AddPass(ImagePass::ImagePassTypeToString(passType),
+            [this, pass, passType, profile](const askygg::RenderGraph &graph)
+            {
+                m_PassExecutionTime[passType] = Execute([&pass, &graph] { pass->Execute(graph); }, profile);
+            });
+    return pass->Declare(builder, input);
+}
+
+std::vector<uint64_t> ImagePipeline::GetPassSettingsKey() const
+{
+    std::vector<ImagePassType> passTypes = { ImagePassType::Linearize };
+    if (m_ActiveBloomPassType != BloomType::None)
+        passTypes.push_back(ImagePass::ImagePassTypeFromBloomType(m_ActiveBloomPassType));
+    passTypes.insert(passTypes.end(), m_OrderedPassTypes.begin() + 1, m_OrderedPassTypes.end());
+
+    std::vector<uint64_t> key;
+    for (ImagePassType passType : passTypes)
+    {
+        const uint64_t passKey[2] = { (uint64_t)passType, m_AllPasses.at(passType)->GetSettingsHash() };
+        key.push_back(ImagePass::HashBytes(passKey, sizeof(passKey)));
+    }
+    return key;
+}
+
+askygg::RenderGraphResource ImagePipeline::DeclareCachedPass(ImagePassType passType, askygg::RenderGraphResource input,
+    uint64_t& key, const glm::vec2& targetSize, bool profile)
+{
+    if (!m_PassCaching || passType == ImagePassType::OutputCompute)
+        return DeclarePass(passType, input, targetSize, profile);
+
+    const uint64_t passKey[2] = { (uint64_t)passType, m_AllPasses[passType]->GetSettingsHash() };
+    key = ImagePass::HashBytes(passKey, sizeof(passKey), key);
+
+    const std::string name = ImagePass::ImagePassTypeToString(passType);
+    auto cached = m_PassCache.find(passType);
+    if (cached != m_PassCache.end() && cached->second.Key == key)
+    {
+        m_CachedPasses.insert(passType);
+        m_PassExecutionTime.erase(passType);
+        m_PassCacheHits++;
+        return m_RenderGraph.ImportTexture(name + " (Cached)", cached->second.Texture);
+    }
+
+    // The output may be a pooled transient that another pass reuses later in the graph, so it is copied out right
+    // after the pass ran.
+    m_PassCacheMisses++;
+    askygg::RenderGraphResource output = DeclarePass(passType, input, targetSize, profile);
+    auto builder = m_RenderGraph.AddPass(name + " Cache Copy",
+            [this, passType, output, key](const askygg::RenderGraph& graph)
+            {
+                const askygg::Ref<askygg::Texture2D>& source = graph.GetTexture(output);
+                const askygg::Texture2DSpecification& sourceSpec = source->GetSpecification();
+                CachedPassOutput& cached = m_PassCache[passType];
+                if (!cached.Texture || cached.Texture->GetWidth() != sourceSpec.Width
+                    || cached.Texture->GetHeight() != sourceSpec.Height
+                    || cached.Texture->GetSpecification().InternalFormat != sourceSpec.InternalFormat
+                    || cached.Texture->GetMipLevelCount() != source->GetMipLevelCount())
+                {
+                    if (cached.Texture)
+                        askygg::TextureRegistry::Release(cached.Texture->GetHandle());
+                    askygg::Texture2DSpecification spec = sourceSpec;
+                    spec.Name = ImagePass::ImagePassTypeToString(passType) + " Cached Output";
+                    cached.Texture = askygg::CreateRef<askygg::Texture2D>(spec);
+                    askygg::TextureRegistry::Register(cached.Texture);
+                }
+                cached.Texture->CopyFrom(source->GetID());
+                cached.Key = key;
+            });
+    builder.Read(output, askygg::RenderGraphAccess::Readback);
+    return output;
+}
+
+void ImagePipeline::Save(const askygg::Texture2D& texture, const std::string& outputDirectory, bool profile)
+{
+    glm::vec2 textureSize{texture.GetWidth(), texture.GetHeight()};
+    Submit(textureSize, texture.GetID(), askygg::RenderGraphAccess::Readback, profile);
+
+    std::filesystem::path path(texture.GetName());
+    // Removes the previous extension - keeps just the name.
+    std::string name = path.stem().string();
+
+    std::string filePath = outputDirectory + name + ".jpeg";
+    GetOutputTexture()->Save(filePath, true);
+}
+
+bool ImagePipeline::Encode(const askygg::Texture2D& texture, std::vector<uint8_t>& encoded, bool profile)
+{
+    glm::vec2 textureSize{texture.GetWidth(), texture.GetHeight()};
+    Submit(textureSize, texture.GetID(), askygg::RenderGraphAccess::Readback, profile);
+    return GetOutputTexture()->EncodeJPEG(encoded, true);
+}
+
+uint64_t ImagePipeline::GetMemorySize() const
+{
+    uint64_t size = m_RenderGraph.GetTransientMemorySize();
+    for (const auto& [passType, pass] : m_AllPasses)
+        size += pass->GetOwnedMemorySize();
+    for (const auto& [passType, cached] : m_PassCache)
+        size += cached.Texture->GetMemorySize();
+    return size;
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "askygg/renderer/RenderGraph.h"
+
+#include "ImagePass.h"
+#include "SettingsStore.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+// One complete set of passes, their render graph and the statistics they produce.  Instances are independent, so
+// several can run at once as long as each one is only ever used with the context that was current at Initialize().
+class ImagePipeline
+{
+public:
+	explicit ImagePipeline(std::string settingsFileName);
+	~ImagePipeline();
+
+	// Builds every pass and reads the pass order and bloom type from the settings file, or from the settings snapshot
+	// when one is set and was taken from the same file.  With privateShaderPrograms each pass drives its own copy of
+	// the library program, which is required when pipelines run on several threads.
+	void Initialize(bool privateShaderPrograms = false);
+	// Initialize() without a context: the passes and their settings only, for CpuPipeline.  Submit() is unavailable.
+	void InitializeForCpu();
+	void Shutdown();
+
+	// Re-reads every pass's settings, the pass order and the bloom type from a parsed settings document.  Cheap:
+	// nothing is compiled or allocated, so it can run before every job.
+	void ApplySettings(const YAML::Node& config);
+	// The current pass settings, pass order and bloom type as a settings document for ApplySettings(), e.g. to give
+	// another pipeline the values being edited without saving them.
+	YAML::Node ExportSettings();
+	// Checks what ApplySettings() cannot recover from (unknown pass names, out of range enums).  Values of the wrong
+	// type still throw YAML::Exception from ApplySettings().
+	static bool ValidateSettings(const YAML::Node& config, std::string& error);
+	// Copy of base with overrides laid over it, section by section.
+	static YAML::Node MergeSettings(const YAML::Node& base, const YAML::Node& overrides);
+
+	// Compiles every post-fx program into the ShaderLibrary.  Called once per process, before any Initialize().
+	static void LoadShaders();
+	// Binary copy of every pass's settings, the pass order and the bloom type, read by Initialize() instead of the
+	// settings file for a fast headless startup.  Written on the first Initialize() that finds it missing or taken from
+	// a settings file with different contents.  Empty (the default) disables it.  Set before any Initialize().
+	static void SetSettingsSnapshotFileName(const std::string& fileName) { s_SettingsSnapshotFileName = fileName; }
+	// False if the snapshot could not be written, or was taken from different settings or another build's passes.
+	bool		SaveSettingsSnapshot(const std::string& fileName) const;
+	bool		LoadSettingsSnapshot(const std::string& fileName);
+
+	void Submit(const glm::vec2& targetSize, uint32_t targetTextureID, askygg::RenderGraphAccess outputAccess,
+		bool profile = true);
+	// Declares what Submit() would run, to be executed a tile of one dispatch at a time by ContinueProgressive() over
+	// as many calls (frames) as it takes.  The output is only complete once ContinueProgressive() returned true.  Any
+	// other submit cancels the render.
+	void  BeginProgressive(const glm::vec2& targetSize, uint32_t targetTextureID, askygg::RenderGraphAccess outputAccess);
+	// Runs tiles until about budgetMilliseconds of GPU time are spent, at least one.  True once the render is complete.
+	bool  ContinueProgressive(double budgetMilliseconds);
+	void  CancelProgressive();
+	bool  IsProgressiveActive() const { return m_Progressive.Active; }
+	// Fraction of the active progressive render done, GPU time it took so far and the calls it was spread over.
+	float	 GetProgressiveProgress() const;
+	double	 GetProgressiveTime() const { return m_Progressive.Time; }
+	uint32_t GetProgressiveCallCount() const { return m_Progressive.CallCount; }
+
+	// Runs a single pass on its own, even if its settings make it an identity.  Linearize takes a display-encoded
+	// input, every other pass the RGBA32F linear image Linearize would have produced.  The composite runs without a
+	// bloom input.
+	void SubmitPass(ImagePassType passType, const glm::vec2& targetSize, uint32_t inputTextureID, bool profile = true);
+	// Submits the texture and writes the byte output into outputDirectory as a JPEG named after it.
+	void Save(const askygg::Texture2D& texture, const std::string& outputDirectory, bool profile = true);
+	// Submits the texture and encodes the byte output as a JPEG into memory.  False if encoding failed.
+	bool Encode(const askygg::Texture2D& texture, std::vector<uint8_t>& encoded, bool profile = true);
+
+	// Keeps every pass's output between submits and reruns only the passes at or after the first one whose input or
+	// settings changed.  Meant for the editor, which submits the same image every frame; costs a target per cached
+	// pass.  OutputCompute always runs, its sensor noise is animated.
+	void SetPassCaching(bool enabled);
+	// Drops every cached output, e.g. after an input texture's contents changed without its ID changing.
+	void InvalidatePassCache();
+	// The type and settings hash of every pass Submit() runs, in that order.  Settings that share a prefix of it share
+	// the cached outputs up to where they diverge.
+	std::vector<uint64_t> GetPassSettingsKey() const;
+
+	void	  SetBloomPass(BloomType bloomType);
+	// Format of the final output texture; RGBA8 unless a consumer needs more precision.
+	void	  SetOutputFormat(askygg::ImageUtils::ImageInternalFormat format);
+	// See ImagePass::SetResolutionScale(); applies to every pass until changed back to 1.
+	void	  SetResolutionScale(float scale);
+	BloomType GetBloomType() const { return m_ActiveBloomPassType; }
+
+	const askygg::Ref<ImagePass>& GetPass(ImagePassType type) { return m_AllPasses[type]; }
+	const askygg::Ref<ImagePass>& GetActiveBloomPass() const { return m_ActiveBloomPass; }
+	const askygg::Ref<askygg::Texture2D>& GetOutputTexture() const;
+	// Linearize first, OutputCompute last; the editor reorders the passes in between.
+	std::vector<ImagePassType>& GetOrderedPassTypes() { return m_OrderedPassTypes; }
+
+	const std::unordered_map<ImagePassType, double>& GetPassExecutionTimes() const { return m_PassExecutionTime; }
+	const std::unordered_set<ImagePassType>&		 GetElidedPasses() const { return m_ElidedPasses; }
+	uint64_t										 GetElidedDispatchCount() const { return m_ElidedDispatchCount; }
+	// Passes whose cached output the last submit reused, and the hits and misses since SetPassCaching(true).
+	const std::unordered_set<ImagePassType>&		 GetCachedPasses() const { return m_CachedPasses; }
+	uint64_t										 GetPassCacheHits() const { return m_PassCacheHits; }
+	uint64_t										 GetPassCacheMisses() const { return m_PassCacheMisses; }
+	void											 ResetElidedDispatchCount() { m_ElidedDispatchCount = 0; }
+	// On by default.  Off declares identity passes like any other, to check that eliding them changes nothing.
+	void											 SetPassElision(bool enabled) { m_PassElision = enabled; }
+
+	uint64_t GetMemorySize() const;
+	uint64_t GetPeakMemorySize() const { return m_PeakMemory; }
+	uint32_t GetTransientTextureCount() const { return m_RenderGraph.GetTransientTextureCount(); }
+
+private:
+	struct CachedPassOutput
+	{
+		// Covers the pipeline input and every pass up to and including this one.
+		uint64_t					   Key = 0;
+		askygg::Ref<askygg::Texture2D> Texture;
+	};
+
+	struct ProgressiveRender
+	{
+		bool		   Active = false;
+		// Next graph pass, and where inside it.
+		uint32_t	   PassIndex = 0;
+		DispatchCursor Cursor;
+		double		   LastStepTime = 0.0;
+		double		   Time = 0.0;
+		uint32_t	   CallCount = 0;
+	};
+
+	void CreatePasses();
+	// The snapshot when it matches, otherwise the settings document (and a snapshot of it).
+	void LoadInitialSettings();
+	// Builds and compiles the graph Submit() executes.
+	void DeclareGraph(const glm::vec2& targetSize, uint32_t targetTextureID, askygg::RenderGraphAccess outputAccess,
+		bool profile);
+	// Logs when the memory the last executed graph left allocated is a new peak.
+	void UpdatePeakMemory();
+	askygg::RenderGraphResource DeclarePass(ImagePassType passType, askygg::RenderGraphResource input,
+		const glm::vec2& targetSize, bool profile);
+	// DeclarePass() unless key, extended by this pass, matches its cached output; then that output is imported
+	// instead and the pass does not run.
+	askygg::RenderGraphResource DeclareCachedPass(ImagePassType passType, askygg::RenderGraphResource input,
+		uint64_t& key, const glm::vec2& targetSize, bool profile);
+
+	// FNV-1a of the settings file's text; what a snapshot is matched against.
+	uint64_t GetSettingsSourceHash() const;
+
+private:
+	inline static std::string s_SettingsSnapshotFileName;
+
+	std::string						m_SettingsFileName;
+	// Declared before the passes, which hold on to it.
+	askygg::Ref<SettingsStore>		m_SettingsStore;
+
+	std::unordered_map<ImagePassType, askygg::Ref<ImagePass>> m_AllPasses;
+	std::vector<ImagePassType>								  m_OrderedPassTypes;
+	askygg::Ref<ImagePass>									  m_ActiveBloomPass;
+	BloomType												  m_ActiveBloomPassType = BloomType::None;
+
+	askygg::RenderGraph					  m_RenderGraph;
+	// The image pass behind each graph pass; Invalid for the others.
+	std::vector<ImagePassType>			  m_GraphPassTypes;
+	ProgressiveRender					  m_Progressive;
+	glm::vec2							  m_GraphTargetSize{ 0.0f };
+	uint64_t							  m_PeakMemory = 0;
+	std::unordered_set<ImagePassType>	  m_ElidedPasses;
+	uint64_t							  m_ElidedDispatchCount = 0;
+	bool								  m_PassElision = true;
+	std::unordered_map<ImagePassType, double> m_PassExecutionTime;
+
+	float											   m_ResolutionScale = 1.0f;
+	bool											   m_PassCaching = false;
+	std::unordered_map<ImagePassType, CachedPassOutput> m_PassCache;
+	std::unordered_set<ImagePassType>				   m_CachedPasses;
+	uint64_t										   m_PassCacheHits = 0;
+	uint64_t										   m_PassCacheMisses = 0;
+
+	std::unordered_map<std::string, askygg::Ref<askygg::Shader>> m_PrivateShaders;
+};
@@ -0,0 +1,307 @@
+#include "InputEnumerator.h"
+
+#include "TarStream.h"
+
+#include "askygg/core/Log.h"
+
+#include <algorithm>
+#include <fstream>
+
+void InputEnumeratorSpecification::AppendPatterns(const std::string& text, std::vector<std::string>& patterns)
+{
+	size_t start = 0;
+	while (start <= text.size())
+	{
+		size_t end = text.find(',', start);
+		if (end == std::string::npos)
+			end = text.size();
+		if (end > start)
+			patterns.push_back(text.substr(start, end - start));
+		start = end + 1;
+	}
+}
+
+static bool MatchGlobFrom(const char* pattern, const char* text)
+{
+	while (*pattern)
+	{
+		if (pattern[0] == '*' && pattern[1] == '*')
+		{
+			pattern += 2;
+			// "**/" matches any number of whole directories, including none; a bare "**" anything at all.
+			const bool wholeDirectories = *pattern == '/';
+			if (wholeDirectories)
+				pattern++;
+			for (const char* rest = text;; rest++)
+			{
+				if ((!wholeDirectories || rest == text || rest[-1] == '/') && MatchGlobFrom(pattern, rest))
+					return true;
+				if (!*rest)
+					return false;
+			}
+		}
+		if (*pattern == '*')
+		{
+			pattern++;
+			for (const char* rest = text;; rest++)
+			{
+				if (MatchGlobFrom(pattern, rest))
+					return true;
+				if (!*rest || *rest == '/')
+					return false;
+			}
+		}
+
+		if (!*text || (*pattern == '?' ? *text == '/' : *pattern != *text))
+			return false;
+		pattern++;
+		text++;
+	}
+	return !*text;
+}
+
+bool InputEnumeratorSpecification::MatchGlob(const std::string& pattern, const std::string& relativePath)
+{
+	if (pattern.find('/') != std::string::npos)
+		return MatchGlobFrom(pattern.c_str(), relativePath.c_str());
+
+	size_t nameStart = relativePath.rfind('/');
+	return MatchGlobFrom(pattern.c_str(), relativePath.c_str() + (nameStart == std::string::npos ? 0 : nameStart + 1));
+}
+
+// Archive members carry their bytes, so only a few are read ahead.
+static constexpr size_t ArchiveQueueCapacity = 32;
+
+static size_t GetQueueCapacity(const InputEnumeratorSpecification& specification)
+{
+	if (!specification.ArchivePath.empty())
+		return std::min(specification.QueueCapacity, ArchiveQueueCapacity);
+	return std::max<size_t>(specification.QueueCapacity, 1);
+}
+
+InputEnumerator::InputEnumerator(InputEnumeratorSpecification specification)
+	: m_Specification(std::move(specification)), m_Files(GetQueueCapacity(m_Specification)),
+	  m_Start(std::chrono::steady_clock::now())
+{
+	if (!m_Specification.ArchivePath.empty() || !m_Specification.ManifestPath.empty())
+	{
+		m_ActiveReaders = 1;
+		m_Readers.emplace_back(m_Specification.ArchivePath.empty() ? &InputEnumerator::ReadManifest
+																   : &InputEnumerator::ReadArchive,
+			this);
+		return;
+	}
+
+	m_PendingDirectories.push_back({ m_Specification.Root, std::string() });
+	const uint32_t readerCount = std::max(m_Specification.ReaderCount, 1u);
+	m_ActiveReaders = readerCount;
+	for (uint32_t i = 0; i < readerCount; i++)
+		m_Readers.emplace_back(&InputEnumerator::ReadDirectories, this);
+}
+
+InputEnumerator::~InputEnumerator()
+{
+	// Unblocks readers waiting for queue space or for more directories.
+	m_Stopped = true;
+	m_Files.Close();
+	{
+		std::lock_guard<std::mutex> lock(m_DirectoryMutex);
+		m_PendingDirectories.clear();
+	}
+	m_DirectoryCondition.notify_all();
+
+	for (auto& reader : m_Readers)
+		reader.join();
+}
+
+bool InputEnumerator::Next(InputFile& file)
+{
+	return m_Files.Pop(file);
+}
+
+void InputEnumerator::ReadDirectories()
+{
+	while (true)
+	{
+		PendingDirectory directory;
+		{
+			std::unique_lock<std::mutex> lock(m_DirectoryMutex);
+			m_DirectoryCondition.wait(lock, [this]
+			{
+				return !m_PendingDirectories.empty() || m_BusyReaders == 0 || m_Stopped;
+			});
+			if (m_PendingDirectories.empty() || m_Stopped)
+				break;
+
+			directory = std::move(m_PendingDirectories.back());
+			m_PendingDirectories.pop_back();
+			m_BusyReaders++;
+		}
+
+		ReadDirectory(directory);
+
+		{
+			std::lock_guard<std::mutex> lock(m_DirectoryMutex);
+			m_BusyReaders--;
+		}
+		// Either there is more to read or, with nobody busy and nothing pending, the other readers can leave.
+		m_DirectoryCondition.notify_all();
+	}
+	m_DirectoryCondition.notify_all();
+	FinishReader();
+}
+
+void InputEnumerator::ReadDirectory(const PendingDirectory& directory)
+{
+	std::error_code error;
+	std::filesystem::directory_iterator it(directory.Path, std::filesystem::directory_options::skip_permission_denied,
+		error);
+	if (error)
+	{
+		YGG_LOG_WARN("Cannot read input directory '{}': {}", directory.Path.string(), error.message());
+		return;
+	}
+	m_DirectoryCount++;
+
+	std::vector<PendingDirectory> subdirectories;
+	for (; it != std::filesystem::directory_iterator() && !m_Stopped; it.increment(error))
+	{
+		if (error)
+			break;
+
+		// The type comes from the directory listing where the filesystem provides it, so this does not stat.
+		const auto&		  entry = *it;
+		const std::string name = entry.path().filename().string();
+		std::string		  relativePath = directory.RelativePath.empty() ? name : directory.RelativePath + "/" + name;
+
+		std::error_code typeError;
+		if (entry.is_directory(typeError))
+		{
+			// Symlinked directories are not followed; they could form cycles.
+			if (m_Specification.Recursive && !entry.is_symlink(typeError) && !IsExcluded(relativePath))
+				subdirectories.push_back({ entry.path(), std::move(relativePath) });
+		}
+		else if (entry.is_regular_file(typeError))
+		{
+			if (IsIncluded(relativePath) && !Emit({ entry.path().string(), std::move(relativePath) }))
+				return;
+		}
+	}
+
+	if (!subdirectories.empty())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_DirectoryMutex);
+			for (auto& subdirectory : subdirectories)
+				m_PendingDirectories.push_back(std::move(subdirectory));
+		}
+		m_DirectoryCondition.notify_all();
+	}
+}
+
+void InputEnumerator::ReadManifest()
+{
+	std::ifstream manifest(m_Specification.ManifestPath);
+	if (!manifest)
+		YGG_LOG_ERROR("Cannot open manifest '{}'.", m_Specification.ManifestPath);
+
+	const std::filesystem::path root(m_Specification.Root);
+	std::string					line;
+	while (!m_Stopped && std::getline(manifest, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (line.empty() || line[0] == '#')
+			continue;
+
+		std::filesystem::path path(line);
+		std::filesystem::path relative;
+		if (path.is_absolute())
+			relative = path.lexically_relative(root);
+		else
+		{
+			relative = path.lexically_normal();
+			path = root / path;
+		}
+		// Files outside Root, absolute or reached through "..", keep just their name in the output tree.
+		std::string relativePath = relative.empty() || *relative.begin() == ".." ? path.filename().generic_string()
+																				 : relative.generic_string();
+
+		if (IsIncluded(relativePath) && !Emit({ path.string(), std::move(relativePath) }))
+			break;
+	}
+	FinishReader();
+}
+
+void InputEnumerator::ReadArchive()
+{
+	TarReader		  archive(m_Specification.ArchivePath);
+	TarReader::Member member;
+	while (!m_Stopped && archive.Next(member))
+	{
+		if (!IsIncluded(member.Name))
+			continue;
+
+		InputFile file;
+		file.Path = m_Specification.ArchivePath + ":" + member.Name;
+		file.RelativePath = std::move(member.Name);
+		file.Data = std::move(member.Data);
+		if (!Emit(std::move(file)))
+			break;
+	}
+	FinishReader();
+}
+
+bool InputEnumerator::IsIncluded(const std::string& relativePath) const
+{
+	if (IsExcluded(relativePath))
+		return false;
+	if (m_Specification.Include.empty())
+		return true;
+	return std::any_of(m_Specification.Include.begin(), m_Specification.Include.end(),
+		[&relativePath](const std::string& pattern)
+		{
+			return InputEnumeratorSpecification::MatchGlob(pattern, relativePath);
+		});
+}
+
+bool InputEnumerator::IsExcluded(const std::string& relativePath) const
+{
+	return std::any_of(m_Specification.Exclude.begin(), m_Specification.Exclude.end(),
+		[&relativePath](const std::string& pattern)
+		{
+			return InputEnumeratorSpecification::MatchGlob(pattern, relativePath);
+		});
+}
+
+bool InputEnumerator::Emit(InputFile file)
+{
+	if (!m_Files.Push(std::move(file)))
+		return false;
+
+	if (++m_FileCount == 1)
+		YGG_LOG_INFO("First input found after {:.1f} ms",
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_Start).count());
+	return true;
+}
+
+void InputEnumerator::FinishReader()
+{
+	if (--m_ActiveReaders > 0)
+		return;
+
+	m_Files.Close();
+	if (m_Stopped)
+		return;
+
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_Start).count();
+	if (!m_Specification.ArchivePath.empty())
+		YGG_LOG_INFO("Read {} input images from '{}' in {:.2f} s", m_FileCount.load(), m_Specification.ArchivePath,
+			seconds);
+	else if (m_Specification.ManifestPath.empty())
+		YGG_LOG_INFO("Enumerated {} input files in {} directories in {:.2f} s", m_FileCount.load(),
+			m_DirectoryCount.load(), seconds);
+	else
+		YGG_LOG_INFO("Read {} input files from '{}' in {:.2f} s", m_FileCount.load(), m_Specification.ManifestPath,
+			seconds);
+}
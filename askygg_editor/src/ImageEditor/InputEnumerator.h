@@ -0,0 +1,97 @@
+#pragma once
+
+#include "askygg/core/BlockingQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct InputEnumeratorSpecification
+{
+	std::string Root;
+	bool		Recursive = false;
+	// Globs over the path relative to Root ('/' separated).  A pattern without '/' matches the file or directory name
+	// alone.  '*' and '?' stay within one path component, '**' spans components.  No includes means every file.
+	// Directories matching an exclude are not entered.
+	std::vector<std::string> Include;
+	std::vector<std::string> Exclude;
+	// One path per line, relative to Root or absolute; read instead of walking Root.  Blank lines and lines starting
+	// with '#' are skipped.
+	std::string ManifestPath;
+	// A tar or tar.gz ("-" for stdin) read member by member instead of walking Root.  Member names take the place of
+	// relative paths.
+	std::string ArchivePath;
+	uint32_t	ReaderCount = 4;
+	// Files found but not yet taken by Next(); readers stall once this many are waiting.
+	size_t		QueueCapacity = 4096;
+
+	// "a,b,c" into Include / Exclude.
+	static void AppendPatterns(const std::string& text, std::vector<std::string>& patterns);
+	static bool MatchGlob(const std::string& pattern, const std::string& relativePath);
+};
+
+// Streams the input files of a run: readers walk the tree (or read the manifest) on their own threads while the
+// consumer processes what has been found so far.  Files come in no particular order.  Directories are walked depth
+// first, so the pending set stays proportional to the tree's depth times its fan-out rather than to its size.
+class InputEnumerator
+{
+public:
+	struct InputFile
+	{
+		std::string Path;
+		// Relative to Root, '/' separated; the output tree mirrors it.
+		std::string RelativePath;
+		// The encoded image for archive members, which have no path of their own.  Empty for files.
+		std::vector<uint8_t> Data;
+	};
+
+	explicit InputEnumerator(InputEnumeratorSpecification specification);
+	~InputEnumerator();
+
+	InputEnumerator(const InputEnumerator&) = delete;
+	InputEnumerator& operator=(const InputEnumerator&) = delete;
+
+	// Next file, or false once enumeration finished and every file was handed out.  Safe from several threads.
+	bool Next(InputFile& file);
+
+	uint64_t GetFileCount() const { return m_FileCount; }
+	uint64_t GetDirectoryCount() const { return m_DirectoryCount; }
+
+private:
+	struct PendingDirectory
+	{
+		std::filesystem::path Path;
+		std::string			  RelativePath;
+	};
+
+	void ReadDirectories();
+	void ReadManifest();
+	void ReadArchive();
+	void ReadDirectory(const PendingDirectory& directory);
+	bool IsIncluded(const std::string& relativePath) const;
+	bool IsExcluded(const std::string& relativePath) const;
+	bool Emit(InputFile file);
+	void FinishReader();
+
+private:
+	InputEnumeratorSpecification m_Specification;
+	askygg::BlockingQueue<InputFile> m_Files;
+	std::vector<std::thread>		 m_Readers;
+	std::atomic<uint32_t>			 m_ActiveReaders = 0;
+	std::atomic<bool>				 m_Stopped = false;
+
+	// Directories found but not yet read, and how many readers are inside one; both empty means the walk is done.
+	std::mutex					  m_DirectoryMutex;
+	std::condition_variable		  m_DirectoryCondition;
+	std::vector<PendingDirectory> m_PendingDirectories;
+	uint32_t					  m_BusyReaders = 0;
+
+	std::chrono::steady_clock::time_point m_Start;
+	std::atomic<uint64_t>				  m_FileCount = 0;
+	std::atomic<uint64_t>				  m_DirectoryCount = 0;
+};
@@ -0,0 +1,469 @@
+#include "JobServer.h"
+
+#include "askygg/core/Log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Longest request line accepted; anything larger is a client bug, not a job.
+static constexpr size_t MaxRequestSize = 1 << 20;
+// Frames that can ride along with a single request.
+static constexpr size_t MaxFdsPerMessage = 64;
+// Jobs kept for the latency percentiles in a stats reply.
+static constexpr size_t LatencyWindow = 1024;
+
+struct JobServer::Connection
+{
+	int				  Fd = -1;
+	std::mutex		  WriteMutex;
+	std::atomic<bool> Finished = false;
+
+	~Connection() { close(Fd); }
+};
+
+static std::string EscapeJson(const std::string& text)
+{
+	std::string escaped;
+	for (char c : text)
+	{
+		if (c == '"' || c == '\\')
+		{
+			escaped += '\\';
+			escaped += c;
+		}
+		else if ((unsigned char)c < 0x20)
+		{
+			// Replies are one line each, so no raw control characters, newlines included.
+			static constexpr char Hex[] = "0123456789abcdef";
+			escaped += "\\u00";
+			escaped += Hex[(unsigned char)c >> 4];
+			escaped += Hex[(unsigned char)c & 0xF];
+		}
+		else
+			escaped += c;
+	}
+	return escaped;
+}
+
+static void CloseFds(std::vector<int>& fds)
+{
+	for (int fd : fds)
+		close(fd);
+	fds.clear();
+}
+
+SharedFrame::SharedFrame(int fd, uint64_t size)
+	: m_Size(size)
+{
+	struct stat status{};
+	if (fstat(fd, &status) != 0 || (uint64_t)status.st_size < size)
+		return;
+
+	void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (data != MAP_FAILED)
+		m_Data = static_cast<uint8_t*>(data);
+}
+
+SharedFrame::~SharedFrame()
+{
+	if (m_Data)
+		munmap(m_Data, m_Size);
+}
+
+JobServer::JobServer(std::string socketPath)
+	: m_SocketPath(std::move(socketPath))
+{
+	m_QueueLatencies.reserve(LatencyWindow);
+	m_TotalLatencies.reserve(LatencyWindow);
+}
+
+JobServer::~JobServer()
+{
+	Stop();
+}
+
+bool JobServer::Start()
+{
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	if (m_SocketPath.size() >= sizeof(address.sun_path))
+	{
+		YGG_LOG_ERROR("Daemon: socket path '{}' is too long", m_SocketPath);
+		return false;
+	}
+	std::strncpy(address.sun_path, m_SocketPath.c_str(), sizeof(address.sun_path) - 1);
+
+	m_ListenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (m_ListenFd < 0)
+	{
+		YGG_LOG_ERROR("Daemon: socket() failed: {}", std::strerror(errno));
+		return false;
+	}
+
+	// A socket file nobody answers on is left over from a daemon that did not shut down cleanly.
+	if (connect(m_ListenFd, (sockaddr*)&address, sizeof(address)) == 0)
+	{
+		YGG_LOG_ERROR("Daemon: another daemon is already serving '{}'", m_SocketPath);
+		close(m_ListenFd);
+		m_ListenFd = -1;
+		return false;
+	}
+	close(m_ListenFd);
+	m_ListenFd = -1;
+
+	struct stat status{};
+	if (lstat(m_SocketPath.c_str(), &status) == 0)
+	{
+		if (!S_ISSOCK(status.st_mode))
+		{
+			YGG_LOG_ERROR("Daemon: '{}' exists and is not a socket; refusing to replace it", m_SocketPath);
+			return false;
+		}
+		unlink(m_SocketPath.c_str());
+	}
+
+	m_ListenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (bind(m_ListenFd, (sockaddr*)&address, sizeof(address)) != 0 || listen(m_ListenFd, 16) != 0)
+	{
+		YGG_LOG_ERROR("Daemon: cannot listen on '{}': {}", m_SocketPath, std::strerror(errno));
+		close(m_ListenFd);
+		m_ListenFd = -1;
+		return false;
+	}
+
+	YGG_LOG_INFO("Daemon: listening on '{}'", m_SocketPath);
+	m_Start = Clock::now();
+	m_Acceptor = std::thread(&JobServer::AcceptConnections, this);
+	return true;
+}
+
+void JobServer::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_ConnectionMutex);
+		if (m_Stopped || m_ListenFd < 0)
+			return;
+		m_Stopped = true;
+	}
+
+	m_Jobs.Close();
+	// Wakes accept() and every recvmsg() so their threads can be joined.
+	shutdown(m_ListenFd, SHUT_RDWR);
+	m_Acceptor.join();
+	for (auto& entry : m_ConnectionThreads)
+	{
+		if (auto connection = entry.Socket.lock())
+			shutdown(connection->Fd, SHUT_RDWR);
+	}
+	for (auto& entry : m_ConnectionThreads)
+		entry.Thread.join();
+	m_ConnectionThreads.clear();
+
+	// Anything still queued never reaches the GL thread.
+	Job job;
+	while (m_Jobs.Pop(job))
+		CloseFds(job.FrameFds);
+
+	close(m_ListenFd);
+	unlink(m_SocketPath.c_str());
+	YGG_LOG_INFO("Daemon: stopped after {} jobs ({} failed), {} images", m_JobsSucceeded + m_JobsFailed,
+		m_JobsFailed.load(), m_ImagesProcessed.load());
+}
+
+bool JobServer::AcquireJob(Job& job)
+{
+	if (!m_Jobs.Pop(job))
+		return false;
+
+	job.StartTime = Clock::now();
+	m_JobsRunning++;
+	return true;
+}
+
+void JobServer::Complete(Job& job, const JobResult& result)
+{
+	const Clock::time_point now = Clock::now();
+	const double queueMs = std::chrono::duration<double, std::milli>(job.StartTime - job.ReceiveTime).count();
+	const double processMs = std::chrono::duration<double, std::milli>(now - job.StartTime).count();
+	const double totalMs = std::chrono::duration<double, std::milli>(now - job.ReceiveTime).count();
+
+	CloseFds(job.FrameFds);
+	m_JobsRunning--;
+	(result.Success ? m_JobsSucceeded : m_JobsFailed)++;
+	m_ImagesProcessed += result.Processed;
+	{
+		std::lock_guard<std::mutex> lock(m_LatencyMutex);
+		if (m_TotalLatencies.size() < LatencyWindow)
+		{
+			m_QueueLatencies.push_back(queueMs);
+			m_TotalLatencies.push_back(totalMs);
+		}
+		else
+		{
+			m_QueueLatencies[m_NextLatency] = queueMs;
+			m_TotalLatencies[m_NextLatency] = totalMs;
+		}
+		m_NextLatency = (m_NextLatency + 1) % LatencyWindow;
+	}
+
+	std::ostringstream reply;
+	reply << "{\"id\": \"" << EscapeJson(job.Id) << "\", \"status\": \"" << (result.Success ? "ok" : "error") << "\"";
+	if (!result.Success)
+		reply << ", \"message\": \"" << EscapeJson(result.Message) << "\"";
+	reply << ", \"processed\": " << result.Processed << ", \"queue_ms\": " << queueMs
+		  << ", \"process_ms\": " << processMs << ", \"total_ms\": " << totalMs << "}";
+	Reply(*job.Origin, reply.str());
+
+	if (!result.Success)
+		YGG_LOG_WARN("Daemon: job '{}' failed: {}", job.Id, result.Message);
+	job.Origin = nullptr;
+}
+
+void JobServer::AcceptConnections()
+{
+	while (true)
+	{
+		int fd = accept4(m_ListenFd, nullptr, nullptr, SOCK_CLOEXEC);
+		if (fd < 0)
+		{
+			if (errno == EINTR || errno == ECONNABORTED)
+				continue;
+			break;
+		}
+
+		std::lock_guard<std::mutex> lock(m_ConnectionMutex);
+		if (m_Stopped)
+		{
+			close(fd);
+			break;
+		}
+		// Reap the threads of connections that hung up since the last accept.
+		for (size_t i = m_ConnectionThreads.size(); i-- > 0;)
+		{
+			auto connection = m_ConnectionThreads[i].Socket.lock();
+			if (!connection || connection->Finished)
+			{
+				m_ConnectionThreads[i].Thread.join();
+				m_ConnectionThreads.erase(m_ConnectionThreads.begin() + i);
+			}
+		}
+
+		auto connection = askygg::CreateRef<Connection>();
+		connection->Fd = fd;
+		m_ConnectionThreads.push_back({ std::thread(&JobServer::ServeConnection, this, connection), connection });
+	}
+}
+
+void JobServer::ServeConnection(askygg::Ref<Connection> connection)
+{
+	std::string		 pending;
+	std::vector<int> fds;
+	char			 data[64 * 1024];
+	alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * MaxFdsPerMessage)];
+
+	while (true)
+	{
+		iovec  vector{ data, sizeof(data) };
+		msghdr message{};
+		message.msg_iov = &vector;
+		message.msg_iovlen = 1;
+		message.msg_control = control;
+		message.msg_controllen = sizeof(control);
+
+		ssize_t received = recvmsg(connection->Fd, &message, MSG_CMSG_CLOEXEC);
+		if (received < 0 && errno == EINTR)
+			continue;
+		if (received <= 0)
+			break;
+
+		for (cmsghdr* header = CMSG_FIRSTHDR(&message); header; header = CMSG_NXTHDR(&message, header))
+		{
+			if (header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS)
+				continue;
+			size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+			const int* passed = reinterpret_cast<const int*>(CMSG_DATA(header));
+			fds.insert(fds.end(), passed, passed + count);
+		}
+		if (message.msg_flags & MSG_CTRUNC)
+		{
+			Reply(*connection, "{\"status\": \"error\", \"message\": \"too many fds in one message; the limit is "
+				+ std::to_string(MaxFdsPerMessage) + "\"}");
+			break;
+		}
+
+		pending.append(data, received);
+		size_t end;
+		while ((end = pending.find('\n')) != std::string::npos)
+		{
+			std::string line = pending.substr(0, end);
+			pending.erase(0, end + 1);
+			if (line.find_first_not_of(" \t\r") != std::string::npos)
+				HandleRequest(connection, line, fds);
+		}
+		if (pending.size() > MaxRequestSize)
+		{
+			Reply(*connection, "{\"status\": \"error\", \"message\": \"request too large\"}");
+			break;
+		}
+	}
+	CloseFds(fds);
+
+	// Jobs still queued from this connection keep it open until they are answered.
+	connection->Finished = true;
+}
+
+void JobServer::HandleRequest(const askygg::Ref<Connection>& connection, const std::string& line, std::vector<int>& fds)
+{
+	// Fds sent along with the line belong to it; stray ones are closed rather than handed to a later request.
+	Job job;
+	job.FrameFds = std::move(fds);
+	fds.clear();
+	job.Origin = connection;
+	job.ReceiveTime = Clock::now();
+
+	auto reject = [&](const std::string& reason)
+	{
+		CloseFds(job.FrameFds);
+		Reply(*connection, "{\"id\": \"" + EscapeJson(job.Id) + "\", \"status\": \"error\", \"message\": \""
+			+ EscapeJson(reason) + "\"}");
+	};
+
+	std::string type;
+	YAML::Node	request;
+	try
+	{
+		// JSON is a subset of YAML's flow style.
+		request = YAML::Load(line);
+		if (!request.IsMap())
+			return reject("request must be a JSON object");
+
+		type = request["type"] ? request["type"].as<std::string>() : std::string();
+		job.Id = request["id"] ? request["id"].as<std::string>() : std::to_string(m_JobsReceived + 1);
+
+		if (type == "stats")
+		{
+			CloseFds(job.FrameFds);
+			return Reply(*connection, GetStatistics());
+		}
+		if (type == "shutdown")
+		{
+			CloseFds(job.FrameFds);
+			YGG_LOG_INFO("Daemon: shutdown requested; finishing {} queued jobs", m_Jobs.GetSize());
+			m_ShutdownRequested = true;
+			m_Jobs.Close();
+			return Reply(*connection, "{\"status\": \"ok\"}");
+		}
+		if (m_ShutdownRequested)
+			return reject("daemon is shutting down");
+
+		if (request["overrides"])
+		{
+			if (!request["overrides"].IsMap())
+				return reject("overrides must be an object");
+			job.Overrides = request["overrides"];
+		}
+
+		if (type == "files")
+		{
+			job.Type = JobType::Files;
+			if (!job.FrameFds.empty())
+				return reject("files jobs take no fds");
+			if (!request["inputs"] || !request["inputs"].IsSequence() || request["inputs"].size() == 0)
+				return reject("files jobs need a non-empty inputs list");
+			job.Inputs = request["inputs"].as<std::vector<std::string>>();
+			job.OutputDirectory = request["output_dir"] ? request["output_dir"].as<std::string>() : std::string();
+		}
+		else if (type == "frames")
+		{
+			job.Type = JobType::Frames;
+			if (job.FrameFds.empty())
+				return reject("frames jobs need one fd per frame sent with the request (SCM_RIGHTS)");
+			if (!request["width"] || !request["height"])
+				return reject("frames jobs need width and height");
+
+			job.FrameSpecification.Width = request["width"].as<uint32_t>();
+			job.FrameSpecification.Height = request["height"].as<uint32_t>();
+			std::string pixelFormat = request["pix_fmt"] ? request["pix_fmt"].as<std::string>() : "rgba";
+			if (job.FrameSpecification.Width == 0 || job.FrameSpecification.Height == 0)
+				return reject("width and height must be positive");
+			if (!FrameStreamSpecification::ParsePixelFormat(pixelFormat, job.FrameSpecification.PixelFormat))
+				return reject("pix_fmt must be rgba, rgb24 or rgba64le");
+		}
+		else
+		{
+			return reject("unknown request type '" + type + "'; expected files, frames, stats or shutdown");
+		}
+	}
+	catch (const YAML::Exception& e)
+	{
+		return reject(std::string("malformed request: ") + e.what());
+	}
+
+	m_JobsReceived++;
+	m_Jobs.Push(std::move(job));
+}
+
+std::string JobServer::GetStatistics() const
+{
+	std::vector<double> queueLatencies, totalLatencies;
+	{
+		std::lock_guard<std::mutex> lock(m_LatencyMutex);
+		queueLatencies = m_QueueLatencies;
+		totalLatencies = m_TotalLatencies;
+	}
+
+	auto summary = [](std::vector<double>& latencies)
+	{
+		std::sort(latencies.begin(), latencies.end());
+		auto percentile = [&latencies](double p)
+		{ return latencies.empty() ? 0.0 : latencies[std::min((size_t)(p * latencies.size()), latencies.size() - 1)]; };
+		double mean = latencies.empty() ? 0.0
+			: std::accumulate(latencies.begin(), latencies.end(), 0.0) / (double)latencies.size();
+
+		std::ostringstream out;
+		out << "{\"mean\": " << mean << ", \"p50\": " << percentile(0.5) << ", \"p95\": " << percentile(0.95)
+			<< ", \"p99\": " << percentile(0.99) << ", \"max\": " << (latencies.empty() ? 0.0 : latencies.back())
+			<< "}";
+		return out.str();
+	};
+
+	std::ostringstream stats;
+	stats << "{\"status\": \"ok\""
+		  << ", \"uptime_s\": " << std::chrono::duration<double>(Clock::now() - m_Start).count()
+		  << ", \"queue_depth\": " << m_Jobs.GetSize()
+		  << ", \"running\": " << m_JobsRunning.load()
+		  << ", \"received\": " << m_JobsReceived.load()
+		  << ", \"succeeded\": " << m_JobsSucceeded.load()
+		  << ", \"failed\": " << m_JobsFailed.load()
+		  << ", \"images\": " << m_ImagesProcessed.load()
+		  << ", \"latency_window\": " << totalLatencies.size()
+		  << ", \"queue_ms\": " << summary(queueLatencies)
+		  << ", \"total_ms\": " << summary(totalLatencies) << "}";
+	return stats.str();
+}
+
+void JobServer::Reply(Connection& connection, const std::string& message)
+{
+	std::lock_guard<std::mutex> lock(connection.WriteMutex);
+	std::string line = message + "\n";
+	size_t		sent = 0;
+	while (sent < line.size())
+	{
+		// MSG_NOSIGNAL: a client that hung up must not take the daemon down with SIGPIPE.
+		ssize_t result = send(connection.Fd, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+		if (result < 0 && errno == EINTR)
+			continue;
+		if (result <= 0)
+			return;
+		sent += result;
+	}
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "askygg/core/Memory.h"
+#include "askygg/core/BlockingQueue.h"
+#include "FrameStream.h"
+
+#include "yaml-cpp/yaml.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A frame handed over as a memfd (or any mmap-able fd).  The pixels are processed in place: the client reads the
+// result out of the same memory once the job completes.
+class SharedFrame
+{
+public:
+	SharedFrame(int fd, uint64_t size);
+	~SharedFrame();
+
+	SharedFrame(const SharedFrame&) = delete;
+	SharedFrame& operator=(const SharedFrame&) = delete;
+
+	bool	 IsValid() const { return m_Data != nullptr; }
+	uint8_t* GetData() const { return m_Data; }
+
+private:
+	uint8_t* m_Data = nullptr;
+	uint64_t m_Size = 0;
+};
+
+// Accepts newline-delimited JSON requests on a Unix domain socket and hands jobs to the GL thread in arrival order.
+// Every connection gets its own thread; replies go back on the connection the job came in on.  Stats requests are
+// answered straight from the connection thread, so they never wait behind queued work.
+class JobServer
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	enum class JobType
+	{
+		Files,
+		Frames
+	};
+
+	struct Connection;
+
+	struct Job
+	{
+		std::string Id;
+		JobType		Type = JobType::Files;
+		// Files: decoded, processed and written as JPEGs into OutputDirectory (the daemon's --output_dir if empty).
+		std::vector<std::string> Inputs;
+		std::string				 OutputDirectory;
+		// Frames: one fd per frame, all of FrameSpecification.  Owned by the job, closed by Complete().
+		FrameStreamSpecification FrameSpecification;
+		std::vector<int>		 FrameFds;
+		// Laid over the daemon's settings for this job only.
+		YAML::Node Overrides;
+
+		askygg::Ref<Connection> Origin;
+		Clock::time_point		ReceiveTime;
+		Clock::time_point		StartTime;
+	};
+
+	struct JobResult
+	{
+		bool		Success = true;
+		std::string Message;
+		uint32_t	Processed = 0;
+	};
+
+	explicit JobServer(std::string socketPath);
+	~JobServer();
+
+	// Binds the socket and starts accepting.  False if the socket could not be created.
+	bool Start();
+	// Stops accepting, closes every connection and wakes AcquireJob().  Safe to call more than once.
+	void Stop();
+
+	// Next job, or false once the server was stopped (by Stop() or a shutdown request) and the queue drained.
+	bool AcquireJob(Job& job);
+	// Sends the reply, closes the job's fds and records its latency.
+	void Complete(Job& job, const JobResult& result);
+
+private:
+	void AcceptConnections();
+	void ServeConnection(askygg::Ref<Connection> connection);
+	void HandleRequest(const askygg::Ref<Connection>& connection, const std::string& line, std::vector<int>& fds);
+	std::string GetStatistics() const;
+
+	static void Reply(Connection& connection, const std::string& message);
+
+private:
+	std::string m_SocketPath;
+	int			m_ListenFd = -1;
+	std::thread m_Acceptor;
+	bool		m_Stopped = false;
+
+	struct ConnectionThread
+	{
+		std::thread				  Thread;
+		// Expires once the thread ended and every job from the connection was answered; that closes the socket.
+		std::weak_ptr<Connection> Socket;
+	};
+	std::mutex					  m_ConnectionMutex;
+	std::vector<ConnectionThread> m_ConnectionThreads;
+
+	askygg::BlockingQueue<Job> m_Jobs;
+	std::atomic<bool>		   m_ShutdownRequested = false;
+
+	Clock::time_point	  m_Start;
+	std::atomic<uint64_t> m_JobsReceived = 0;
+	std::atomic<uint64_t> m_JobsRunning = 0;
+	std::atomic<uint64_t> m_JobsSucceeded = 0;
+	std::atomic<uint64_t> m_JobsFailed = 0;
+	std::atomic<uint64_t> m_ImagesProcessed = 0;
+	// Queue wait and receive-to-reply time of the most recent jobs, in milliseconds.
+	mutable std::mutex	m_LatencyMutex;
+	std::vector<double> m_QueueLatencies;
+	std::vector<double> m_TotalLatencies;
+	size_t				m_NextLatency = 0;
+};
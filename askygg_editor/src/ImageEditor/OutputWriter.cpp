@@ -0,0 +1,280 @@
+#include "OutputWriter.h"
+
+#include "askygg/core/Log.h"
+#include "askygg/platform/PlatformDetection.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <unordered_set>
+
+#if defined(E_PLATFORM_WINDOWS)
+	#include <fcntl.h>
+	#include <io.h>
+#else
+	#include <fcntl.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+// Buffer address, file offset and length granularity for O_DIRECT; the logical block size of every common device
+// divides it.
+static constexpr size_t DirectIOAlignment = 4096;
+
+OutputWriter::OutputWriter(const OutputWriterSpecification& specification)
+	: m_Specification(specification)
+{
+	const uint32_t threadCount = std::max(m_Specification.ThreadCount, 1u);
+	for (uint32_t i = 0; i < threadCount; i++)
+		m_Threads.emplace_back(&OutputWriter::Run, this);
+}
+
+OutputWriter::~OutputWriter()
+{
+	Flush();
+	m_Requests.Close();
+	for (auto& thread : m_Threads)
+		thread.join();
+}
+
+void OutputWriter::Write(std::string path, std::vector<uint8_t> data)
+{
+	const uint64_t size = data.size();
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		if (!m_Started)
+		{
+			m_Started = true;
+			m_FirstWrite = Clock::now();
+		}
+
+		// An output larger than the whole limit still goes through once nothing else is pending.
+		auto hasSpace = [this, size] {
+			return m_PendingBytes == 0 || m_PendingBytes + size <= m_Specification.MaxPendingBytes;
+		};
+		if (!hasSpace())
+		{
+			const Clock::time_point start = Clock::now();
+			m_SpaceCondition.wait(lock, hasSpace);
+			m_BlockedNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+		}
+		m_PendingBytes += size;
+		m_PendingFiles++;
+	}
+	m_Requests.Push({ std::move(path), std::move(data) });
+}
+
+void OutputWriter::Flush()
+{
+	std::vector<std::string> unsynced;
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_IdleCondition.wait(lock, [this] { return m_PendingFiles == 0 && m_ActiveCheckpoints == 0; });
+		unsynced.swap(m_UnsyncedPaths);
+	}
+	Sync(unsynced);
+}
+
+void OutputWriter::LogStatistics() const
+{
+	double seconds = 0.0;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (m_Started)
+			seconds = std::chrono::duration<double>(m_LastWrite - m_FirstWrite).count();
+	}
+	const double megabytes = m_ByteCount / (1024.0 * 1024.0);
+	YGG_LOG_INFO("Output writer: {} files, {:.1f} MB in {:.2f} s ({:.1f} MB/s), {} failed", m_FileCount.load(),
+		megabytes, seconds, megabytes / std::max(seconds, 1e-9), m_FailureCount.load());
+	YGG_LOG_INFO("Output writer: producers blocked {:.2f} s, {} checkpoints took {:.2f} s", m_BlockedNanoseconds * 1e-9,
+		m_CheckpointCount.load(), m_SyncNanoseconds * 1e-9);
+}
+
+void OutputWriter::Run()
+{
+	// Staging for direct I/O, kept across files so it is only allocated once per thread.
+	std::vector<uint8_t> alignedBuffer;
+	Request				 request;
+	while (m_Requests.Pop(request))
+	{
+		const bool				 written = WriteFile(request, alignedBuffer);
+		std::vector<std::string> checkpoint;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_PendingBytes -= request.Data.size();
+			m_PendingFiles--;
+			m_LastWrite = Clock::now();
+			if (written)
+			{
+				m_FileCount++;
+				m_ByteCount += request.Data.size();
+				if (m_Specification.SyncInterval > 0)
+				{
+					m_UnsyncedPaths.push_back(std::move(request.Path));
+					if (m_UnsyncedPaths.size() >= m_Specification.SyncInterval)
+					{
+						checkpoint.swap(m_UnsyncedPaths);
+						m_ActiveCheckpoints++;
+					}
+				}
+			}
+			else
+				m_FailureCount++;
+		}
+		m_SpaceCondition.notify_all();
+
+		if (!checkpoint.empty())
+		{
+			Sync(checkpoint);
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_ActiveCheckpoints--;
+		}
+		m_IdleCondition.notify_all();
+	}
+}
+
+#if defined(E_PLATFORM_WINDOWS)
+bool OutputWriter::WriteFile(const Request& request, std::vector<uint8_t>&)
+{
+	std::FILE* file = std::fopen(request.Path.c_str(), "wb");
+	bool	   written = file && std::fwrite(request.Data.data(), 1, request.Data.size(), file) == request.Data.size();
+	if (file && std::fclose(file) != 0)
+		written = false;
+	if (!written)
+		YGG_LOG_ERROR("Writing '{}' failed: {}", request.Path, std::strerror(errno));
+	return written;
+}
+#else
+static bool WriteAll(int fd, const uint8_t* data, size_t size)
+{
+	while (size > 0)
+	{
+		const ssize_t count = ::write(fd, data, size);
+		if (count < 0 && errno == EINTR)
+			continue;
+		if (count <= 0)
+			return false;
+		data += count;
+		size -= (size_t)count;
+	}
+	return true;
+}
+
+bool OutputWriter::WriteFile(const Request& request, std::vector<uint8_t>& alignedBuffer)
+{
+	const bool direct = m_Specification.DirectIO && !m_DirectIOFailed;
+	int		   flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+	#if defined(O_DIRECT)
+	if (direct)
+		flags |= O_DIRECT;
+	#endif
+
+	const int fd = ::open(request.Path.c_str(), flags, 0644);
+	if (fd < 0 && direct && errno == EINVAL)
+	{
+		// tmpfs and some network filesystems refuse O_DIRECT.
+		if (!m_DirectIOFailed.exchange(true))
+			YGG_LOG_WARN("'{}' does not support direct I/O; writing through the page cache.", request.Path);
+		return WriteFile(request, alignedBuffer);
+	}
+	if (fd < 0)
+	{
+		YGG_LOG_ERROR("Cannot create '{}': {}", request.Path, std::strerror(errno));
+		return false;
+	}
+
+	const uint8_t* data = request.Data.data();
+	const size_t   size = request.Data.size();
+	size_t		   writeSize = size;
+	#if defined(O_DIRECT)
+	if (direct)
+	{
+		// O_DIRECT transfers whole, aligned blocks from an aligned buffer; the padding is cut off again below.
+		writeSize = (size + DirectIOAlignment - 1) / DirectIOAlignment * DirectIOAlignment;
+		alignedBuffer.resize(writeSize + DirectIOAlignment);
+		auto* aligned = reinterpret_cast<uint8_t*>(
+			(reinterpret_cast<uintptr_t>(alignedBuffer.data()) + DirectIOAlignment - 1) & ~(DirectIOAlignment - 1));
+		std::memcpy(aligned, data, size);
+		std::memset(aligned + size, 0, writeSize - size);
+		data = aligned;
+	}
+	#elif defined(E_PLATFORM_MACOS)
+	if (direct)
+		::fcntl(fd, F_NOCACHE, 1);
+	#endif
+
+	bool written = WriteAll(fd, data, writeSize);
+	if (!written && direct && errno == EINVAL)
+	{
+		::close(fd);
+		if (!m_DirectIOFailed.exchange(true))
+			YGG_LOG_WARN("'{}' does not support direct I/O; writing through the page cache.", request.Path);
+		return WriteFile(request, alignedBuffer);
+	}
+	if (written && writeSize != size)
+		written = ::ftruncate(fd, (off_t)size) == 0;
+	if (!written)
+		YGG_LOG_ERROR("Writing '{}' failed: {}", request.Path, std::strerror(errno));
+	if (::close(fd) != 0 && written)
+	{
+		YGG_LOG_ERROR("Writing '{}' failed: {}", request.Path, std::strerror(errno));
+		written = false;
+	}
+	return written;
+}
+#endif
+
+void OutputWriter::Sync(const std::vector<std::string>& paths)
+{
+	if (paths.empty())
+		return;
+	// Checkpoints from several threads would sync the same filesystems at once.
+	std::lock_guard<std::mutex> lock(m_SyncMutex);
+
+	const Clock::time_point start = Clock::now();
+#if defined(E_PLATFORM_LINUX)
+	// One syncfs per filesystem covers every file written to it, instead of an fsync per file.
+	std::unordered_set<std::string> directories;
+	std::unordered_set<dev_t>		devices;
+	for (const auto& path : paths)
+	{
+		std::string directory = std::filesystem::path(path).parent_path().string();
+		if (directory.empty())
+			directory = ".";
+		if (!directories.insert(directory).second)
+			continue;
+
+		const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (fd < 0)
+			continue;
+		struct stat status;
+		if (::fstat(fd, &status) == 0 && devices.insert(status.st_dev).second && ::syncfs(fd) != 0)
+			YGG_LOG_ERROR("Syncing the filesystem of '{}' failed: {}", directory, std::strerror(errno));
+		::close(fd);
+	}
+#elif defined(E_PLATFORM_WINDOWS)
+	for (const auto& path : paths)
+	{
+		const int fd = ::_open(path.c_str(), _O_RDWR | _O_BINARY);
+		if (fd < 0)
+			continue;
+		if (::_commit(fd) != 0)
+			YGG_LOG_ERROR("Syncing '{}' failed: {}", path, std::strerror(errno));
+		::_close(fd);
+	}
+#else
+	for (const auto& path : paths)
+	{
+		const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+			continue;
+		if (::fsync(fd) != 0)
+			YGG_LOG_ERROR("Syncing '{}' failed: {}", path, std::strerror(errno));
+		::close(fd);
+	}
+#endif
+	m_SyncNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+	m_CheckpointCount++;
+}
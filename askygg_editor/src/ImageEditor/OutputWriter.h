@@ -0,0 +1,88 @@
+#pragma once
+
+#include "askygg/core/BlockingQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct OutputWriterSpecification
+{
+	uint32_t ThreadCount = 2;
+	// Encoded bytes accepted but not yet written.  Write() blocks beyond this, which throttles the encoders to what
+	// the storage sustains instead of piling outputs up in memory.
+	uint64_t MaxPendingBytes = 256ull << 20;
+	// Bypasses the page cache (O_DIRECT on Linux, F_NOCACHE on macOS).  Filesystems that refuse it fall back to
+	// buffered writes.
+	bool DirectIO = false;
+	// Files between durability checkpoints, at which everything written since the last one is synced in one batch.
+	// 0 never syncs and leaves write-back to the OS.
+	uint32_t SyncInterval = 0;
+};
+
+// Writes encoded outputs to files on its own threads, so the GL threads only hand buffers over instead of waiting on
+// storage for every image.  Throughput, time the producers spent blocked on back-pressure and sync time are kept for
+// LogStatistics().
+class OutputWriter
+{
+public:
+	explicit OutputWriter(const OutputWriterSpecification& specification);
+	// Flushes what is still queued.
+	~OutputWriter();
+
+	OutputWriter(const OutputWriter&) = delete;
+	OutputWriter& operator=(const OutputWriter&) = delete;
+
+	// Queues data for path and returns; blocks only while MaxPendingBytes are waiting.  Safe from several threads.
+	void Write(std::string path, std::vector<uint8_t> data);
+	// Returns once everything queued so far is written and, with a SyncInterval, synced.
+	void Flush();
+
+	void LogStatistics() const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Request
+	{
+		std::string			 Path;
+		std::vector<uint8_t> Data;
+	};
+
+	void Run();
+	bool WriteFile(const Request& request, std::vector<uint8_t>& alignedBuffer);
+	// Syncs the files in paths, once per filesystem where the platform allows it.
+	void Sync(const std::vector<std::string>& paths);
+
+private:
+	OutputWriterSpecification	  m_Specification;
+	askygg::BlockingQueue<Request> m_Requests;
+	std::vector<std::thread>	  m_Threads;
+
+	// Back-pressure and Flush(): what has been queued but not yet written.
+	mutable std::mutex		 m_Mutex;
+	std::condition_variable	 m_SpaceCondition;
+	std::condition_variable	 m_IdleCondition;
+	uint64_t				 m_PendingBytes = 0;
+	uint64_t				 m_PendingFiles = 0;
+	// Written since the last checkpoint, and checkpoints writer threads are still syncing.
+	std::vector<std::string> m_UnsyncedPaths;
+	uint32_t				 m_ActiveCheckpoints = 0;
+	std::mutex				 m_SyncMutex;
+
+	std::atomic<bool>	  m_DirectIOFailed = false;
+	bool				  m_Started = false;
+	Clock::time_point	  m_FirstWrite;
+	Clock::time_point	  m_LastWrite;
+	std::atomic<uint64_t> m_FileCount = 0;
+	std::atomic<uint64_t> m_ByteCount = 0;
+	std::atomic<uint64_t> m_FailureCount = 0;
+	std::atomic<uint64_t> m_CheckpointCount = 0;
+	std::atomic<int64_t>  m_BlockedNanoseconds = 0;
+	std::atomic<int64_t>  m_SyncNanoseconds = 0;
+};
@@ -10,19 +10,18 @@ struct BarrelDistortionPassSettings
 class BarrelDistortionPass : public ImagePass
 {
 public:
-	explicit BarrelDistortionPass(std::string settingsFilePath);
-	uint32_t	GetOutputID() override { return m_BarrelDistortionOutput->GetID(); }
+	explicit BarrelDistortionPass(SettingsStore& settings);
 	std::string GetOutputName() override { return m_OutputName; }
 	void		Initialize() override;
 	void		Submit(uint32_t textureID) override;
 	void		DrawUI() override;
-	void		Save() override;
-	void		Load() override;
-	void		OnResize(const glm::vec2& targetSize) override;
-    bool        IsActive() override { return glm::length(m_Settings.DistortionStrength) > 0.0f; }
+	void		SaveSettings(YAML::Node& config) override;
+	void		LoadSettings(const YAML::Node& config) override;
+	uint64_t	GetSettingsHash() override { return HashSettings(m_Settings); }
+	SettingsBytes GetSettingsData() override { return GetSettingsBytes(m_Settings); }
+	const BarrelDistortionPassSettings& GetSettings() const { return m_Settings; }
 
 private:
 	std::string					   m_OutputName = "Barrel Distortion Output";
 	BarrelDistortionPassSettings   m_Settings;
-	askygg::Ref<askygg::Texture2D> m_BarrelDistortionOutput;
 };
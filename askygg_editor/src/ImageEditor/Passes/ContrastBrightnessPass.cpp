@@ -1,34 +1,17 @@
 #include "ContrastBrightnessPass.h"
-#include "askygg/core/Application.h"
+#ifndef YGG_PIPELINE_NO_UI
 #include "askygg/ui/PropertyDrawer.h"
 #include <imgui.h>
+#endif
 #include <yaml-cpp/yaml.h>
-#include <fstream>
 #include <utility>
 
-ContrastBrightnessPass::ContrastBrightnessPass(std::string settingsFilePath)
-	: ImagePass(std::move(settingsFilePath)) {}
+ContrastBrightnessPass::ContrastBrightnessPass(SettingsStore& settings)
+	: ImagePass(settings) {}
 
 void ContrastBrightnessPass::Initialize()
 {
 	m_Shader = askygg::ShaderLibrary::Get("ContrastAdjust");
-	const auto& Window = askygg::Application::GetWindow();
-
-	askygg::Texture2DSpecification ContrastTextureSpec = {
-		askygg::ImageUtils::WrapMode::ClampToEdge,
-		askygg::ImageUtils::WrapMode::ClampToEdge,
-		askygg::ImageUtils::FilterMode::Linear,
-		askygg::ImageUtils::FilterMode::Linear,
-		askygg::ImageUtils::ImageInternalFormat::RGBA32F,
-		askygg::ImageUtils::ImageDataLayout::RGBA,
-		askygg::ImageUtils::ImageDataType::Float,
-		Window.GetWidth(),
-		Window.GetHeight()
-	};
-
-	ContrastTextureSpec.Name = m_OutputName;
-	m_ContrastBrightnessOutput = askygg::CreateRef<askygg::Texture2D>(ContrastTextureSpec);
-	askygg::TextureLibrary::AddTexture2D(m_ContrastBrightnessOutput);
 }
 
 void ContrastBrightnessPass::Submit(uint32_t textureID)
@@ -39,16 +22,14 @@ void ContrastBrightnessPass::Submit(uint32_t textureID)
 	m_Shader->UploadUniformFloat("u_ContrastStrength", m_Settings.ContrastStrength);
 	m_Shader->UploadUniformFloat("u_Brightness", m_Settings.Brightness);
 
-	glm::vec2 textureSize = { m_ContrastBrightnessOutput->GetWidth(),
-		m_ContrastBrightnessOutput->GetHeight() };
+	glm::vec2 textureSize = { m_Output->GetWidth(), m_Output->GetHeight() };
 	auto	  workGroupsX = (uint32_t)glm::ceil((float)textureSize.x / (float)m_WorkGroupSize);
 	auto	  workGroupsY = (uint32_t)glm::ceil((float)textureSize.y / (float)m_WorkGroupSize);
 
-	m_ContrastBrightnessOutput->BindToImageSlot(0, 0,
+	m_Output->BindToImageSlot(0, 0,
 		askygg::ImageUtils::TextureAccessLevel::WriteOnly,
 		askygg::ImageUtils::TextureShaderDataFormat::RGBA32F);
-	m_Shader->DispatchCompute(workGroupsX, workGroupsY, 1);
-	m_Shader->EnableShaderImageAccessBarrierBit();
+	Dispatch(workGroupsX, workGroupsY);
 
 	askygg::Texture2D::ClearBinding();
 	m_Shader->Unbind();
@@ -56,6 +37,7 @@ void ContrastBrightnessPass::Submit(uint32_t textureID)
 
 void ContrastBrightnessPass::DrawUI()
 {
+#ifndef YGG_PIPELINE_NO_UI
 	if (ImGui::CollapsingHeader("Contrast & Brightness Settings"))
 	{
 		askygg::UI::UIFloat::Draw("Contrast Strength", &m_Settings.ContrastStrength);
@@ -64,21 +46,17 @@ void ContrastBrightnessPass::DrawUI()
 		if (ImGui::Button("Save Contrast & Brightness Settings"))
 			Save();
 	}
+#endif
 }
 
-void ContrastBrightnessPass::Save()
+void ContrastBrightnessPass::SaveSettings(YAML::Node& config)
 {
-	YAML::Node existingConfig;
-	existingConfig = YAML::LoadFile(m_SettingsFilePath);
-	existingConfig["Contrast & Brightness"]["Contrast Strength"] = m_Settings.ContrastStrength;
-	existingConfig["Contrast & Brightness"]["Brightness"] = m_Settings.Brightness;
-	std::ofstream outFile(m_SettingsFilePath);
-	outFile << existingConfig;
+	config["Contrast & Brightness"]["Contrast Strength"] = m_Settings.ContrastStrength;
+	config["Contrast & Brightness"]["Brightness"] = m_Settings.Brightness;
 }
 
-void ContrastBrightnessPass::Load()
+void ContrastBrightnessPass::LoadSettings(const YAML::Node& config)
 {
-	YAML::Node config = YAML::LoadFile(m_SettingsFilePath);
 	m_Settings.ContrastStrength =
 		config["Contrast & Brightness"]["Contrast Strength"]
 		? config["Contrast & Brightness"]["Contrast Strength"].as<float>()
@@ -87,11 +65,3 @@ void ContrastBrightnessPass::Load()
 		? config["Contrast & Brightness"]["Brightness"].as<float>()
 		: 0.0f;
 }
-
-void ContrastBrightnessPass::OnResize(const glm::vec2& targetSize)
-{
-	if (m_OutputSize == targetSize)
-		return;
-	ImagePass::OnResize(targetSize);
-	m_ContrastBrightnessOutput->Resize(targetSize.x, targetSize.y);
-}
@@ -1,34 +1,17 @@
 #include "HSVAdjustmentPass.h"
-#include "askygg/core/Application.h"
+#ifndef YGG_PIPELINE_NO_UI
 #include "askygg/ui/PropertyDrawer.h"
 #include <imgui.h>
+#endif
 #include <yaml-cpp/yaml.h>
-#include <fstream>
 #include <utility>
 
-HSVAdjustmentPass::HSVAdjustmentPass(std::string settingsFilePath)
-	: ImagePass(std::move(settingsFilePath)) {}
+HSVAdjustmentPass::HSVAdjustmentPass(SettingsStore& settings)
+	: ImagePass(settings) {}
 
 void HSVAdjustmentPass::Initialize()
 {
 	m_Shader = askygg::ShaderLibrary::Get("HSVAdjust");
-	const auto& Window = askygg::Application::GetWindow();
-
-	askygg::Texture2DSpecification SharpenTextureSpec = {
-		askygg::ImageUtils::WrapMode::ClampToEdge,
-		askygg::ImageUtils::WrapMode::ClampToEdge,
-		askygg::ImageUtils::FilterMode::Linear,
-		askygg::ImageUtils::FilterMode::Linear,
-		askygg::ImageUtils::ImageInternalFormat::RGBA32F,
-		askygg::ImageUtils::ImageDataLayout::RGBA,
-		askygg::ImageUtils::ImageDataType::Float,
-		Window.GetWidth(),
-		Window.GetHeight()
-	};
-
-	SharpenTextureSpec.Name = m_OutputName;
-	m_HSVOutput = askygg::CreateRef<askygg::Texture2D>(SharpenTextureSpec);
-	askygg::TextureLibrary::AddTexture2D(m_HSVOutput);
 }
 
 void HSVAdjustmentPass::Submit(uint32_t textureID)
@@ -45,14 +28,13 @@ void HSVAdjustmentPass::Submit(uint32_t textureID)
 	m_Shader->UploadUniformFloat("u_SaturationBoost", m_Settings.SaturationBoost);
 	m_Shader->UploadUniformFloat("u_ValueBoost", m_Settings.ValueBoost);
 
-	glm::vec2 textureSize = { m_HSVOutput->GetWidth(), m_HSVOutput->GetHeight() };
+	glm::vec2 textureSize = { m_Output->GetWidth(), m_Output->GetHeight() };
 	auto	  workGroupsX = (uint32_t)glm::ceil((float)textureSize.x / (float)m_WorkGroupSize);
 	auto	  workGroupsY = (uint32_t)glm::ceil((float)textureSize.y / (float)m_WorkGroupSize);
 
-	m_HSVOutput->BindToImageSlot(0, 0, askygg::ImageUtils::TextureAccessLevel::WriteOnly,
+	m_Output->BindToImageSlot(0, 0, askygg::ImageUtils::TextureAccessLevel::WriteOnly,
 		askygg::ImageUtils::TextureShaderDataFormat::RGBA32F);
-	m_Shader->DispatchCompute(workGroupsX, workGroupsY, 1);
-	m_Shader->EnableShaderImageAccessBarrierBit();
+	Dispatch(workGroupsX, workGroupsY);
 
 	askygg::Texture2D::ClearBinding();
 	m_Shader->Unbind();
@@ -60,6 +42,7 @@ void HSVAdjustmentPass::Submit(uint32_t textureID)
 
 void HSVAdjustmentPass::DrawUI()
 {
+#ifndef YGG_PIPELINE_NO_UI
 	if (ImGui::CollapsingHeader("Hue Shift Settings"))
 	{
 		askygg::UI::UIFloat::Draw("Hue Shift Amount", &m_Settings.HueShift);
@@ -68,22 +51,18 @@ void HSVAdjustmentPass::DrawUI()
 		if (ImGui::Button("Save Hue Shift Settings"))
 			Save();
 	}
+#endif
 }
 
-void HSVAdjustmentPass::Save()
+void HSVAdjustmentPass::SaveSettings(YAML::Node& config)
 {
-	YAML::Node existingConfig;
-	existingConfig = YAML::LoadFile(m_SettingsFilePath);
-	existingConfig["Hue Shift"]["Hue Shift Amount"] = m_Settings.HueShift;
-	existingConfig["Hue Shift"]["Saturation Boost Amount"] = m_Settings.SaturationBoost;
-	existingConfig["Hue Shift"]["Value Boost Amount"] = m_Settings.ValueBoost;
-	std::ofstream outFile(m_SettingsFilePath);
-	outFile << existingConfig;
+	config["Hue Shift"]["Hue Shift Amount"] = m_Settings.HueShift;
+	config["Hue Shift"]["Saturation Boost Amount"] = m_Settings.SaturationBoost;
+	config["Hue Shift"]["Value Boost Amount"] = m_Settings.ValueBoost;
 }
 
-void HSVAdjustmentPass::Load()
+void HSVAdjustmentPass::LoadSettings(const YAML::Node& config)
 {
-	YAML::Node config = YAML::LoadFile(m_SettingsFilePath);
 	m_Settings.HueShift = config["Hue Shift"]["Hue Shift Amount"]
 		? config["Hue Shift"]["Hue Shift Amount"].as<float>()
 		: 0.0f;
@@ -94,11 +73,3 @@ void HSVAdjustmentPass::Load()
 		? config["Hue Shift"]["Value Boost Amount"].as<float>()
 		: 0.0f;
 }
-
-void HSVAdjustmentPass::OnResize(const glm::vec2& targetSize)
-{
-	if (m_OutputSize == targetSize)
-		return;
-	ImagePass::OnResize(targetSize);
-	m_HSVOutput->Resize(targetSize.x, targetSize.y);
-}
@@ -12,18 +12,18 @@ struct HSVAdjustmentSettings
 class HSVAdjustmentPass : public ImagePass
 {
 public:
-	explicit HSVAdjustmentPass(std::string settingsFilePath);
-	uint32_t	GetOutputID() override { return m_HSVOutput->GetID(); }
+	explicit HSVAdjustmentPass(SettingsStore& settings);
 	std::string GetOutputName() override { return m_OutputName; }
 	void		Initialize() override;
 	void		Submit(uint32_t textureID) override;
 	void		DrawUI() override;
-	void		Save() override;
-	void		Load() override;
-	void		OnResize(const glm::vec2& targetSize) override;
+	void		SaveSettings(YAML::Node& config) override;
+	void		LoadSettings(const YAML::Node& config) override;
+	uint64_t	GetSettingsHash() override { return HashSettings(m_Settings); }
+	SettingsBytes GetSettingsData() override { return GetSettingsBytes(m_Settings); }
+	const HSVAdjustmentSettings& GetSettings() const { return m_Settings; }
 
 private:
 	std::string					   m_OutputName = "HSV Output";
 	HSVAdjustmentSettings		   m_Settings;
-	askygg::Ref<askygg::Texture2D> m_HSVOutput;
 };
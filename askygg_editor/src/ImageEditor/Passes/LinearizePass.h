@@ -5,17 +5,15 @@
 class LinearizePass : public ImagePass
 {
 public:
-	explicit LinearizePass(std::string settingsFilePath);
-	uint32_t	GetOutputID() override { return m_Output->GetID(); }
+	explicit LinearizePass(SettingsStore& settings);
 	std::string GetOutputName() override { return m_OutputName; }
 	void		Initialize() override;
 	void		Submit(uint32_t textureID) override;
 	void		DrawUI() override {}
-	void		Save() override {}
-	void		Load() override {}
-	void		OnResize(const glm::vec2& targetSize) override;
+	void		SaveSettings(YAML::Node&) override {}
+	void		LoadSettings(const YAML::Node& config) override {}
+	uint64_t	GetSettingsHash() override { return 0; }
 
 private:
 	std::string					   m_OutputName = "Linearize Output";
-	askygg::Ref<askygg::Texture2D> m_Output;
 };
@@ -1,20 +1,24 @@
 #include "MultiPassBloomPass.h"
-#include "askygg/core/Application.h"
-#include "askygg/ui/PropertyDrawer.h"
+#include "askygg/renderer/RenderCommand.h"
 #include "askygg/platform/PlatformPath.h"
+#ifndef YGG_PIPELINE_NO_UI
+#include "askygg/ui/PropertyDrawer.h"
 #include <imgui.h>
+#endif
 #include <yaml-cpp/yaml.h>
-#include <fstream>
 
-MultiPassBloomPass::MultiPassBloomPass(std::string settingsFilePath)
-	: ImagePass(std::move(settingsFilePath)) {}
+MultiPassBloomPass::MultiPassBloomPass(SettingsStore& settings)
+	: ImagePass(settings) {}
 
 void MultiPassBloomPass::Initialize()
 {
 	m_Shader = askygg::ShaderLibrary::Get("MultiPassBloom");
+}
 
-	const glm::vec2 WindowDimensions = { askygg::Application::GetWindow().GetWidth(),
-		askygg::Application::GetWindow().GetHeight() };
+// The down/up-sample chain needs mips and half-res storage, so unlike the other passes these targets stay owned by the
+// pass.  They are only created once the pass is first resized for a submit and are dropped when it is deactivated.
+void MultiPassBloomPass::CreateTargets()
+{
 	uint32_t		halfWidth = m_OutputSize.x / 2;
 	uint32_t		halfHeight = m_OutputSize.y / 2;
 	halfWidth += m_WorkGroupSize - halfWidth % m_WorkGroupSize;
@@ -41,6 +45,37 @@ void MultiPassBloomPass::Initialize()
 	m_BloomComputeTextures[2] = askygg::CreateRef<askygg::Texture2D>(BloomTextureSpecification);
 
 	askygg::TextureLibrary::AddTexture2D(m_BloomComputeTextures[2]);
+	m_Output = m_BloomComputeTextures[2];
+}
+
+void MultiPassBloomPass::ReleaseTargets()
+{
+	if (m_BloomComputeTextures.empty())
+		return;
+
+	askygg::TextureRegistry::Release(m_BloomComputeTextures[2]->GetHandle());
+	m_BloomComputeTextures.clear();
+	m_Output = nullptr;
+}
+
+uint64_t MultiPassBloomPass::GetOwnedMemorySize()
+{
+	uint64_t size = 0;
+	for (const auto& texture : m_BloomComputeTextures)
+		size += texture->GetMemorySize();
+	return size;
+}
+
+askygg::RenderGraphResource MultiPassBloomPass::Declare(askygg::RenderGraphBuilder& builder, askygg::RenderGraphResource input)
+{
+	m_InputResource = builder.Read(input, askygg::RenderGraphAccess::Sampled);
+	m_OutputResource = builder.Write(builder.Import(m_OutputName, m_BloomComputeTextures[2]));
+	return m_OutputResource;
+}
+
+void MultiPassBloomPass::Execute(const askygg::RenderGraph& graph)
+{
+	Submit(graph.GetTextureID(m_InputResource));
 }
 
 void MultiPassBloomPass::Submit(uint32_t textureID)
@@ -73,8 +108,8 @@ void MultiPassBloomPass::Submit(uint32_t textureID)
 			0, 0, askygg::ImageUtils::TextureAccessLevel::WriteOnly,
 			askygg::ImageUtils::TextureShaderDataFormat::RGBA32F);
 
-		m_Shader->DispatchCompute(workGroupsX, workGroupsY, 1);
-		m_Shader->EnableShaderImageAccessBarrierBit();
+		Dispatch(workGroupsX, workGroupsY);
+		askygg::RenderCommand::InsertMemoryBarrier(askygg::MemoryBarrierFlag::TextureFetch);
 		askygg::Texture2D::ClearBinding();
 	}
 	//------------------ PREFILTER -----------------//
@@ -100,8 +135,8 @@ void MultiPassBloomPass::Submit(uint32_t textureID)
 			m_Shader->UploadUniformInt("u_Texture", 0);
 			m_Shader->UploadUniformInt("u_Mode", bloomConstants.Mode);
 			m_Shader->UploadUniformFloat("u_LOD", bloomConstants.LOD);
-			m_Shader->DispatchCompute(workGroupsX, workGroupsY, 1);
-			m_Shader->EnableShaderImageAccessBarrierBit();
+			Dispatch(workGroupsX, workGroupsY);
+			askygg::RenderCommand::InsertMemoryBarrier(askygg::MemoryBarrierFlag::TextureFetch);
 		}
 
 		{
@@ -116,8 +151,8 @@ void MultiPassBloomPass::Submit(uint32_t textureID)
 			m_Shader->UploadUniformInt("u_Texture", 0);
 			m_Shader->UploadUniformInt("u_Mode", bloomConstants.Mode);
 			m_Shader->UploadUniformFloat("u_LOD", bloomConstants.LOD);
-			m_Shader->DispatchCompute(workGroupsX, workGroupsY, 1);
-			m_Shader->EnableShaderImageAccessBarrierBit();
+			Dispatch(workGroupsX, workGroupsY);
+			askygg::RenderCommand::InsertMemoryBarrier(askygg::MemoryBarrierFlag::TextureFetch);
 		}
 	}
 	//------------------ DOWNSAMPLE -----------------//
@@ -142,8 +177,8 @@ void MultiPassBloomPass::Submit(uint32_t textureID)
 		auto [mipWidth, mipHeight] = m_BloomComputeTextures[2]->GetMipSize(mips - 2);
 		workGroupsX = (uint32_t)glm::ceil((float)mipWidth / (float)m_WorkGroupSize);
 		workGroupsY = (uint32_t)glm::ceil((float)mipHeight / (float)m_WorkGroupSize);
-		m_Shader->DispatchCompute(workGroupsX, workGroupsY, 1);
-		m_Shader->EnableShaderImageAccessBarrierBit();
+		Dispatch(workGroupsX, workGroupsY);
+		askygg::RenderCommand::InsertMemoryBarrier(askygg::MemoryBarrierFlag::TextureFetch);
 	}
 	//------------------ UPSAMPLE_FIRST -----------------//
 
@@ -159,7 +194,6 @@ void MultiPassBloomPass::Submit(uint32_t textureID)
 			bloomConstants.LOD = mip;
 
 			// Write to 2
-			m_Shader->EnableShaderImageAccessBarrierBit();
 			m_BloomComputeTextures[2]->BindToImageSlot(
 				0, mip, askygg::ImageUtils::TextureAccessLevel::WriteOnly,
 				askygg::ImageUtils::TextureShaderDataFormat::RGBA32F);
@@ -172,8 +206,10 @@ void MultiPassBloomPass::Submit(uint32_t textureID)
 			m_Shader->UploadUniformFloat("u_LOD", bloomConstants.LOD);
             m_Shader->UploadUniformFloat("u_Radius", m_Settings.Radius);
             m_Shader->UploadUniformFloat("u_UpsampleTightenFactor", m_Settings.UpsampleTightenFactor);
-			m_Shader->DispatchCompute(workGroupsX, workGroupsY, 1);
-			m_Shader->EnableShaderImageAccessBarrierBit();
+			Dispatch(workGroupsX, workGroupsY);
+			// The next (larger) mip samples this one; the graph covers the read of mip 0.
+			if (mip > 0)
+				askygg::RenderCommand::InsertMemoryBarrier(askygg::MemoryBarrierFlag::TextureFetch);
 		}
 	}
 	//------------------ UPSAMPLE -----------------//
@@ -184,6 +220,7 @@ void MultiPassBloomPass::Submit(uint32_t textureID)
 
 void MultiPassBloomPass::DrawUI()
 {
+#ifndef YGG_PIPELINE_NO_UI
 	if (ImGui::CollapsingHeader("Multi-Pass Bloom Settings"))
 	{
         askygg::UI::UIFloat::Draw("Threshold", &m_Settings.BloomThreshold);
@@ -192,7 +229,7 @@ void MultiPassBloomPass::DrawUI()
         askygg::UI::UIFloat::Draw("Tighten Factor", &m_Settings.UpsampleTightenFactor);
         askygg::UI::UIBool::Draw("Display Compute Textures", &m_Settings.DisplayBloomDebug);
 
-        if (m_Settings.DisplayBloomDebug)
+        if (m_Settings.DisplayBloomDebug && !m_BloomComputeTextures.empty())
         {
             float aspect = (float)m_OutputSize.x / (float)m_OutputSize.y;
             ImGui::Image(reinterpret_cast<ImTextureID>(m_BloomComputeTextures[0]->GetID()),
@@ -206,23 +243,19 @@ void MultiPassBloomPass::DrawUI()
 		if (ImGui::Button("Save Multi-Pass Bloom Settings"))
 			Save();
 	}
+#endif
 }
 
-void MultiPassBloomPass::Save()
+void MultiPassBloomPass::SaveSettings(YAML::Node& config)
 {
-	YAML::Node existingConfig;
-	existingConfig = YAML::LoadFile(m_SettingsFilePath);
-	existingConfig["MultiPassBloom"]["Threshold"] = m_Settings.BloomThreshold;
-	existingConfig["MultiPassBloom"]["Knee"] = m_Settings.BloomKnee;
-	existingConfig["MultiPassBloom"]["Radius"] = m_Settings.Radius;
-	existingConfig["MultiPassBloom"]["Upsample Tighten Factor"] = m_Settings.UpsampleTightenFactor;
-	std::ofstream outFile(m_SettingsFilePath);
-	outFile << existingConfig;
+	config["MultiPassBloom"]["Threshold"] = m_Settings.BloomThreshold;
+	config["MultiPassBloom"]["Knee"] = m_Settings.BloomKnee;
+	config["MultiPassBloom"]["Radius"] = m_Settings.Radius;
+	config["MultiPassBloom"]["Upsample Tighten Factor"] = m_Settings.UpsampleTightenFactor;
 }
 
-void MultiPassBloomPass::Load()
+void MultiPassBloomPass::LoadSettings(const YAML::Node& config)
 {
-	YAML::Node config = YAML::LoadFile(m_SettingsFilePath);
 	m_Settings.BloomThreshold = config["MultiPassBloom"]["Threshold"] ? config["MultiPassBloom"]["Threshold"].as<float>() : 2.0f;
 	m_Settings.BloomKnee = config["MultiPassBloom"]["Knee"] ? config["MultiPassBloom"]["Knee"].as<float>() : 0.2f;
 	m_Settings.Radius = config["MultiPassBloom"]["Radius"] ? config["MultiPassBloom"]["Radius"].as<float>() : 1.0f;
@@ -231,10 +264,16 @@ void MultiPassBloomPass::Load()
 
 void MultiPassBloomPass::OnResize(const glm::vec2& targetSize)
 {
-	if (m_OutputSize == targetSize)
+	if (!m_BloomComputeTextures.empty() && m_OutputSize == targetSize)
 		return;
 
 	ImagePass::OnResize(targetSize);
+	if (m_BloomComputeTextures.empty())
+	{
+		CreateTargets();
+		return;
+	}
+
 	uint32_t halfWidth = targetSize.x / 2;
 	uint32_t halfHeight = targetSize.y / 2;
 	halfWidth += m_WorkGroupSize - halfWidth % m_WorkGroupSize;
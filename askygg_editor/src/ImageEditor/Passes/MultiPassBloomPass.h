@@ -14,17 +14,26 @@ struct MultiPassBloomSettings
 class MultiPassBloomPass : public ImagePass
 {
 public:
-	explicit MultiPassBloomPass(std::string settingsFilePath);
+	explicit MultiPassBloomPass(SettingsStore& settings);
 
-	uint32_t	   GetOutputID() override { return m_BloomComputeTextures[2]->GetID(); }
 	std::string	   GetOutputName() override { return m_OutputName; }
 
 	void Initialize() override;
+	askygg::RenderGraphResource Declare(askygg::RenderGraphBuilder& builder, askygg::RenderGraphResource input) override;
+	void Execute(const askygg::RenderGraph& graph) override;
 	void Submit(uint32_t textureID) override;
 	void DrawUI() override;
-	void Save() override;
-	void Load() override;
+	void SaveSettings(YAML::Node& config) override;
+	void LoadSettings(const YAML::Node& config) override;
+	uint64_t GetSettingsHash() override { return HashSettings(m_Settings); }
+	SettingsBytes GetSettingsData() override { return GetSettingsBytes(m_Settings); }
+	const MultiPassBloomSettings& GetSettings() const { return m_Settings; }
 	void OnResize(const glm::vec2& targetSize) override;
+	void ReleaseTargets() override;
+	uint64_t GetOwnedMemorySize() override;
+
+private:
+	void CreateTargets();
 
 private:
 	std::string									m_OutputName = "Multi-Pass Bloom Output";
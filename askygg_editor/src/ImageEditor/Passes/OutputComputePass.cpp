@@ -1,18 +1,17 @@
-#include <fstream>
 #include <chrono>
 #include "OutputComputePass.h"
-#include "askygg/core/Application.h"
+#ifndef YGG_PIPELINE_NO_UI
 #include "askygg/ui/PropertyDrawer.h"
 #include "imgui.h"
+#endif
 #include "platform/PlatformPath.h"
 
-OutputComputePass::OutputComputePass(std::string settingsFilePath)
-	: ImagePass(std::move(settingsFilePath)) {}
+OutputComputePass::OutputComputePass(SettingsStore& settings)
+	: ImagePass(settings) {}
 
 void OutputComputePass::Initialize()
 {
 	m_Shader = askygg::ShaderLibrary::Get("OutputPass");
-	const auto& Window = askygg::Application::GetWindow();
 
     askygg::Texture2DSpecification fileTextureSpec = {
             askygg::ImageUtils::WrapMode::Repeat,
@@ -40,8 +39,8 @@ void OutputComputePass::Initialize()
 		askygg::ImageUtils::ImageInternalFormat::RGBA8,
 		askygg::ImageUtils::ImageDataLayout::RGBA,
 		askygg::ImageUtils::ImageDataType::UByte,
-		Window.GetWidth(),
-		Window.GetHeight()
+		(uint32_t)m_OutputSize.x,
+		(uint32_t)m_OutputSize.y
 	};
 
     OutputComputeTextureSpec.Name = m_OutputName;
@@ -52,16 +51,44 @@ void OutputComputePass::Initialize()
 }
 
 
+void OutputComputePass::SetOutputFormat(askygg::ImageUtils::ImageInternalFormat format)
+{
+	askygg::Texture2DSpecification spec = m_ByteOutput->GetSpecification();
+	if (spec.InternalFormat == format)
+		return;
+
+	spec.InternalFormat = format;
+	spec.DataType = format == askygg::ImageUtils::ImageInternalFormat::RGBA16
+		? askygg::ImageUtils::ImageDataType::UShort : askygg::ImageUtils::ImageDataType::UByte;
+	askygg::TextureRegistry::Release(m_ByteOutput->GetHandle());
+	m_ByteOutput = askygg::CreateRef<askygg::Texture2D>(spec);
+	askygg::TextureLibrary::AddTexture2D(m_ByteOutput);
+}
+
+askygg::RenderGraphResource OutputComputePass::Declare(askygg::RenderGraphBuilder& builder, askygg::RenderGraphResource input)
+{
+	m_InputResource = builder.Read(input, askygg::RenderGraphAccess::ImageLoad);
+	if (m_BloomResource != askygg::InvalidRenderGraphResource)
+		builder.Read(m_BloomResource, askygg::RenderGraphAccess::Sampled);
+	// The byte output outlives the graph (display, capture), so it is imported rather than pooled.
+	m_OutputResource = builder.Write(builder.Import(m_OutputName, m_ByteOutput));
+	return m_OutputResource;
+}
+
+void OutputComputePass::Execute(const askygg::RenderGraph& graph)
+{
+	m_BloomTextureID = m_BloomResource != askygg::InvalidRenderGraphResource ? graph.GetTextureID(m_BloomResource) : 0;
+	Submit(graph.GetTextureID(m_InputResource));
+}
+
 void OutputComputePass::Submit(uint32_t textureID)
 {
-    auto current_time = std::chrono::high_resolution_clock::now();
-    auto elapsed = std::chrono::duration<float>(current_time - m_Start).count();
+    // Every tile of a progressive render gets the same noise frame, or the tiles would not line up.
+    if (!IsResumingDispatch())
+        m_Time = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - m_Start).count();
 
     m_Shader->Bind();
-    std::string bloomOutputName = m_Settings.ActiveBloomType == BloomType::Radial ? "Radial Bloom Output" : "Multi-Pass Bloom Output";
-	uint32_t bloomTextureID = askygg::TextureLibrary::GetIDFromName(bloomOutputName);
-
-	askygg::TextureLibrary::BindTextureToSlot(bloomTextureID, 0);
+	askygg::TextureLibrary::BindTextureToSlot(m_BloomTextureID, 0);
 	m_Shader->UploadUniformInt("u_BloomTexture", 0);
 	askygg::TextureLibrary::BindTextureToSlot(m_BloomDirtTexture->GetID(), 1);
 	m_Shader->UploadUniformInt("u_BloomDirtTexture", 1);
@@ -77,7 +104,7 @@ void OutputComputePass::Submit(uint32_t textureID)
     m_Shader->UploadUniformFloat("u_NoiseGamma", m_Settings.NoiseGamma);
     m_Shader->UploadUniformFloat("u_NoiseFrequency", m_Settings.NoiseFrequency);
     m_Shader->UploadUniformFloat("u_NoiseAmplitude", m_Settings.NoiseAmplitude);
-    m_Shader->UploadUniformFloat("u_Time", elapsed);
+    m_Shader->UploadUniformFloat("u_Time", m_Time);
 
     m_Shader->UploadUniformInt("u_BloomType", static_cast<int>(m_Settings.ActiveBloomType) * -1);
     m_Shader->UploadUniformInt("u_BloomEnabled", m_Settings.ActiveBloomType != BloomType::None ? 1 : 0);
@@ -90,11 +117,11 @@ void OutputComputePass::Submit(uint32_t textureID)
 	auto	  workGroupsX = (uint32_t)glm::ceil((float)textureSize.x / (float)m_WorkGroupSize);
 	auto	  workGroupsY = (uint32_t)glm::ceil((float)textureSize.y / (float)m_WorkGroupSize);
 
-	auto& fInputTexture = askygg::TextureLibrary::Get2DFromID(textureID);
-	fInputTexture.BindToImageSlot(0, 0, askygg::ImageUtils::TextureAccessLevel::ReadOnly,askygg::ImageUtils::TextureShaderDataFormat::RGBA32F);
-	m_ByteOutput->BindToImageSlot(1, 0, askygg::ImageUtils::TextureAccessLevel::WriteOnly,askygg::ImageUtils::TextureShaderDataFormat::RGBA8);
-	m_Shader->DispatchCompute(workGroupsX, workGroupsY, 1);
-	m_Shader->EnableShaderImageAccessBarrierBit();
+	askygg::Texture2D::BindTextureIDToImageSlot(textureID, 0, 0, askygg::ImageUtils::TextureAccessLevel::ReadOnly, askygg::ImageUtils::TextureShaderDataFormat::RGBA32F);
+	const auto outputFormat = m_ByteOutput->GetSpecification().InternalFormat == askygg::ImageUtils::ImageInternalFormat::RGBA16
+		? askygg::ImageUtils::TextureShaderDataFormat::RGBA16 : askygg::ImageUtils::TextureShaderDataFormat::RGBA8;
+	m_ByteOutput->BindToImageSlot(1, 0, askygg::ImageUtils::TextureAccessLevel::WriteOnly, outputFormat);
+	Dispatch(workGroupsX, workGroupsY);
 
 	askygg::Texture2D::ClearBinding();
 	m_Shader->Unbind();
@@ -102,6 +129,7 @@ void OutputComputePass::Submit(uint32_t textureID)
 
 void OutputComputePass::DrawUI()
 {
+#ifndef YGG_PIPELINE_NO_UI
 	if (ImGui::CollapsingHeader("Composite Pass Settings"))
 	{
 		askygg::UI::UIFloat::Draw("Exposure", &m_Settings.Exposure);
@@ -149,35 +177,30 @@ void OutputComputePass::DrawUI()
         if (ImGui::Button("Save Composite Pass Settings"))
 			Save();
 	}
+#endif
 }
 
-void OutputComputePass::Save()
+void OutputComputePass::SaveSettings(YAML::Node& config)
 {
-	YAML::Node existingConfig;
-	existingConfig = YAML::LoadFile(m_SettingsFilePath);
-	existingConfig["Output"]["Exposure"] = m_Settings.Exposure;
-	existingConfig["Output"]["Tonemapper"] = static_cast<int>(m_Settings.Tonemap);
-	existingConfig["Output"]["WhitePoint"] = m_Settings.WhitePoint;
-
-    existingConfig["Output"]["Sensor Noise Alpha"] = m_Settings.NoiseAlpha;
-    existingConfig["Output"]["Sensor Noise Beta"] = m_Settings.NoiseBeta;
-    existingConfig["Output"]["Sensor Noise Gamma"] = m_Settings.NoiseGamma;
-
-    existingConfig["Output"]["Sensor Offset Perlin Frequency"] = m_Settings.NoiseFrequency;
-    existingConfig["Output"]["Sensor Offset Perlin Amplitude"] = m_Settings.NoiseAmplitude;
-
-    existingConfig["Output"]["Bloom Intensity"] = m_Settings.BloomIntensity;
-    existingConfig["Output"]["Bloom Dirt Intensity"] = m_Settings.BloomDirtIntensity;
-    existingConfig["Output"]["Bloom Upsample Radius"] = m_Settings.BloomUpsampleRadius;
-    existingConfig["Output"]["Bloom Upsample Tighten Factor"] = m_Settings.BloomUpsampleTightenFactor;
-
-	std::ofstream outFile(m_SettingsFilePath);
-	outFile << existingConfig;
+	config["Output"]["Exposure"] = m_Settings.Exposure;
+	config["Output"]["Tonemapper"] = static_cast<int>(m_Settings.Tonemap);
+	config["Output"]["WhitePoint"] = m_Settings.WhitePoint;
+
+    config["Output"]["Sensor Noise Alpha"] = m_Settings.NoiseAlpha;
+    config["Output"]["Sensor Noise Beta"] = m_Settings.NoiseBeta;
+    config["Output"]["Sensor Noise Gamma"] = m_Settings.NoiseGamma;
+
+    config["Output"]["Sensor Offset Perlin Frequency"] = m_Settings.NoiseFrequency;
+    config["Output"]["Sensor Offset Perlin Amplitude"] = m_Settings.NoiseAmplitude;
+
+    config["Output"]["Bloom Intensity"] = m_Settings.BloomIntensity;
+    config["Output"]["Bloom Dirt Intensity"] = m_Settings.BloomDirtIntensity;
+    config["Output"]["Bloom Upsample Radius"] = m_Settings.BloomUpsampleRadius;
+    config["Output"]["Bloom Upsample Tighten Factor"] = m_Settings.BloomUpsampleTightenFactor;
 }
 
-void OutputComputePass::Load()
+void OutputComputePass::LoadSettings(const YAML::Node& config)
 {
-	YAML::Node config = YAML::LoadFile(m_SettingsFilePath);
 	m_Settings.Exposure = config["Output"]["Exposure"] ? config["Output"]["Exposure"].as<float>() : 1.0f;
 
 	int tonemapInt = config["Output"]["Tonemapper"] ? config["Output"]["Tonemapper"].as<int>() : 0;
@@ -33,29 +33,50 @@ struct OutputComputePassSettings
 class OutputComputePass : public ImagePass
 {
 public:
-	explicit OutputComputePass(std::string settingsFilePath);
+	explicit OutputComputePass(SettingsStore& settings);
 
 	uint32_t GetOutputID() override { return m_ByteOutput->GetID(); }
+	askygg::TextureHandle GetOutputHandle() override { return m_ByteOutput->GetHandle(); }
+	const askygg::Ref<askygg::Texture2D>& GetOutputTexture() const { return m_ByteOutput; }
 
 	std::string GetOutputName() override { return m_OutputName; }
     void SetBloomType(BloomType inType) { m_Settings.ActiveBloomType = inType; }
+    // RGBA8 by default.  RGBA16 keeps 16-bit consumers (raw frame streaming) from being quantized to 8 bits.
+    void SetOutputFormat(askygg::ImageUtils::ImageInternalFormat format);
+    // Graph resource holding the active bloom result, or InvalidRenderGraphResource when bloom is disabled.
+    void SetBloomInput(askygg::RenderGraphResource bloomResource) { m_BloomResource = bloomResource; }
 
 	void Initialize() override;
+	askygg::RenderGraphResource Declare(askygg::RenderGraphBuilder& builder, askygg::RenderGraphResource input) override;
+	void Execute(const askygg::RenderGraph& graph) override;
 	void Submit(uint32_t textureID) override;
 	void DrawUI() override;
 
-	void Save() override;
-	void Load() override;
+	void SaveSettings(YAML::Node& config) override;
+	void LoadSettings(const YAML::Node& config) override;
+	uint64_t GetSettingsHash() override { return HashSettings(m_Settings); }
+	SettingsBytes GetSettingsData() override { return GetSettingsBytes(m_Settings); }
+	const OutputComputePassSettings& GetSettings() const { return m_Settings; }
 
 	void OnResize(const glm::vec2& targetSize) override;
+	uint64_t GetOwnedMemorySize() override { return m_ByteOutput ? m_ByteOutput->GetMemorySize() : 0; }
+	// No target before Initialize(), e.g. in a pipeline only the CPU backend reads settings from.
+	void	 ReleaseTargets() override
+	{
+		if (m_ByteOutput)
+			askygg::TextureRegistry::Release(m_ByteOutput->GetHandle());
+	}
 
 private:
 	std::string					   m_OutputName = "Final Output";
 	OutputComputePassSettings	   m_Settings;
 	askygg::Ref<askygg::Texture2D> m_ByteOutput;
 
+    askygg::RenderGraphResource    m_BloomResource = askygg::InvalidRenderGraphResource;
+    uint32_t                       m_BloomTextureID = 0;
     askygg::Ref<askygg::Texture2D> m_BloomDirtTexture;
 	askygg::Ref<askygg::Texture2D> m_SensorNoisePatchTexture;
 
     std::chrono::time_point<std::chrono::high_resolution_clock> m_Start;
+    float m_Time = 0.0f;
 };
@@ -1,42 +1,46 @@
 #include "RadialBloomPass.h"
-#include "core/Application.h"
+#ifndef YGG_PIPELINE_NO_UI
 #include "imgui.h"
 #include "ui/PropertyDrawer.h"
+#endif
+#include <algorithm>
+#include <cmath>
 #include <utility>
-#include <fstream>
 
 
-RadialBloomPass::RadialBloomPass(std::string settingsFilePath)
-        : ImagePass(std::move(settingsFilePath)) {}
+RadialBloomPass::RadialBloomPass(SettingsStore& settings)
+        : ImagePass(settings) {}
 
 void RadialBloomPass::Initialize()
 {
     m_Shader = askygg::ShaderLibrary::Get("RadialBloom");
-    const auto& Window = askygg::Application::GetWindow();
-
-    askygg::Texture2DSpecification bloomEdgeLightsSpec = {
-            askygg::ImageUtils::WrapMode::ClampToEdge,
-            askygg::ImageUtils::WrapMode::ClampToEdge,
-            askygg::ImageUtils::FilterMode::Linear,
-            askygg::ImageUtils::FilterMode::Linear,
-            askygg::ImageUtils::ImageInternalFormat::RGBA32F,
-            askygg::ImageUtils::ImageDataLayout::RGBA,
-            askygg::ImageUtils::ImageDataType::Float,
-            Window.GetWidth(),
-            Window.GetHeight()
-    };
-
-    bloomEdgeLightsSpec.Name = m_OutputName;
-    m_Output = askygg::CreateRef<askygg::Texture2D>(bloomEdgeLightsSpec);
-    askygg::TextureLibrary::AddTexture2D(m_Output);
-
-    bloomEdgeLightsSpec.Name = "Bloom Intermediate Output";
-    m_Intermediate = askygg::CreateRef<askygg::Texture2D>(bloomEdgeLightsSpec);
-    askygg::TextureLibrary::AddTexture2D(m_Intermediate);
-
-    bloomEdgeLightsSpec.Name = "Bloom Emitter Extraction Output";
-    m_BloomEmitterExtractionOutput = askygg::CreateRef<askygg::Texture2D>(bloomEdgeLightsSpec);
-    askygg::TextureLibrary::AddTexture2D(m_BloomEmitterExtractionOutput);
+}
+
+askygg::RenderGraphResource RadialBloomPass::Declare(askygg::RenderGraphBuilder& builder, askygg::RenderGraphResource input)
+{
+    // All three targets are full-size RGBA32F and only sampled at level 0, so they come from the graph's pool.  The
+    // extraction and blur targets die with this pass; the result lives until the composite reads it.
+    askygg::RenderGraphTextureDesc desc = { (uint32_t)m_OutputSize.x, (uint32_t)m_OutputSize.y,
+        askygg::ImageUtils::ImageInternalFormat::RGBA32F };
+
+    m_InputResource = builder.Read(input, askygg::RenderGraphAccess::ImageLoad);
+    m_ExtractionResource = builder.CreateTexture("Bloom Emitter Extraction Output", desc);
+    m_IntermediateResource = builder.CreateTexture("Bloom Intermediate Output", desc);
+    m_OutputResource = builder.CreateTexture(m_OutputName, desc);
+    return m_OutputResource;
+}
+
+void RadialBloomPass::Execute(const askygg::RenderGraph& graph)
+{
+    m_BloomEmitterExtractionOutput = graph.GetTexture(m_ExtractionResource);
+    m_Intermediate = graph.GetTexture(m_IntermediateResource);
+    m_Output = graph.GetTexture(m_OutputResource);
+
+    Submit(graph.GetTextureID(m_InputResource));
+
+    m_BloomEmitterExtractionOutput = nullptr;
+    m_Intermediate = nullptr;
+    m_Output = nullptr;
 }
 
 void RadialBloomPass::Submit(uint32_t textureID)
@@ -45,6 +49,11 @@ void RadialBloomPass::Submit(uint32_t textureID)
     auto	  workGroupsX = (uint32_t)glm::ceil((float)textureSize.x / (float)m_WorkGroupSize);
     auto	  workGroupsY = (uint32_t)glm::ceil((float)textureSize.y / (float)m_WorkGroupSize);
 
+    // The blur footprint is in pixels, so a downscaled preview blurs over proportionally fewer of them.
+    int radiusPixels = m_Settings.BloomRadiusPixels;
+    if (radiusPixels > 0 && m_ResolutionScale < 1.0f)
+        radiusPixels = std::max(1, (int)std::lround((float)radiusPixels * m_ResolutionScale));
+
     m_Shader->Bind();
 
     // Extraction Pass
@@ -53,7 +62,7 @@ void RadialBloomPass::Submit(uint32_t textureID)
         m_BloomEmitterExtractionOutput->BindToImageSlot(1, 0, askygg::ImageUtils::TextureAccessLevel::WriteOnly, askygg::ImageUtils::TextureShaderDataFormat::RGBA32F);
         m_Shader->UploadUniformInt("u_Mode", 0);
         m_Shader->UploadUniformFloat("u_LuminanceThreshold", m_Settings.LuminanceThreshold);
-        m_Shader->DispatchCompute(workGroupsX, workGroupsY, 1);
+        Dispatch(workGroupsX, workGroupsY);
         m_Shader->EnableShaderImageAccessBarrierBit();
         askygg::Texture2D::ClearBinding();
     }
@@ -65,8 +74,8 @@ void RadialBloomPass::Submit(uint32_t textureID)
         m_Shader->UploadUniformFloat("u_Amplitude", m_Settings.BloomAmplitude);
         m_Shader->UploadUniformFloat("u_SigmaScaleFactor", m_Settings.SigmaScaleFactor);
         m_Shader->UploadUniformFloat("u_BlurColorWeight", m_Settings.BlurColorWeight);
-        m_Shader->UploadUniformInt("u_BloomPixelRadius", m_Settings.BloomRadiusPixels);
-        m_Shader->DispatchCompute(workGroupsX, workGroupsY, 1);
+        m_Shader->UploadUniformInt("u_BloomPixelRadius", radiusPixels);
+        Dispatch(workGroupsX, workGroupsY);
         m_Shader->EnableShaderImageAccessBarrierBit();
         askygg::Texture2D::ClearBinding();
     }
@@ -79,9 +88,8 @@ void RadialBloomPass::Submit(uint32_t textureID)
         m_Shader->UploadUniformFloat("u_Amplitude", m_Settings.BloomAmplitude);
         m_Shader->UploadUniformFloat("u_SigmaScaleFactor", m_Settings.SigmaScaleFactor);
         m_Shader->UploadUniformFloat("u_BlurColorWeight", m_Settings.BlurColorWeight);
-        m_Shader->UploadUniformInt("u_BloomPixelRadius", m_Settings.BloomRadiusPixels);
-        m_Shader->DispatchCompute(workGroupsX, workGroupsY, 1);
-        m_Shader->EnableShaderImageAccessBarrierBit();
+        m_Shader->UploadUniformInt("u_BloomPixelRadius", radiusPixels);
+        Dispatch(workGroupsX, workGroupsY);
         askygg::Texture2D::ClearBinding();
     }
     m_Shader->Unbind();
@@ -89,6 +97,7 @@ void RadialBloomPass::Submit(uint32_t textureID)
 
 void RadialBloomPass::DrawUI()
 {
+#ifndef YGG_PIPELINE_NO_UI
     if (ImGui::CollapsingHeader("Radial Bloom Settings"))
     {
         askygg::UI::UIInt::DrawDragInt("Pixel Radius", &m_Settings.BloomRadiusPixels, 0.1f, 0, 20);
@@ -99,24 +108,20 @@ void RadialBloomPass::DrawUI()
         if (ImGui::Button("Save Radial Bloom Settings"))
             Save();
     }
+#endif
 }
 
-void RadialBloomPass::Save()
+void RadialBloomPass::SaveSettings(YAML::Node& config)
 {
-    YAML::Node existingConfig;
-    existingConfig = YAML::LoadFile(m_SettingsFilePath);
-    existingConfig["RadialBloom"]["Amplitude"] = m_Settings.BloomAmplitude;
-    existingConfig["RadialBloom"]["Pixel Radius"] = m_Settings.BloomRadiusPixels;
-    existingConfig["RadialBloom"]["Luminance Threshold"] = m_Settings.LuminanceThreshold;
-    existingConfig["RadialBloom"]["Sigma Scale Factor"] = m_Settings.SigmaScaleFactor;
-    existingConfig["RadialBloom"]["Blur Color Weight"] = m_Settings.BlurColorWeight;
-    std::ofstream outFile(m_SettingsFilePath);
-    outFile << existingConfig;
+    config["RadialBloom"]["Amplitude"] = m_Settings.BloomAmplitude;
+    config["RadialBloom"]["Pixel Radius"] = m_Settings.BloomRadiusPixels;
+    config["RadialBloom"]["Luminance Threshold"] = m_Settings.LuminanceThreshold;
+    config["RadialBloom"]["Sigma Scale Factor"] = m_Settings.SigmaScaleFactor;
+    config["RadialBloom"]["Blur Color Weight"] = m_Settings.BlurColorWeight;
 }
 
-void RadialBloomPass::Load()
+void RadialBloomPass::LoadSettings(const YAML::Node& config)
 {
-    YAML::Node config = YAML::LoadFile(m_SettingsFilePath);
     m_Settings.BloomRadiusPixels =
             config["RadialBloom"]["Pixel Radius"] ? config["RadialBloom"]["Pixel Radius"].as<int>() : 1;
     m_Settings.BloomAmplitude =
@@ -128,13 +133,3 @@ void RadialBloomPass::Load()
     m_Settings.BlurColorWeight =
             config["RadialBloom"]["Blur Color Weight"] ? config["RadialBloom"]["Blur Color Weight"].as<float>() : 0.5f;
 }
-
-void RadialBloomPass::OnResize(const glm::vec2& targetSize)
-{
-    if (m_OutputSize == targetSize)
-        return;
-    ImagePass::OnResize(targetSize);
-    m_Output->Resize(targetSize.x, targetSize.y);
-    m_Intermediate->Resize(targetSize.x, targetSize.y);
-    m_BloomEmitterExtractionOutput->Resize(targetSize.x, targetSize.y);
-}
@@ -14,21 +14,25 @@ struct RadialBloomSettings
 class RadialBloomPass : public ImagePass
 {
 public:
-    explicit RadialBloomPass(std::string settingsFilePath);
+    explicit RadialBloomPass(SettingsStore& settings);
 
-    uint32_t	   GetOutputID() override { return m_Output->GetID(); }
     std::string	   GetOutputName() override { return m_OutputName; }
 
     void Initialize() override;
+    askygg::RenderGraphResource Declare(askygg::RenderGraphBuilder& builder, askygg::RenderGraphResource input) override;
+    void Execute(const askygg::RenderGraph& graph) override;
     void Submit(uint32_t textureID) override;
     void DrawUI() override;
-    void Save() override;
-    void Load() override;
-    void OnResize(const glm::vec2& targetSize) override;
+    void SaveSettings(YAML::Node& config) override;
+    void LoadSettings(const YAML::Node& config) override;
+    uint64_t GetSettingsHash() override { return HashSettings(m_Settings); }
+    SettingsBytes GetSettingsData() override { return GetSettingsBytes(m_Settings); }
+    const RadialBloomSettings& GetSettings() const { return m_Settings; }
 
 private:
     std::string									m_OutputName = "Radial Bloom Output";
-    askygg::Ref<askygg::Texture2D>              m_Output;
+    askygg::RenderGraphResource                 m_IntermediateResource = askygg::InvalidRenderGraphResource;
+    askygg::RenderGraphResource                 m_ExtractionResource = askygg::InvalidRenderGraphResource;
     askygg::Ref<askygg::Texture2D>              m_Intermediate;
     askygg::Ref<askygg::Texture2D>              m_BloomEmitterExtractionOutput;
     RadialBloomSettings						    m_Settings;
@@ -1,34 +1,17 @@
 #include "RadialBlurPass.h"
-#include "askygg/core/Application.h"
+#ifndef YGG_PIPELINE_NO_UI
 #include "askygg/ui/PropertyDrawer.h"
 #include <imgui.h>
+#endif
 #include <yaml-cpp/yaml.h>
-#include <fstream>
 #include <utility>
 
-RadialBlurPass::RadialBlurPass(std::string settingsFilePath)
-	: ImagePass(std::move(settingsFilePath)) {}
+RadialBlurPass::RadialBlurPass(SettingsStore& settings)
+	: ImagePass(settings) {}
 
 void RadialBlurPass::Initialize()
 {
 	m_Shader = askygg::ShaderLibrary::Get("RadialBlur");
-	const auto& Window = askygg::Application::GetWindow();
-
-	askygg::Texture2DSpecification RadialBlurTextureSpec = {
-		askygg::ImageUtils::WrapMode::ClampToEdge,
-		askygg::ImageUtils::WrapMode::ClampToEdge,
-		askygg::ImageUtils::FilterMode::Linear,
-		askygg::ImageUtils::FilterMode::Linear,
-		askygg::ImageUtils::ImageInternalFormat::RGBA32F,
-		askygg::ImageUtils::ImageDataLayout::RGBA,
-		askygg::ImageUtils::ImageDataType::Float,
-		Window.GetWidth(),
-		Window.GetHeight()
-	};
-
-	RadialBlurTextureSpec.Name = m_OutputName;
-	m_RadialBlurOutput = askygg::CreateRef<askygg::Texture2D>(RadialBlurTextureSpec);
-	askygg::TextureLibrary::AddTexture2D(m_RadialBlurOutput);
 }
 
 void RadialBlurPass::Submit(uint32_t textureID)
@@ -41,14 +24,13 @@ void RadialBlurPass::Submit(uint32_t textureID)
 	m_Shader->UploadUniformFloat2("u_BlurDirection",
 		glm::vec2(m_Settings.BlurDirection.x, m_Settings.BlurDirection.y));
 
-	glm::vec2 textureSize = { m_RadialBlurOutput->GetWidth(), m_RadialBlurOutput->GetHeight() };
+	glm::vec2 textureSize = { m_Output->GetWidth(), m_Output->GetHeight() };
 	auto	  workGroupsX = (uint32_t)glm::ceil((float)textureSize.x / (float)m_WorkGroupSize);
 	auto	  workGroupsY = (uint32_t)glm::ceil((float)textureSize.y / (float)m_WorkGroupSize);
 
-	m_RadialBlurOutput->BindToImageSlot(0, 0, askygg::ImageUtils::TextureAccessLevel::WriteOnly,
+	m_Output->BindToImageSlot(0, 0, askygg::ImageUtils::TextureAccessLevel::WriteOnly,
 		askygg::ImageUtils::TextureShaderDataFormat::RGBA32F);
-	m_Shader->DispatchCompute(workGroupsX, workGroupsY, 1);
-	m_Shader->EnableShaderImageAccessBarrierBit();
+	Dispatch(workGroupsX, workGroupsY);
 
 	askygg::Texture2D::ClearBinding();
 	m_Shader->Unbind();
@@ -56,6 +38,7 @@ void RadialBlurPass::Submit(uint32_t textureID)
 
 void RadialBlurPass::DrawUI()
 {
+#ifndef YGG_PIPELINE_NO_UI
 	if (ImGui::CollapsingHeader("Radial Blur Settings"))
 	{
 		askygg::UI::UIFloat::Draw("Blur Strength", &m_Settings.BlurStrength);
@@ -65,23 +48,19 @@ void RadialBlurPass::DrawUI()
 		if (ImGui::Button("Save Radial Blur Settings"))
 			Save();
 	}
+#endif
 }
 
-void RadialBlurPass::Save()
+void RadialBlurPass::SaveSettings(YAML::Node& config)
 {
-	YAML::Node existingConfig;
-	existingConfig = YAML::LoadFile(m_SettingsFilePath);
-	existingConfig["Radial Blur"]["Blur Strength"] = m_Settings.BlurStrength;
-	existingConfig["Radial Blur"]["Blur Samples"] = m_Settings.BlurSamples;
-	existingConfig["Radial Blur"]["Blur Direction"] =
+	config["Radial Blur"]["Blur Strength"] = m_Settings.BlurStrength;
+	config["Radial Blur"]["Blur Samples"] = m_Settings.BlurSamples;
+	config["Radial Blur"]["Blur Direction"] =
 		glm::vec2(m_Settings.BlurDirection.x, m_Settings.BlurDirection.y);
-	std::ofstream outFile(m_SettingsFilePath);
-	outFile << existingConfig;
 }
 
-void RadialBlurPass::Load()
+void RadialBlurPass::LoadSettings(const YAML::Node& config)
 {
-	YAML::Node config = YAML::LoadFile(m_SettingsFilePath);
 	m_Settings.BlurStrength = config["Radial Blur"]["Blur Strength"]
 		? config["Radial Blur"]["Blur Strength"].as<float>()
 		: 0.0f;
@@ -92,12 +71,3 @@ void RadialBlurPass::Load()
 	m_Settings.BlurSamples =
 		config["Radial Blur"]["Blur Samples"] ? config["Radial Blur"]["Blur Samples"].as<int>() : 10;
 }
-
-void RadialBlurPass::OnResize(const glm::vec2& targetSize)
-{
-	if (m_OutputSize == targetSize)
-		return;
-
-	ImagePass::OnResize(targetSize);
-	m_RadialBlurOutput->Resize(targetSize.x, targetSize.y);
-}
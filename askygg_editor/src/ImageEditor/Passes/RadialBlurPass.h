@@ -12,18 +12,20 @@ struct RadialBlurSettings
 class RadialBlurPass : public ImagePass
 {
 public:
-	explicit RadialBlurPass(std::string settingsFilePath);
-	uint32_t	GetOutputID() override { return m_RadialBlurOutput->GetID(); }
+	explicit RadialBlurPass(SettingsStore& settings);
 	std::string GetOutputName() override { return m_OutputName; }
 	void		Initialize() override;
 	void		Submit(uint32_t textureID) override;
 	void		DrawUI() override;
-	void		Save() override;
-	void		Load() override;
-	void		OnResize(const glm::vec2& targetSize) override;
+	void		SaveSettings(YAML::Node& config) override;
+	void		LoadSettings(const YAML::Node& config) override;
+	uint64_t	GetSettingsHash() override { return HashSettings(m_Settings); }
+	SettingsBytes GetSettingsData() override { return GetSettingsBytes(m_Settings); }
+	const RadialBlurSettings& GetSettings() const { return m_Settings; }
+	// mix() with a weight of zero gives back the fetched texel, unless no samples make the blur NaN.
+	bool		IsIdentity() override { return m_Settings.BlurStrength == 0.0f && m_Settings.BlurSamples > 0; }
 
 private:
 	std::string					   m_OutputName = "Radial Blur Output";
 	RadialBlurSettings			   m_Settings;
-	askygg::Ref<askygg::Texture2D> m_RadialBlurOutput;
 };
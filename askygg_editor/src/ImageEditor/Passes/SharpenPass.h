@@ -10,18 +10,18 @@ struct SharpenSettings
 class SharpenPass : public ImagePass
 {
 public:
-	explicit SharpenPass(std::string settingsFilePath);
-	uint32_t	GetOutputID() override { return m_SharpenOutput->GetID(); }
+	explicit SharpenPass(SettingsStore& settings);
 	std::string GetOutputName() override { return m_OutputName; }
 	void		Initialize() override;
 	void		Submit(uint32_t textureID) override;
 	void		DrawUI() override;
-	void		Save() override;
-	void		Load() override;
-	void		OnResize(const glm::vec2& targetSize) override;
+	void		SaveSettings(YAML::Node& config) override;
+	void		LoadSettings(const YAML::Node& config) override;
+	uint64_t	GetSettingsHash() override { return HashSettings(m_Settings); }
+	SettingsBytes GetSettingsData() override { return GetSettingsBytes(m_Settings); }
+	const SharpenSettings& GetSettings() const { return m_Settings; }
 
 private:
 	std::string					   m_OutputName = "Sharpen Output";
 	SharpenSettings				   m_Settings;
-	askygg::Ref<askygg::Texture2D> m_SharpenOutput;
 };
@@ -11,18 +11,20 @@ struct SobelSettings
 class SobelPass : public ImagePass
 {
 public:
-	explicit SobelPass(std::string settingsFilePath);
-	uint32_t	GetOutputID() override { return m_SobelOutput->GetID(); }
+	explicit SobelPass(SettingsStore& settings);
 	std::string GetOutputName() override { return m_OutputName; }
 	void		Initialize() override;
 	void		Submit(uint32_t textureID) override;
 	void		DrawUI() override;
-	void		Save() override;
-	void		Load() override;
-	void		OnResize(const glm::vec2& targetSize) override;
+	void		SaveSettings(YAML::Node& config) override;
+	void		LoadSettings(const YAML::Node& config) override;
+	uint64_t	GetSettingsHash() override { return HashSettings(m_Settings); }
+	SettingsBytes GetSettingsData() override { return GetSettingsBytes(m_Settings); }
+	const SobelSettings& GetSettings() const { return m_Settings; }
+	// Adds zero to the fetched texel.
+	bool		IsIdentity() override { return m_Settings.SobelStrength == 0.0f; }
 
 private:
 	std::string					   m_OutputName = "Sobel Output";
 	SobelSettings				   m_Settings;
-	askygg::Ref<askygg::Texture2D> m_SobelOutput;
 };
@@ -1,34 +1,17 @@
 #include "VignettePass.h"
-#include "askygg/core/Application.h"
+#ifndef YGG_PIPELINE_NO_UI
 #include "askygg/ui/PropertyDrawer.h"
 #include <imgui.h>
+#endif
 #include <yaml-cpp/yaml.h>
-#include <fstream>
 #include <utility>
 
-VignettePass::VignettePass(std::string settingsFilePath)
-	: ImagePass(std::move(settingsFilePath)) {}
+VignettePass::VignettePass(SettingsStore& settings)
+	: ImagePass(settings) {}
 
 void VignettePass::Initialize()
 {
 	m_Shader = askygg::ShaderLibrary::Get("Vignette");
-	const auto& Window = askygg::Application::GetWindow();
-
-	askygg::Texture2DSpecification VignetteTextureSpec = {
-		askygg::ImageUtils::WrapMode::ClampToEdge,
-		askygg::ImageUtils::WrapMode::ClampToEdge,
-		askygg::ImageUtils::FilterMode::Linear,
-		askygg::ImageUtils::FilterMode::Linear,
-		askygg::ImageUtils::ImageInternalFormat::RGBA32F,
-		askygg::ImageUtils::ImageDataLayout::RGBA,
-		askygg::ImageUtils::ImageDataType::Float,
-		Window.GetWidth(),
-		Window.GetHeight()
-	};
-
-	VignetteTextureSpec.Name = m_OutputName;
-	m_VignetteOutput = askygg::CreateRef<askygg::Texture2D>(VignetteTextureSpec);
-	askygg::TextureLibrary::AddTexture2D(m_VignetteOutput);
 }
 
 void VignettePass::Submit(uint32_t textureID)
@@ -39,14 +22,13 @@ void VignettePass::Submit(uint32_t textureID)
 	m_Shader->UploadUniformFloat("u_Radius", m_Settings.Radius);
 	m_Shader->UploadUniformFloat("u_Softness", m_Settings.Softness);
 
-	glm::vec2 textureSize = { m_VignetteOutput->GetWidth(), m_VignetteOutput->GetHeight() };
+	glm::vec2 textureSize = { m_Output->GetWidth(), m_Output->GetHeight() };
 	auto	  workGroupsX = (uint32_t)glm::ceil((float)textureSize.x / (float)m_WorkGroupSize);
 	auto	  workGroupsY = (uint32_t)glm::ceil((float)textureSize.y / (float)m_WorkGroupSize);
 
-	m_VignetteOutput->BindToImageSlot(0, 0, askygg::ImageUtils::TextureAccessLevel::WriteOnly,
+	m_Output->BindToImageSlot(0, 0, askygg::ImageUtils::TextureAccessLevel::WriteOnly,
 		askygg::ImageUtils::TextureShaderDataFormat::RGBA32F);
-	m_Shader->DispatchCompute(workGroupsX, workGroupsY, 1);
-	m_Shader->EnableShaderImageAccessBarrierBit();
+	Dispatch(workGroupsX, workGroupsY);
 
 	askygg::Texture2D::ClearBinding();
 	m_Shader->Unbind();
@@ -54,6 +36,7 @@ void VignettePass::Submit(uint32_t textureID)
 
 void VignettePass::DrawUI()
 {
+#ifndef YGG_PIPELINE_NO_UI
 	if (ImGui::CollapsingHeader("Vignette Settings"))
 	{
 		askygg::UI::UIFloat::Draw("Vignette Radius", &m_Settings.Radius);
@@ -62,34 +45,20 @@ void VignettePass::DrawUI()
 		if (ImGui::Button("Save Vignette Settings"))
 			Save();
 	}
+#endif
 }
 
-void VignettePass::Save()
+void VignettePass::SaveSettings(YAML::Node& config)
 {
-	YAML::Node existingConfig;
-	existingConfig = YAML::LoadFile(m_SettingsFilePath);
-	existingConfig["Vignette"]["Radius"] = m_Settings.Radius;
-	existingConfig["Vignette"]["Softness"] = m_Settings.Softness;
-
-	std::ofstream outFile(m_SettingsFilePath);
-	outFile << existingConfig;
+	config["Vignette"]["Radius"] = m_Settings.Radius;
+	config["Vignette"]["Softness"] = m_Settings.Softness;
 }
 
-void VignettePass::Load()
+void VignettePass::LoadSettings(const YAML::Node& node)
 {
-	YAML::Node node = YAML::LoadFile(m_SettingsFilePath);
 	if (node["Vignette"])
 	{
 		m_Settings.Radius = node["Vignette"]["Radius"].as<float>();
 		m_Settings.Softness = node["Vignette"]["Softness"].as<float>();
 	}
 }
-
-void VignettePass::OnResize(const glm::vec2& targetSize)
-{
-	if (m_OutputSize == targetSize)
-		return;
-
-	ImagePass::OnResize(targetSize);
-	m_VignetteOutput->Resize(targetSize.x, targetSize.y);
-}
@@ -11,18 +11,18 @@ struct VignetteSettings
 class VignettePass : public ImagePass
 {
 public:
-	explicit VignettePass(std::string settingsFilePath);
-	uint32_t	GetOutputID() override { return m_VignetteOutput->GetID(); }
+	explicit VignettePass(SettingsStore& settings);
 	std::string GetOutputName() override { return m_OutputName; }
 	void		Initialize() override;
 	void		Submit(uint32_t textureID) override;
 	void		DrawUI() override;
-	void		Save() override;
-	void		Load() override;
-	void		OnResize(const glm::vec2& targetSize) override;
+	void		SaveSettings(YAML::Node& config) override;
+	void		LoadSettings(const YAML::Node& config) override;
+	uint64_t	GetSettingsHash() override { return HashSettings(m_Settings); }
+	SettingsBytes GetSettingsData() override { return GetSettingsBytes(m_Settings); }
+	const VignetteSettings& GetSettings() const { return m_Settings; }
 
 private:
 	std::string					   m_OutputName = "Vignette Output";
 	VignetteSettings			   m_Settings;
-	askygg::Ref<askygg::Texture2D> m_VignetteOutput;
 };
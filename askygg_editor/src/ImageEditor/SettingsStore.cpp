@@ -0,0 +1,137 @@
+#include "SettingsStore.h"
+
+#include "askygg/core/Log.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+SettingsStore::SettingsStore(SettingsStoreSpecification specification)
+	: m_Specification(std::move(specification))
+{
+	m_Thread = std::thread(&SettingsStore::Run, this);
+}
+
+SettingsStore::~SettingsStore()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopped = true;
+	}
+	m_Condition.notify_all();
+	m_Thread.join();
+	Write();
+}
+
+askygg::Ref<SettingsStore> SettingsStore::Open(const std::string& fileName)
+{
+	static std::mutex												   s_Mutex;
+	static std::unordered_map<std::string, std::weak_ptr<SettingsStore>> s_Stores;
+
+	std::lock_guard<std::mutex> lock(s_Mutex);
+	askygg::Ref<SettingsStore>	store = s_Stores[fileName].lock();
+	if (!store)
+	{
+		SettingsStoreSpecification specification;
+		specification.FileName = fileName;
+		store = askygg::CreateRef<SettingsStore>(std::move(specification));
+		s_Stores[fileName] = store;
+	}
+	return store;
+}
+
+YAML::Node SettingsStore::GetDocument() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	Load();
+	return YAML::Clone(m_Document);
+}
+
+void SettingsStore::Edit(const std::function<void(YAML::Node& document)>& edit)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		Load();
+		edit(m_Document);
+		m_Revision++;
+		m_LastEdit = Clock::now();
+	}
+	m_EditCount++;
+	m_Condition.notify_all();
+}
+
+void SettingsStore::Flush()
+{
+	Write();
+}
+
+void SettingsStore::Load() const
+{
+	if (m_Loaded)
+		return;
+	// Rebinds rather than assigns; see YAML::Node::operator=.
+	m_Document.reset(YAML::LoadFile(m_Specification.FileName));
+	m_Loaded = true;
+}
+
+void SettingsStore::Write()
+{
+	std::lock_guard<std::mutex> writeLock(m_WriteMutex);
+	uint64_t					revision;
+	std::string					text;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (m_Revision == m_WrittenRevision)
+			return;
+		revision = m_Revision;
+		std::ostringstream stream;
+		stream << m_Document;
+		text = stream.str();
+	}
+
+	const std::string temporaryFileName = m_Specification.FileName + ".tmp";
+	bool			  written = false;
+	{
+		std::ofstream out(temporaryFileName, std::ios::trunc);
+		out << text;
+		out.close();
+		written = !out.fail();
+	}
+	std::error_code error;
+	if (written)
+		std::filesystem::rename(temporaryFileName, m_Specification.FileName, error);
+	if (!written || error)
+	{
+		YGG_LOG_ERROR("Could not write settings to '{}': {}", m_Specification.FileName,
+			written ? error.message() : "writing the temporary file failed");
+		std::filesystem::remove(temporaryFileName, error);
+	}
+	else
+		m_WriteCount++;
+
+	// A failed write is not retried until the next edit.
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_WrittenRevision = std::max(m_WrittenRevision, revision);
+}
+
+void SettingsStore::Run()
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	while (true)
+	{
+		m_Condition.wait(lock, [this] { return m_Stopped || m_Revision != m_WrittenRevision; });
+		if (m_Stopped)
+			break;
+		const Clock::time_point due = m_LastEdit + std::chrono::milliseconds(m_Specification.DebounceMilliseconds);
+		if (Clock::now() < due)
+		{
+			m_Condition.wait_until(lock, due);
+			continue;
+		}
+		lock.unlock();
+		Write();
+		lock.lock();
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "askygg/core/Memory.h"
+
+#include <yaml-cpp/yaml.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct SettingsStoreSpecification
+{
+	std::string FileName;
+	// Edits are written once none followed for this long, so a burst of them costs one write.
+	uint32_t	DebounceMilliseconds = 500;
+};
+
+// The parsed settings file, shared by every pipeline and editor panel using it.  The file is parsed on first use and
+// never again; edits change the document in memory and are written back on a background thread after the debounce
+// interval, to a temporary file that is then renamed over the settings file, so a crash never leaves it half-written.
+// Safe to use from any thread.
+class SettingsStore
+{
+public:
+	explicit SettingsStore(SettingsStoreSpecification specification);
+	// Writes edits still waiting for the debounce interval.
+	~SettingsStore();
+
+	SettingsStore(const SettingsStore&) = delete;
+	SettingsStore& operator=(const SettingsStore&) = delete;
+
+	// The process-wide store of fileName, created on first use; it lives as long as someone holds it.
+	static askygg::Ref<SettingsStore> Open(const std::string& fileName);
+
+	// A copy of the document; later edits do not show up in it.  Throws YAML::Exception if the file cannot be parsed.
+	YAML::Node GetDocument() const;
+	// Changes the document in place and schedules a write.  The document must not escape the call.
+	void	   Edit(const std::function<void(YAML::Node& document)>& edit);
+	// Writes pending edits now instead of after the debounce interval.
+	void	   Flush();
+
+	const std::string& GetFileName() const { return m_Specification.FileName; }
+	uint64_t		   GetEditCount() const { return m_EditCount; }
+	uint64_t		   GetWriteCount() const { return m_WriteCount; }
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	// Parses the file unless that already happened.  Needs m_Mutex.
+	void Load() const;
+	// Writes the document if it changed since the last write.  Takes m_Mutex itself.
+	void Write();
+	void Run();
+
+private:
+	SettingsStoreSpecification m_Specification;
+	std::thread				   m_Thread;
+
+	mutable std::mutex		   m_Mutex;
+	// Serializes writes, so a Flush() and the background thread never race on the temporary file.
+	std::mutex				   m_WriteMutex;
+	std::condition_variable	   m_Condition;
+	mutable YAML::Node		   m_Document;
+	mutable bool			   m_Loaded = false;
+	uint64_t				   m_Revision = 0;
+	uint64_t				   m_WrittenRevision = 0;
+	Clock::time_point		   m_LastEdit;
+	bool					   m_Stopped = false;
+
+	std::atomic<uint64_t> m_EditCount = 0;
+	std::atomic<uint64_t> m_WriteCount = 0;
+};
@@ -0,0 +1,443 @@
+#include "TarStream.h"
+
+#include "askygg/core/Log.h"
+#include "askygg/platform/PlatformDetection.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+
+#if defined(E_PLATFORM_WINDOWS)
+	#include <fcntl.h>
+	#include <io.h>
+#endif
+
+#ifdef YGG_HAS_ZLIB
+	#include <zlib.h>
+#endif
+
+static constexpr size_t TarBlockSize = 512;
+// stdio's default buffer is a few KB; archives are read and written in long sequential runs.
+static constexpr size_t StreamBufferSize = 1 << 20;
+// Long names and pax headers are a few hundred bytes; anything near this is a corrupt or hostile archive.
+static constexpr uint64_t MaxExtensionSize = 1 << 20;
+// Members are images read whole into memory.
+static constexpr uint64_t MaxMemberSize = uint64_t(1) << 32;
+// Member data is read in pieces of this size, so a truncated archive never allocates much more than it holds.
+static constexpr size_t MemberReadSize = 16 << 20;
+
+static uint64_t PadToBlock(uint64_t size)
+{
+	return (size + TarBlockSize - 1) / TarBlockSize * TarBlockSize;
+}
+
+// Octal, or base-256 (GNU) when the high bit of the first byte is set.
+static uint64_t ParseNumber(const uint8_t* field, size_t length)
+{
+	uint64_t value = 0;
+	if (field[0] & 0x80)
+	{
+		value = field[0] & 0x7f;
+		for (size_t i = 1; i < length; i++)
+			value = (value << 8) | field[i];
+		return value;
+	}
+
+	for (size_t i = 0; i < length && field[i] != 0; i++)
+	{
+		if (field[i] >= '0' && field[i] <= '7')
+			value = (value << 3) | (field[i] - '0');
+	}
+	return value;
+}
+
+static uint32_t GetHeaderChecksum(const uint8_t* header)
+{
+	// The checksum field itself counts as spaces.
+	uint32_t sum = 0;
+	for (size_t i = 0; i < TarBlockSize; i++)
+		sum += (i >= 148 && i < 156) ? ' ' : header[i];
+	return sum;
+}
+
+static std::string GetField(const uint8_t* field, size_t length)
+{
+	return std::string((const char*)field, strnlen((const char*)field, length));
+}
+
+// Member names end up in output paths; absolute names and ".." components could point outside the output tree.
+static bool IsSafeMemberName(const std::string& name)
+{
+	if (name.empty() || name[0] == '/' || name[0] == '\\' || (name.size() > 1 && name[1] == ':' && std::isalpha((unsigned char)name[0])))
+		return false;
+
+	size_t start = 0;
+	while (start <= name.size())
+	{
+		size_t end = name.find_first_of("/\\", start);
+		if (end == std::string::npos)
+			end = name.size();
+		if (name.compare(start, end - start, "..") == 0)
+			return false;
+		start = end + 1;
+	}
+	return true;
+}
+
+#ifdef YGG_HAS_ZLIB
+struct TarReader::Inflater
+{
+	z_stream			 Stream{};
+	std::vector<uint8_t> Input = std::vector<uint8_t>(1 << 16);
+};
+#else
+struct TarReader::Inflater
+{
+};
+#endif
+
+TarReader::TarReader(const std::string& path)
+	: m_Path(path)
+{
+	if (path == "-")
+	{
+#if defined(E_PLATFORM_WINDOWS)
+		_setmode(_fileno(stdin), _O_BINARY);
+#endif
+		m_File = stdin;
+	}
+	else
+	{
+		m_File = std::fopen(path.c_str(), "rb");
+		m_OwnsFile = true;
+	}
+	if (!m_File)
+	{
+		YGG_LOG_ERROR("Cannot open input archive '{}'.", path);
+		return;
+	}
+	std::setvbuf(m_File, nullptr, _IOFBF, StreamBufferSize);
+
+	uint8_t magic[2] = {};
+	size_t	peeked = std::fread(magic, 1, sizeof(magic), m_File);
+	if (peeked == 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+	{
+#ifdef YGG_HAS_ZLIB
+		m_Inflater = new Inflater();
+		inflateInit2(&m_Inflater->Stream, 16 + MAX_WBITS);
+		std::memcpy(m_Inflater->Input.data(), magic, peeked);
+		m_Inflater->Stream.next_in = m_Inflater->Input.data();
+		m_Inflater->Stream.avail_in = (uInt)peeked;
+#else
+		YGG_LOG_ERROR("'{}' is gzip-compressed, but askygg was built without zlib.", path);
+		if (m_OwnsFile)
+			std::fclose(m_File);
+		m_File = nullptr;
+#endif
+		return;
+	}
+	m_Peeked.assign(magic, magic + peeked);
+}
+
+TarReader::~TarReader()
+{
+#ifdef YGG_HAS_ZLIB
+	if (m_Inflater)
+		inflateEnd(&m_Inflater->Stream);
+#endif
+	delete m_Inflater;
+	if (m_File && m_OwnsFile)
+		std::fclose(m_File);
+}
+
+bool TarReader::Next(Member& member)
+{
+	if (!m_File)
+		return false;
+
+	// Set by a GNU long name ('L') or pax ('x') header for the member that follows it.
+	std::string			 longName;
+	std::vector<uint8_t> extension;
+	while (true)
+	{
+		uint8_t header[TarBlockSize];
+		if (!Read(header, TarBlockSize))
+			return false;
+		if (std::all_of(header, header + TarBlockSize, [](uint8_t byte) { return byte == 0; }))
+			return false;
+		if (ParseNumber(header + 148, 8) != GetHeaderChecksum(header))
+		{
+			YGG_LOG_ERROR("'{}' is not a tar archive or is corrupt (bad header checksum).", m_Path);
+			return false;
+		}
+
+		const uint64_t size = ParseNumber(header + 124, 12);
+		const uint64_t padding = PadToBlock(size) - size;
+		const char	   type = (char)header[156];
+
+		if (type == 'L' || type == 'x')
+		{
+			if (size > MaxExtensionSize)
+			{
+				YGG_LOG_ERROR("'{}' is corrupt (extended header of {} bytes).", m_Path, size);
+				return false;
+			}
+			extension.resize(size);
+			if (!Read(extension.data(), size) || !Skip(padding))
+				return false;
+
+			if (type == 'L')
+				longName = GetField(extension.data(), size);
+			else
+			{
+				// Records are "<length> <key>=<value>\n"; only the path matters here.
+				size_t offset = 0;
+				while (offset < size)
+				{
+					size_t space = offset;
+					while (space < size && extension[space] != ' ')
+						space++;
+					const std::string digits((const char*)&extension[offset], space - offset);
+					// Plain decimal digits only; strtoul() would also take a sign or leading blanks.
+					const bool		  isNumber = !digits.empty() && digits.size() <= 7
+						&& std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; });
+					const size_t	  length = isNumber ? std::strtoul(digits.c_str(), nullptr, 10) : 0;
+					// The length counts the whole record, so it must end past the space, with the newline, and
+					// within the header data.
+					if (!isNumber || length > size - offset || space + 2 > offset + length
+						|| extension[offset + length - 1] != '\n')
+					{
+						YGG_LOG_ERROR("'{}' is corrupt (malformed pax record at byte {} of an extended header).", m_Path,
+							offset);
+						return false;
+					}
+					const std::string record((const char*)&extension[space + 1], offset + length - space - 2);
+					if (record.compare(0, 5, "path=") == 0)
+						longName = record.substr(5);
+					offset += length;
+				}
+			}
+			continue;
+		}
+
+		if (type != '0' && type != '\0' && type != '7')
+		{
+			// Directories, links and the like.
+			if (!Skip(size + padding))
+				return false;
+			longName.clear();
+			continue;
+		}
+
+		if (!longName.empty())
+			member.Name = std::move(longName);
+		else
+		{
+			const std::string prefix = GetField(header + 345, 155);
+			const std::string name = GetField(header, 100);
+			member.Name = prefix.empty() ? name : prefix + "/" + name;
+		}
+		longName.clear();
+
+		if (!IsSafeMemberName(member.Name))
+		{
+			YGG_LOG_WARN("Skipping '{}' in '{}': absolute name or '..' component.", member.Name, m_Path);
+			if (!Skip(size + padding))
+				return false;
+			continue;
+		}
+		if (size > MaxMemberSize)
+		{
+			YGG_LOG_ERROR("'{}' is corrupt ('{}' claims {} bytes).", m_Path, member.Name, size);
+			return false;
+		}
+
+		member.Data.clear();
+		for (uint64_t offset = 0; offset < size; offset += MemberReadSize)
+		{
+			const size_t count = (size_t)std::min<uint64_t>(size - offset, MemberReadSize);
+			member.Data.resize((size_t)offset + count);
+			if (!Read(member.Data.data() + offset, count))
+			{
+				YGG_LOG_ERROR("'{}' ends in the middle of '{}'.", m_Path, member.Name);
+				return false;
+			}
+		}
+		if (!Skip(padding))
+		{
+			YGG_LOG_ERROR("'{}' ends in the middle of '{}'.", m_Path, member.Name);
+			return false;
+		}
+		return true;
+	}
+}
+
+bool TarReader::Read(void* data, size_t size)
+{
+	auto* output = static_cast<uint8_t*>(data);
+	if (m_PeekedOffset < m_Peeked.size())
+	{
+		const size_t count = std::min(size, m_Peeked.size() - m_PeekedOffset);
+		std::memcpy(output, m_Peeked.data() + m_PeekedOffset, count);
+		m_PeekedOffset += count;
+		output += count;
+		size -= count;
+	}
+	if (size == 0)
+		return true;
+
+	if (m_Inflater)
+		return ReadCompressed(output, size);
+	return std::fread(output, 1, size, m_File) == size;
+}
+
+bool TarReader::Skip(uint64_t size)
+{
+	uint8_t scratch[64 * 1024];
+	while (size > 0)
+	{
+		const size_t count = (size_t)std::min<uint64_t>(size, sizeof(scratch));
+		if (!Read(scratch, count))
+			return false;
+		size -= count;
+	}
+	return true;
+}
+
+bool TarReader::ReadCompressed(uint8_t* data, size_t size)
+{
+#ifdef YGG_HAS_ZLIB
+	z_stream& stream = m_Inflater->Stream;
+	stream.next_out = data;
+	stream.avail_out = (uInt)size;
+	while (stream.avail_out > 0)
+	{
+		if (stream.avail_in == 0)
+		{
+			const size_t count = std::fread(m_Inflater->Input.data(), 1, m_Inflater->Input.size(), m_File);
+			if (count == 0)
+				return false;
+			stream.next_in = m_Inflater->Input.data();
+			stream.avail_in = (uInt)count;
+		}
+
+		const int result = inflate(&stream, Z_NO_FLUSH);
+		// Concatenated gzip members (as written by pigz or cat) continue the same tar stream.
+		if (result == Z_STREAM_END)
+			inflateReset(&stream);
+		else if (result != Z_OK && result != Z_BUF_ERROR)
+		{
+			YGG_LOG_ERROR("'{}': gzip data is corrupt ({}).", m_Path, stream.msg ? stream.msg : "unknown error");
+			return false;
+		}
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+TarWriter::TarWriter(const std::string& path)
+	: m_Path(path)
+{
+	if (path == "-")
+	{
+#if defined(E_PLATFORM_WINDOWS)
+		_setmode(_fileno(stdout), _O_BINARY);
+#endif
+		m_File = stdout;
+	}
+	else
+	{
+		m_File = std::fopen(path.c_str(), "wb");
+		m_OwnsFile = true;
+	}
+	if (!m_File)
+	{
+		YGG_LOG_ERROR("Cannot create output archive '{}'.", path);
+		return;
+	}
+	std::setvbuf(m_File, nullptr, _IOFBF, StreamBufferSize);
+}
+
+TarWriter::~TarWriter()
+{
+	Finish();
+	if (m_File && m_OwnsFile)
+		std::fclose(m_File);
+}
+
+bool TarWriter::Write(const std::string& name, const void* data, size_t size)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (!m_File || m_Finished)
+		return false;
+
+	static const uint8_t zeros[TarBlockSize] = {};
+	const size_t		 padding = PadToBlock(size) - size;
+	if (!WriteHeader(name, size, '0') || std::fwrite(data, 1, size, m_File) != size
+		|| std::fwrite(zeros, 1, padding, m_File) != padding)
+	{
+		YGG_LOG_ERROR("Writing '{}' to '{}' failed.", name, m_Path);
+		return false;
+	}
+	return true;
+}
+
+void TarWriter::Finish()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (!m_File || m_Finished)
+		return;
+
+	static const uint8_t zeros[2 * TarBlockSize] = {};
+	std::fwrite(zeros, 1, sizeof(zeros), m_File);
+	std::fflush(m_File);
+	m_Finished = true;
+}
+
+bool TarWriter::WriteHeader(const std::string& name, uint64_t size, char type)
+{
+	uint8_t header[TarBlockSize] = {};
+	auto	field = [&header](size_t offset) { return (char*)header + offset; };
+
+	// ustar stores up to 155 + 100 characters split at a '/'; anything else gets a GNU long name member first.
+	std::string storedName = name;
+	std::string prefix;
+	if (name.size() > 100)
+	{
+		const size_t split = name.rfind('/', 155);
+		if (split != std::string::npos && split > 0 && name.size() - split - 1 <= 100)
+		{
+			prefix = name.substr(0, split);
+			storedName = name.substr(split + 1);
+		}
+		else
+		{
+			static const uint8_t zeros[TarBlockSize] = {};
+			const size_t		 length = name.size() + 1;
+			if (!WriteHeader("././@LongLink", length, 'L') || std::fwrite(name.c_str(), 1, length, m_File) != length
+				|| std::fwrite(zeros, 1, PadToBlock(length) - length, m_File) != PadToBlock(length) - length)
+				return false;
+			storedName = name.substr(0, 100);
+		}
+	}
+
+	const auto now = std::chrono::duration_cast<std::chrono::seconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count();
+	std::memcpy(field(0), storedName.data(), std::min<size_t>(storedName.size(), 100));
+	std::snprintf(field(100), 8, "%07o", 0644);
+	std::snprintf(field(108), 8, "%07o", 0);
+	std::snprintf(field(116), 8, "%07o", 0);
+	std::snprintf(field(124), 12, "%011llo", (unsigned long long)size);
+	std::snprintf(field(136), 12, "%011llo", (unsigned long long)now);
+	header[156] = (uint8_t)type;
+	std::memcpy(field(257), "ustar", 6);
+	std::memcpy(field(263), "00", 2);
+	std::memcpy(field(345), prefix.data(), std::min<size_t>(prefix.size(), 155));
+	std::snprintf(field(148), 8, "%06o", GetHeaderChecksum(header));
+	header[155] = ' ';
+
+	return std::fwrite(header, 1, TarBlockSize, m_File) == TarBlockSize;
+}
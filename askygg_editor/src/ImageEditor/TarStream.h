@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Sequential reader for ustar / GNU / pax tar archives, plain or gzip-compressed (detected from the first bytes).
+// "-" reads stdin.  Members are read one after another straight from the stream; nothing is unpacked to disk and
+// nothing is seeked, so pipes work as well as files.  Only regular files are returned; members with an
+// absolute name or a ".." component are skipped with a warning.
+class TarReader
+{
+public:
+	struct Member
+	{
+		std::string			 Name;
+		std::vector<uint8_t> Data;
+	};
+
+	explicit TarReader(const std::string& path);
+	~TarReader();
+
+	TarReader(const TarReader&) = delete;
+	TarReader& operator=(const TarReader&) = delete;
+
+	bool IsOpen() const { return m_File != nullptr; }
+	// Next regular file, or false at the end of the archive or on a read error (logged).
+	bool Next(Member& member);
+
+private:
+	// Exactly size bytes of the (decompressed) stream, or false if it ended first.
+	bool Read(void* data, size_t size);
+	bool Skip(uint64_t size);
+	bool ReadCompressed(uint8_t* data, size_t size);
+
+private:
+	std::string m_Path;
+	std::FILE*	m_File = nullptr;
+	bool		m_OwnsFile = false;
+
+	// Set for gzip input; z_stream is kept opaque so zlib stays out of this header.
+	struct Inflater;
+	Inflater* m_Inflater = nullptr;
+	// Bytes read to sniff the compression, handed out before anything else.
+	std::vector<uint8_t> m_Peeked;
+	size_t				 m_PeekedOffset = 0;
+};
+
+// Appends members to an uncompressed ustar archive.  "-" writes stdout.  Write() may be called from several threads;
+// each member is written whole.
+class TarWriter
+{
+public:
+	explicit TarWriter(const std::string& path);
+	~TarWriter();
+
+	TarWriter(const TarWriter&) = delete;
+	TarWriter& operator=(const TarWriter&) = delete;
+
+	bool IsOpen() const { return m_File != nullptr; }
+	bool Write(const std::string& name, const void* data, size_t size);
+	// Writes the end-of-archive marker and flushes.  Called by the destructor if not before.
+	void Finish();
+
+private:
+	bool WriteHeader(const std::string& name, uint64_t size, char type);
+
+private:
+	std::string m_Path;
+	std::FILE*	m_File = nullptr;
+	bool		m_OwnsFile = false;
+	bool		m_Finished = false;
+	std::mutex	m_Mutex;
+};
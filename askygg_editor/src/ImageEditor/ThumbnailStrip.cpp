@@ -0,0 +1,248 @@
+#include "ThumbnailStrip.h"
+
+#include "ImagePipeline.h"
+
+#include "askygg/core/Log.h"
+#include "askygg/renderer/PixelBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+ThumbnailStrip::ThumbnailStrip(ThumbnailStripSpecification specification)
+	: m_Specification(std::move(specification)), m_Thumbnails(m_Specification.InputPaths.size()),
+	  m_RenderedGenerations(m_Specification.InputPaths.size(), 0), m_FailedInputs(m_Specification.InputPaths.size(), false)
+{
+	m_Thread = std::thread(&ThumbnailStrip::Run, this);
+}
+
+ThumbnailStrip::~ThumbnailStrip()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopped = true;
+	}
+	m_Condition.notify_all();
+	m_Thread.join();
+}
+
+void ThumbnailStrip::SetSettings(YAML::Node settings)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		// Assigning would overwrite the document the strip's thread may still be reading.
+		m_Settings.reset(settings);
+		m_Generation++;
+		m_PendingCount = (uint32_t)std::count(m_FailedInputs.begin(), m_FailedInputs.end(), false);
+	}
+	m_Condition.notify_all();
+}
+
+void ThumbnailStrip::NotifyViewportRendered()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_LastViewportRender = Clock::now();
+}
+
+bool ThumbnailStrip::Update(uint32_t activeIndex)
+{
+	std::vector<RenderedThumbnail> rendered;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_ActiveIndex = activeIndex;
+		rendered.swap(m_Rendered);
+	}
+
+	for (RenderedThumbnail& result : rendered)
+	{
+		Thumbnail& thumbnail = m_Thumbnails[result.Index];
+		if (result.Failed)
+		{
+			thumbnail.Failed = true;
+			continue;
+		}
+		// A result from older settings than the one already shown is dropped.
+		if (result.Generation < thumbnail.Generation)
+			continue;
+
+		if (!thumbnail.Texture || thumbnail.Texture->GetWidth() != result.Width
+			|| thumbnail.Texture->GetHeight() != result.Height)
+		{
+			askygg::Texture2DSpecification thumbnailSpec = {
+				askygg::ImageUtils::WrapMode::ClampToEdge,
+				askygg::ImageUtils::WrapMode::ClampToEdge,
+				askygg::ImageUtils::FilterMode::Linear,
+				askygg::ImageUtils::FilterMode::Linear,
+				askygg::ImageUtils::ImageInternalFormat::RGBA8,
+				askygg::ImageUtils::ImageDataLayout::RGBA,
+				askygg::ImageUtils::ImageDataType::UByte,
+				result.Width,
+				result.Height
+			};
+			thumbnailSpec.MipLevels = 1;
+			thumbnailSpec.Name = "Thumbnail " + std::to_string(result.Index);
+			thumbnail.Texture = askygg::CreateRef<askygg::Texture2D>(thumbnailSpec);
+		}
+		thumbnail.Texture->SetData(result.Pixels.data(), (uint32_t)result.Pixels.size());
+		thumbnail.Generation = result.Generation;
+	}
+	return !rendered.empty();
+}
+
+uint32_t ThumbnailStrip::GetTextureID(uint32_t index) const
+{
+	const Thumbnail& thumbnail = m_Thumbnails[index];
+	return thumbnail.Texture ? thumbnail.Texture->GetID() : 0;
+}
+
+glm::uvec2 ThumbnailStrip::GetThumbnailSize(uint32_t index) const
+{
+	const Thumbnail& thumbnail = m_Thumbnails[index];
+	if (!thumbnail.Texture)
+		return glm::uvec2(0);
+	return { thumbnail.Texture->GetWidth(), thumbnail.Texture->GetHeight() };
+}
+
+double ThumbnailStrip::GetRenderTime() const
+{
+	const uint64_t count = m_RenderCount;
+	return count ? m_RenderNanoseconds * 1e-6 / (double)count : 0.0;
+}
+
+bool ThumbnailStrip::GetNextIndex(uint32_t& index) const
+{
+	const uint32_t count = (uint32_t)m_RenderedGenerations.size();
+	if (m_Generation == 0 || count == 0)
+		return false;
+	// Outward from the active image: active, active + 1, active - 1, active + 2, ...
+	const uint32_t active = std::min(m_ActiveIndex, count - 1);
+	for (uint32_t distance = 0; distance < count; distance++)
+	{
+		const uint32_t candidates[2] = { (active + distance) % count, (active + count - distance) % count };
+		for (uint32_t candidate : candidates)
+		{
+			if (m_RenderedGenerations[candidate] != m_Generation && !m_FailedInputs[candidate])
+			{
+				index = candidate;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void ThumbnailStrip::Run()
+{
+	m_Specification.Context->MakeCurrent();
+	{
+		ImagePipeline pipeline(m_Specification.SettingsFileName);
+		pipeline.Initialize(true);
+
+		const size_t								  imageCount = m_Specification.InputPaths.size();
+		std::vector<askygg::Scope<askygg::Texture2D>> proxies(imageCount);
+		std::vector<uint32_t>						  inputWidths(imageCount, 0);
+		askygg::Scope<askygg::PixelPackBuffer>		  readback;
+		uint64_t									  appliedGeneration = 0;
+
+		while (true)
+		{
+			uint32_t   index = 0;
+			uint64_t   generation = 0;
+			YAML::Node settings;
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				while (!m_Stopped)
+				{
+					if (!GetNextIndex(index))
+					{
+						m_Condition.wait(lock);
+						continue;
+					}
+					const Clock::time_point idleFrom =
+						m_LastViewportRender + std::chrono::milliseconds(m_Specification.ViewportIdleMilliseconds);
+					if (Clock::now() >= idleFrom)
+						break;
+					m_Condition.wait_until(lock, idleFrom);
+				}
+				if (m_Stopped)
+					break;
+				generation = m_Generation;
+				if (generation != appliedGeneration)
+					settings = m_Settings;
+			}
+			// A default constructed node is a null document, not an absent one; only a new sweep applies settings.
+			if (generation != appliedGeneration)
+			{
+				pipeline.ApplySettings(settings);
+				appliedGeneration = generation;
+			}
+
+			const std::string& path = m_Specification.InputPaths[index];
+			if (!proxies[index])
+			{
+				if (!askygg::Texture2D::IsLoadable(path))
+				{
+					YGG_LOG_WARN("No thumbnail for '{}': not a readable image.", path);
+					{
+						std::lock_guard<std::mutex> lock(m_Mutex);
+						m_FailedInputs[index] = true;
+						m_PendingCount--;
+						m_Rendered.push_back({ index, generation, true });
+					}
+					if (m_Specification.OnRendered)
+						m_Specification.OnRendered();
+					continue;
+				}
+
+				// Decoded once; only the mip the thumbnail is rendered from is kept.
+				askygg::Texture2D input(path, m_Specification.InputSpecification);
+				uint32_t		  mip = 0;
+				while (mip + 1 < input.GetMipLevelCount())
+				{
+					const auto [width, height] = input.GetMipSize(mip + 1);
+					if (std::max(width, height) < m_Specification.ThumbnailSize)
+						break;
+					mip++;
+				}
+				askygg::Texture2DSpecification proxySpec = input.GetSpecification();
+				std::tie(proxySpec.Width, proxySpec.Height) = input.GetMipSize(mip);
+				proxySpec.Name = "Thumbnail Proxy " + std::to_string(index);
+				proxies[index] = askygg::CreateScope<askygg::Texture2D>(proxySpec);
+				proxies[index]->CopyFrom(input.GetID(), mip);
+				inputWidths[index] = input.GetWidth();
+			}
+
+			const Clock::time_point		  start = Clock::now();
+			const askygg::Texture2D&	  proxy = *proxies[index];
+			const uint64_t				  outputSize = (uint64_t)proxy.GetWidth() * proxy.GetHeight() * 4;
+			// Footprints measured in pixels shrink with the proxy, as for the editor's previews.
+			pipeline.SetResolutionScale((float)proxy.GetWidth() / (float)inputWidths[index]);
+			pipeline.Submit({ proxy.GetWidth(), proxy.GetHeight() }, proxy.GetID(), askygg::RenderGraphAccess::Readback,
+				false);
+			if (!readback || readback->GetSize() != outputSize)
+				readback = askygg::CreateScope<askygg::PixelPackBuffer>(outputSize);
+			readback->ReadTexture(*pipeline.GetOutputTexture(), askygg::ImageUtils::ImageDataLayout::RGBA,
+				askygg::ImageUtils::ImageDataType::UByte);
+
+			// Waiting here keeps at most one thumbnail's work queued ahead of the viewport's on the GPU.
+			RenderedThumbnail result{ index, generation, false, proxy.GetWidth(), proxy.GetHeight() };
+			result.Pixels.resize(outputSize);
+			std::memcpy(result.Pixels.data(), readback->Map(), outputSize);
+			readback->Unmap();
+			m_RenderNanoseconds +=
+				std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+			m_RenderCount++;
+
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_RenderedGenerations[index] = generation;
+				// A sweep started meanwhile still renders this image again; the result is shown until then.
+				if (generation == m_Generation)
+					m_PendingCount--;
+				m_Rendered.push_back(std::move(result));
+			}
+			if (m_Specification.OnRendered)
+				m_Specification.OnRendered();
+		}
+	}
+	m_Specification.Context->DetachCurrent();
+}
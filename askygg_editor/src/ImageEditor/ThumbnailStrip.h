@@ -0,0 +1,118 @@
+#pragma once
+
+#include "askygg/core/Memory.h"
+#include "askygg/renderer/GraphicsContext.h"
+#include "askygg/renderer/Texture.h"
+
+#include <glm/glm.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct ThumbnailStripSpecification
+{
+	std::vector<std::string>	   InputPaths;
+	// Wrapping and filtering of the decoded inputs, as the editor loads them.
+	askygg::Texture2DSpecification InputSpecification;
+	// The pipeline reads its defaults from this file; SetSettings() supplies the values being edited.
+	std::string					   SettingsFileName;
+	// Shares objects with the main context; made current on the strip's thread, so it must not be current elsewhere.
+	askygg::Ref<askygg::GraphicsContext> Context;
+	// Each proxy is the smallest input mip whose longer edge still has this many pixels.
+	uint32_t							 ThumbnailSize = 160;
+	// The strip only renders once the viewport has not rendered for this long, so it never competes with it.
+	uint32_t							 ViewportIdleMilliseconds = 100;
+	// Called on the strip's thread whenever a thumbnail is ready for Update(), e.g. to wake a main loop that idles.
+	std::function<void()>				 OnRendered;
+};
+
+// Runs the pipeline over a small proxy of every input in the background, for a strip of processed thumbnails.
+// Proxies are made once per image from a mip of the decoded input and stay resident.  Every SetSettings() starts a
+// new sweep over all of them, nearest the active image first; thumbnails from the previous settings stay up until
+// theirs is replaced.  Pixels come back through the CPU and are uploaded by Update(), so the main context never
+// samples a texture another context is writing.
+class ThumbnailStrip
+{
+public:
+	explicit ThumbnailStrip(ThumbnailStripSpecification specification);
+	// Stops the sweep and releases every thumbnail; needs the GL context.
+	~ThumbnailStrip();
+
+	ThumbnailStrip(const ThumbnailStrip&) = delete;
+	ThumbnailStrip& operator=(const ThumbnailStrip&) = delete;
+
+	// Re-renders every thumbnail with these settings (ImagePipeline::ExportSettings()).
+	void SetSettings(YAML::Node settings);
+	// Holds the strip back for another ViewportIdleMilliseconds.
+	void NotifyViewportRendered();
+	// Uploads finished thumbnails and sweeps outward from activeIndex from now on.  Needs the GL context.  True if a
+	// thumbnail changed.
+	bool Update(uint32_t activeIndex);
+
+	// Zero until the image's first thumbnail is uploaded.
+	uint32_t   GetTextureID(uint32_t index) const;
+	glm::uvec2 GetThumbnailSize(uint32_t index) const;
+	// True once the thumbnail reflects the latest SetSettings().
+	bool	   IsCurrent(uint32_t index) const { return m_Thumbnails[index].Generation == m_Generation; }
+	bool	   IsFailed(uint32_t index) const { return m_Thumbnails[index].Failed; }
+	uint32_t   GetImageCount() const { return (uint32_t)m_Thumbnails.size(); }
+	// Thumbnails the current sweep has yet to render.
+	uint32_t   GetPendingCount() const { return m_PendingCount; }
+	// Average wall time per thumbnail on the strip's thread in milliseconds, proxy creation excluded.
+	double	   GetRenderTime() const;
+
+private:
+	struct Thumbnail
+	{
+		askygg::Ref<askygg::Texture2D> Texture;
+		// SetSettings() count the uploaded texture was rendered with; 0 before the first.
+		uint64_t					   Generation = 0;
+		bool						   Failed = false;
+	};
+
+	struct RenderedThumbnail
+	{
+		uint32_t			 Index = 0;
+		uint64_t			 Generation = 0;
+		// Set if the input could not be decoded; there are no pixels then.
+		bool				 Failed = false;
+		uint32_t			 Width = 0, Height = 0;
+		// RGBA8, bottom row first.
+		std::vector<uint8_t> Pixels;
+	};
+
+	using Clock = std::chrono::steady_clock;
+
+	void Run();
+	// Next image the sweep has not rendered with the current settings, nearest the active one; false if none.
+	bool GetNextIndex(uint32_t& index) const;
+
+private:
+	ThumbnailStripSpecification m_Specification;
+	std::vector<Thumbnail>		m_Thumbnails;
+	std::thread					m_Thread;
+
+	// Shared with the strip's thread.
+	mutable std::mutex			   m_Mutex;
+	std::condition_variable		   m_Condition;
+	YAML::Node					   m_Settings;
+	uint64_t					   m_Generation = 0;
+	// Per image: the generation the thread last rendered it with, and whether its input failed to decode.
+	std::vector<uint64_t>		   m_RenderedGenerations;
+	std::vector<bool>			   m_FailedInputs;
+	uint32_t					   m_ActiveIndex = 0;
+	Clock::time_point			   m_LastViewportRender;
+	std::vector<RenderedThumbnail> m_Rendered;
+	bool						   m_Stopped = false;
+
+	std::atomic<uint32_t> m_PendingCount = 0;
+	std::atomic<uint64_t> m_RenderCount = 0;
+	std::atomic<uint64_t> m_RenderNanoseconds = 0;
+};
@@ -0,0 +1,365 @@
+#include "VariantSweep.h"
+
+#include "ImagePipeline.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+
+namespace
+{
+	// Grids larger than this are almost certainly a typo in Steps.
+	constexpr size_t MaxVariantCount = 4096;
+
+	struct SweepParameter
+	{
+		std::vector<std::string> Path;
+		// Either explicit values or a range.
+		std::vector<YAML::Node>	 Values;
+		double					 Minimum = 0.0;
+		double					 Maximum = 0.0;
+		bool					 Integer = false;
+		uint32_t				 Steps = 3;
+	};
+
+	std::string GetIndexedName(const std::string& prefix, size_t index)
+	{
+		char buffer[16];
+		std::snprintf(buffer, sizeof(buffer), "%03zu", index);
+		return prefix + buffer;
+	}
+
+	YAML::Node MakeNumber(double value, bool integer)
+	{
+		if (integer)
+			return YAML::Node((int64_t)std::llround(value));
+		// Short enough to read in folder listings and the contact sheet, and exact enough for any setting.
+		char buffer[32];
+		std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+		return YAML::Node(std::string(buffer));
+	}
+
+	void SetSetting(YAML::Node& overrides, const std::vector<std::string>& path, const YAML::Node& value)
+	{
+		if (path.size() == 1)
+			overrides[path[0]] = YAML::Clone(value);
+		else
+			overrides[path[0]][path[1]] = YAML::Clone(value);
+	}
+
+	std::string EscapeHTML(const std::string& text)
+	{
+		std::string escaped;
+		for (char c : text)
+		{
+			switch (c)
+			{
+				case '&': escaped += "&amp;"; break;
+				case '<': escaped += "&lt;"; break;
+				case '>': escaped += "&gt;"; break;
+				case '"': escaped += "&quot;"; break;
+				default: escaped += c; break;
+			}
+		}
+		return escaped;
+	}
+
+	std::string EscapeURL(const std::string& path)
+	{
+		std::string escaped;
+		for (unsigned char c : path)
+		{
+			if (c == ' ' || c == '#' || c == '%' || c == '?' || c == '"' || c < 0x20)
+			{
+				char buffer[4];
+				std::snprintf(buffer, sizeof(buffer), "%%%02X", c);
+				escaped += buffer;
+			}
+			else
+				escaped += (char)c;
+		}
+		return escaped;
+	}
+}
+
+bool VariantSweep::Load(const std::string& fileName, const YAML::Node& baseSettings, std::string& error)
+{
+	m_Variants.clear();
+	m_RenderOrder.clear();
+	try
+	{
+		const YAML::Node spec = YAML::LoadFile(fileName);
+
+		std::vector<std::string> names;
+		std::vector<YAML::Node>	 overrides;
+		if (spec["Variants"])
+		{
+			if (!spec["Variants"].IsSequence())
+			{
+				error = "Variants must be a list";
+				return false;
+			}
+			for (size_t i = 0; i < spec["Variants"].size(); i++)
+			{
+				const YAML::Node entry = spec["Variants"][i];
+				if (!entry["Settings"] || !entry["Settings"].IsMap())
+				{
+					error = "variant " + std::to_string(i) + " has no Settings map";
+					return false;
+				}
+				names.push_back(entry["Name"] ? entry["Name"].as<std::string>() : GetIndexedName("variant_", i));
+				overrides.push_back(entry["Settings"]);
+			}
+		}
+		if (spec["Sweep"])
+		{
+			std::vector<YAML::Node> sweepOverrides;
+			if (!LoadSweep(spec["Sweep"], sweepOverrides, error))
+				return false;
+			for (size_t i = 0; i < sweepOverrides.size(); i++)
+			{
+				names.push_back(GetIndexedName("sweep_", i));
+				overrides.push_back(sweepOverrides[i]);
+			}
+		}
+		if (names.empty())
+		{
+			error = "no Variants or Sweep";
+			return false;
+		}
+		if (names.size() > MaxVariantCount)
+		{
+			error = std::to_string(names.size()) + " variants, more than " + std::to_string(MaxVariantCount);
+			return false;
+		}
+
+		std::set<std::string> usedNames;
+		for (size_t i = 0; i < names.size(); i++)
+		{
+			// Names become directories under the output root.
+			const std::string& name = names[i];
+			if (name.empty() || name == "." || name == ".." || name.find_first_of("/\\") != std::string::npos
+				|| !usedNames.insert(name).second)
+			{
+				error = "variant name '" + name + "' is empty, a path or used twice";
+				return false;
+			}
+
+			SettingsVariant variant;
+			variant.Name = name;
+			variant.Overrides = overrides[i];
+			variant.Settings = ImagePipeline::MergeSettings(baseSettings, overrides[i]);
+			std::string settingsError;
+			if (!ImagePipeline::ValidateSettings(variant.Settings, settingsError))
+			{
+				error = "variant '" + name + "': " + settingsError;
+				return false;
+			}
+			m_Variants.push_back(std::move(variant));
+		}
+	}
+	catch (const YAML::Exception& exception)
+	{
+		error = exception.what();
+		m_Variants.clear();
+		return false;
+	}
+
+	m_RenderOrder.resize(m_Variants.size());
+	std::iota(m_RenderOrder.begin(), m_RenderOrder.end(), 0);
+	return true;
+}
+
+bool VariantSweep::LoadSweep(const YAML::Node& sweep, std::vector<YAML::Node>& overrides, std::string& error) const
+{
+	const std::string mode = sweep["Mode"] ? sweep["Mode"].as<std::string>() : "Grid";
+	if (mode != "Grid" && mode != "Random")
+	{
+		error = "Sweep Mode must be Grid or Random";
+		return false;
+	}
+	if (!sweep["Parameters"] || !sweep["Parameters"].IsSequence() || sweep["Parameters"].size() == 0)
+	{
+		error = "Sweep needs a list of Parameters";
+		return false;
+	}
+
+	std::vector<SweepParameter> parameters;
+	for (size_t i = 0; i < sweep["Parameters"].size(); i++)
+	{
+		const YAML::Node entry = sweep["Parameters"][i];
+		SweepParameter	 parameter;
+		const std::string setting = entry["Setting"] ? entry["Setting"].as<std::string>() : std::string();
+		std::stringstream stream(setting);
+		for (std::string part; std::getline(stream, part, '/');)
+			parameter.Path.push_back(part);
+		if (parameter.Path.empty() || parameter.Path.size() > 2)
+		{
+			error = "sweep parameter " + std::to_string(i) + " needs a Setting like 'Output/Exposure'";
+			return false;
+		}
+
+		if (entry["Values"] && entry["Values"].IsSequence() && entry["Values"].size() > 0)
+		{
+			for (size_t v = 0; v < entry["Values"].size(); v++)
+				parameter.Values.push_back(entry["Values"][v]);
+		}
+		else if (entry["Range"] && entry["Range"].IsSequence() && entry["Range"].size() == 2)
+		{
+			int64_t minimum, maximum;
+			parameter.Integer = YAML::convert<int64_t>::decode(entry["Range"][0], minimum)
+				&& YAML::convert<int64_t>::decode(entry["Range"][1], maximum);
+			parameter.Minimum = entry["Range"][0].as<double>();
+			parameter.Maximum = entry["Range"][1].as<double>();
+			parameter.Steps = entry["Steps"] ? std::max(entry["Steps"].as<uint32_t>(), 1u) : parameter.Steps;
+			if (!(parameter.Minimum <= parameter.Maximum))
+			{
+				error = "sweep parameter '" + setting + "' has a Range whose first bound is above its second";
+				return false;
+			}
+			if (parameter.Steps > MaxVariantCount)
+			{
+				error = "sweep parameter '" + setting + "' has " + std::to_string(parameter.Steps)
+					+ " Steps, more than " + std::to_string(MaxVariantCount) + " variants";
+				return false;
+			}
+		}
+		else
+		{
+			error = "sweep parameter '" + setting + "' needs Values or a Range of two bounds";
+			return false;
+		}
+		parameters.push_back(std::move(parameter));
+	}
+
+	if (mode == "Random")
+	{
+		const uint32_t samples = sweep["Samples"] ? sweep["Samples"].as<uint32_t>() : 8;
+		std::mt19937   random(sweep["Seed"] ? sweep["Seed"].as<uint32_t>() : 0u);
+		for (uint32_t s = 0; s < samples && overrides.size() <= MaxVariantCount; s++)
+		{
+			YAML::Node variant;
+			for (const SweepParameter& parameter : parameters)
+			{
+				if (!parameter.Values.empty())
+				{
+					std::uniform_int_distribution<size_t> pick(0, parameter.Values.size() - 1);
+					SetSetting(variant, parameter.Path, parameter.Values[pick(random)]);
+				}
+				else if (parameter.Integer)
+				{
+					std::uniform_int_distribution<int64_t> pick((int64_t)parameter.Minimum, (int64_t)parameter.Maximum);
+					SetSetting(variant, parameter.Path, MakeNumber((double)pick(random), true));
+				}
+				else
+				{
+					std::uniform_real_distribution<double> pick(parameter.Minimum, parameter.Maximum);
+					SetSetting(variant, parameter.Path, MakeNumber(pick(random), false));
+				}
+			}
+			overrides.push_back(variant);
+		}
+		return true;
+	}
+
+	// Every combination, the last parameter varying fastest.
+	std::vector<std::vector<YAML::Node>> candidates;
+	for (const SweepParameter& parameter : parameters)
+	{
+		std::vector<YAML::Node> values = parameter.Values;
+		if (values.empty())
+		{
+			for (uint32_t step = 0; step < parameter.Steps; step++)
+			{
+				const double t = parameter.Steps > 1 ? (double)step / (double)(parameter.Steps - 1) : 0.0;
+				values.push_back(
+					MakeNumber(parameter.Minimum + t * (parameter.Maximum - parameter.Minimum), parameter.Integer));
+			}
+		}
+		candidates.push_back(std::move(values));
+	}
+	std::vector<size_t> indices(parameters.size(), 0);
+	while (overrides.size() <= MaxVariantCount)
+	{
+		YAML::Node variant;
+		for (size_t p = 0; p < parameters.size(); p++)
+			SetSetting(variant, parameters[p].Path, candidates[p][indices[p]]);
+		overrides.push_back(variant);
+
+		size_t p = parameters.size();
+		while (p > 0 && ++indices[p - 1] == candidates[p - 1].size())
+			indices[--p] = 0;
+		if (p == 0)
+			break;
+	}
+	return true;
+}
+
+bool VariantSweep::SortForReuse(ImagePipeline& pipeline, std::string& error)
+{
+	std::vector<std::vector<uint64_t>> keys(m_Variants.size());
+	for (size_t i = 0; i < m_Variants.size(); i++)
+	{
+		// Also the first time every variant is applied, so values of the wrong type surface here and not mid-run.
+		try
+		{
+			pipeline.ApplySettings(m_Variants[i].Settings);
+		}
+		catch (const YAML::Exception& exception)
+		{
+			error = "variant '" + m_Variants[i].Name + "': " + exception.what();
+			return false;
+		}
+		keys[i] = pipeline.GetPassSettingsKey();
+	}
+	std::stable_sort(m_RenderOrder.begin(), m_RenderOrder.end(),
+		[&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+	return true;
+}
+
+void VariantSweep::AddOutput(const std::string& inputPath, uint32_t variantIndex, const std::string& outputPath,
+	uint32_t reusedPassCount)
+{
+	m_ReusedPassCount += reusedPassCount;
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	std::vector<std::string>&	outputs = m_Outputs[inputPath];
+	outputs.resize(m_Variants.size());
+	outputs[variantIndex] = outputPath;
+}
+
+std::string VariantSweep::GetContactSheet() const
+{
+	std::ostringstream html;
+	html << "<!DOCTYPE html>\n<html><head><meta charset=\"utf-8\"><title>askygg contact sheet</title>\n"
+		 << "<style>body{font-family:sans-serif;background:#202020;color:#d0d0d0}td,th{padding:4px;vertical-align:top;"
+		 << "text-align:left;font-size:12px}img{width:240px}pre{margin:0;white-space:pre-wrap;font-weight:normal}"
+		 << "</style></head><body>\n<table>\n<tr><th></th>";
+	for (const SettingsVariant& variant : m_Variants)
+	{
+		YAML::Emitter overrides;
+		overrides << variant.Overrides;
+		html << "<th>" << EscapeHTML(variant.Name) << "<pre>" << EscapeHTML(overrides.c_str()) << "</pre></th>";
+	}
+	html << "</tr>\n";
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	for (const auto& [inputPath, outputs] : m_Outputs)
+	{
+		html << "<tr><th>" << EscapeHTML(inputPath) << "</th>";
+		for (const std::string& output : outputs)
+		{
+			if (output.empty())
+				html << "<td></td>";
+			else
+				html << "<td><a href=\"" << EscapeHTML(EscapeURL(output)) << "\"><img loading=\"lazy\" src=\""
+					 << EscapeHTML(EscapeURL(output)) << "\"></a></td>";
+		}
+		html << "</tr>\n";
+	}
+	html << "</table>\n</body></html>\n";
+	return html.str();
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <yaml-cpp/yaml.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ImagePipeline;
+
+// One look of a fan-out run: settings overrides laid over the settings file.
+struct SettingsVariant
+{
+	// Output subdirectory (or archive prefix) of the variant's outputs.
+	std::string Name;
+	YAML::Node	Overrides;
+	// The settings file with Overrides merged in, for ImagePipeline::ApplySettings().
+	YAML::Node	Settings;
+};
+
+// The variants of a fan-out run and the outputs they produced.  Variants are listed explicitly, described by a sweep
+// over settings, or both:
+//
+//   Variants:
+//     - Name: warm                                 # optional
+//       Settings: { Output: { Exposure: 1.2, Tonemapper: 2 } }
+//   Sweep:
+//     Mode: Grid                                   # every combination; Random draws Samples of them
+//     Samples: 16
+//     Seed: 1
+//     Parameters:
+//       - { Setting: Output/Exposure, Range: [0.5, 2.0], Steps: 4 }
+//       - { Setting: Output/Tonemapper, Values: [0, 1, 2] }
+//
+// A Range with integer bounds yields integers.  Grid steps a Range evenly from bound to bound; Random draws uniformly.
+class VariantSweep
+{
+public:
+	// False with error set if the file cannot be read, describes no variants or a variant is not valid settings.
+	bool Load(const std::string& fileName, const YAML::Node& baseSettings, std::string& error);
+	// Orders rendering so variants sharing the most passes' settings follow each other; a caching pipeline then only
+	// reruns the passes from the first one they differ in.  Leaves the pipeline with the last variant's settings.  False
+	// with error set if a variant's values have the wrong type.
+	bool SortForReuse(ImagePipeline& pipeline, std::string& error);
+
+	const std::vector<SettingsVariant>& GetVariants() const { return m_Variants; }
+	// Indices into GetVariants() in the order each input is rendered.
+	const std::vector<uint32_t>&		GetRenderOrder() const { return m_RenderOrder; }
+
+	// Records where a variant's output of an input went, relative to the output root, and how many pass outputs its
+	// render took from the cache.  Safe from any thread.
+	void		AddOutput(const std::string& inputPath, uint32_t variantIndex, const std::string& outputPath,
+				   uint32_t reusedPassCount);
+	uint64_t	GetReusedPassCount() const { return m_ReusedPassCount; }
+	// An HTML page with a row per input and a column per variant, headed by the variant's overrides.
+	std::string GetContactSheet() const;
+
+private:
+	bool LoadSweep(const YAML::Node& sweep, std::vector<YAML::Node>& overrides, std::string& error) const;
+
+private:
+	std::vector<SettingsVariant> m_Variants;
+	std::vector<uint32_t>		 m_RenderOrder;
+
+	mutable std::mutex								m_Mutex;
+	std::map<std::string, std::vector<std::string>> m_Outputs;
+	std::atomic<uint64_t>							m_ReusedPassCount = 0;
+};
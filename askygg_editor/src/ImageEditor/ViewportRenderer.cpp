@@ -0,0 +1,258 @@
+#include "ViewportRenderer.h"
+
+#include "ImagePipeline.h"
+
+#include "askygg/platform/renderer_platform/opengl/OpenGLTimer.h"
+
+ViewportRenderer::ViewportRenderer(ViewportRendererSpecification specification)
+	: m_Specification(std::move(specification))
+{
+	m_Thread = std::thread(&ViewportRenderer::Run, this);
+}
+
+ViewportRenderer::~ViewportRenderer()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopped = true;
+	}
+	m_Condition.notify_all();
+	m_Thread.join();
+}
+
+void ViewportRenderer::Submit(ViewportRenderRequest request)
+{
+	auto pending = askygg::CreateScope<PendingRequest>(PendingRequest{ std::move(request), Clock::now() });
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (m_Pending)
+			m_SupersededCount++;
+		m_Pending.swap(pending);
+	}
+	m_Condition.notify_all();
+}
+
+bool ViewportRenderer::Update()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (m_ReadySlot == NoSlot)
+		return false;
+	// Follows the draws that sampled the slot until now; it is not written before they are done.
+	if (m_ShownSlot != NoSlot)
+		m_Slots[m_ShownSlot].Released = askygg::CreateRef<askygg::Fence>();
+	m_ShownSlot = m_ReadySlot;
+	m_ReadySlot = NoSlot;
+	m_Statistics = std::move(m_ReadyStatistics);
+	return true;
+}
+
+uint32_t ViewportRenderer::GetOutputTextureID() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_ShownSlot != NoSlot ? m_Slots[m_ShownSlot].Texture->GetID() : 0;
+}
+
+bool ViewportRenderer::IsBusy() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_Pending || m_Rendering;
+}
+
+float ViewportRenderer::GetProgress() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_Progress;
+}
+
+void ViewportRenderer::Run()
+{
+	m_Specification.Context->MakeCurrent();
+	{
+		ImagePipeline pipeline(m_Specification.SettingsFileName);
+		pipeline.Initialize(true);
+		// Requests mostly differ in one setting; only the passes from the first changed one rerun.
+		pipeline.SetPassCaching(true);
+
+		askygg::Scope<PendingRequest>	 current;
+		askygg::Ref<askygg::Texture2D>	 previewTexture;
+		const askygg::Texture2D*		 previewSource = nullptr;
+		uint32_t						 previewMip = 0;
+		ViewportRenderStatistics		 statistics;
+		askygg::OpenGLFuncTimer			 timer;
+
+		auto publish = [&]
+		{
+			statistics.PassExecutionTimes = pipeline.GetPassExecutionTimes();
+			statistics.ElidedPasses = pipeline.GetElidedPasses();
+			statistics.CachedPasses = pipeline.GetCachedPasses();
+			statistics.PassCacheHits = pipeline.GetPassCacheHits();
+			statistics.PassCacheMisses = pipeline.GetPassCacheMisses();
+			statistics.MemorySize = pipeline.GetMemorySize();
+			statistics.PeakMemorySize = pipeline.GetPeakMemorySize();
+			statistics.TransientTextureCount = pipeline.GetTransientTextureCount();
+			Publish(*pipeline.GetOutputTexture(), statistics);
+		};
+
+		while (true)
+		{
+			askygg::Scope<PendingRequest> next;
+			{
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				// A full-size render in progress looks for newer requests between its steps only.
+				if (!pipeline.IsProgressiveActive())
+				{
+					m_Rendering = false;
+					m_Progress = -1.0f;
+					m_Condition.wait(lock, [this] { return m_Stopped || m_Pending; });
+				}
+				if (m_Stopped)
+					break;
+				next = std::move(m_Pending);
+				if (next)
+					m_Rendering = true;
+			}
+
+			if (next)
+			{
+				if (pipeline.IsProgressiveActive())
+				{
+					pipeline.CancelProgressive();
+					m_AbandonedCount++;
+				}
+				// The request it replaces, and with it the previous input, is released at the end of this iteration.
+				std::swap(current, next);
+				const ViewportRenderRequest& request = current->Request;
+				request.Ready->WaitGPU();
+				if (!next || request.SettingsHash != next->Request.SettingsHash)
+					pipeline.ApplySettings(request.Settings);
+				// Once the previous input is released its GL name can come back for another image, which the cache
+				// would take for the old one.
+				if (!next || request.Input != next->Request.Input)
+				{
+					pipeline.InvalidatePassCache();
+					previewSource = nullptr;
+				}
+
+				const askygg::Texture2D& input = *request.Input;
+				if (request.PreviewMip > 0)
+				{
+					uint32_t width, height;
+					std::tie(width, height) = input.GetMipSize(request.PreviewMip);
+					if (!previewTexture || previewTexture->GetWidth() != width || previewTexture->GetHeight() != height
+						|| previewTexture->GetSpecification().InternalFormat != input.GetSpecification().InternalFormat)
+					{
+						askygg::Texture2DSpecification previewSpec = input.GetSpecification();
+						previewSpec.Width = width;
+						previewSpec.Height = height;
+						previewSpec.Name = "Preview Input";
+						previewTexture = askygg::CreateRef<askygg::Texture2D>(previewSpec);
+						previewSource = nullptr;
+					}
+					if (previewSource != &input || previewMip != request.PreviewMip)
+					{
+						previewTexture->CopyFrom(input.GetID(), request.PreviewMip);
+						previewSource = &input;
+						previewMip = request.PreviewMip;
+					}
+
+					pipeline.SetResolutionScale((float)width / request.ImageWidth);
+					statistics.PreviewRenderTime = timer.ProfileFn([&]
+					{
+						pipeline.Submit({ width, height }, previewTexture->GetID(), askygg::RenderGraphAccess::Readback);
+					});
+					pipeline.SetResolutionScale(1.0f);
+					statistics.Preview = true;
+					statistics.Latency = std::chrono::duration<double, std::milli>(Clock::now() - current->SubmitTime).count();
+					publish();
+					continue;
+				}
+
+				// A reduced-scale JPEG preview stands in for the image until its full resolution is decoded.
+				const glm::vec2 inputSize = { input.GetWidth(), input.GetHeight() };
+				const bool		fullResolution = (float)input.GetWidth() == request.ImageWidth;
+				if (request.StepBudget > 0.0f && fullResolution)
+					pipeline.BeginProgressive(inputSize, input.GetID(), askygg::RenderGraphAccess::Readback);
+				else
+				{
+					pipeline.SetResolutionScale(inputSize.x / request.ImageWidth);
+					const double renderTime = timer.ProfileFn([&]
+					{
+						pipeline.Submit(inputSize, input.GetID(), askygg::RenderGraphAccess::Readback);
+					});
+					pipeline.SetResolutionScale(1.0f);
+					(fullResolution ? statistics.FullRenderTime : statistics.PreviewRenderTime) = renderTime;
+					statistics.StepCount = 1;
+					statistics.Preview = !fullResolution;
+					statistics.Latency = std::chrono::duration<double, std::milli>(Clock::now() - current->SubmitTime).count();
+					publish();
+					continue;
+				}
+			}
+
+			const bool complete = pipeline.ContinueProgressive(current->Request.StepBudget);
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Progress = complete ? -1.0f : pipeline.GetProgressiveProgress();
+			}
+			if (!complete)
+			{
+				if (m_Specification.OnProgress)
+					m_Specification.OnProgress();
+				continue;
+			}
+			statistics.FullRenderTime = pipeline.GetProgressiveTime();
+			statistics.StepCount = pipeline.GetProgressiveCallCount();
+			statistics.Preview = false;
+			statistics.Latency = std::chrono::duration<double, std::milli>(Clock::now() - current->SubmitTime).count();
+			publish();
+		}
+
+		// Released on this context; the slots stay for the UI thread until destruction.
+		current.reset();
+	}
+	m_Specification.Context->DetachCurrent();
+}
+
+void ViewportRenderer::Publish(const askygg::Texture2D& output, ViewportRenderStatistics statistics)
+{
+	uint32_t				   slot = NoSlot;
+	askygg::Ref<askygg::Fence> released;
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		// An output the UI thread has not taken yet is simply replaced; otherwise any slot it is not showing.
+		slot = m_ReadySlot;
+		m_ReadySlot = NoSlot;
+		for (uint32_t i = 0; slot == NoSlot && i < (uint32_t)m_Slots.size(); i++)
+		{
+			if (i != m_ShownSlot)
+				slot = i;
+		}
+		released = std::move(m_Slots[slot].Released);
+	}
+	if (released)
+		released->WaitGPU();
+
+	// Neither shown nor ready, so the UI thread does not touch the slot meanwhile.
+	askygg::Ref<askygg::Texture2D>& texture = m_Slots[slot].Texture;
+	if (!texture || texture->GetWidth() != output.GetWidth() || texture->GetHeight() != output.GetHeight()
+		|| texture->GetSpecification().InternalFormat != output.GetSpecification().InternalFormat)
+	{
+		askygg::Texture2DSpecification outputSpec = output.GetSpecification();
+		outputSpec.MipLevels = 1;
+		outputSpec.Name = "Viewport Output " + std::to_string(slot);
+		texture = askygg::CreateRef<askygg::Texture2D>(outputSpec);
+	}
+	texture->CopyFrom(output.GetID());
+	// Complete before it is handed over: the UI context samples it without waiting for anything.
+	askygg::Fence copied;
+	copied.Wait();
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_ReadySlot = slot;
+		m_ReadyStatistics = std::move(statistics);
+	}
+	m_PublishedCount++;
+	if (m_Specification.OnProgress)
+		m_Specification.OnProgress();
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "askygg/core/Memory.h"
+#include "askygg/renderer/Fence.h"
+#include "askygg/renderer/GraphicsContext.h"
+#include "askygg/renderer/Texture.h"
+
+#include "ImagePass.h"
+
+#include <yaml-cpp/yaml.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+struct ViewportRendererSpecification
+{
+	// The pipeline reads its defaults from this file; every request carries the values being edited.
+	std::string							 SettingsFileName;
+	// Shares objects with the main context; made current on the render thread, so it must not be current elsewhere.
+	askygg::Ref<askygg::GraphicsContext> Context;
+	// Called on the render thread after every step of a render and once an output is published, e.g. to wake a main
+	// loop that idles.
+	std::function<void()>				 OnProgress;
+};
+
+// Everything the viewport's image depends on, as the UI thread saw it.  Never changed once submitted.
+struct ViewportRenderRequest
+{
+	// ImagePipeline::ExportSettings(); only read when SettingsHash differs from the last request's.
+	YAML::Node	Settings;
+	uint64_t	SettingsHash = 0;
+	// Held until the request is superseded, so the GL name cannot be reused for another image meanwhile.
+	askygg::Ref<askygg::Texture2D> Input;
+	// Full-resolution width of the image the input shows, which may be a reduced-scale preview of it.
+	float		ImageWidth = 0.0f;
+	// Renders a copy of this input mip instead of the input, for previews while a setting is dragged.
+	uint32_t	PreviewMip = 0;
+	// GPU milliseconds per step of a full-size render, after which newer requests are looked at; 0 renders in one go.
+	float		StepBudget = 0.0f;
+	// Follows the UI context's commands the input depends on, e.g. its upload.
+	askygg::Ref<askygg::Fence> Ready;
+};
+
+// What the render thread measured for the output last published.
+struct ViewportRenderStatistics
+{
+	std::unordered_map<ImagePassType, double> PassExecutionTimes;
+	std::unordered_set<ImagePassType>		  ElidedPasses;
+	std::unordered_set<ImagePassType>		  CachedPasses;
+	uint64_t								  PassCacheHits = 0;
+	uint64_t								  PassCacheMisses = 0;
+	uint64_t								  MemorySize = 0;
+	uint64_t								  PeakMemorySize = 0;
+	uint32_t								  TransientTextureCount = 0;
+	// GPU milliseconds of the last full-size and preview render.
+	double									  FullRenderTime = 0.0;
+	double									  PreviewRenderTime = 0.0;
+	// Steps the last full-size render took.
+	uint32_t								  StepCount = 0;
+	bool									  Preview = false;
+	// Milliseconds from Submit() to the output being published.
+	double									  Latency = 0.0;
+};
+
+// Runs the editor's display pipeline on its own thread and context, so a slow render never holds up the UI.  The UI
+// thread submits immutable requests; only the newest is rendered, and a full-size render in progress is abandoned
+// between steps once a newer one arrives.  Finished outputs are copied into one of three textures, fenced, and handed
+// to the UI thread, which keeps showing the previous output until the next one is complete.
+class ViewportRenderer
+{
+public:
+	explicit ViewportRenderer(ViewportRendererSpecification specification);
+	// Abandons the render in progress and waits for the thread; needs the GL context.
+	~ViewportRenderer();
+
+	ViewportRenderer(const ViewportRenderer&) = delete;
+	ViewportRenderer& operator=(const ViewportRenderer&) = delete;
+
+	// Replaces a request the thread has not started yet.
+	void Submit(ViewportRenderRequest request);
+	// Takes the newest published output for display.  Needs the GL context; call before drawing.  True if it changed.
+	bool Update();
+
+	// The output on display; zero before the first one.
+	uint32_t GetOutputTextureID() const;
+	// True while a request is waiting or being rendered.
+	bool	 IsBusy() const;
+	// Progress of the full-size render in steps, 0 to 1; negative when none is in progress.
+	float	 GetProgress() const;
+	// Statistics that came with the output on display.
+	const ViewportRenderStatistics& GetStatistics() const { return m_Statistics; }
+	uint64_t GetPublishedCount() const { return m_PublishedCount; }
+	// Requests replaced before the thread started them, and renders abandoned for a newer request.
+	uint64_t GetSupersededCount() const { return m_SupersededCount; }
+	uint64_t GetAbandonedCount() const { return m_AbandonedCount; }
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct PendingRequest
+	{
+		ViewportRenderRequest Request;
+		Clock::time_point	  SubmitTime;
+	};
+
+	struct OutputSlot
+	{
+		askygg::Ref<askygg::Texture2D> Texture;
+		// Set by the UI thread when it stops showing the slot; the render thread waits for it before writing.
+		askygg::Ref<askygg::Fence>	   Released;
+	};
+
+	static constexpr uint32_t NoSlot = UINT32_MAX;
+
+	void Run();
+	// Copies the pipeline's output into a slot the UI thread is not showing and publishes it.
+	void Publish(const askygg::Texture2D& output, ViewportRenderStatistics statistics);
+
+private:
+	ViewportRendererSpecification m_Specification;
+	std::thread					  m_Thread;
+
+	// Shared with the render thread.
+	mutable std::mutex			  m_Mutex;
+	std::condition_variable		  m_Condition;
+	// Held by pointer: assigning a YAML::Node rebinds the node it refers to, which every copy of it shares.
+	askygg::Scope<PendingRequest> m_Pending;
+	bool						  m_Rendering = false;
+	float						  m_Progress = -1.0f;
+	std::array<OutputSlot, 3>	  m_Slots;
+	uint32_t					  m_ShownSlot = NoSlot;
+	uint32_t					  m_ReadySlot = NoSlot;
+	ViewportRenderStatistics	  m_ReadyStatistics;
+	bool						  m_Stopped = false;
+
+	std::atomic<uint64_t> m_SupersededCount = 0;
+	std::atomic<uint64_t> m_AbandonedCount = 0;
+	std::atomic<uint64_t> m_PublishedCount = 0;
+
+	// UI thread only.
+	ViewportRenderStatistics m_Statistics;
+};
@@ -0,0 +1,15 @@
+#include "DaemonLayer.h"
+#include "ImageEditor.h"
+
+DaemonLayer::DaemonLayer(std::string socketPath, std::string outputDirectory, std::string configFilePath)
+	: m_SocketPath(std::move(socketPath)), m_OutputDirectory(std::move(outputDirectory)),
+	  m_ConfigFilePath(std::move(configFilePath)) {}
+
+void DaemonLayer::OnAttach()
+{
+	askygg::Application::GetWindow().ToggleIsHidden(true);
+	ImageEditor::InitializeImageEditor(std::string(), m_OutputDirectory, m_ConfigFilePath);
+	ImageEditor::ServeJobs(m_SocketPath);
+	ImageEditor::ShutdownImageEditor();
+	askygg::Application::Close();
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "askygg.h"
+
+class DaemonLayer : public askygg::Layer
+{
+public:
+	DaemonLayer(std::string socketPath, std::string outputDirectory, std::string configFilePath);
+	void OnAttach() override;
+	void OnDetach() override {}
+
+private:
+	std::string m_SocketPath;
+	std::string m_OutputDirectory;
+	std::string m_ConfigFilePath;
+};
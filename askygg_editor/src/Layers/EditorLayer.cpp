@@ -2,14 +2,16 @@
 #include "ImageEditor.h"
 
 EditorLayer::EditorLayer(std::string inputDirectory, std::string outputDirectory,
-	std::string configFilePath)
-	: m_InputDirectory(std::move(inputDirectory)), m_OutputDirectory(std::move(outputDirectory)), m_ConfigFilePath(std::move(configFilePath)) {}
+	std::string configFilePath, bool renderOnDemand)
+	: m_InputDirectory(std::move(inputDirectory)), m_OutputDirectory(std::move(outputDirectory)), m_ConfigFilePath(std::move(configFilePath)),
+	  m_RenderOnDemand(renderOnDemand) {}
 
 void EditorLayer::OnAttach()
 {
 	ImageEditor::InitializeImageEditor(m_InputDirectory, m_OutputDirectory, m_ConfigFilePath);
 	ImageEditor::LoadTextureSet(m_InputDirectory);
-	m_Viewport = askygg::CreateRef<askygg::UI::Viewport>(ImageEditor::GetOutputFBO());
+	m_Viewport = askygg::CreateRef<askygg::UI::Viewport>();
+	askygg::Application::GetApplication().SetRenderOnDemand(m_RenderOnDemand);
 }
 
 void EditorLayer::OnDetach() {}
@@ -25,7 +27,9 @@ void EditorLayer::OnImGuiRender()
 	askygg::UI::Dockspace::Draw();
 	askygg::UI::StatisticsPanel::Draw();
 	ImageEditor::DrawImageEditorUI();
+	m_Viewport->SetTexture(ImageEditor::GetDisplayTextureID(), ImageEditor::GetDisplayTextureSize());
 	m_Viewport->Draw();
+	ImageEditor::SetViewportSize(m_Viewport->GetViewportSize());
 	askygg::UI::Dockspace::End();
 }
 
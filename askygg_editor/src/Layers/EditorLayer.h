@@ -5,7 +5,9 @@
 class EditorLayer : public askygg::Layer
 {
 public:
-	EditorLayer(std::string inputDirectory, std::string outputDirectory, std::string configFilePath);
+	// With renderOnDemand the application idles while nothing changes instead of redrawing continuously.
+	EditorLayer(std::string inputDirectory, std::string outputDirectory, std::string configFilePath,
+		bool renderOnDemand = true);
 	~EditorLayer() override = default;
 
 	void OnAttach() override;
@@ -19,4 +21,5 @@ private:
 	std::string						  m_InputDirectory;
 	std::string						  m_OutputDirectory;
 	std::string						  m_ConfigFilePath;
+	bool							  m_RenderOnDemand;
 };
\ No newline at end of file
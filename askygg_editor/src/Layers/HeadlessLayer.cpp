@@ -1,15 +1,26 @@
 #include "HeadlessLayer.h"
 #include "ImageEditor.h"
 
-HeadlessLayer::HeadlessLayer(std::string inputDirectory, std::string outputDirectory,
-	std::string configFilePath)
-	: m_InputDirectory(std::move(inputDirectory)), m_OutputDirectory(std::move(outputDirectory)), m_ConfigFilePath(std::move(configFilePath)) {}
+HeadlessLayer::HeadlessLayer(InputEnumeratorSpecification input, std::string outputDirectory,
+	std::string configFilePath, uint32_t workerCount, bool scalingReport, std::string outputArchive,
+	OutputWriterSpecification output, std::string variantsFileName, const CpuPipelineSpecification* cpuBackend)
+	: m_Input(std::move(input)), m_OutputDirectory(std::move(outputDirectory)), m_ConfigFilePath(std::move(configFilePath)), m_WorkerCount(workerCount), m_ScalingReport(scalingReport), m_OutputArchive(std::move(outputArchive)), m_Output(output), m_VariantsFileName(std::move(variantsFileName))
+{
+	if (cpuBackend)
+		m_CpuBackend = askygg::CreateScope<CpuPipelineSpecification>(*cpuBackend);
+}
 
 void HeadlessLayer::OnAttach()
 {
 	askygg::Application::GetWindow().ToggleIsHidden(true);
-	ImageEditor::InitializeImageEditor(m_InputDirectory, m_OutputDirectory, m_ConfigFilePath);
-	ImageEditor::HeadlessProcessDirectory();
-	ImageEditor::ShutdownImageEditor();
+	Run();
 	askygg::Application::Close();
 }
+
+void HeadlessLayer::Run()
+{
+	ImageEditor::InitializeImageEditor(m_Input.Root, m_OutputDirectory, m_ConfigFilePath, m_CpuBackend.get());
+	ImageEditor::HeadlessProcessDirectory(m_Input, m_WorkerCount, m_ScalingReport, m_OutputArchive, m_Output,
+		m_VariantsFileName);
+	ImageEditor::ShutdownImageEditor();
+}
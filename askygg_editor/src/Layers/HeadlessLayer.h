@@ -1,17 +1,33 @@
 #pragma once
 
 #include "askygg.h"
+#include "ImageEditor/InputEnumerator.h"
+#include "ImageEditor/OutputWriter.h"
+#include "ImageEditor/Cpu/CpuPipeline.h"
 
 class HeadlessLayer : public askygg::Layer
 {
 public:
-	HeadlessLayer(std::string inputDirectory, std::string outputDirectory,
-		std::string configFilePath);
+	HeadlessLayer(InputEnumeratorSpecification input, std::string outputDirectory,
+		std::string configFilePath, uint32_t workerCount = 1, bool scalingReport = false,
+		std::string outputArchive = std::string(), OutputWriterSpecification output = OutputWriterSpecification(),
+		std::string variantsFileName = std::string(), const CpuPipelineSpecification* cpuBackend = nullptr);
 	void OnAttach() override;
 	void OnDetach() override {}
 
+	// Processes the input and shuts the editor down again.  With the CPU backend this needs no window or context,
+	// so it may run without an Application.
+	void Run();
+
 private:
-	std::string m_InputDirectory;
-	std::string m_OutputDirectory;
-	std::string m_ConfigFilePath;
+	InputEnumeratorSpecification m_Input;
+	std::string					 m_OutputDirectory;
+	std::string					 m_ConfigFilePath;
+	uint32_t					 m_WorkerCount;
+	bool						 m_ScalingReport;
+	std::string					 m_OutputArchive;
+	OutputWriterSpecification	 m_Output;
+	std::string					 m_VariantsFileName;
+	// Null for the GPU backend.
+	askygg::Scope<CpuPipelineSpecification> m_CpuBackend;
 };
\ No newline at end of file
@@ -0,0 +1,14 @@
+#include "StreamLayer.h"
+#include "ImageEditor.h"
+
+StreamLayer::StreamLayer(FrameStreamSpecification specification, std::string configFilePath)
+	: m_Specification(specification), m_ConfigFilePath(std::move(configFilePath)) {}
+
+void StreamLayer::OnAttach()
+{
+	askygg::Application::GetWindow().ToggleIsHidden(true);
+	ImageEditor::InitializeImageEditor(std::string(), std::string(), m_ConfigFilePath);
+	ImageEditor::StreamFrames(m_Specification);
+	ImageEditor::ShutdownImageEditor();
+	askygg::Application::Close();
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "askygg.h"
+#include "FrameStream.h"
+
+class StreamLayer : public askygg::Layer
+{
+public:
+	StreamLayer(FrameStreamSpecification specification, std::string configFilePath);
+	void OnAttach() override;
+	void OnDetach() override {}
+
+private:
+	FrameStreamSpecification m_Specification;
+	std::string				 m_ConfigFilePath;
+};
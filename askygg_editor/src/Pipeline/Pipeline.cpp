@@ -0,0 +1,178 @@
+#include "Pipeline.h"
+
+#include "askygg/core/Log.h"
+#include "askygg/platform/PlatformPath.h"
+#include "askygg/renderer/GraphicsContext.h"
+#include "askygg/renderer/PixelBuffer.h"
+#include "askygg/renderer/PlatformRenderAPI.h"
+#include "askygg/renderer/Texture.h"
+
+#include "ImageEditor/ImagePipeline.h"
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+
+namespace askygg
+{
+	// Owns the shader programs every instance's context shares.  Created with the first instance, kept for the process.
+	static std::mutex			s_RootMutex;
+	static Ref<GraphicsContext> s_RootContext;
+
+	// Makes a context current for one scope and detaches it however the scope is left, exceptions included.
+	class CurrentContextScope
+	{
+	public:
+		explicit CurrentContextScope(GraphicsContext& context)
+			: m_Context(context) { m_Context.MakeCurrent(); }
+		~CurrentContextScope() { m_Context.DetachCurrent(); }
+
+		CurrentContextScope(const CurrentContextScope&) = delete;
+		CurrentContextScope& operator=(const CurrentContextScope&) = delete;
+
+	private:
+		GraphicsContext& m_Context;
+	};
+
+	struct Pipeline::State
+	{
+		Ref<GraphicsContext> Context;
+		Scope<ImagePipeline> Images;
+		std::mutex			 Mutex;
+
+		PipelineImage						  TargetLayout;
+		std::array<Ref<Texture2D>, 2>		  Inputs;
+		std::array<Scope<PixelPackBuffer>, 2> Readbacks;
+
+		void PrepareTargets(const PipelineImage& layout);
+	};
+
+	Pipeline::Pipeline(const std::string& configFilePath, const std::string& assetDirectory)
+		: m_State(CreateScope<State>())
+	{
+		if (!std::filesystem::is_regular_file(configFilePath))
+			throw std::runtime_error("config file '" + configFilePath + "' does not exist");
+
+		{
+			std::lock_guard<std::mutex> lock(s_RootMutex);
+			if (!s_RootContext)
+			{
+				Log::Init();
+				if (!assetDirectory.empty())
+					OverrideExecutablePath(assetDirectory);
+				PlatformRenderAPI::InitializePlatformRendererType();
+				s_RootContext = GraphicsContext::CreateHeadless();
+				s_RootContext->Initialize();
+				ImagePipeline::LoadShaders();
+				s_RootContext->DetachCurrent();
+			}
+			m_State->Context = GraphicsContext::CreateHeadless(s_RootContext.get());
+		}
+
+		CurrentContextScope current(*m_State->Context);
+		try
+		{
+			m_State->Images = CreateScope<ImagePipeline>(configFilePath);
+			m_State->Images->Initialize(true);
+		}
+		catch (...)
+		{
+			m_State->Images = nullptr;
+			throw;
+		}
+	}
+
+	Pipeline::~Pipeline()
+	{
+		std::lock_guard<std::mutex> lock(m_State->Mutex);
+		CurrentContextScope			current(*m_State->Context);
+		m_State->Inputs = {};
+		m_State->Readbacks = {};
+		if (m_State->Images)
+			m_State->Images->Shutdown();
+		m_State->Images = nullptr;
+	}
+
+	void Pipeline::Process(const std::vector<PipelineImage>& inputs, const std::vector<PipelineImage>& outputs)
+	{
+		YGG_ASSERT(inputs.size() == outputs.size(), "Pipeline: every input needs an output.");
+		if (inputs.empty())
+			return;
+
+		// The targets are sized from the first input, so any other layout would overrun them or the caller's buffers.
+		const PipelineImage& layout = inputs.front();
+		for (size_t i = 0; i < inputs.size(); i++)
+		{
+			if (!inputs[i].HasSameLayout(layout) || !outputs[i].HasSameLayout(layout))
+				throw std::invalid_argument("image " + std::to_string(i) + " differs in size or format from the first input");
+			if (!inputs[i].Data || !outputs[i].Data)
+				throw std::invalid_argument("image " + std::to_string(i) + " has no pixel data");
+		}
+
+		std::lock_guard<std::mutex> lock(m_State->Mutex);
+		CurrentContextScope			current(*m_State->Context);
+		m_State->PrepareTargets(layout);
+
+		const glm::vec2 size = { layout.Width, layout.Height };
+		const auto dataLayout = layout.Channels == 3 ? ImageUtils::ImageDataLayout::RGB : ImageUtils::ImageDataLayout::RGBA;
+		const auto dataType = layout.Float ? ImageUtils::ImageDataType::Float : ImageUtils::ImageDataType::UByte;
+
+		auto drain = [&](size_t index)
+		{
+			auto& readback = m_State->Readbacks[index % 2];
+			std::memcpy(outputs[index].Data, readback->Map(), layout.GetSize());
+			readback->Unmap();
+		};
+
+		for (size_t i = 0; i < inputs.size(); i++)
+		{
+			const uint32_t slot = i % 2;
+			m_State->Inputs[slot]->SetData(inputs[i].Data, (uint32_t)layout.GetSize());
+			m_State->Images->Submit(size, m_State->Inputs[slot]->GetID(), RenderGraphAccess::Readback, false);
+			m_State->Readbacks[slot]->ReadTexture(*m_State->Images->GetOutputTexture(), dataLayout, dataType);
+			if (i > 0)
+				drain(i - 1);
+		}
+		drain(inputs.size() - 1);
+	}
+
+	void Pipeline::ProcessRGBA(const uint8_t* input, uint8_t* output, uint32_t width, uint32_t height)
+	{
+		PipelineImage source = { const_cast<uint8_t*>(input), width, height, 4, false };
+		PipelineImage target = source;
+		target.Data = output;
+		Process({ source }, { target });
+	}
+
+	void Pipeline::State::PrepareTargets(const PipelineImage& layout)
+	{
+		if (Inputs[0] && layout.HasSameLayout(TargetLayout))
+			return;
+
+		Texture2DSpecification inputSpec = {
+			ImageUtils::WrapMode::ClampToEdge,
+			ImageUtils::WrapMode::ClampToEdge,
+			ImageUtils::FilterMode::Linear,
+			ImageUtils::FilterMode::Linear,
+			layout.Float ? ImageUtils::ImageInternalFormat::RGBA32F : ImageUtils::ImageInternalFormat::RGBA8,
+			layout.Channels == 3 ? ImageUtils::ImageDataLayout::RGB : ImageUtils::ImageDataLayout::RGBA,
+			layout.Float ? ImageUtils::ImageDataType::Float : ImageUtils::ImageDataType::UByte,
+			layout.Width,
+			layout.Height
+		};
+		inputSpec.MipLevels = 1;
+
+		for (uint32_t i = 0; i < 2; i++)
+		{
+			inputSpec.Name = "Pipeline Input " + std::to_string(i);
+			Inputs[i] = CreateRef<Texture2D>(inputSpec);
+			Readbacks[i] = CreateScope<PixelPackBuffer>(layout.GetSize());
+		}
+
+		// Float callers get the 16-bit output rather than the 8-bit one.
+		Images->SetOutputFormat(layout.Float ? ImageUtils::ImageInternalFormat::RGBA16 : ImageUtils::ImageInternalFormat::RGBA8);
+		TargetLayout = layout;
+	}
+} // namespace askygg
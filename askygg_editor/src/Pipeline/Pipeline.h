@@ -0,0 +1,54 @@
+#pragma once
+
+#include "askygg/core/Memory.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace askygg
+{
+	// Caller-owned, tightly packed HxWxC pixels, top row first.  Float images hold display-encoded values in [0, 1].
+	struct PipelineImage
+	{
+		void*	 Data = nullptr;
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		uint32_t Channels = 4;
+		bool	 Float = false;
+
+		uint64_t GetSize() const { return (uint64_t)Width * Height * Channels * (Float ? 4 : 1); }
+		bool	 HasSameLayout(const PipelineImage& other) const
+		{
+			return Width == other.Width && Height == other.Height && Channels == other.Channels && Float == other.Float;
+		}
+	};
+
+	// The image pipeline as an embeddable object: it owns its passes, its textures and the settings it was created
+	// with, and runs on a headless context of its own.  Nothing here touches Application, a window or ImGui.
+	// Inputs are uploaded straight from the caller's buffer and results are copied out of a pixel pack buffer, so the
+	// host never stages a copy.  Calls may come from any thread; they are serialized per instance, and separate
+	// instances run concurrently.  Throws std::runtime_error (or YAML::Exception) when the settings cannot be loaded.
+	class Pipeline
+	{
+	public:
+		// assetDirectory holds assets/ (the executable's directory if empty); only the first instance in a process
+		// uses it, since shaders are compiled once.
+		Pipeline(const std::string& configFilePath, const std::string& assetDirectory = "");
+		~Pipeline();
+
+		Pipeline(const Pipeline&) = delete;
+		Pipeline& operator=(const Pipeline&) = delete;
+
+		// Processes inputs[i] into outputs[i].  Every image in a call must share one layout; float inputs produce float
+		// outputs with 16 bits of precision, byte inputs byte outputs.  Uploading image n overlaps the GPU finishing n-1.
+		// Throws std::invalid_argument, before touching the GPU, if an image's size or format differs from the first.
+		void Process(const std::vector<PipelineImage>& inputs, const std::vector<PipelineImage>& outputs);
+		// One RGBA8 image; input and output may be the same buffer.
+		void ProcessRGBA(const uint8_t* input, uint8_t* output, uint32_t width, uint32_t height);
+
+	private:
+		struct State;
+		Scope<State> m_State;
+	};
+} // namespace askygg
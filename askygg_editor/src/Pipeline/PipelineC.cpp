@@ -0,0 +1,66 @@
+#include "askygg_pipeline.h"
+#include "Pipeline.h"
+
+#include <exception>
+#include <string>
+
+// Exceptions never cross the C boundary; they end up here instead.
+static thread_local std::string s_LastError;
+
+struct askygg_pipeline
+{
+	askygg::Pipeline Instance;
+
+	askygg_pipeline(const char* configPath, const char* assetDirectory)
+		: Instance(configPath, assetDirectory ? assetDirectory : "") {}
+};
+
+askygg_pipeline* askygg_pipeline_create(const char* config_path, const char* asset_dir)
+{
+	if (!config_path)
+	{
+		s_LastError = "config_path is NULL";
+		return nullptr;
+	}
+
+	try
+	{
+		return new askygg_pipeline(config_path, asset_dir);
+	}
+	catch (const std::exception& e)
+	{
+		s_LastError = e.what();
+		return nullptr;
+	}
+}
+
+int askygg_pipeline_process_rgba(askygg_pipeline* pipeline, const uint8_t* input, uint8_t* output, uint32_t width,
+	uint32_t height)
+{
+	if (!pipeline || !input || !output || width == 0 || height == 0)
+	{
+		s_LastError = "invalid argument";
+		return -1;
+	}
+
+	try
+	{
+		pipeline->Instance.ProcessRGBA(input, output, width, height);
+		return 0;
+	}
+	catch (const std::exception& e)
+	{
+		s_LastError = e.what();
+		return -1;
+	}
+}
+
+void askygg_pipeline_destroy(askygg_pipeline* pipeline)
+{
+	delete pipeline;
+}
+
+const char* askygg_pipeline_last_error(void)
+{
+	return s_LastError.c_str();
+}
@@ -0,0 +1,33 @@
+/* C interface to askygg::Pipeline, for hosts that cannot take a C++ dependency.
+ *
+ * A pipeline is created from a settings file and processes tightly packed RGBA8 images, top row first.  Every
+ * pipeline runs on its own headless context: separate pipelines may be used from separate threads at once, and calls
+ * on one pipeline are serialized.  Failures return NULL or a non-zero value; askygg_pipeline_last_error() describes
+ * the most recent failure on the calling thread. */
+#ifndef ASKYGG_PIPELINE_H
+#define ASKYGG_PIPELINE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct askygg_pipeline askygg_pipeline;
+
+/* asset_dir holds assets/; NULL means the executable's directory.  Only the first pipeline in a process uses it. */
+askygg_pipeline* askygg_pipeline_create(const char* config_path, const char* asset_dir);
+
+/* Writes width * height * 4 bytes to output.  input and output may point to the same buffer. */
+int askygg_pipeline_process_rgba(askygg_pipeline* pipeline, const uint8_t* input, uint8_t* output,
+	uint32_t width, uint32_t height);
+
+void askygg_pipeline_destroy(askygg_pipeline* pipeline);
+
+const char* askygg_pipeline_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,320 @@
+// Python bindings: askygg.Pipeline(config_path).process(image, out=None) and .process_batch(images, outs=None).
+// Images are any C-contiguous HxWx3 / HxWx4 uint8 or float32 buffer (NumPy arrays included); nothing is copied on
+// the way in and the result is written straight into out.  Written against the plain C API so the module needs
+// nothing but Python's headers; NumPy is only imported at runtime to allocate outputs the caller did not pass.
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "Pipeline/Pipeline.h"
+
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+struct PipelineObject
+{
+	PyObject_HEAD
+	askygg::Pipeline* Pipeline;
+};
+
+// A Py_buffer that releases itself.
+class BufferView
+{
+public:
+	BufferView() = default;
+	~BufferView()
+	{
+		if (m_Acquired)
+			PyBuffer_Release(&m_View);
+	}
+	BufferView(const BufferView&) = delete;
+	BufferView& operator=(const BufferView&) = delete;
+
+	bool Acquire(PyObject* object, bool writable)
+	{
+		int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+		m_Acquired = PyObject_GetBuffer(object, &m_View, flags) == 0;
+		return m_Acquired;
+	}
+
+	const Py_buffer& Get() const { return m_View; }
+
+private:
+	Py_buffer m_View{};
+	bool	  m_Acquired = false;
+};
+
+// Describes a buffer as a PipelineImage, or sets a ValueError and returns false.
+static bool DescribeImage(const Py_buffer& view, const char* name, askygg::PipelineImage& image)
+{
+	if (view.ndim != 3 || (view.shape[2] != 3 && view.shape[2] != 4) || view.shape[0] <= 0 || view.shape[1] <= 0)
+	{
+		PyErr_Format(PyExc_ValueError, "%s must have shape (height, width, 3) or (height, width, 4)", name);
+		return false;
+	}
+
+	// '@', '=' and '<' all mean native little-endian here.
+	const char* format = view.format ? view.format : "B";
+	if (*format == '@' || *format == '=' || *format == '<')
+		format++;
+	if (std::strcmp(format, "B") == 0 && view.itemsize == 1)
+		image.Float = false;
+	else if (std::strcmp(format, "f") == 0 && view.itemsize == 4)
+		image.Float = true;
+	else
+	{
+		PyErr_Format(PyExc_ValueError, "%s must be uint8 or float32", name);
+		return false;
+	}
+
+	image.Data = view.buf;
+	image.Height = (uint32_t)view.shape[0];
+	image.Width = (uint32_t)view.shape[1];
+	image.Channels = (uint32_t)view.shape[2];
+	return true;
+}
+
+// numpy.empty_like(image) without linking against NumPy.
+static PyObject* AllocateOutput(const askygg::PipelineImage& image)
+{
+	PyObject* numpy = PyImport_ImportModule("numpy");
+	if (!numpy)
+	{
+		PyErr_Clear();
+		PyErr_SetString(PyExc_TypeError, "NumPy is not installed; pass a preallocated out buffer instead");
+		return nullptr;
+	}
+	PyObject* output = PyObject_CallMethod(numpy, "empty", "((III)s)", image.Height, image.Width, image.Channels,
+		image.Float ? "float32" : "uint8");
+	Py_DECREF(numpy);
+	return output;
+}
+
+static int Pipeline_Init(PipelineObject* self, PyObject* args, PyObject* kwargs)
+{
+	static const char* keywords[] = { "config_path", "asset_dir", nullptr };
+	const char*		   configPath = nullptr;
+	const char*		   assetDirectory = nullptr;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|z", const_cast<char**>(keywords), &configPath, &assetDirectory))
+		return -1;
+	// The editor's source directory unless told otherwise; it is where the build links its assets from.
+	if (!assetDirectory)
+		assetDirectory = YGG_PYTHON_ASSET_DIR;
+
+	if (!std::filesystem::is_regular_file(configPath))
+	{
+		PyErr_Format(PyExc_FileNotFoundError, "config file '%s' does not exist", configPath);
+		return -1;
+	}
+	if (!std::filesystem::is_directory(std::filesystem::path(assetDirectory) / "assets"))
+	{
+		PyErr_Format(PyExc_FileNotFoundError, "'%s' has no assets directory", assetDirectory);
+		return -1;
+	}
+
+	delete self->Pipeline;
+	self->Pipeline = nullptr;
+
+	// Compiling shaders and building the passes takes a while; other Python threads may run meanwhile.
+	askygg::Pipeline* pipeline = nullptr;
+	std::string	   error;
+	Py_BEGIN_ALLOW_THREADS
+	try
+	{
+		pipeline = new askygg::Pipeline(configPath, assetDirectory);
+	}
+	catch (const std::exception& e)
+	{
+		error = e.what();
+	}
+	Py_END_ALLOW_THREADS
+
+	if (!pipeline)
+	{
+		PyErr_Format(PyExc_RuntimeError, "cannot create the pipeline: %s", error.c_str());
+		return -1;
+	}
+	self->Pipeline = pipeline;
+	return 0;
+}
+
+static void Pipeline_Dealloc(PipelineObject* self)
+{
+	delete self->Pipeline;
+	Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+// Shared by process() and process_batch(): validates and pairs up the buffers, runs the pipeline with the GIL
+// released and returns the outputs.
+static PyObject* ProcessImages(PipelineObject* self, PyObject* images, PyObject* outs, bool batch)
+{
+	if (!self->Pipeline)
+	{
+		PyErr_SetString(PyExc_RuntimeError, "Pipeline was not initialized");
+		return nullptr;
+	}
+
+	PyObject* imageList = PySequence_Fast(images, "images must be a sequence");
+	if (!imageList)
+		return nullptr;
+	const Py_ssize_t count = PySequence_Fast_GET_SIZE(imageList);
+
+	PyObject* outputList = nullptr;
+	if (outs && outs != Py_None)
+	{
+		outputList = PySequence_Fast(outs, "outs must be a sequence");
+		if (!outputList || PySequence_Fast_GET_SIZE(outputList) != count)
+		{
+			if (outputList)
+				PyErr_SetString(PyExc_ValueError, "outs must have one buffer per image");
+			Py_XDECREF(outputList);
+			Py_DECREF(imageList);
+			return nullptr;
+		}
+	}
+	else
+	{
+		outputList = PyList_New(count);
+		for (Py_ssize_t i = 0; i < count; i++)
+		{
+			Py_INCREF(Py_None);
+			PyList_SET_ITEM(outputList, i, Py_None);
+		}
+	}
+
+	std::vector<BufferView>			   inputViews(count), outputViews(count);
+	std::vector<askygg::PipelineImage> inputs(count), outputs(count);
+	PyObject*						   result = PyList_New(count);
+	bool							   valid = true;
+	for (Py_ssize_t i = 0; i < count && valid; i++)
+	{
+		valid = inputViews[i].Acquire(PySequence_Fast_GET_ITEM(imageList, i), false)
+			&& DescribeImage(inputViews[i].Get(), "image", inputs[i]);
+		if (valid && i > 0 && !inputs[i].HasSameLayout(inputs[0]))
+		{
+			PyErr_SetString(PyExc_ValueError, "every image in a batch must have the same shape and dtype");
+			valid = false;
+		}
+		if (!valid)
+			break;
+
+		PyObject* output = PySequence_Fast_GET_ITEM(outputList, i);
+		if (output == Py_None)
+			output = AllocateOutput(inputs[i]);
+		else
+			Py_INCREF(output);
+		if (!output)
+		{
+			valid = false;
+			break;
+		}
+		PyList_SET_ITEM(result, i, output);
+
+		valid = outputViews[i].Acquire(output, true) && DescribeImage(outputViews[i].Get(), "out", outputs[i]);
+		if (valid && !outputs[i].HasSameLayout(inputs[i]))
+		{
+			PyErr_SetString(PyExc_ValueError, "out must have the same shape and dtype as its image");
+			valid = false;
+		}
+	}
+
+	if (valid)
+	{
+		// The buffers stay exported until the views are released, so the arrays cannot be resized meanwhile.
+		Py_BEGIN_ALLOW_THREADS
+		self->Pipeline->Process(inputs, outputs);
+		Py_END_ALLOW_THREADS
+	}
+
+	Py_DECREF(imageList);
+	Py_DECREF(outputList);
+	if (!valid)
+	{
+		Py_DECREF(result);
+		return nullptr;
+	}
+	if (batch)
+		return result;
+
+	PyObject* single = PyList_GET_ITEM(result, 0);
+	Py_INCREF(single);
+	Py_DECREF(result);
+	return single;
+}
+
+static PyObject* Pipeline_Process(PipelineObject* self, PyObject* args, PyObject* kwargs)
+{
+	static const char* keywords[] = { "image", "out", nullptr };
+	PyObject*		   image = nullptr;
+	PyObject*		   out = Py_None;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", const_cast<char**>(keywords), &image, &out))
+		return nullptr;
+
+	PyObject* images = PyTuple_Pack(1, image);
+	PyObject* outs = PyTuple_Pack(1, out);
+	PyObject* result = ProcessImages(self, images, outs, false);
+	Py_DECREF(images);
+	Py_DECREF(outs);
+	return result;
+}
+
+static PyObject* Pipeline_ProcessBatch(PipelineObject* self, PyObject* args, PyObject* kwargs)
+{
+	static const char* keywords[] = { "images", "outs", nullptr };
+	PyObject*		   images = nullptr;
+	PyObject*		   outs = Py_None;
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", const_cast<char**>(keywords), &images, &outs))
+		return nullptr;
+	return ProcessImages(self, images, outs, true);
+}
+
+static PyMethodDef s_PipelineMethods[] = {
+	{ "process", (PyCFunction)(void (*)(void))Pipeline_Process, METH_VARARGS | METH_KEYWORDS,
+		"process(image, out=None) -> ndarray\n\n"
+		"Runs the pipeline on one HxWx3 or HxWx4 uint8/float32 image and returns out (allocated if None)." },
+	{ "process_batch", (PyCFunction)(void (*)(void))Pipeline_ProcessBatch, METH_VARARGS | METH_KEYWORDS,
+		"process_batch(images, outs=None) -> list\n\n"
+		"Runs the pipeline on images of one shape and dtype without holding the GIL, overlapping uploads with GPU "
+		"work." },
+	{ nullptr, nullptr, 0, nullptr }
+};
+
+static PyTypeObject s_PipelineType = {
+	PyVarObject_HEAD_INIT(nullptr, 0)
+};
+
+static PyModuleDef s_Module = {
+	PyModuleDef_HEAD_INIT,
+	"askygg",
+	"In-process askygg image pipeline on a headless OpenGL context.",
+	-1,
+	nullptr
+};
+
+PyMODINIT_FUNC PyInit_askygg()
+{
+	s_PipelineType.tp_name = "askygg.Pipeline";
+	s_PipelineType.tp_doc = "Pipeline(config_path, asset_dir=None)\n\n"
+							"The passes and settings of config_path on a private headless OpenGL context.";
+	s_PipelineType.tp_basicsize = sizeof(PipelineObject);
+	s_PipelineType.tp_flags = Py_TPFLAGS_DEFAULT;
+	s_PipelineType.tp_new = PyType_GenericNew;
+	s_PipelineType.tp_init = (initproc)Pipeline_Init;
+	s_PipelineType.tp_dealloc = (destructor)Pipeline_Dealloc;
+	s_PipelineType.tp_methods = s_PipelineMethods;
+	if (PyType_Ready(&s_PipelineType) < 0)
+		return nullptr;
+
+	PyObject* module = PyModule_Create(&s_Module);
+	if (!module)
+		return nullptr;
+	Py_INCREF(&s_PipelineType);
+	if (PyModule_AddObject(module, "Pipeline", (PyObject*)&s_PipelineType) < 0)
+	{
+		Py_DECREF(&s_PipelineType);
+		Py_DECREF(module);
+		return nullptr;
+	}
+	return module;
+}
@@ -4,10 +4,50 @@ import os
 import json
 
 parser = argparse.ArgumentParser()
-parser.add_argument('--mode', choices=['headless', 'editor'], required=True,
-                    help="Run the application in headless or editor mode.")
+parser.add_argument('--mode', choices=['headless', 'editor', 'stream', 'daemon'], required=True,
+                    help="Run the application in headless, editor, stream or daemon mode.")
 parser.add_argument('--build_type', choices=['debug', 'release'], default='release',
                     help="Choose to run the debug or release build. Default is release.")
+parser.add_argument('--workers', type=int, default=1,
+                    help="Headless only: number of GL worker contexts processing images in parallel. Default is 1.")
+parser.add_argument('--scaling_report', action='store_true',
+                    help="Headless only: process the input once per worker count from 1 to --workers and log the scaling.")
+parser.add_argument('--recursive', action='store_true',
+                    help="Headless only: process every subdirectory of the input and mirror them in the output.")
+parser.add_argument('--include', default=None,
+                    help="Headless only: comma-separated globs of the files to process. Default is every file.")
+parser.add_argument('--exclude', default=None,
+                    help="Headless only: comma-separated globs of files and directories to skip.")
+parser.add_argument('--manifest', default=None,
+                    help="Headless only: file listing the inputs, one per line, read instead of the input directory.")
+parser.add_argument('--input_tar', default=None,
+                    help="Headless only: tar or tar.gz to read the inputs from instead of the input directory, - for stdin.")
+parser.add_argument('--output_tar', default=None,
+                    help="Headless only: tar to write the outputs to instead of the output directory, - for stdout.")
+parser.add_argument('--readers', type=int, default=4,
+                    help="Headless only: number of threads reading input directories. Default is 4.")
+parser.add_argument('--write_threads', type=int, default=2,
+                    help="Headless only: number of threads writing output files. Default is 2.")
+parser.add_argument('--direct_io', action='store_true',
+                    help="Headless only: write output files past the page cache where the filesystem supports it.")
+parser.add_argument('--sync_every', type=int, default=0,
+                    help="Headless only: sync outputs to storage in batches of this many files. Default is 0 (never).")
+parser.add_argument('--variants', default=None,
+                    help="Headless only: YAML listing settings variants or a sweep; every input is rendered with each.")
+parser.add_argument('--settings_snapshot', default=None,
+                    help="Headless only: binary copy of the settings to start from, written when missing or stale.")
+parser.add_argument('--backend', choices=['gpu', 'cpu'], default='gpu',
+                    help="Headless only: run the passes on the GPU or on the CPU, for hosts without one. Default is gpu.")
+parser.add_argument('--cpu_threads', type=int, default=0,
+                    help="Headless only: threads the CPU backend uses. Default is 0 (every hardware thread).")
+parser.add_argument('--continuous', action='store_true',
+                    help="Editor only: redraw every frame instead of only when something changed.")
+parser.add_argument('--stream_size', default='1920x1080',
+                    help="Stream only: size of the raw frames on stdin, as WIDTHxHEIGHT. Default is 1920x1080.")
+parser.add_argument('--pix_fmt', choices=['rgba', 'rgb24', 'rgba64le'], default='rgba',
+                    help="Stream only: pixel format of the raw frames on stdin and stdout. Default is rgba.")
+parser.add_argument('--socket', default='/tmp/askygg.sock',
+                    help="Daemon only: Unix domain socket to accept jobs on. Default is /tmp/askygg.sock.")
 args = parser.parse_args()
 
 with open('settings.json') as f:
@@ -27,7 +67,40 @@ build_dir = os.path.join(script_dir, f"build_{args.build_type}")
 app_path = os.path.join(build_dir, f"askygg_editor", f"askygg_editor")
 
 # Create the command to run the application (askygg_editor)
-cmd = [app_path, f"--{args.mode}", "--input_dir", input_dir, "--output_dir", output_dir, "--config_file", config_file]
+if args.mode == 'stream':
+    # stdin and stdout are inherited, so this sits in a pipe like the binary itself.
+    cmd = [app_path, "--stream", args.stream_size, "--pix_fmt", args.pix_fmt, "--config_file", config_file]
+elif args.mode == 'daemon':
+    cmd = [app_path, "--daemon", args.socket, "--output_dir", output_dir, "--config_file", config_file]
+else:
+    cmd = [app_path, f"--{args.mode}", "--input_dir", input_dir, "--output_dir", output_dir, "--config_file", config_file,
+           "--workers", str(args.workers), "--readers", str(args.readers), "--write_threads", str(args.write_threads)]
+    if args.recursive:
+        cmd.append("--recursive")
+    if args.include:
+        cmd += ["--include", args.include]
+    if args.exclude:
+        cmd += ["--exclude", args.exclude]
+    if args.manifest:
+        cmd += ["--manifest", args.manifest]
+    if args.input_tar:
+        cmd += ["--input_tar", args.input_tar]
+    if args.output_tar:
+        cmd += ["--output_tar", args.output_tar]
+    if args.direct_io:
+        cmd.append("--direct_io")
+    if args.sync_every:
+        cmd += ["--sync_every", str(args.sync_every)]
+    if args.variants:
+        cmd += ["--variants", args.variants]
+    if args.settings_snapshot:
+        cmd += ["--settings_snapshot", args.settings_snapshot]
+    if args.backend == 'cpu':
+        cmd += ["--backend", "cpu", "--cpu_threads", str(args.cpu_threads)]
+if args.scaling_report:
+    cmd.append("--scaling_report")
+if args.continuous:
+    cmd.append("--continuous")
 
 subprocess.run(cmd)
 